@@ -39,8 +39,9 @@
 @property (strong, nonatomic) IBOutlet UIActivityIndicatorView *activityIndicator;
 
 @property (strong, nonatomic) MAVSingularValueDecomposition *imageSVD;
+@property (strong, nonatomic) MAVAsyncFactorizationTask *imageSVDTask;
 
-@property (assign, nonatomic) int currentAmountOfSingularValues;
+@property (assign, nonatomic) MAVIndex currentAmountOfSingularValues;
 
 void freePixelValues(void *info, const void *data, size_t size);
 
@@ -75,7 +76,7 @@ void freePixelValues(void *info, const void *data, size_t size);
 - (IBAction)compressionSliderValueChanged:(id)sender
 {
     MAVIndex singularValues = (MAVIndex)((UISlider *)sender).value;
-    self.compressionLabel.text = [NSString stringWithFormat:@"Singular values: %d/%d", singularValues, self.imageSVD.s.diagonalValues.length];
+    self.compressionLabel.text = [NSString stringWithFormat:@"Singular values: %lld/%lld", (long long int)singularValues, (long long int)self.imageSVD.s.diagonalValues.length];
 }
 
 - (IBAction)compressionSliderFinishedChangingValue:(id)sender
@@ -104,19 +105,32 @@ void freePixelValues(void *info, const void *data, size_t size);
     self.imageView.image = croppedGrayscaleImage;
     
     MAVMatrix *grayscaleValues = [self getGrayscalePixelValuesFromImage:croppedGrayscaleImage];
-    self.imageSVD = [MAVSingularValueDecomposition singularValueDecompositionWithMatrix:grayscaleValues];
     
+    // decompose off the main thread, dropping the result of any photo still being decomposed
+    [self.imageSVDTask cancel];
+    self.compressionSlider.enabled = NO;
+    [self setProgressViewVisible:YES completion:nil];
+    __weak SVDImageCompressionViewController *wself = self;
+    self.imageSVDTask = [grayscaleValues computeSingularValueDecompositionWithCompletion:^(MAVSingularValueDecomposition *singularValueDecomposition) {
+        wself.imageSVD = singularValueDecomposition;
+        [wself imageSVDFinished];
+        [wself setProgressViewVisible:NO completion:nil];
+    }];
+}
+
+#pragma mark - Private interface
+
+- (void)imageSVDFinished
+{
     MAVVector *singularValues = self.imageSVD.s.diagonalValues;
     self.compressionSlider.minimumValue = 1;
     self.compressionSlider.maximumValue = singularValues.length;
     self.currentAmountOfSingularValues = singularValues.length;
     self.compressionSlider.enabled = YES;
     [self.compressionSlider setValue:singularValues.length animated:YES];
-    self.compressionLabel.text = [NSString stringWithFormat:@"Singular values: %d/%d", singularValues.length, self.imageSVD.s.diagonalValues.length];
+    self.compressionLabel.text = [NSString stringWithFormat:@"Singular values: %lld/%lld", (long long int)singularValues.length, (long long int)self.imageSVD.s.diagonalValues.length];
 }
 
-#pragma mark - Private interface
-
 // adapted from http://stackoverflow.com/questions/448125/how-to-get-pixel-data-from-a-uiimage-cocoa-touch-or-cgimage-core-graphics
 - (MAVMatrix *)getGrayscalePixelValuesFromImage:(UIImage*)image
 {
@@ -190,14 +204,14 @@ void freePixelValues(void *info, const void *data, size_t size) {
 }
 
 // adapted from http://stackoverflow.com/questions/4545237/creating-uiimage-from-raw-rgba-data
-- (UIImage *)compressedImageWithSingularValues:(int)singularValues
+- (UIImage *)compressedImageWithSingularValues:(MAVIndex)singularValues
 {
     MAVMutableVector *partialSum = [(MAVMutableVector *)[[self.imageSVD.u columnVectorForColumn:0] mutableCopy] multiplyByScalar:[self.imageSVD.s.diagonalValues valueAtIndex:0]];
     MAVMutableMatrix *leftMultiplicand = [MAVMutableMatrix matrixWithValues:partialSum.values rows:partialSum.length columns:1];
     MAVVector *rightMultiplicandVector = [self.imageSVD.vT rowVectorForRow:0];
     MAVMatrix *rightMultiplicand = [MAVMatrix matrixWithValues:rightMultiplicandVector.values rows:1 columns:rightMultiplicandVector.length];
     MAVMutableMatrix *sum = [[leftMultiplicand mutableCopy] multiplyByMatrix:rightMultiplicand];
-    for (int i = singularValues - 1; i >= 0; i--) {
+    for (MAVIndex i = singularValues - 1; i >= 0; i--) {
         partialSum = [(MAVMutableVector *)[[self.imageSVD.u columnVectorForColumn:i] mutableCopy] multiplyByScalar:[self.imageSVD.s.diagonalValues valueAtIndex:i]];
         leftMultiplicand = [MAVMutableMatrix matrixWithValues:partialSum.values rows:partialSum.length columns:1];
         rightMultiplicandVector = [self.imageSVD.vT rowVectorForRow:i];
@@ -205,9 +219,9 @@ void freePixelValues(void *info, const void *data, size_t size) {
         [sum multiplyByMatrix:[leftMultiplicand multiplyByMatrix:rightMultiplicand]];
     }
     
-    int size = sum.rows * sum.columns;
+    MAVIndex size = sum.rows * sum.columns;
     unsigned char *pixelValues = malloc(size * 4);
-    for (int i = 0; i < size; i++) {
+    for (MAVIndex i = 0; i < size; i++) {
         double grayscaleValue = ((double *)sum.values.bytes)[i];
         unsigned char bitValue = (unsigned char)MIN(255, MAX(0, (int)(grayscaleValue * 255)));
         pixelValues[4 * i] = bitValue;
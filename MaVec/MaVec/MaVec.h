@@ -33,16 +33,29 @@ FOUNDATION_EXPORT double MaVecVersionNumber;
 //! Project version string for MCKNumerics.
 FOUNDATION_EXPORT const unsigned char MaVecVersionString[];
 
+#import "MAVMatrix+MAVAsyncFactorization.h"
 #import "MAVMatrix+MAVMatrixConverter.h"
 #import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix+MAVMatrixFile.h"
+#import "MAVMatrix+MAVMatrixMarket.h"
+#import "MAVMatrix+MAVNumPy.h"
 #import "NSData+MAVMatrixData.h"
+#import "MAVCholeskyFactorization.h"
+#import "MAVCovarianceAccumulator.h"
 #import "MAVEigendecomposition.h"
+#import "MAVFactorizationCache.h"
 #import "MAVLUFactorization.h"
 #import "MAVMatrix.h"
+#import "MAVMatrixBatch.h"
+#import "MAVMatrixExpression.h"
 #import "MAVMutableMatrix.h"
 #import "MAVQRFactorization.h"
 #import "MAVSingularValueDecomposition.h"
+#import "MAVTiledMatrix.h"
 #import "MAVConstants.h"
+#import "MAVParallel.h"
+#import "MAVRandomGenerator.h"
 #import "MAVTypedefs.h"
 #import "MAVMutableVector.h"
 #import "MAVVector.h"
+#import "MAVVectorSet.h"
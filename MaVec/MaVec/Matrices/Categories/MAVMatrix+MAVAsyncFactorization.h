@@ -0,0 +1,126 @@
+//
+//  MAVMatrix+MAVAsyncFactorization.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "MAVMatrix.h"
+
+/**
+ @class MAVAsyncFactorizationTask
+ @description A handle on a factorization requested with one of the asynchronous methods of MAVMatrix (MAVAsyncFactorization), used to cancel delivery of its result.
+ */
+@interface MAVAsyncFactorizationTask : NSObject
+
+/**
+ @property cancelled
+ @brief YES if cancel has been called on this task.
+ */
+@property (atomic, readonly, assign, getter=isCancelled) BOOL cancelled;
+
+/**
+ @brief Prevent the completion block of this task from being called. If every task sharing a computation is cancelled before it starts, the computation is skipped; a computation that has already started runs to completion, since the underlying LAPACK routines cannot be interrupted, and its result is still cached on the matrix. Cancelling on the completion queue before the completion block has run guarantees it will not run.
+ */
+- (void)cancel;
+
+@end
+
+/**
+ @description Asynchronous variants of the factorization properties of MAVMatrix, which compute on a global dispatch queue and deliver the result to a completion block. Concurrent requests for the same factorization of the same matrix are coalesced into a single computation whose result is delivered to each of them, and the result populates the matrix's lazily computed property, so later synchronous access returns it immediately. The matrix must not be mutated while a request is pending.
+ */
+@interface MAVMatrix (MAVAsyncFactorization)
+
+/**
+ @brief Compute the singular value decomposition of this matrix on a global dispatch queue with default priority, calling the completion block on the main queue.
+ @param completion The block to call with the decomposition.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeSingularValueDecompositionWithCompletion:(void (^)(MAVSingularValueDecomposition *singularValueDecomposition))completion;
+
+/**
+ @brief Compute the singular value decomposition of this matrix on a global dispatch queue.
+ @param priority The priority of the global dispatch queue to compute on, like DISPATCH_QUEUE_PRIORITY_LOW. A request coalesced with a pending one raises its priority if the computation has not started yet.
+ @param completionQueue The queue to call the completion block on.
+ @param completion The block to call with the decomposition.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeSingularValueDecompositionWithPriority:(dispatch_queue_priority_t)priority
+                                                             completionQueue:(dispatch_queue_t)completionQueue
+                                                                  completion:(void (^)(MAVSingularValueDecomposition *singularValueDecomposition))completion;
+
+/**
+ @brief Compute the eigendecomposition of this matrix on a global dispatch queue with default priority, calling the completion block on the main queue.
+ @param completion The block to call with the decomposition.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeEigendecompositionWithCompletion:(void (^)(MAVEigendecomposition *eigendecomposition))completion;
+
+/**
+ @brief Compute the eigendecomposition of this matrix on a global dispatch queue.
+ @param priority The priority of the global dispatch queue to compute on, like DISPATCH_QUEUE_PRIORITY_LOW. A request coalesced with a pending one raises its priority if the computation has not started yet.
+ @param completionQueue The queue to call the completion block on.
+ @param completion The block to call with the decomposition.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeEigendecompositionWithPriority:(dispatch_queue_priority_t)priority
+                                                     completionQueue:(dispatch_queue_t)completionQueue
+                                                          completion:(void (^)(MAVEigendecomposition *eigendecomposition))completion;
+
+/**
+ @brief Compute the LU factorization of this matrix on a global dispatch queue with default priority, calling the completion block on the main queue.
+ @param completion The block to call with the factorization.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeLUFactorizationWithCompletion:(void (^)(MAVLUFactorization *luFactorization))completion;
+
+/**
+ @brief Compute the LU factorization of this matrix on a global dispatch queue.
+ @param priority The priority of the global dispatch queue to compute on, like DISPATCH_QUEUE_PRIORITY_LOW. A request coalesced with a pending one raises its priority if the computation has not started yet.
+ @param completionQueue The queue to call the completion block on.
+ @param completion The block to call with the factorization.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeLUFactorizationWithPriority:(dispatch_queue_priority_t)priority
+                                                  completionQueue:(dispatch_queue_t)completionQueue
+                                                       completion:(void (^)(MAVLUFactorization *luFactorization))completion;
+
+/**
+ @brief Compute the QR factorization of this matrix on a global dispatch queue with default priority, calling the completion block on the main queue.
+ @param completion The block to call with the factorization.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeQRFactorizationWithCompletion:(void (^)(MAVQRFactorization *qrFactorization))completion;
+
+/**
+ @brief Compute the QR factorization of this matrix on a global dispatch queue.
+ @param priority The priority of the global dispatch queue to compute on, like DISPATCH_QUEUE_PRIORITY_LOW. A request coalesced with a pending one raises its priority if the computation has not started yet.
+ @param completionQueue The queue to call the completion block on.
+ @param completion The block to call with the factorization.
+ @return A task which can be used to cancel the request.
+ */
+- (MAVAsyncFactorizationTask *)computeQRFactorizationWithPriority:(dispatch_queue_priority_t)priority
+                                                  completionQueue:(dispatch_queue_t)completionQueue
+                                                       completion:(void (^)(MAVQRFactorization *qrFactorization))completion;
+
+@end
@@ -0,0 +1,298 @@
+//
+//  MAVMatrix+MAVAsyncFactorization.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <objc/runtime.h>
+
+#import "MAVMatrix+MAVAsyncFactorization.h"
+#import "MAVMatrix-Protected.h"
+
+static char MAVPendingFactorizationTasksKey;
+
+@interface MAVAsyncFactorizationTask ()
+
+@property (atomic, readwrite, assign, getter=isCancelled) BOOL cancelled;
+@property (copy, nonatomic) void (^completion)(id result);
+#if OS_OBJECT_USE_OBJC
+@property (strong, nonatomic) dispatch_queue_t completionQueue;
+#else
+@property (assign, nonatomic) dispatch_queue_t completionQueue;
+#endif
+
+@end
+
+/**
+ @class MAVPendingFactorization
+ @description The tasks waiting for a lazy property of a matrix, and the state of the computation they share. Must only be accessed on pendingFactorizationTasksQueue.
+ */
+@interface MAVPendingFactorization : NSObject
+
+@property (strong, nonatomic) NSMutableArray *tasks;
+@property (assign, nonatomic) dispatch_queue_priority_t priority;
+@property (assign, nonatomic, getter=isStarted) BOOL started;
+
+@end
+
+@implementation MAVPendingFactorization
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _tasks = [NSMutableArray array];
+    }
+    return self;
+}
+
+@end
+
+@implementation MAVAsyncFactorizationTask
+
+- (void)cancel
+{
+    self.cancelled = YES;
+}
+
+#if !OS_OBJECT_USE_OBJC
+- (void)setCompletionQueue:(dispatch_queue_t)completionQueue
+{
+    if (completionQueue != NULL) {
+        dispatch_retain(completionQueue);
+    }
+    if (_completionQueue != NULL) {
+        dispatch_release(_completionQueue);
+    }
+    _completionQueue = completionQueue;
+}
+
+- (void)dealloc
+{
+    if (_completionQueue != NULL) {
+        dispatch_release(_completionQueue);
+    }
+}
+#endif
+
+@end
+
+@implementation MAVMatrix (MAVAsyncFactorization)
+
+#pragma mark - Public
+
+- (MAVAsyncFactorizationTask *)computeSingularValueDecompositionWithCompletion:(void (^)(MAVSingularValueDecomposition *))completion
+{
+    return [self computeSingularValueDecompositionWithPriority:DISPATCH_QUEUE_PRIORITY_DEFAULT completionQueue:dispatch_get_main_queue() completion:completion];
+}
+
+- (MAVAsyncFactorizationTask *)computeSingularValueDecompositionWithPriority:(dispatch_queue_priority_t)priority
+                                                             completionQueue:(dispatch_queue_t)completionQueue
+                                                                  completion:(void (^)(MAVSingularValueDecomposition *))completion
+{
+    return [self computeLazyProperty:MAVMatrixLazyPropertySingularValueDecomposition
+                            priority:priority
+                     completionQueue:completionQueue
+                          completion:completion
+                        computeBlock:^id(MAVMatrix *matrix) {
+                            return matrix.singularValueDecomposition;
+                        }];
+}
+
+- (MAVAsyncFactorizationTask *)computeEigendecompositionWithCompletion:(void (^)(MAVEigendecomposition *))completion
+{
+    return [self computeEigendecompositionWithPriority:DISPATCH_QUEUE_PRIORITY_DEFAULT completionQueue:dispatch_get_main_queue() completion:completion];
+}
+
+- (MAVAsyncFactorizationTask *)computeEigendecompositionWithPriority:(dispatch_queue_priority_t)priority
+                                                     completionQueue:(dispatch_queue_t)completionQueue
+                                                          completion:(void (^)(MAVEigendecomposition *))completion
+{
+    return [self computeLazyProperty:MAVMatrixLazyPropertyEigendecomposition
+                            priority:priority
+                     completionQueue:completionQueue
+                          completion:completion
+                        computeBlock:^id(MAVMatrix *matrix) {
+                            return matrix.eigendecomposition;
+                        }];
+}
+
+- (MAVAsyncFactorizationTask *)computeLUFactorizationWithCompletion:(void (^)(MAVLUFactorization *))completion
+{
+    return [self computeLUFactorizationWithPriority:DISPATCH_QUEUE_PRIORITY_DEFAULT completionQueue:dispatch_get_main_queue() completion:completion];
+}
+
+- (MAVAsyncFactorizationTask *)computeLUFactorizationWithPriority:(dispatch_queue_priority_t)priority
+                                                  completionQueue:(dispatch_queue_t)completionQueue
+                                                       completion:(void (^)(MAVLUFactorization *))completion
+{
+    return [self computeLazyProperty:MAVMatrixLazyPropertyLUFactorization
+                            priority:priority
+                     completionQueue:completionQueue
+                          completion:completion
+                        computeBlock:^id(MAVMatrix *matrix) {
+                            return matrix.luFactorization;
+                        }];
+}
+
+- (MAVAsyncFactorizationTask *)computeQRFactorizationWithCompletion:(void (^)(MAVQRFactorization *))completion
+{
+    return [self computeQRFactorizationWithPriority:DISPATCH_QUEUE_PRIORITY_DEFAULT completionQueue:dispatch_get_main_queue() completion:completion];
+}
+
+- (MAVAsyncFactorizationTask *)computeQRFactorizationWithPriority:(dispatch_queue_priority_t)priority
+                                                  completionQueue:(dispatch_queue_t)completionQueue
+                                                       completion:(void (^)(MAVQRFactorization *))completion
+{
+    return [self computeLazyProperty:MAVMatrixLazyPropertyQRFactorization
+                            priority:priority
+                     completionQueue:completionQueue
+                          completion:completion
+                        computeBlock:^id(MAVMatrix *matrix) {
+                            return matrix.qrFactorization;
+                        }];
+}
+
+#pragma mark - Private
+
+// serializes access to the pending tasks of every matrix
++ (dispatch_queue_t)pendingFactorizationTasksQueue
+{
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.amproductions.mavec.pending-factorization-tasks", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+// must only be called on pendingFactorizationTasksQueue; maps each lazy property being computed to its MAVPendingFactorization
+- (NSMutableDictionary *)pendingFactorizationTasks
+{
+    NSMutableDictionary *pendingTasks = objc_getAssociatedObject(self, &MAVPendingFactorizationTasksKey);
+    if (pendingTasks == nil) {
+        pendingTasks = [NSMutableDictionary dictionary];
+        objc_setAssociatedObject(self, &MAVPendingFactorizationTasksKey, pendingTasks, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return pendingTasks;
+}
+
+/**
+ @brief Register a task waiting for a lazy property, and start computing the property unless a computation is already pending, in which case the task shares its result. If the pending computation has not started yet and the task asks for a higher priority, the computation is dispatched again at that priority, and whichever dispatch runs first computes the property.
+ @param computeBlock A block reading the lazy property from the matrix, which computes and caches it if necessary.
+ */
+- (MAVAsyncFactorizationTask *)computeLazyProperty:(MAVMatrixLazyProperty)property
+                                          priority:(dispatch_queue_priority_t)priority
+                                   completionQueue:(dispatch_queue_t)completionQueue
+                                        completion:(void (^)(id result))completion
+                                      computeBlock:(id (^)(MAVMatrix *matrix))computeBlock
+{
+    NSAssert(completion != nil, @"Must supply a completion block");
+    NSAssert(completionQueue != nil, @"Must supply a completion queue");
+
+    MAVAsyncFactorizationTask *task = [[MAVAsyncFactorizationTask alloc] init];
+    task.completion = completion;
+    task.completionQueue = completionQueue;
+
+    NSNumber *key = @(property);
+    __block MAVPendingFactorization *pending;
+    __block BOOL dispatchComputation;
+    dispatch_sync([MAVMatrix pendingFactorizationTasksQueue], ^{
+        pending = self.pendingFactorizationTasks[key];
+        if (pending == nil) {
+            pending = [[MAVPendingFactorization alloc] init];
+            pending.priority = priority;
+            self.pendingFactorizationTasks[key] = pending;
+            dispatchComputation = YES;
+        } else {
+            // a computation already running keeps the priority it started with, since the thread running it cannot be promoted
+            dispatchComputation = !pending.isStarted && priority > pending.priority;
+            if (dispatchComputation) {
+                pending.priority = priority;
+            }
+        }
+        [pending.tasks addObject:task];
+    });
+
+    if (dispatchComputation) {
+        [self dispatchComputationOfPendingFactorization:pending forKey:key priority:priority computeBlock:computeBlock];
+    }
+
+    return task;
+}
+
+/**
+ @brief Compute a pending lazy property on the global dispatch queue of the given priority, and deliver the result to every task waiting for it. Does nothing if another dispatch of the same pending computation has already started or finished.
+ */
+- (void)dispatchComputationOfPendingFactorization:(MAVPendingFactorization *)pending
+                                           forKey:(NSNumber *)key
+                                         priority:(dispatch_queue_priority_t)priority
+                                     computeBlock:(id (^)(MAVMatrix *matrix))computeBlock
+{
+    dispatch_queue_t pendingTasksQueue = [MAVMatrix pendingFactorizationTasksQueue];
+    dispatch_async(dispatch_get_global_queue(priority, 0), ^{
+        // skip the computation if another dispatch started it, or if every request for it was cancelled while it waited to start
+        __block BOOL skipComputation = YES;
+        dispatch_sync(pendingTasksQueue, ^{
+            if (self.pendingFactorizationTasks[key] != pending || pending.isStarted) {
+                return;
+            }
+            for (MAVAsyncFactorizationTask *pendingTask in pending.tasks) {
+                if (!pendingTask.isCancelled) {
+                    skipComputation = NO;
+                    break;
+                }
+            }
+            if (skipComputation) {
+                [self.pendingFactorizationTasks removeObjectForKey:key];
+            } else {
+                pending.started = YES;
+            }
+        });
+        if (skipComputation) {
+            return;
+        }
+
+        id result = computeBlock(self);
+
+        __block NSArray *tasks;
+        dispatch_sync(pendingTasksQueue, ^{
+            tasks = pending.tasks;
+            [self.pendingFactorizationTasks removeObjectForKey:key];
+        });
+        for (MAVAsyncFactorizationTask *finishedTask in tasks) {
+            if (finishedTask.isCancelled) {
+                continue;
+            }
+            dispatch_async(finishedTask.completionQueue, ^{
+                if (!finishedTask.isCancelled) {
+                    finishedTask.completion(result);
+                }
+                finishedTask.completion = nil;
+            });
+        }
+    });
+}
+
+@end
@@ -26,6 +26,7 @@
 //
 
 #import "MAVMatrix.h"
+#import "MAVRandomGenerator.h"
 
 @interface MAVMatrix (MAVMatrixFactory)
 
@@ -215,7 +216,7 @@
                                                  direction:(MAVAngleDirection)direction;
 
 /**
- @brief Class convenience method to create a matrix with the specified size containing random double-precision floating-point values.
+ @brief Class convenience method to create a matrix with the specified size containing random floating-point values distributed uniformly on [-1, 1), drawn from the default MAVRandomGenerator.
  @param rows The number of rows desired in the random matrix.
  @param columns The number of columns desired in the random matrix.
  @param precision The precision of the floating point values.
@@ -226,12 +227,40 @@
                            precision:(MCKPrecision)precision;
 
 /**
- @brief Class convenience method to create a square symmetric matrix with the specified order containing random double-precision floating-point values.
+ @brief Class convenience method to create a matrix with the specified size containing random floating-point values from the specified distribution, like a Gaussian or Rademacher sketching matrix.
+ @param rows The number of rows desired in the random matrix.
+ @param columns The number of columns desired in the random matrix.
+ @param distribution The distribution of the values.
+ @param generator The generator to draw the values from; seed it to make the matrix reproducible.
+ @param precision The precision of the floating point values.
+ @return A new instance of MAVMatrix containing rows * columns random values.
+ */
++ (instancetype)randomMatrixWithRows:(MAVIndex)rows
+                             columns:(MAVIndex)columns
+                        distribution:(MAVRandomDistribution)distribution
+                           generator:(MAVRandomGenerator *)generator
+                           precision:(MCKPrecision)precision;
+
+/**
+ @brief Class convenience method to create a square symmetric matrix with the specified order containing random floating-point values distributed uniformly on [-1, 1), drawn from the default MAVRandomGenerator.
+ @param order The amount of rows/columns desired in the matrix.
+ @param precision The precision of the floating point values.
+ @return A new square symmetric instance of MAVMatrix containing random values.
+ */
++ (instancetype)randomSymmetricMatrixOfOrder:(MAVIndex)order
+                                   precision:(MCKPrecision)precision;
+
+/**
+ @brief Class convenience method to create a square symmetric matrix with the specified order whose upper triangle contains random floating-point values from the specified distribution.
  @param order The amount of rows/columns desired in the matrix.
+ @param distribution The distribution of the values.
+ @param generator The generator to draw the values from; seed it to make the matrix reproducible.
  @param precision The precision of the floating point values.
  @return A new square symmetric instance of MAVMatrix containing random values.
  */
 + (instancetype)randomSymmetricMatrixOfOrder:(MAVIndex)order
+                                distribution:(MAVRandomDistribution)distribution
+                                   generator:(MAVRandomGenerator *)generator
                                    precision:(MCKPrecision)precision;
 
 /**
@@ -368,7 +368,20 @@
                              columns:(MAVIndex)columns
                            precision:(MCKPrecision)precision
 {
-    return [self matrixWithValues:[self randomArrayOfSize:rows * columns precision:precision]
+    return [self randomMatrixWithRows:rows
+                              columns:columns
+                         distribution:MAVRandomDistributionUniform
+                            generator:[MAVRandomGenerator defaultGenerator]
+                            precision:precision];
+}
+
++ (instancetype)randomMatrixWithRows:(MAVIndex)rows
+                             columns:(MAVIndex)columns
+                        distribution:(MAVRandomDistribution)distribution
+                           generator:(MAVRandomGenerator *)generator
+                           precision:(MCKPrecision)precision
+{
+    return [self matrixWithValues:[generator valuesWithDistribution:distribution count:rows * columns precision:precision]
                              rows:rows
                           columns:columns];
 }
@@ -376,7 +389,18 @@
 + (instancetype)randomSymmetricMatrixOfOrder:(MAVIndex)order
                                    precision:(MCKPrecision)precision
 {
-    return [self symmetricMatrixWithPackedValues:[self randomArrayOfSize:(order * (order + 1)) / 2 precision:precision]
+    return [self randomSymmetricMatrixOfOrder:order
+                                 distribution:MAVRandomDistributionUniform
+                                    generator:[MAVRandomGenerator defaultGenerator]
+                                    precision:precision];
+}
+
++ (instancetype)randomSymmetricMatrixOfOrder:(MAVIndex)order
+                                distribution:(MAVRandomDistribution)distribution
+                                   generator:(MAVRandomGenerator *)generator
+                                   precision:(MCKPrecision)precision
+{
+    return [self symmetricMatrixWithPackedValues:[generator valuesWithDistribution:distribution count:(order * (order + 1)) / 2 precision:precision]
                              triangularComponent:MAVMatrixTriangularComponentUpper
                                 leadingDimension:MAVMatrixLeadingDimensionColumn
                                            order:order];
@@ -420,42 +444,16 @@
     switch(definiteness) {
 
         case MAVMatrixDefinitenessIndefinite: {
-            BOOL shouldHaveZero = (arc4random() % 2) == 0;
-            MAVIndex zeroIndex = arc4random() % order;
-            BOOL positive = (arc4random() % 2) == 0;
-            NSData *valueData;
-            if (precision == MCKPrecisionDouble) {
-                size_t length = order * sizeof(double);
-                double *values = malloc(length);
-                for (MAVIndex i = 0; i < order; i++) {
-                    if (shouldHaveZero && i == zeroIndex) {
-                        values[i] = 0.0;
-                    } else {
-                        values[i] = fabs([NSNumber mck_randomDouble].doubleValue) * (positive ? 1.0 : -1.0);
-                        while (values[i] == 0.0 || values[i] == -0.0) {
-                            values[i] = fabs([NSNumber mck_randomDouble].doubleValue) * (positive ? 1.0 : -1.0);
-                        }
-                        positive = !positive;
-                    }
-                }
-                valueData = [NSData dataWithBytesNoCopy:values length:length];
-            } else {
-                size_t length = order * sizeof(float);
-                float *values = malloc(length);
-                for (MAVIndex i = 0; i < order; i++) {
-                    if (shouldHaveZero && i == zeroIndex) {
-                        values[i] = 0.0f;
-                    } else {
-                        values[i] = fabsf([NSNumber mck_randomFloat].floatValue) * (positive ? 1.0f : -1.0f);
-                        while (values[i] == 0.0f || values[i] == -0.0f) {
-                            values[i] = fabsf([NSNumber mck_randomFloat].floatValue) * (positive ? 1.0f : -1.0f);
-                        }
-                        positive = !positive;
-                    }
-                }
-                valueData = [NSData dataWithBytesNoCopy:values length:length];
-            }
-            matrix = [self diagonalMatrixWithValues:valueData order:order];
+            MAVRandomGenerator *generator = [MAVRandomGenerator defaultGenerator];
+            BOOL shouldHaveZero = [generator randomIndexBelow:2] == 0;
+            MAVIndex zeroIndex = shouldHaveZero ? (MAVIndex)[generator randomIndexBelow:order] : -1;
+            BOOL positive = [generator randomIndexBelow:2] == 0;
+            matrix = [self diagonalMatrixWithValues:[self randomNonzeroValuesOfOrder:order
+                                                                           zeroIndex:zeroIndex
+                                                                    startingPositive:positive
+                                                                    alternatingSigns:YES
+                                                                           precision:precision]
+                                              order:order];
         } break;
 
         case MAVMatrixDefinitenessPositiveDefinite: {
@@ -478,73 +476,23 @@
              */
 
         case MAVMatrixDefinitenessPositiveSemidefinite: {
-            MAVIndex zeroIndex = arc4random() % order;
-            NSData *valueData;
-            if (precision == MCKPrecisionDouble) {
-                size_t length = order * sizeof(double);
-                double *values = malloc(length);
-                for (MAVIndex i = 0; i < order; i++) {
-                    if (i == zeroIndex) {
-                        values[i] = 0.0;
-                    } else {
-                        values[i] = fabs([NSNumber mck_randomDouble].doubleValue);
-                        while (values[i] == 0.0 || values[i] == -0.0) {
-                            values[i] = fabs([NSNumber mck_randomDouble].doubleValue);
-                        }
-                    }
-                }
-                valueData = [NSData dataWithBytesNoCopy:values length:length];
-            } else {
-                size_t length = order * sizeof(float);
-                float *values = malloc(length);
-                for (MAVIndex i = 0; i < order; i++) {
-                    if (i == zeroIndex) {
-                        values[i] = 0.0f;
-                    } else {
-                        values[i] = fabsf([NSNumber mck_randomFloat].floatValue);
-                        while (values[i] == 0.0f || values[i] == -0.0f) {
-                            values[i] = fabsf([NSNumber mck_randomFloat].floatValue);
-                        }
-                    }
-                }
-                valueData = [NSData dataWithBytesNoCopy:values length:length];
-            }
-            matrix = [self diagonalMatrixWithValues:valueData order:order];
+            MAVIndex zeroIndex = (MAVIndex)[[MAVRandomGenerator defaultGenerator] randomIndexBelow:order];
+            matrix = [self diagonalMatrixWithValues:[self randomNonzeroValuesOfOrder:order
+                                                                           zeroIndex:zeroIndex
+                                                                    startingPositive:YES
+                                                                    alternatingSigns:NO
+                                                                           precision:precision]
+                                              order:order];
         } break;
 
         case MAVMatrixDefinitenessNegativeSemidefinite: {
-            MAVIndex zeroIndex = arc4random() % order;
-            NSData *valueData;
-            if (precision == MCKPrecisionDouble) {
-                size_t length = order * sizeof(double);
-                double *values = malloc(length);
-                for (MAVIndex i = 0; i < order; i++) {
-                    if (i == zeroIndex) {
-                        values[i] = 0.0;
-                    } else {
-                        values[i] = -fabs([NSNumber mck_randomDouble].doubleValue);
-                        while (values[i] == 0.0 || values[i] == -0.0) {
-                            values[i] = -fabs([NSNumber mck_randomDouble].doubleValue);
-                        }
-                    }
-                }
-                valueData = [NSData dataWithBytesNoCopy:values length:length];
-            } else {
-                size_t length = order * sizeof(float);
-                float *values = malloc(length);
-                for (MAVIndex i = 0; i < order; i++) {
-                    if (i == zeroIndex) {
-                        values[i] = 0.0f;
-                    } else {
-                        values[i] = -fabsf([NSNumber mck_randomFloat].floatValue);
-                        while (values[i] == 0.0f || values[i] == -0.0f) {
-                            values[i] = -fabsf([NSNumber mck_randomFloat].floatValue);
-                        }
-                    }
-                }
-                valueData = [NSData dataWithBytesNoCopy:values length:length];
-            }
-            matrix = [self diagonalMatrixWithValues:valueData order:order];
+            MAVIndex zeroIndex = (MAVIndex)[[MAVRandomGenerator defaultGenerator] randomIndexBelow:order];
+            matrix = [self diagonalMatrixWithValues:[self randomNonzeroValuesOfOrder:order
+                                                                           zeroIndex:zeroIndex
+                                                                    startingPositive:NO
+                                                                    alternatingSigns:NO
+                                                                           precision:precision]
+                                              order:order];
         } break;
 
         case MAVMatrixDefinitenessUnknown:
@@ -560,8 +508,9 @@
 
 + (instancetype)randomSingularMatrixOfOrder:(MAVIndex)order precision:(MCKPrecision)precision
 {
-    BOOL shouldHaveZeroColumn = (arc4random() % 2) == 0;
-    MAVIndex zeroVectorIndex = arc4random() % order;
+    MAVRandomGenerator *generator = [MAVRandomGenerator defaultGenerator];
+    BOOL shouldHaveZeroColumn = [generator randomIndexBelow:2] == 0;
+    MAVIndex zeroVectorIndex = (MAVIndex)[generator randomIndexBelow:order];
 
     NSMutableArray *vectors = [NSMutableArray new];
     MAVVectorFormat vectorFormat = shouldHaveZeroColumn ? MAVVectorFormatColumnVector : MAVVectorFormatRowVector;
@@ -584,4 +533,52 @@
     return matrix;
 }
 
+#pragma mark - Private
+
+/**
+ @brief Generate values with random magnitudes that are all nonzero, except for an optional zero at a specified index.
+ @param zeroIndex The index of the value to set to zero, or -1 if all values should be nonzero.
+ @param startingPositive YES if the first nonzero value should be positive, NO if it should be negative.
+ @param alternatingSigns YES to alternate the signs of successive nonzero values, NO to give them all the sign of the first.
+ @return An array of order values of the specified precision.
+ */
++ (NSData *)randomNonzeroValuesOfOrder:(MAVIndex)order
+                             zeroIndex:(MAVIndex)zeroIndex
+                      startingPositive:(BOOL)startingPositive
+                      alternatingSigns:(BOOL)alternatingSigns
+                             precision:(MCKPrecision)precision
+{
+    MAVRandomGenerator *generator = [MAVRandomGenerator defaultGenerator];
+    NSMutableData *valueData = [[generator valuesWithDistribution:MAVRandomDistributionUniform count:order precision:precision] mutableCopy];
+    BOOL positive = startingPositive;
+    if (precision == MCKPrecisionDouble) {
+        double *values = valueData.mutableBytes;
+        for (MAVIndex i = 0; i < order; i++) {
+            if (i == zeroIndex) {
+                values[i] = 0.0;
+            } else {
+                while (values[i] == 0.0) {
+                    [generator fillValues:values + i count:1 distribution:MAVRandomDistributionUniform precision:precision];
+                }
+                values[i] = fabs(values[i]) * (positive ? 1.0 : -1.0);
+                positive = alternatingSigns ? !positive : positive;
+            }
+        }
+    } else {
+        float *values = valueData.mutableBytes;
+        for (MAVIndex i = 0; i < order; i++) {
+            if (i == zeroIndex) {
+                values[i] = 0.0f;
+            } else {
+                while (values[i] == 0.0f) {
+                    [generator fillValues:values + i count:1 distribution:MAVRandomDistributionUniform precision:precision];
+                }
+                values[i] = fabsf(values[i]) * (positive ? 1.0f : -1.0f);
+                positive = alternatingSigns ? !positive : positive;
+            }
+        }
+    }
+    return valueData;
+}
+
 @end
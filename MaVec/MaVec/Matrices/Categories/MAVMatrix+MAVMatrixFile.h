@@ -0,0 +1,93 @@
+//
+//  MAVMatrix+MAVMatrixFile.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import "MAVMatrix.h"
+
+/**
+ The version of the binary matrix file format written by writeToURL:error:.
+ */
+#define MAV_MATRIX_FILE_VERSION 1
+
+/**
+ The alignment of the values in a binary matrix file, in bytes, which is also the length of the file's header block.
+ */
+#define MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT 4096
+
+/**
+ The domain of errors reading or writing matrix files, in MaVec's binary format or any of the interchange formats, that are not errors of the underlying system calls, which are reported in NSPOSIXErrorDomain.
+ */
+extern NSString *const MAVMatrixFileErrorDomain;
+
+typedef enum : NSInteger {
+    /**
+     The file does not start with the matrix file signature, or its header describes an impossible matrix.
+     */
+    MAVMatrixFileErrorInvalidFormat,
+    
+    /**
+     The file was written in a version of the format this version of MaVec cannot read.
+     */
+    MAVMatrixFileErrorUnsupportedVersion,
+    
+    /**
+     The file is shorter than its header says.
+     */
+    MAVMatrixFileErrorTruncated,
+    
+    /**
+     The file is well formed but holds data MaVec cannot represent, like complex, integer or more than two-dimensional arrays.
+     */
+    MAVMatrixFileErrorUnsupportedType
+}
+/**
+ Constants describing errors in MAVMatrixFileErrorDomain.
+ */
+MAVMatrixFileError;
+
+/**
+ @description Reading and writing matrices in MaVec's binary file format. A file starts with a header block of MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT bytes, of which the first 64 hold the signature "MAVMATRX", the format version, the offset and length of the values, the rows, columns and band codiagonals, and the size of a value, leading dimension, packing method, triangular component and symmetry of the matrix, all little-endian. The values follow, aligned and exactly as the matrix stores them, so packed and band matrices keep their compact storage.
+ */
+@interface MAVMatrix (MAVMatrixFile)
+
+/**
+ @brief Open a matrix written with writeToURL:error:. The file is mapped into memory read-only instead of being read, so opening it takes constant time regardless of its size, and only the pages holding values that are actually used are ever read from disk. The file must not be modified while the matrix exists. Mutable matrices copy the values on their first mutation.
+ @param url The file URL of the matrix file.
+ @param error If the file cannot be opened or is not a valid matrix file, set to an error describing the problem.
+ @return A new matrix whose values are backed by the mapped file, or nil if the file could not be opened.
+ */
++ (instancetype)matrixWithContentsOfURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ @brief Write this matrix to a file in the binary matrix file format. The file is written to a temporary file first and then moved into place, so readers never see a partially written file.
+ @param url The file URL to write to, replacing any existing file.
+ @param error If the file cannot be written, set to an error describing the problem.
+ @return YES if the file was written, NO otherwise.
+ */
+- (BOOL)writeToURL:(NSURL *)url error:(NSError **)error;
+
+@end
@@ -0,0 +1,275 @@
+//
+//  MAVMatrix+MAVMatrixFile.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <libkern/OSByteOrder.h>
+
+#import "MAVFileIO.h"
+#import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix+MAVMatrixFile.h"
+#import "MAVMatrix-Protected.h"
+
+NSString *const MAVMatrixFileErrorDomain = @"MAVMatrixFileErrorDomain";
+
+/**
+ The signature at the start of every matrix file.
+ */
+static const char MAVMatrixFileSignature[8] = { 'M', 'A', 'V', 'M', 'A', 'T', 'R', 'X' };
+
+/**
+ The number of bytes of the header block holding fields; the rest of the block is zero padding.
+ */
+#define MAV_MATRIX_FILE_HEADER_FIELDS_LENGTH 64
+
+/**
+ The fields of a matrix file header, in host byte order.
+ */
+typedef struct {
+    uint32_t version;
+    uint32_t payloadOffset;
+    uint64_t payloadLength;
+    uint64_t rows;
+    uint64_t columns;
+    uint64_t upperCodiagonals;
+    uint64_t lowerCodiagonals;
+    uint8_t valueSize;
+    uint8_t leadingDimension;
+    uint8_t packingMethod;
+    uint8_t triangularComponent;
+    uint8_t symmetric;
+} MAVMatrixFileHeader;
+
+static void MAVEncodeMatrixFileHeader(const MAVMatrixFileHeader *header, uint8_t *bytes)
+{
+    memcpy(bytes, MAVMatrixFileSignature, sizeof(MAVMatrixFileSignature));
+    OSWriteLittleInt32(bytes, 8, header->version);
+    OSWriteLittleInt32(bytes, 12, header->payloadOffset);
+    OSWriteLittleInt64(bytes, 16, header->payloadLength);
+    OSWriteLittleInt64(bytes, 24, header->rows);
+    OSWriteLittleInt64(bytes, 32, header->columns);
+    OSWriteLittleInt64(bytes, 40, header->upperCodiagonals);
+    OSWriteLittleInt64(bytes, 48, header->lowerCodiagonals);
+    bytes[56] = header->valueSize;
+    bytes[57] = header->leadingDimension;
+    bytes[58] = header->packingMethod;
+    bytes[59] = header->triangularComponent;
+    bytes[60] = header->symmetric;
+}
+
+static void MAVDecodeMatrixFileHeader(const uint8_t *bytes, MAVMatrixFileHeader *header)
+{
+    header->version = OSReadLittleInt32(bytes, 8);
+    header->payloadOffset = OSReadLittleInt32(bytes, 12);
+    header->payloadLength = OSReadLittleInt64(bytes, 16);
+    header->rows = OSReadLittleInt64(bytes, 24);
+    header->columns = OSReadLittleInt64(bytes, 32);
+    header->upperCodiagonals = OSReadLittleInt64(bytes, 40);
+    header->lowerCodiagonals = OSReadLittleInt64(bytes, 48);
+    header->valueSize = bytes[56];
+    header->leadingDimension = bytes[57];
+    header->packingMethod = bytes[58];
+    header->triangularComponent = bytes[59];
+    header->symmetric = bytes[60];
+}
+
+@implementation MAVMatrix (MAVMatrixFile)
+
++ (instancetype)matrixWithContentsOfURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Matrix files can only be read from file URLs.");
+    
+    MAVMappedFile *file = [MAVMappedFile mappedFileWithURL:url error:error];
+    if (file == nil) {
+        return nil;
+    }
+    if (file.length < MAV_MATRIX_FILE_HEADER_FIELDS_LENGTH) {
+        if (error) {
+            *error = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the file is shorter than a header");
+        }
+        return nil;
+    }
+    
+    MAVMatrixFileHeader header;
+    MAVDecodeMatrixFileHeader(file.bytes, &header);
+    NSError *formatError = [self validateMatrixFileHeader:header signature:file.bytes fileLength:file.length url:url];
+    if (formatError != nil) {
+        if (error) {
+            *error = formatError;
+        }
+        return nil;
+    }
+    
+    NSData *values = [file dataWithRange:NSMakeRange(header.payloadOffset, (NSUInteger)header.payloadLength)];
+    MAVIndex rows = (MAVIndex)header.rows;
+    MAVIndex columns = (MAVIndex)header.columns;
+    MAVMatrixTriangularComponent triangularComponent = (MAVMatrixTriangularComponent)header.triangularComponent;
+    
+    MAVMatrix *matrix;
+    switch ((MAVMatrixValuePackingMethod)header.packingMethod) {
+        case MAVMatrixValuePackingMethodConventional:
+            matrix = [[self alloc] initWithValues:values
+                                             rows:rows
+                                          columns:columns
+                                 leadingDimension:(MAVMatrixLeadingDimension)header.leadingDimension
+                                    packingMethod:MAVMatrixValuePackingMethodConventional
+                              triangularComponent:triangularComponent];
+            if (header.symmetric) {
+                matrix.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+            }
+            break;
+            
+        case MAVMatrixValuePackingMethodPacked:
+            if (header.symmetric) {
+                matrix = [self symmetricMatrixWithPackedValues:values
+                                           triangularComponent:triangularComponent
+                                              leadingDimension:(MAVMatrixLeadingDimension)header.leadingDimension
+                                                         order:rows];
+            } else {
+                matrix = [self triangularMatrixWithPackedValues:values
+                                          ofTriangularComponent:triangularComponent
+                                               leadingDimension:(MAVMatrixLeadingDimension)header.leadingDimension
+                                                          order:rows];
+            }
+            break;
+            
+        case MAVMatrixValuePackingMethodBand:
+            matrix = [self bandMatrixWithValues:values
+                                          order:rows
+                               upperCodiagonals:(MAVIndex)header.upperCodiagonals
+                               lowerCodiagonals:(MAVIndex)header.lowerCodiagonals];
+            if (header.symmetric) {
+                matrix.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+            }
+            break;
+            
+        default: break;
+    }
+    
+    return matrix;
+}
+
+- (BOOL)writeToURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Matrix files can only be written to file URLs.");
+    
+    MAVMatrixFileHeader header = {
+        .version = MAV_MATRIX_FILE_VERSION,
+        .payloadOffset = MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT,
+        .payloadLength = self.values.length,
+        .rows = (uint64_t)self.rows,
+        .columns = (uint64_t)self.columns,
+        .upperCodiagonals = self.packingMethod == MAVMatrixValuePackingMethodBand ? (uint64_t)self.upperCodiagonals : 0,
+        .lowerCodiagonals = self.packingMethod == MAVMatrixValuePackingMethodBand ? (uint64_t)(self.bandwidth - self.upperCodiagonals - 1) : 0,
+        .valueSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float),
+        .leadingDimension = self.leadingDimension,
+        .packingMethod = self.packingMethod,
+        .triangularComponent = self.triangularComponent,
+        .symmetric = self.isSymmetric.isYes ? 1 : 0,
+    };
+    uint8_t *headerBlock = calloc(MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT, 1);
+    MAVEncodeMatrixFileHeader(&header, headerBlock);
+    
+    BOOL written = MAVWriteFileAtomically(url, error, ^BOOL(int fileDescriptor) {
+        return MAVWriteFully(fileDescriptor, headerBlock, MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT)
+        && MAVWriteFully(fileDescriptor, self.values.bytes, self.values.length);
+    });
+    free(headerBlock);
+    
+    return written;
+}
+
+#pragma mark - Private
+
+/**
+ @brief Check that a decoded header describes a matrix this version can read, whose values lie within the file.
+ @param signature The first bytes of the file.
+ @return nil if the header is valid, otherwise an error describing the problem.
+ */
++ (NSError *)validateMatrixFileHeader:(MAVMatrixFileHeader)header
+                            signature:(const void *)signature
+                           fileLength:(size_t)fileLength
+                                  url:(NSURL *)url
+{
+    if (memcmp(signature, MAVMatrixFileSignature, sizeof(MAVMatrixFileSignature)) != 0) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the signature is missing");
+    }
+    if (header.version != MAV_MATRIX_FILE_VERSION) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedVersion, url, [NSString stringWithFormat:@"format version %u is not supported", header.version]);
+    }
+    if (header.valueSize != sizeof(double) && header.valueSize != sizeof(float)) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the value size is neither that of a float nor a double");
+    }
+    if (header.rows > INT64_MAX || header.columns > INT64_MAX || header.upperCodiagonals > INT64_MAX || header.lowerCodiagonals > INT64_MAX
+        || (header.leadingDimension != MAVMatrixLeadingDimensionRow && header.leadingDimension != MAVMatrixLeadingDimensionColumn)
+        || (header.triangularComponent != MAVMatrixTriangularComponentUpper && header.triangularComponent != MAVMatrixTriangularComponentLower && header.triangularComponent != MAVMatrixTriangularComponentBoth)) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the header describes an impossible matrix");
+    }
+    
+    // the values of the largest matrix that can be mapped, so counting them cannot overflow
+    uint64_t maximumValueCount = SIZE_MAX / header.valueSize;
+    uint64_t valueCount;
+    switch ((MAVMatrixValuePackingMethod)header.packingMethod) {
+        case MAVMatrixValuePackingMethodConventional:
+            if (header.columns > 0 && header.rows > maximumValueCount / header.columns) {
+                return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the matrix is too large");
+            }
+            valueCount = header.rows * header.columns;
+            break;
+            
+        case MAVMatrixValuePackingMethodPacked:
+            if (header.rows != header.columns || header.triangularComponent == MAVMatrixTriangularComponentBoth) {
+                return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"packed matrices must be square and store one triangle");
+            }
+            if (header.rows > 0 && header.rows / 2 + 1 > maximumValueCount / header.rows) {
+                return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the matrix is too large");
+            }
+            valueCount = header.rows % 2 == 0 ? header.rows / 2 * (header.rows + 1) : (header.rows + 1) / 2 * header.rows;
+            break;
+            
+        case MAVMatrixValuePackingMethodBand:
+            if (header.rows != header.columns || (header.rows > 0 && (header.upperCodiagonals >= header.rows || header.lowerCodiagonals >= header.rows))) {
+                return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"band matrices must be square with fewer codiagonals on either side than their order");
+            }
+            if (header.rows > 0 && header.upperCodiagonals + header.lowerCodiagonals + 1 > maximumValueCount / header.rows) {
+                return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the matrix is too large");
+            }
+            valueCount = (header.upperCodiagonals + header.lowerCodiagonals + 1) * header.rows;
+            break;
+            
+        default:
+            return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the packing method is unknown");
+    }
+    
+    if (header.payloadOffset < MAV_MATRIX_FILE_HEADER_FIELDS_LENGTH || header.payloadOffset % header.valueSize != 0 || header.payloadLength != valueCount * header.valueSize) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the location of the values is inconsistent with the matrix");
+    }
+    if (header.payloadOffset + header.payloadLength > fileLength) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the file ends before the last value");
+    }
+    
+    return nil;
+}
+
+@end
@@ -0,0 +1,75 @@
+//
+//  MAVMatrix+MAVMatrixMarket.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import "MAVMatrix.h"
+#import "MAVMatrix+MAVMatrixFile.h"
+
+typedef enum : UInt8 {
+    /**
+     Every value is listed in column-major order, one per line. Symmetric matrices list only their lower triangle.
+     */
+    MAVMatrixMarketFormatArray,
+    
+    /**
+     Only nonzero values are listed, one per line with its one-based row and column. Symmetric matrices list only their lower triangle.
+     */
+    MAVMatrixMarketFormatCoordinate
+}
+/**
+ Constants describing the formats of Matrix Market files.
+ */
+MAVMatrixMarketFormat;
+
+/**
+ @description Reading and writing matrices in the NIST Matrix Market exchange format (http://math.nist.gov/MatrixMarket/formats.html). Real, integer and pattern matrices in array or coordinate format, with general, symmetric, skew-symmetric or (real) Hermitian symmetry, can be read. The file is mapped and parsed one line at a time straight into the final buffer of values, without boxing any of them in NSNumber. Errors in the files are reported in MAVMatrixFileErrorDomain.
+ */
+@interface MAVMatrix (MAVMatrixMarket)
+
+/**
+ @brief Read a matrix from a Matrix Market file. Symmetric and skew-symmetric matrices are expanded into conventional storage, and symmetric ones are marked as such.
+ @param url The file URL of the Matrix Market file.
+ @param precision The precision of the values of the new matrix.
+ @param error If the file cannot be read or is not a Matrix Market file of a real matrix, set to an error describing the problem.
+ @return A new, conventionally stored, column-major matrix holding the file's values, or nil if the file could not be read.
+ */
++ (instancetype)matrixWithContentsOfMatrixMarketURL:(NSURL *)url
+                                          precision:(MCKPrecision)precision
+                                              error:(NSError **)error;
+
+/**
+ @brief Write this matrix to a Matrix Market file of real values, with enough significant digits that reading it back yields exactly the same values. Symmetric matrices are written with symmetric symmetry, listing only their lower triangle. The file is written to a temporary file first and then moved into place.
+ @param url The file URL to write to, replacing any existing file.
+ @param format The format to write the values in.
+ @param error If the file cannot be written, set to an error describing the problem.
+ @return YES if the file was written, NO otherwise.
+ */
+- (BOOL)writeMatrixMarketToURL:(NSURL *)url
+                        format:(MAVMatrixMarketFormat)format
+                         error:(NSError **)error;
+
+@end
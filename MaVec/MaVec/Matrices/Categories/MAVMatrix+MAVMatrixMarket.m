@@ -0,0 +1,400 @@
+//
+//  MAVMatrix+MAVMatrixMarket.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <ctype.h>
+#import <stdarg.h>
+#import <strings.h>
+
+#import "MAVFileIO.h"
+#import "MAVMatrix+MAVMatrixMarket.h"
+#import "MAVMatrix-Protected.h"
+
+/**
+ Formatted lines are collected in a buffer of this many bytes before being written to the file.
+ */
+#define MAV_MATRIX_MARKET_WRITE_BUFFER_LENGTH (1 << 20)
+
+/**
+ The longest line the writer formats, comfortably above two indices and a value with 17 significant digits.
+ */
+#define MAV_MATRIX_MARKET_MAX_LINE_LENGTH 128
+
+typedef enum : UInt8 {
+    MAVMatrixMarketSymmetryGeneral,
+    MAVMatrixMarketSymmetrySymmetric,
+    MAVMatrixMarketSymmetrySkewSymmetric
+}
+/**
+ Constants describing the symmetries a Matrix Market file can declare, of which real Hermitian matrices are symmetric.
+ */
+MAVMatrixMarketSymmetry;
+
+/**
+ Cursor over the lines of a mapped Matrix Market file, copying each into a reusable, NUL-terminated buffer so it can be parsed with the C library without reading past the end of the mapping.
+ */
+typedef struct {
+    const char *position;
+    const char *end;
+    char *line;
+    size_t capacity;
+} MAVMatrixMarketScanner;
+
+/**
+ @return YES if another line was copied into scanner->line, NO at the end of the file.
+ */
+static BOOL MAVScanMatrixMarketLine(MAVMatrixMarketScanner *scanner)
+{
+    if (scanner->position >= scanner->end) {
+        return NO;
+    }
+    const char *newline = memchr(scanner->position, '\n', (size_t)(scanner->end - scanner->position));
+    size_t length = (size_t)((newline != NULL ? newline : scanner->end) - scanner->position);
+    if (length + 1 > scanner->capacity) {
+        scanner->capacity = MAX(length + 1, scanner->capacity * 2);
+        scanner->line = realloc(scanner->line, scanner->capacity);
+    }
+    memcpy(scanner->line, scanner->position, length);
+    scanner->line[length] = '\0';
+    scanner->position += length + (newline != NULL ? 1 : 0);
+    return YES;
+}
+
+/**
+ @return YES if another line holding data, rather than a comment or only whitespace, was copied into scanner->line, NO at the end of the file.
+ */
+static BOOL MAVScanMatrixMarketDataLine(MAVMatrixMarketScanner *scanner)
+{
+    while (MAVScanMatrixMarketLine(scanner)) {
+        const char *character = scanner->line;
+        while (isspace((unsigned char)*character)) {
+            character++;
+        }
+        if (*character != '\0' && *character != '%') {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+/**
+ Output buffer for formatting a Matrix Market file in large chunks.
+ */
+typedef struct {
+    int fileDescriptor;
+    char *buffer;
+    size_t length;
+} MAVMatrixMarketWriter;
+
+/**
+ @return NO with errno set if the buffered lines could not be written.
+ */
+static BOOL MAVFlushMatrixMarketWriter(MAVMatrixMarketWriter *writer)
+{
+    BOOL written = MAVWriteFully(writer->fileDescriptor, writer->buffer, writer->length);
+    writer->length = 0;
+    return written;
+}
+
+/**
+ @brief Format a line of at most MAV_MATRIX_MARKET_MAX_LINE_LENGTH bytes into the buffer, first writing out the buffer if it is nearly full.
+ @return NO with errno set if the buffer had to be written and could not be.
+ */
+static BOOL MAVWriteMatrixMarketLine(MAVMatrixMarketWriter *writer, const char *format, ...) __attribute__((format(printf, 2, 3)));
+static BOOL MAVWriteMatrixMarketLine(MAVMatrixMarketWriter *writer, const char *format, ...)
+{
+    if (writer->length + MAV_MATRIX_MARKET_MAX_LINE_LENGTH > MAV_MATRIX_MARKET_WRITE_BUFFER_LENGTH && !MAVFlushMatrixMarketWriter(writer)) {
+        return NO;
+    }
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(writer->buffer + writer->length, MAV_MATRIX_MARKET_MAX_LINE_LENGTH, format, arguments);
+    va_end(arguments);
+    writer->length += (size_t)MIN(length, MAV_MATRIX_MARKET_MAX_LINE_LENGTH - 1);
+    return YES;
+}
+
+@implementation MAVMatrix (MAVMatrixMarket)
+
++ (instancetype)matrixWithContentsOfMatrixMarketURL:(NSURL *)url
+                                          precision:(MCKPrecision)precision
+                                              error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Matrix Market files can only be read from file URLs.");
+    
+    MAVMappedFile *file = [MAVMappedFile mappedFileWithURL:url error:error];
+    if (file == nil) {
+        return nil;
+    }
+    
+    MAVMatrixMarketScanner scanner = {
+        .position = (const char *)file.bytes,
+        .end = (const char *)file.bytes + file.length,
+        .line = NULL,
+        .capacity = 0,
+    };
+    NSError *formatError = nil;
+    BOOL coordinate = NO;
+    BOOL pattern = NO;
+    MAVMatrixMarketSymmetry symmetry = MAVMatrixMarketSymmetryGeneral;
+    long long rows = 0;
+    long long columns = 0;
+    long long entries = 0;
+    
+    // the banner: %%MatrixMarket matrix <format> <field> <symmetry>
+    char object[32], format[32], field[32], symmetryName[32];
+    if (!MAVScanMatrixMarketLine(&scanner) || sscanf(scanner.line, "%%%%MatrixMarket %31s %31s %31s %31s", object, format, field, symmetryName) != 4) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the Matrix Market banner is missing");
+    } else if (strcasecmp(object, "matrix") != 0) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, [NSString stringWithFormat:@"%s objects are not supported", object]);
+    } else if (strcasecmp(field, "complex") == 0) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, @"complex matrices are not supported");
+    } else {
+        coordinate = strcasecmp(format, "coordinate") == 0;
+        pattern = strcasecmp(field, "pattern") == 0;
+        if (strcasecmp(symmetryName, "symmetric") == 0 || strcasecmp(symmetryName, "hermitian") == 0) {
+            symmetry = MAVMatrixMarketSymmetrySymmetric;
+        } else if (strcasecmp(symmetryName, "skew-symmetric") == 0) {
+            symmetry = MAVMatrixMarketSymmetrySkewSymmetric;
+        } else if (strcasecmp(symmetryName, "general") != 0) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, [NSString stringWithFormat:@"symmetry %s is unknown", symmetryName]);
+        }
+        if (!coordinate && strcasecmp(format, "array") != 0) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, [NSString stringWithFormat:@"format %s is unknown", format]);
+        } else if (!(pattern && coordinate) && strcasecmp(field, "real") != 0 && strcasecmp(field, "double") != 0 && strcasecmp(field, "integer") != 0) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, [NSString stringWithFormat:@"field %s is unknown or not allowed in %s format", field, format]);
+        }
+    }
+    
+    if (formatError == nil) {
+        if (!MAVScanMatrixMarketDataLine(&scanner)) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the file ends before the size of the matrix");
+        } else {
+            int sizeCount = coordinate ? sscanf(scanner.line, "%lld %lld %lld", &rows, &columns, &entries) : sscanf(scanner.line, "%lld %lld", &rows, &columns);
+            if (sizeCount != (coordinate ? 3 : 2) || rows < 0 || columns < 0 || entries < 0) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the size of the matrix is invalid");
+            } else if (columns > 0 && (uint64_t)rows > SIZE_MAX / sizeof(double) / (uint64_t)columns) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the matrix is too large");
+            } else if (symmetry != MAVMatrixMarketSymmetryGeneral && rows != columns) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"symmetric matrices must be square");
+            }
+        }
+    }
+    
+    if (formatError != nil) {
+        free(scanner.line);
+        if (error) {
+            *error = formatError;
+        }
+        return nil;
+    }
+    
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    size_t valuesLength = (size_t)(rows * columns) * valueSize;
+    void *values = calloc((size_t)(rows * columns), valueSize);
+    double *doubleValues = values;
+    float *floatValues = values;
+    
+    if (coordinate) {
+        long long entry = 0;
+        for (; entry < entries && MAVScanMatrixMarketDataLine(&scanner); entry++) {
+            char *position = scanner.line;
+            char *end;
+            long long row = strtoll(position, &end, 10);
+            BOOL parsed = end != position;
+            position = end;
+            long long column = strtoll(position, &end, 10);
+            parsed = parsed && end != position;
+            position = end;
+            double value = 1.0;
+            if (!pattern) {
+                value = strtod(position, &end);
+                parsed = parsed && end != position;
+            }
+            if (!parsed || row < 1 || row > rows || column < 1 || column > columns) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, [NSString stringWithFormat:@"entry %lld is invalid", entry + 1]);
+                break;
+            }
+            
+            size_t index = (size_t)((column - 1) * rows + row - 1);
+            size_t mirroredIndex = (size_t)((row - 1) * rows + column - 1);
+            double mirroredValue = symmetry == MAVMatrixMarketSymmetrySkewSymmetric ? -value : value;
+            if (precision == MCKPrecisionDouble) {
+                doubleValues[index] = value;
+                if (symmetry != MAVMatrixMarketSymmetryGeneral && row != column) {
+                    doubleValues[mirroredIndex] = mirroredValue;
+                }
+            } else {
+                floatValues[index] = (float)value;
+                if (symmetry != MAVMatrixMarketSymmetryGeneral && row != column) {
+                    floatValues[mirroredIndex] = (float)mirroredValue;
+                }
+            }
+        }
+        if (formatError == nil && entry < entries) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, [NSString stringWithFormat:@"the file ends after %lld of %lld entries", entry, entries]);
+        }
+    } else {
+        // values run down the columns, over only the lower triangle of symmetric matrices and the strictly lower triangle of skew-symmetric ones
+        long long row = symmetry == MAVMatrixMarketSymmetrySkewSymmetric ? 1 : 0;
+        long long column = 0;
+        while (formatError == nil && column < columns && row >= rows) {
+            column++;
+            row = symmetry == MAVMatrixMarketSymmetryGeneral ? 0 : column + (symmetry == MAVMatrixMarketSymmetrySkewSymmetric ? 1 : 0);
+        }
+        while (column < columns && formatError == nil) {
+            if (!MAVScanMatrixMarketDataLine(&scanner)) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the file ends before the last value");
+                break;
+            }
+            
+            // values are meant to be one per line, but take any number
+            char *position = scanner.line;
+            while (column < columns) {
+                char *end;
+                double value = strtod(position, &end);
+                if (end == position) {
+                    while (isspace((unsigned char)*end)) {
+                        end++;
+                    }
+                    if (*end != '\0') {
+                        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, [NSString stringWithFormat:@"the value at row %lld, column %lld is invalid", row + 1, column + 1]);
+                    }
+                    break;
+                }
+                position = end;
+                
+                size_t index = (size_t)(column * rows + row);
+                size_t mirroredIndex = (size_t)(row * rows + column);
+                double mirroredValue = symmetry == MAVMatrixMarketSymmetrySkewSymmetric ? -value : value;
+                if (precision == MCKPrecisionDouble) {
+                    doubleValues[index] = value;
+                    if (symmetry != MAVMatrixMarketSymmetryGeneral) {
+                        doubleValues[mirroredIndex] = mirroredValue;
+                    }
+                } else {
+                    floatValues[index] = (float)value;
+                    if (symmetry != MAVMatrixMarketSymmetryGeneral) {
+                        floatValues[mirroredIndex] = (float)mirroredValue;
+                    }
+                }
+                
+                row++;
+                while (column < columns && row >= rows) {
+                    column++;
+                    row = symmetry == MAVMatrixMarketSymmetryGeneral ? 0 : column + (symmetry == MAVMatrixMarketSymmetrySkewSymmetric ? 1 : 0);
+                }
+            }
+        }
+    }
+    free(scanner.line);
+    
+    if (formatError != nil) {
+        free(values);
+        if (error) {
+            *error = formatError;
+        }
+        return nil;
+    }
+    
+    MAVMatrix *matrix = [[self alloc] initWithValues:[NSData dataWithBytesNoCopy:values length:valuesLength]
+                                                rows:(MAVIndex)rows
+                                             columns:(MAVIndex)columns
+                                    leadingDimension:MAVMatrixLeadingDimensionColumn
+                                       packingMethod:MAVMatrixValuePackingMethodConventional
+                                 triangularComponent:MAVMatrixTriangularComponentBoth];
+    matrix.precision = precision;
+    if (symmetry == MAVMatrixMarketSymmetrySymmetric) {
+        matrix.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    
+    return matrix;
+}
+
+- (BOOL)writeMatrixMarketToURL:(NSURL *)url
+                        format:(MAVMatrixMarketFormat)format
+                         error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Matrix Market files can only be written to file URLs.");
+    
+    NSData *columnMajorValues = self.packingMethod == MAVMatrixValuePackingMethodConventional && self.leadingDimension == MAVMatrixLeadingDimensionColumn ? self.values : [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    BOOL symmetric = self.isSymmetric.isYes;
+    MAVIndex rows = self.rows;
+    MAVIndex columns = self.columns;
+    const double *doubleValues = columnMajorValues.bytes;
+    const float *floatValues = columnMajorValues.bytes;
+    BOOL isDouble = self.precision == MCKPrecisionDouble;
+    
+    return MAVWriteFileAtomically(url, error, ^BOOL(int fileDescriptor) {
+        MAVMatrixMarketWriter writer = {
+            .fileDescriptor = fileDescriptor,
+            .buffer = malloc(MAV_MATRIX_MARKET_WRITE_BUFFER_LENGTH),
+            .length = 0,
+        };
+        BOOL written = MAVWriteMatrixMarketLine(&writer, "%%%%MatrixMarket matrix %s real %s\n", format == MAVMatrixMarketFormatCoordinate ? "coordinate" : "array", symmetric ? "symmetric" : "general");
+        
+        if (format == MAVMatrixMarketFormatCoordinate) {
+            // the number of entries precedes them
+            long long entries = 0;
+            for (MAVIndex column = 0; column < columns; column++) {
+                for (MAVIndex row = symmetric ? column : 0; row < rows; row++) {
+                    size_t index = (size_t)column * rows + row;
+                    if (isDouble ? doubleValues[index] != 0.0 : floatValues[index] != 0.0f) {
+                        entries++;
+                    }
+                }
+            }
+            written = written && MAVWriteMatrixMarketLine(&writer, "%lld %lld %lld\n", (long long int)rows, (long long int)columns, entries);
+            for (MAVIndex column = 0; written && column < columns; column++) {
+                for (MAVIndex row = symmetric ? column : 0; written && row < rows; row++) {
+                    size_t index = (size_t)column * rows + row;
+                    if (isDouble && doubleValues[index] != 0.0) {
+                        written = MAVWriteMatrixMarketLine(&writer, "%lld %lld %.17g\n", (long long int)row + 1, (long long int)column + 1, doubleValues[index]);
+                    } else if (!isDouble && floatValues[index] != 0.0f) {
+                        written = MAVWriteMatrixMarketLine(&writer, "%lld %lld %.9g\n", (long long int)row + 1, (long long int)column + 1, (double)floatValues[index]);
+                    }
+                }
+            }
+        } else {
+            written = written && MAVWriteMatrixMarketLine(&writer, "%lld %lld\n", (long long int)rows, (long long int)columns);
+            for (MAVIndex column = 0; written && column < columns; column++) {
+                for (MAVIndex row = symmetric ? column : 0; written && row < rows; row++) {
+                    size_t index = (size_t)column * rows + row;
+                    if (isDouble) {
+                        written = MAVWriteMatrixMarketLine(&writer, "%.17g\n", doubleValues[index]);
+                    } else {
+                        written = MAVWriteMatrixMarketLine(&writer, "%.9g\n", (double)floatValues[index]);
+                    }
+                }
+            }
+        }
+        
+        written = written && MAVFlushMatrixMarketWriter(&writer);
+        free(writer.buffer);
+        return written;
+    });
+}
+
+@end
@@ -0,0 +1,70 @@
+//
+//  MAVMatrix+MAVNumPy.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import "MAVMatrix.h"
+#import "MAVMatrix+MAVMatrixFile.h"
+
+/**
+ @description Reading and writing matrices as NumPy arrays, in .npy files holding a single array and .npz archives holding several arrays by name. Arrays of little- or big-endian 32- and 64-bit floats (dtypes f4 and f8) with up to two dimensions can be read: C-ordered arrays become row-major matrices and Fortran-ordered arrays column-major ones, one-dimensional arrays become matrices with a single column and zero-dimensional arrays matrices with a single value. Values are never boxed in NSNumber: they are mapped straight from the file when their layout allows it, and otherwise read, byte-swapped or inflated straight into the matrix's final buffer. Errors in the files are reported in MAVMatrixFileErrorDomain.
+ */
+@interface MAVMatrix (MAVNumPy)
+
+/**
+ @brief Read a matrix from a NumPy .npy file. The values of little-endian arrays are mapped from the file, so the file must not be modified while the matrix exists.
+ @param url The file URL of the .npy file.
+ @param error If the file cannot be read or does not hold an array of floats with at most two dimensions, set to an error describing the problem.
+ @return A new matrix holding the array, or nil if the file could not be read.
+ */
++ (instancetype)matrixWithContentsOfNumPyURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ @brief Read all the arrays in a NumPy .npz archive, as written by numpy.savez or numpy.savez_compressed. Stored entries whose values are suitably aligned are mapped from the file, so the file must not be modified while the matrices exist; compressed entries are inflated.
+ @param url The file URL of the .npz archive.
+ @param error If the archive cannot be read or any of its arrays is not an array of floats with at most two dimensions, set to an error describing the problem.
+ @return A dictionary mapping the name of each array in the archive, without its .npy extension, to a new matrix holding it, or nil if the archive could not be read.
+ */
++ (NSDictionary *)matricesWithContentsOfNumPyArchiveURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ @brief Write this matrix to a NumPy .npy file, as a two-dimensional array in the order of its leading dimension. Packed and band matrices are written in their conventional, column-major form. The file is written to a temporary file first and then moved into place.
+ @param url The file URL to write to, replacing any existing file.
+ @param error If the file cannot be written, set to an error describing the problem.
+ @return YES if the file was written, NO otherwise.
+ */
+- (BOOL)writeNumPyToURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ @brief Write matrices to an uncompressed NumPy .npz archive, readable with numpy.load. The archive uses the Zip64 format so it can hold arrays of any size.
+ @param matrices A dictionary mapping the name of each array to the matrix to write under that name.
+ @param url The file URL to write to, replacing any existing file.
+ @param error If the archive cannot be written, set to an error describing the problem.
+ @return YES if the archive was written, NO otherwise.
+ */
++ (BOOL)writeMatrices:(NSDictionary *)matrices toNumPyArchiveURL:(NSURL *)url error:(NSError **)error;
+
+@end
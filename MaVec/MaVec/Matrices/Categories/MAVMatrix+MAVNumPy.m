@@ -0,0 +1,787 @@
+//
+//  MAVMatrix+MAVNumPy.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <ctype.h>
+#import <errno.h>
+#import <libkern/OSByteOrder.h>
+#import <zlib.h>
+
+#import "MAVFileIO.h"
+#import "MAVMatrix+MAVNumPy.h"
+#import "MAVMatrix-Protected.h"
+
+/**
+ The magic string at the start of every .npy file.
+ */
+static const char MAVNumPyMagic[6] = { '\x93', 'N', 'U', 'M', 'P', 'Y' };
+
+/**
+ The length of the magic string, version and header length preceding the header of a version 1.0 .npy file, and of a version 2.0 or 3.0 file, whose header length is 32 bits wide.
+ */
+#define MAV_NUMPY_PREAMBLE_LENGTH_V1 10
+#define MAV_NUMPY_PREAMBLE_LENGTH_V2 12
+
+/**
+ NumPy pads headers so that the values start at a multiple of this many bytes.
+ */
+#define MAV_NUMPY_HEADER_ALIGNMENT 64
+
+// zip record signatures and lengths, from the PKWARE APPNOTE
+#define MAV_ZIP_LOCAL_HEADER_SIGNATURE 0x04034b50
+#define MAV_ZIP_CENTRAL_HEADER_SIGNATURE 0x02014b50
+#define MAV_ZIP_END_RECORD_SIGNATURE 0x06054b50
+#define MAV_ZIP64_END_RECORD_SIGNATURE 0x06064b50
+#define MAV_ZIP64_END_LOCATOR_SIGNATURE 0x07064b50
+#define MAV_ZIP_LOCAL_HEADER_LENGTH 30
+#define MAV_ZIP_CENTRAL_HEADER_LENGTH 46
+#define MAV_ZIP_END_RECORD_LENGTH 22
+#define MAV_ZIP_MAX_COMMENT_LENGTH 0xFFFF
+#define MAV_ZIP64_END_RECORD_LENGTH 56
+#define MAV_ZIP64_END_LOCATOR_LENGTH 20
+#define MAV_ZIP64_EXTRA_FIELD_ID 0x0001
+#define MAV_ZIP64_VERSION 45
+#define MAV_ZIP_METHOD_STORED 0
+#define MAV_ZIP_METHOD_DEFLATED 8
+#define MAV_ZIP_FLAG_ENCRYPTED 0x0001
+#define MAV_ZIP_DOS_DATE_1980 0x0021
+
+/**
+ The description of an array parsed from a .npy header.
+ */
+typedef struct {
+    size_t dataOffset;
+    size_t valueSize;
+    BOOL bigEndian;
+    BOOL fortranOrder;
+    uint64_t rows;
+    uint64_t columns;
+} MAVNumPyHeader;
+
+/**
+ @brief Read the magic string and version at the start of a .npy array.
+ @param dataOffset Set to the offset of the array's values, just past its header.
+ @return nil if the preamble is valid, otherwise an error describing the problem.
+ */
+static NSError *MAVReadNumPyPreamble(const uint8_t *bytes, size_t length, NSURL *url, size_t *dataOffset)
+{
+    if (length < MAV_NUMPY_PREAMBLE_LENGTH_V2) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the array is shorter than a header");
+    }
+    if (memcmp(bytes, MAVNumPyMagic, sizeof(MAVNumPyMagic)) != 0) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the NumPy magic string is missing");
+    }
+    switch (bytes[6]) {
+        case 1:
+            *dataOffset = MAV_NUMPY_PREAMBLE_LENGTH_V1 + OSReadLittleInt16(bytes, 8);
+            break;
+            
+        case 2:
+        case 3:
+            *dataOffset = MAV_NUMPY_PREAMBLE_LENGTH_V2 + OSReadLittleInt32(bytes, 8);
+            break;
+            
+        default:
+            return MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedVersion, url, [NSString stringWithFormat:@"NumPy format version %u is not supported", bytes[6]]);
+    }
+    if (*dataOffset < MAV_NUMPY_PREAMBLE_LENGTH_V2) {
+        return MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the header is empty");
+    }
+    return nil;
+}
+
+/**
+ @return A pointer to the value of a key in the Python dictionary literal of a .npy header, or NULL if the key is missing.
+ */
+static const char *MAVNumPyHeaderValue(const char *dictionary, const char *key)
+{
+    const char quotes[2] = { '\'', '"' };
+    for (int i = 0; i < 2; i++) {
+        char quotedKey[32];
+        snprintf(quotedKey, sizeof(quotedKey), "%c%s%c", quotes[i], key, quotes[i]);
+        const char *value = strstr(dictionary, quotedKey);
+        if (value != NULL) {
+            value += strlen(quotedKey);
+            while (isspace((unsigned char)*value)) {
+                value++;
+            }
+            if (*value != ':') {
+                return NULL;
+            }
+            value++;
+            while (isspace((unsigned char)*value)) {
+                value++;
+            }
+            return value;
+        }
+    }
+    return NULL;
+}
+
+/**
+ @brief Parse the dtype, order and shape out of a complete .npy header.
+ @param bytes The array's bytes, of which at least header->dataOffset are available.
+ @return nil if the header describes an array that can be read as a matrix, otherwise an error describing the problem.
+ */
+static NSError *MAVParseNumPyHeader(const uint8_t *bytes, NSURL *url, MAVNumPyHeader *header)
+{
+    size_t preambleLength = bytes[6] == 1 ? MAV_NUMPY_PREAMBLE_LENGTH_V1 : MAV_NUMPY_PREAMBLE_LENGTH_V2;
+    size_t dictionaryLength = header->dataOffset - preambleLength;
+    char *dictionary = malloc(dictionaryLength + 1);
+    memcpy(dictionary, bytes + preambleLength, dictionaryLength);
+    dictionary[dictionaryLength] = '\0';
+    
+    NSError *error = nil;
+    const char *descr = MAVNumPyHeaderValue(dictionary, "descr");
+    const char *fortranOrder = MAVNumPyHeaderValue(dictionary, "fortran_order");
+    const char *shape = MAVNumPyHeaderValue(dictionary, "shape");
+    if (descr == NULL || fortranOrder == NULL || shape == NULL) {
+        error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the header lacks a dtype, order or shape");
+    } else if (descr[0] != '\'' && descr[0] != '"') {
+        error = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, @"structured dtypes are not supported");
+    } else if (!(descr[1] == '<' || descr[1] == '>' || descr[1] == '=') || descr[2] != 'f' || !(descr[3] == '4' || descr[3] == '8') || descr[4] != descr[0]) {
+        const char *end = strchr(descr + 1, descr[0]);
+        int descrLength = end != NULL ? (int)(end - descr - 1) : 0;
+        error = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, [NSString stringWithFormat:@"dtype %.*s is not a 32- or 64-bit float", descrLength, descr + 1]);
+    } else {
+        header->valueSize = descr[3] == '8' ? sizeof(double) : sizeof(float);
+        // '=' means native byte order, which is little-endian on every platform MaVec runs on
+        header->bigEndian = descr[1] == '>';
+        
+        if (strncmp(fortranOrder, "True", 4) == 0) {
+            header->fortranOrder = YES;
+        } else if (strncmp(fortranOrder, "False", 5) == 0) {
+            header->fortranOrder = NO;
+        } else {
+            error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the order is neither True nor False");
+        }
+    }
+    
+    if (error == nil) {
+        uint64_t dimensions[2] = { 1, 1 };
+        int dimensionCount = 0;
+        const char *position = shape;
+        if (*position++ != '(') {
+            error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the shape is not a tuple");
+        }
+        while (error == nil) {
+            while (isspace((unsigned char)*position)) {
+                position++;
+            }
+            if (*position == ')') {
+                break;
+            }
+            char *end;
+            unsigned long long dimension = strtoull(position, &end, 10);
+            if (end == position) {
+                error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the shape is not a tuple of integers");
+                break;
+            }
+            if (dimensionCount == 2) {
+                error = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, @"arrays with more than two dimensions are not supported");
+                break;
+            }
+            dimensions[dimensionCount++] = dimension;
+            
+            // Python 2 wrote long integers with a suffix
+            position = end;
+            if (*position == 'L') {
+                position++;
+            }
+            while (isspace((unsigned char)*position)) {
+                position++;
+            }
+            if (*position == ',') {
+                position++;
+            }
+        }
+        
+        if (error == nil) {
+            // one-dimensional arrays are read as column vectors
+            header->rows = dimensions[0];
+            header->columns = dimensions[1];
+            if (header->rows > INT64_MAX || header->columns > INT64_MAX || (header->columns > 0 && header->rows > SIZE_MAX / header->valueSize / header->columns)) {
+                error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the array is too large");
+            }
+        }
+    }
+    
+    free(dictionary);
+    return error;
+}
+
+/**
+ @brief Swap the bytes of each value in an array between big- and little-endian order.
+ */
+static void MAVSwapValueBytes(void *values, size_t count, size_t valueSize)
+{
+    if (valueSize == sizeof(double)) {
+        uint64_t *words = values;
+        for (size_t i = 0; i < count; i++) {
+            words[i] = OSSwapInt64(words[i]);
+        }
+    } else {
+        uint32_t *words = values;
+        for (size_t i = 0; i < count; i++) {
+            words[i] = OSSwapInt32(words[i]);
+        }
+    }
+}
+
+/**
+ @return The CRC-32 of bytes continuing from a previous checksum, computed in chunks small enough for zlib.
+ */
+static uLong MAVChecksum(uLong checksum, const uint8_t *bytes, size_t length)
+{
+    while (length > 0) {
+        uInt chunk = (uInt)MIN(length, (size_t)UINT_MAX);
+        checksum = crc32(checksum, bytes, chunk);
+        bytes += chunk;
+        length -= chunk;
+    }
+    return checksum;
+}
+
+/**
+ @brief Inflate exactly length bytes from a raw deflate stream, feeding it input in chunks small enough for zlib.
+ @param input The next compressed byte not yet given to the stream, advanced as it is consumed.
+ @param inputRemaining The number of compressed bytes after input, decreased as they are consumed.
+ @return YES if length bytes were inflated into output, NO if the stream is corrupt or ends early.
+ */
+static BOOL MAVInflateFully(z_stream *stream, const uint8_t **input, uint64_t *inputRemaining, uint8_t *output, size_t length)
+{
+    while (length > 0) {
+        if (stream->avail_in == 0) {
+            stream->avail_in = (uInt)MIN(*inputRemaining, (uint64_t)UINT_MAX);
+            stream->next_in = (Bytef *)*input;
+            *input += stream->avail_in;
+            *inputRemaining -= stream->avail_in;
+        }
+        uInt chunk = (uInt)MIN(length, (size_t)UINT_MAX);
+        stream->next_out = output;
+        stream->avail_out = chunk;
+        int status = inflate(stream, Z_NO_FLUSH);
+        size_t produced = chunk - stream->avail_out;
+        output += produced;
+        length -= produced;
+        if (status == Z_STREAM_END) {
+            return length == 0;
+        }
+        if ((status != Z_OK && status != Z_BUF_ERROR) || (produced == 0 && stream->avail_in == 0 && *inputRemaining == 0)) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+@implementation MAVMatrix (MAVNumPy)
+
+#pragma mark - Reading
+
++ (instancetype)matrixWithContentsOfNumPyURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"NumPy files can only be read from file URLs.");
+    
+    MAVMappedFile *file = [MAVMappedFile mappedFileWithURL:url error:error];
+    if (file == nil) {
+        return nil;
+    }
+    
+    return [self matrixWithNumPyBytesAtOffset:0 length:file.length ofFile:file url:url error:error];
+}
+
++ (NSDictionary *)matricesWithContentsOfNumPyArchiveURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"NumPy archives can only be read from file URLs.");
+    
+    MAVMappedFile *file = [MAVMappedFile mappedFileWithURL:url error:error];
+    if (file == nil) {
+        return nil;
+    }
+    const uint8_t *bytes = file.bytes;
+    size_t length = file.length;
+    
+    // the end record is the last thing in an archive, followed only by a comment
+    if (length < MAV_ZIP_END_RECORD_LENGTH) {
+        if (error) {
+            *error = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the archive is shorter than its end record");
+        }
+        return nil;
+    }
+    size_t lastPossibleEndRecord = length - MAV_ZIP_END_RECORD_LENGTH;
+    size_t firstPossibleEndRecord = lastPossibleEndRecord > MAV_ZIP_MAX_COMMENT_LENGTH ? lastPossibleEndRecord - MAV_ZIP_MAX_COMMENT_LENGTH : 0;
+    size_t endRecord = lastPossibleEndRecord + 1;
+    for (size_t position = lastPossibleEndRecord + 1; position-- > firstPossibleEndRecord; ) {
+        if (OSReadLittleInt32(bytes, position) == MAV_ZIP_END_RECORD_SIGNATURE) {
+            endRecord = position;
+            break;
+        }
+    }
+    if (endRecord > lastPossibleEndRecord) {
+        if (error) {
+            *error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the zip end record is missing");
+        }
+        return nil;
+    }
+    
+    uint64_t entryCount = OSReadLittleInt16(bytes, endRecord + 10);
+    uint64_t directoryLength = OSReadLittleInt32(bytes, endRecord + 12);
+    uint64_t directoryOffset = OSReadLittleInt32(bytes, endRecord + 16);
+    if (endRecord >= MAV_ZIP64_END_LOCATOR_LENGTH && OSReadLittleInt32(bytes, endRecord - MAV_ZIP64_END_LOCATOR_LENGTH) == MAV_ZIP64_END_LOCATOR_SIGNATURE) {
+        uint64_t zip64EndRecord = OSReadLittleInt64(bytes, endRecord - MAV_ZIP64_END_LOCATOR_LENGTH + 8);
+        if (length < MAV_ZIP64_END_RECORD_LENGTH || zip64EndRecord > length - MAV_ZIP64_END_RECORD_LENGTH || OSReadLittleInt32(bytes, (size_t)zip64EndRecord) != MAV_ZIP64_END_RECORD_SIGNATURE) {
+            if (error) {
+                *error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the Zip64 end record is missing");
+            }
+            return nil;
+        }
+        entryCount = OSReadLittleInt64(bytes, (size_t)zip64EndRecord + 32);
+        directoryLength = OSReadLittleInt64(bytes, (size_t)zip64EndRecord + 40);
+        directoryOffset = OSReadLittleInt64(bytes, (size_t)zip64EndRecord + 48);
+    }
+    if (directoryOffset > length || directoryLength > length - directoryOffset) {
+        if (error) {
+            *error = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the archive ends before its central directory");
+        }
+        return nil;
+    }
+    
+    NSMutableDictionary *matrices = [NSMutableDictionary dictionary];
+    size_t position = (size_t)directoryOffset;
+    size_t directoryEnd = (size_t)(directoryOffset + directoryLength);
+    for (uint64_t entry = 0; entry < entryCount; entry++) {
+        if (position + MAV_ZIP_CENTRAL_HEADER_LENGTH > directoryEnd || OSReadLittleInt32(bytes, position) != MAV_ZIP_CENTRAL_HEADER_SIGNATURE) {
+            if (error) {
+                *error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the zip central directory is corrupt");
+            }
+            return nil;
+        }
+        uint16_t flags = OSReadLittleInt16(bytes, position + 8);
+        uint16_t method = OSReadLittleInt16(bytes, position + 10);
+        uint32_t checksum = OSReadLittleInt32(bytes, position + 16);
+        uint64_t compressedLength = OSReadLittleInt32(bytes, position + 20);
+        uint64_t uncompressedLength = OSReadLittleInt32(bytes, position + 24);
+        uint16_t nameLength = OSReadLittleInt16(bytes, position + 28);
+        uint16_t extraLength = OSReadLittleInt16(bytes, position + 30);
+        uint16_t commentLength = OSReadLittleInt16(bytes, position + 32);
+        uint64_t localHeader = OSReadLittleInt32(bytes, position + 42);
+        size_t name = position + MAV_ZIP_CENTRAL_HEADER_LENGTH;
+        size_t extra = name + nameLength;
+        size_t extraEnd = extra + extraLength;
+        if (extraEnd + commentLength > directoryEnd) {
+            if (error) {
+                *error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the zip central directory is corrupt");
+            }
+            return nil;
+        }
+        
+        // Zip64 moves whichever of the sizes and offset overflow their 32-bit fields into an extra field, in this order
+        while (extra + 4 <= extraEnd) {
+            uint16_t fieldID = OSReadLittleInt16(bytes, extra);
+            uint16_t fieldLength = OSReadLittleInt16(bytes, extra + 2);
+            if (fieldID == MAV_ZIP64_EXTRA_FIELD_ID) {
+                size_t field = extra + 4;
+                size_t fieldEnd = MIN(field + fieldLength, extraEnd);
+                if (uncompressedLength == UINT32_MAX && field + 8 <= fieldEnd) {
+                    uncompressedLength = OSReadLittleInt64(bytes, field);
+                    field += 8;
+                }
+                if (compressedLength == UINT32_MAX && field + 8 <= fieldEnd) {
+                    compressedLength = OSReadLittleInt64(bytes, field);
+                    field += 8;
+                }
+                if (localHeader == UINT32_MAX && field + 8 <= fieldEnd) {
+                    localHeader = OSReadLittleInt64(bytes, field);
+                }
+            }
+            extra += 4 + fieldLength;
+        }
+        position = extraEnd + commentLength;
+        
+        // numpy.load only treats entries ending in .npy as arrays
+        NSString *entryName = [[NSString alloc] initWithBytes:bytes + name length:nameLength encoding:NSUTF8StringEncoding];
+        if (![entryName hasSuffix:@".npy"]) {
+            continue;
+        }
+        
+        if (length < MAV_ZIP_LOCAL_HEADER_LENGTH || localHeader > length - MAV_ZIP_LOCAL_HEADER_LENGTH || OSReadLittleInt32(bytes, (size_t)localHeader) != MAV_ZIP_LOCAL_HEADER_SIGNATURE) {
+            if (error) {
+                *error = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, [NSString stringWithFormat:@"the local header of %@ is missing", entryName]);
+            }
+            return nil;
+        }
+        uint64_t dataOffset = localHeader + MAV_ZIP_LOCAL_HEADER_LENGTH + OSReadLittleInt16(bytes, (size_t)localHeader + 26) + OSReadLittleInt16(bytes, (size_t)localHeader + 28);
+        if (dataOffset > length || compressedLength > length - dataOffset) {
+            if (error) {
+                *error = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, [NSString stringWithFormat:@"the archive ends before the end of %@", entryName]);
+            }
+            return nil;
+        }
+        if ((flags & MAV_ZIP_FLAG_ENCRYPTED) != 0) {
+            if (error) {
+                *error = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, [NSString stringWithFormat:@"%@ is encrypted", entryName]);
+            }
+            return nil;
+        }
+        
+        MAVMatrix *matrix;
+        switch (method) {
+            case MAV_ZIP_METHOD_STORED:
+                matrix = [self matrixWithNumPyBytesAtOffset:(size_t)dataOffset length:(size_t)compressedLength ofFile:file url:url error:error];
+                break;
+                
+            case MAV_ZIP_METHOD_DEFLATED:
+                matrix = [self matrixWithDeflatedNumPyBytes:bytes + dataOffset
+                                                     length:compressedLength
+                                             inflatedLength:uncompressedLength
+                                                   checksum:checksum
+                                                        url:url
+                                                      error:error];
+                break;
+                
+            default:
+                if (error) {
+                    *error = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedType, url, [NSString stringWithFormat:@"%@ uses unsupported compression method %u", entryName, method]);
+                }
+                return nil;
+        }
+        if (matrix == nil) {
+            return nil;
+        }
+        matrices[[entryName substringToIndex:entryName.length - 4]] = matrix;
+    }
+    
+    return matrices;
+}
+
+#pragma mark - Writing
+
+- (BOOL)writeNumPyToURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"NumPy files can only be written to file URLs.");
+    
+    MAVMatrixLeadingDimension leadingDimension;
+    NSData *values = [self numPyValuesWithLeadingDimension:&leadingDimension];
+    NSData *header = [self numPyHeaderWithLeadingDimension:leadingDimension];
+    
+    return MAVWriteFileAtomically(url, error, ^BOOL(int fileDescriptor) {
+        return MAVWriteFully(fileDescriptor, header.bytes, header.length)
+        && MAVWriteFully(fileDescriptor, values.bytes, values.length);
+    });
+}
+
++ (BOOL)writeMatrices:(NSDictionary *)matrices toNumPyArchiveURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"NumPy archives can only be written to file URLs.");
+    
+    NSArray *names = [matrices.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    
+    return MAVWriteFileAtomically(url, error, ^BOOL(int fileDescriptor) {
+        NSMutableData *directory = [NSMutableData data];
+        uint64_t offset = 0;
+        
+        // every entry is stored with Zip64 sizes and offsets, so no array or archive is too large
+        for (NSString *name in names) {
+            MAVMatrix *matrix = matrices[name];
+            MAVMatrixLeadingDimension leadingDimension;
+            NSData *values = [matrix numPyValuesWithLeadingDimension:&leadingDimension];
+            NSData *header = [matrix numPyHeaderWithLeadingDimension:leadingDimension];
+            NSData *entryName = [[name stringByAppendingString:@".npy"] dataUsingEncoding:NSUTF8StringEncoding];
+            uint64_t entryLength = header.length + values.length;
+            uint32_t checksum = (uint32_t)MAVChecksum(MAVChecksum(crc32(0, Z_NULL, 0), header.bytes, header.length), values.bytes, values.length);
+            
+            uint8_t localHeader[MAV_ZIP_LOCAL_HEADER_LENGTH];
+            OSWriteLittleInt32(localHeader, 0, MAV_ZIP_LOCAL_HEADER_SIGNATURE);
+            OSWriteLittleInt16(localHeader, 4, MAV_ZIP64_VERSION);
+            OSWriteLittleInt16(localHeader, 6, 0);
+            OSWriteLittleInt16(localHeader, 8, MAV_ZIP_METHOD_STORED);
+            OSWriteLittleInt16(localHeader, 10, 0);
+            OSWriteLittleInt16(localHeader, 12, MAV_ZIP_DOS_DATE_1980);
+            OSWriteLittleInt32(localHeader, 14, checksum);
+            OSWriteLittleInt32(localHeader, 18, UINT32_MAX);
+            OSWriteLittleInt32(localHeader, 22, UINT32_MAX);
+            OSWriteLittleInt16(localHeader, 26, (uint16_t)entryName.length);
+            OSWriteLittleInt16(localHeader, 28, 20);
+            uint8_t localExtra[20];
+            OSWriteLittleInt16(localExtra, 0, MAV_ZIP64_EXTRA_FIELD_ID);
+            OSWriteLittleInt16(localExtra, 2, 16);
+            OSWriteLittleInt64(localExtra, 4, entryLength);
+            OSWriteLittleInt64(localExtra, 12, entryLength);
+            
+            uint8_t centralHeader[MAV_ZIP_CENTRAL_HEADER_LENGTH];
+            OSWriteLittleInt32(centralHeader, 0, MAV_ZIP_CENTRAL_HEADER_SIGNATURE);
+            OSWriteLittleInt16(centralHeader, 4, MAV_ZIP64_VERSION);
+            memcpy(centralHeader + 6, localHeader + 4, 22);
+            OSWriteLittleInt16(centralHeader, 28, (uint16_t)entryName.length);
+            OSWriteLittleInt16(centralHeader, 30, 28);
+            memset(centralHeader + 32, 0, 10);
+            OSWriteLittleInt32(centralHeader, 42, UINT32_MAX);
+            uint8_t centralExtra[28];
+            OSWriteLittleInt16(centralExtra, 0, MAV_ZIP64_EXTRA_FIELD_ID);
+            OSWriteLittleInt16(centralExtra, 2, 24);
+            OSWriteLittleInt64(centralExtra, 4, entryLength);
+            OSWriteLittleInt64(centralExtra, 12, entryLength);
+            OSWriteLittleInt64(centralExtra, 20, offset);
+            [directory appendBytes:centralHeader length:sizeof(centralHeader)];
+            [directory appendData:entryName];
+            [directory appendBytes:centralExtra length:sizeof(centralExtra)];
+            
+            if (!(MAVWriteFully(fileDescriptor, localHeader, sizeof(localHeader))
+                  && MAVWriteFully(fileDescriptor, entryName.bytes, entryName.length)
+                  && MAVWriteFully(fileDescriptor, localExtra, sizeof(localExtra))
+                  && MAVWriteFully(fileDescriptor, header.bytes, header.length)
+                  && MAVWriteFully(fileDescriptor, values.bytes, values.length))) {
+                return NO;
+            }
+            offset += sizeof(localHeader) + entryName.length + sizeof(localExtra) + entryLength;
+        }
+        
+        uint64_t entryCount = names.count;
+        uint8_t trailer[MAV_ZIP64_END_RECORD_LENGTH + MAV_ZIP64_END_LOCATOR_LENGTH + MAV_ZIP_END_RECORD_LENGTH];
+        uint8_t *zip64EndRecord = trailer;
+        OSWriteLittleInt32(zip64EndRecord, 0, MAV_ZIP64_END_RECORD_SIGNATURE);
+        OSWriteLittleInt64(zip64EndRecord, 4, MAV_ZIP64_END_RECORD_LENGTH - 12);
+        OSWriteLittleInt16(zip64EndRecord, 12, MAV_ZIP64_VERSION);
+        OSWriteLittleInt16(zip64EndRecord, 14, MAV_ZIP64_VERSION);
+        OSWriteLittleInt32(zip64EndRecord, 16, 0);
+        OSWriteLittleInt32(zip64EndRecord, 20, 0);
+        OSWriteLittleInt64(zip64EndRecord, 24, entryCount);
+        OSWriteLittleInt64(zip64EndRecord, 32, entryCount);
+        OSWriteLittleInt64(zip64EndRecord, 40, directory.length);
+        OSWriteLittleInt64(zip64EndRecord, 48, offset);
+        uint8_t *zip64EndLocator = zip64EndRecord + MAV_ZIP64_END_RECORD_LENGTH;
+        OSWriteLittleInt32(zip64EndLocator, 0, MAV_ZIP64_END_LOCATOR_SIGNATURE);
+        OSWriteLittleInt32(zip64EndLocator, 4, 0);
+        OSWriteLittleInt64(zip64EndLocator, 8, offset + directory.length);
+        OSWriteLittleInt32(zip64EndLocator, 16, 1);
+        uint8_t *endRecord = zip64EndLocator + MAV_ZIP64_END_LOCATOR_LENGTH;
+        OSWriteLittleInt32(endRecord, 0, MAV_ZIP_END_RECORD_SIGNATURE);
+        OSWriteLittleInt16(endRecord, 4, 0);
+        OSWriteLittleInt16(endRecord, 6, 0);
+        OSWriteLittleInt16(endRecord, 8, (uint16_t)MIN(entryCount, (uint64_t)UINT16_MAX));
+        OSWriteLittleInt16(endRecord, 10, (uint16_t)MIN(entryCount, (uint64_t)UINT16_MAX));
+        OSWriteLittleInt32(endRecord, 12, (uint32_t)MIN((uint64_t)directory.length, (uint64_t)UINT32_MAX));
+        OSWriteLittleInt32(endRecord, 16, (uint32_t)MIN(offset, (uint64_t)UINT32_MAX));
+        OSWriteLittleInt16(endRecord, 20, 0);
+        
+        return MAVWriteFully(fileDescriptor, directory.bytes, directory.length)
+        && MAVWriteFully(fileDescriptor, trailer, sizeof(trailer));
+    });
+}
+
+#pragma mark - Private
+
+/**
+ @brief Read a .npy array lying in a mapped file. Little-endian values at an offset aligned for their type are mapped rather than copied.
+ @param offset The offset of the array in the file.
+ @param length The length of the array, including its header.
+ */
++ (instancetype)matrixWithNumPyBytesAtOffset:(size_t)offset
+                                      length:(size_t)length
+                                      ofFile:(MAVMappedFile *)file
+                                         url:(NSURL *)url
+                                       error:(NSError **)error
+{
+    const uint8_t *bytes = file.bytes + offset;
+    MAVNumPyHeader header;
+    memset(&header, 0, sizeof(header));
+    NSError *formatError = MAVReadNumPyPreamble(bytes, length, url, &header.dataOffset);
+    if (formatError == nil && header.dataOffset > length) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the array ends before its header");
+    }
+    if (formatError == nil) {
+        formatError = MAVParseNumPyHeader(bytes, url, &header);
+    }
+    size_t valueCount = (size_t)(header.rows * header.columns);
+    if (formatError == nil && valueCount * header.valueSize > length - header.dataOffset) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the array ends before its last value");
+    }
+    if (formatError != nil) {
+        if (error) {
+            *error = formatError;
+        }
+        return nil;
+    }
+    
+    size_t valuesOffset = offset + header.dataOffset;
+    size_t valuesLength = valueCount * header.valueSize;
+    NSData *values;
+    if (!header.bigEndian && valuesOffset % header.valueSize == 0) {
+        values = [file dataWithRange:NSMakeRange(valuesOffset, valuesLength)];
+    } else {
+        void *copiedValues = malloc(valuesLength);
+        memcpy(copiedValues, file.bytes + valuesOffset, valuesLength);
+        if (header.bigEndian) {
+            MAVSwapValueBytes(copiedValues, valueCount, header.valueSize);
+        }
+        values = [NSData dataWithBytesNoCopy:copiedValues length:valuesLength];
+    }
+    
+    return [self matrixWithNumPyHeader:header values:values];
+}
+
+/**
+ @brief Read a .npy array compressed in a raw deflate stream, inflating its values straight into the buffer the matrix keeps, and verifying them against the archive's checksum.
+ */
++ (instancetype)matrixWithDeflatedNumPyBytes:(const uint8_t *)bytes
+                                      length:(uint64_t)length
+                              inflatedLength:(uint64_t)inflatedLength
+                                    checksum:(uint32_t)checksum
+                                         url:(NSURL *)url
+                                       error:(NSError **)error
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(ENOMEM, url);
+        }
+        return nil;
+    }
+    
+    const uint8_t *input = bytes;
+    uint64_t inputRemaining = length;
+    MAVNumPyHeader header;
+    memset(&header, 0, sizeof(header));
+    NSError *formatError = nil;
+    uint8_t *headerBytes = NULL;
+    uint8_t *values = NULL;
+    size_t valueCount = 0;
+    size_t valuesLength = 0;
+    
+    uint8_t preamble[MAV_NUMPY_PREAMBLE_LENGTH_V2];
+    if (inflatedLength < sizeof(preamble)) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the array is shorter than a header");
+    } else if (!MAVInflateFully(&stream, &input, &inputRemaining, preamble, sizeof(preamble))) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the compressed array is corrupt");
+    } else {
+        formatError = MAVReadNumPyPreamble(preamble, sizeof(preamble), url, &header.dataOffset);
+    }
+    if (formatError == nil) {
+        if (header.dataOffset > inflatedLength) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the array ends before its header");
+        } else {
+            headerBytes = malloc(header.dataOffset);
+            memcpy(headerBytes, preamble, sizeof(preamble));
+            if (!MAVInflateFully(&stream, &input, &inputRemaining, headerBytes + sizeof(preamble), header.dataOffset - sizeof(preamble))) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the compressed array is corrupt");
+            } else {
+                formatError = MAVParseNumPyHeader(headerBytes, url, &header);
+            }
+        }
+    }
+    if (formatError == nil) {
+        valueCount = (size_t)(header.rows * header.columns);
+        valuesLength = valueCount * header.valueSize;
+        if (valuesLength > inflatedLength - header.dataOffset) {
+            formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the array ends before its last value");
+        } else {
+            values = malloc(valuesLength);
+            if (!MAVInflateFully(&stream, &input, &inputRemaining, values, valuesLength)) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the compressed array is corrupt");
+            } else if (MAVChecksum(MAVChecksum(crc32(0, Z_NULL, 0), headerBytes, header.dataOffset), values, valuesLength) != checksum) {
+                formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the array does not match its checksum");
+            }
+        }
+    }
+    inflateEnd(&stream);
+    free(headerBytes);
+    
+    if (formatError != nil) {
+        free(values);
+        if (error) {
+            *error = formatError;
+        }
+        return nil;
+    }
+    
+    if (header.bigEndian) {
+        MAVSwapValueBytes(values, valueCount, header.valueSize);
+    }
+    return [self matrixWithNumPyHeader:header values:[NSData dataWithBytesNoCopy:values length:valuesLength]];
+}
+
+/**
+ @return A conventionally stored matrix of the dimensions, order and precision described by a .npy header.
+ */
++ (instancetype)matrixWithNumPyHeader:(MAVNumPyHeader)header values:(NSData *)values
+{
+    MAVMatrix *matrix = [[self alloc] initWithValues:values
+                                                rows:(MAVIndex)header.rows
+                                             columns:(MAVIndex)header.columns
+                                    leadingDimension:header.fortranOrder ? MAVMatrixLeadingDimensionColumn : MAVMatrixLeadingDimensionRow
+                                       packingMethod:MAVMatrixValuePackingMethodConventional
+                                 triangularComponent:MAVMatrixTriangularComponentBoth];
+    
+    // the value count alone cannot tell the precision of an empty array
+    matrix.precision = header.valueSize == sizeof(double) ? MCKPrecisionDouble : MCKPrecisionSingle;
+    
+    return matrix;
+}
+
+/**
+ @brief Return this matrix's values in conventional storage, without copying them unless they are packed or band values, which are expanded in column-major order.
+ @param leadingDimension Set to the order of the returned values.
+ */
+- (NSData *)numPyValuesWithLeadingDimension:(MAVMatrixLeadingDimension *)leadingDimension
+{
+    if (self.packingMethod == MAVMatrixValuePackingMethodConventional) {
+        *leadingDimension = self.leadingDimension;
+        return self.values;
+    }
+    
+    *leadingDimension = MAVMatrixLeadingDimensionColumn;
+    return [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+}
+
+/**
+ @return A version 1.0 .npy header describing this matrix's values in the specified order, padded so the values that follow it are aligned.
+ */
+- (NSData *)numPyHeaderWithLeadingDimension:(MAVMatrixLeadingDimension)leadingDimension
+{
+    // every platform MaVec runs on is little-endian, so values are written exactly as they are stored
+    NSString *dictionary = [NSString stringWithFormat:@"{'descr': '<f%zu', 'fortran_order': %@, 'shape': (%lld, %lld), }",
+                            self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float),
+                            leadingDimension == MAVMatrixLeadingDimensionColumn ? @"True" : @"False",
+                            (long long)self.rows,
+                            (long long)self.columns];
+    
+    // the header ends in a newline, and is padded with spaces before it
+    size_t unpaddedLength = MAV_NUMPY_PREAMBLE_LENGTH_V1 + dictionary.length + 1;
+    size_t paddedLength = (unpaddedLength + MAV_NUMPY_HEADER_ALIGNMENT - 1) / MAV_NUMPY_HEADER_ALIGNMENT * MAV_NUMPY_HEADER_ALIGNMENT;
+    NSMutableData *header = [NSMutableData dataWithLength:paddedLength];
+    uint8_t *bytes = header.mutableBytes;
+    memcpy(bytes, MAVNumPyMagic, sizeof(MAVNumPyMagic));
+    bytes[6] = 1;
+    bytes[7] = 0;
+    OSWriteLittleInt16(bytes, 8, (uint16_t)(paddedLength - MAV_NUMPY_PREAMBLE_LENGTH_V1));
+    memcpy(bytes + MAV_NUMPY_PREAMBLE_LENGTH_V1, dictionary.UTF8String, dictionary.length);
+    memset(bytes + MAV_NUMPY_PREAMBLE_LENGTH_V1 + dictionary.length, ' ', paddedLength - unpaddedLength);
+    bytes[paddedLength - 1] = '\n';
+    
+    return header;
+}
+
+@end
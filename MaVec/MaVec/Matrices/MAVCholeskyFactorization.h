@@ -0,0 +1,86 @@
+//
+//  MAVCholeskyFactorization.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@class MAVMatrix;
+@class MAVVector;
+
+/**
+ @brief Container class to hold the results of a Cholesky factorization in an MAVMatrix object.
+ @description The Cholesky factorization decomposes a symmetric positive definite matrix A into the product LLᵀ, where L is a lower triangular matrix with a positive diagonal. Unlike the other factorizations, it can be updated in O(n²) operations when A changes by a symmetric rank-one term, instead of being recomputed in O(n³).
+ */
+@interface MAVCholeskyFactorization : NSObject <NSCopying, NSSecureCoding>
+
+/**
+ @property lowerTriangularMatrix
+ @brief An MAVMatrix holding the lower triangular matrix L of the Cholesky factorization.
+ */
+@property (nonatomic, readonly, strong) MAVMatrix *lowerTriangularMatrix;
+
+#pragma mark - Init
+
+/**
+ @brief Create a new MAVCholeskyFactorization object by calculating the factorization of the provided matrix. Only the lower triangle of the matrix is referenced.
+ @param matrix The symmetric positive definite matrix to factorize.
+ @return A new instance of MAVCholeskyFactorization containing the resulting L matrix, or nil if the matrix is not positive definite.
+ */
+- (instancetype)initWithMatrix:(MAVMatrix *)matrix;
+
+/**
+ @brief Class convenience method for initWithMatrix:
+ @param matrix The symmetric positive definite matrix to factorize.
+ @return A new instance of MAVCholeskyFactorization containing the resulting L matrix, or nil if the matrix is not positive definite.
+ */
++ (instancetype)choleskyFactorizationOfMatrix:(MAVMatrix *)matrix;
+
+#pragma mark - Operations
+
+/**
+ @brief Compute the factorization of A + xxᵀ from this factorization of A with a sequence of rotations, in O(n²) operations. See section 6.5.4 of Golub and Van Loan, Matrix Computations (4th edition).
+ @param vector The vector x, of length equal to the order of A.
+ @return A new factorization of A + xxᵀ.
+ */
+- (MAVCholeskyFactorization *)factorizationUpdatedWithVector:(MAVVector *)vector;
+
+/**
+ @brief Compute the factorization of A - xxᵀ from this factorization of A with a sequence of hyperbolic rotations, in O(n²) operations.
+ @param vector The vector x, of length equal to the order of A.
+ @return A new factorization of A - xxᵀ, or nil if A - xxᵀ is not positive definite or so close to singular that the downdate would be inaccurate, in which case it should be refactored instead.
+ */
+- (MAVCholeskyFactorization *)factorizationDowndatedWithVector:(MAVVector *)vector;
+
+/**
+ @brief Compute the factorization of βA from this factorization of A, by scaling L by √β.
+ @param scalar The positive scalar β.
+ @return A new factorization of βA.
+ */
+- (MAVCholeskyFactorization *)factorizationScaledByScalar:(NSNumber *)scalar;
+
+- (NSString *)description;
+
+@end
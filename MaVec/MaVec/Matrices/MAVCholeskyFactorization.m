@@ -0,0 +1,253 @@
+//
+//  MAVCholeskyFactorization.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Accelerate/Accelerate.h>
+#import <MCKNumerics/MCKNumerics.h>
+
+#import "MAVCholeskyFactorization.h"
+#import "MAVLAPACKInteger.h"
+#import "MAVMatrix-Protected.h"
+#import "MAVMatrix.h"
+#import "MAVVector.h"
+
+/**
+ @brief Update or downdate a column-major lower triangular Cholesky factor L in place so that LLᵀ becomes LLᵀ + sign * xxᵀ, overwriting x.
+ @return NO if a downdate would leave a pivot that lost more than half of its significant digits, or none at all, in which case L is left partially updated.
+ */
+static BOOL MAVCholeskyRankOneUpdateD(double *l, double *x, MAVIndex n, double sign)
+{
+    for (MAVIndex k = 0; k < n; k += 1) {
+        double lkk = l[k * n + k];
+        double r2 = lkk * lkk + sign * x[k] * x[k];
+        if (!(r2 > sqrt(DBL_EPSILON) * lkk * lkk)) {
+            return NO;
+        }
+        double r = sqrt(r2);
+        double c = r / lkk;
+        double s = x[k] / lkk;
+        l[k * n + k] = r;
+        
+        MAVLAPACKInteger below = MAVLAPACKIntegerFromIndex(n - k - 1);
+        if (below > 0) {
+            double *column = l + k * n + k + 1;
+            double *tail = x + k + 1;
+            cblas_daxpy(below, sign * s, tail, 1, column, 1);
+            cblas_dscal(below, 1.0 / c, column, 1);
+            cblas_dscal(below, c, tail, 1);
+            cblas_daxpy(below, -s, column, 1, tail, 1);
+        }
+    }
+    return YES;
+}
+
+static BOOL MAVCholeskyRankOneUpdate(float *l, float *x, MAVIndex n, float sign)
+{
+    for (MAVIndex k = 0; k < n; k += 1) {
+        float lkk = l[k * n + k];
+        float r2 = lkk * lkk + sign * x[k] * x[k];
+        if (!(r2 > sqrtf(FLT_EPSILON) * lkk * lkk)) {
+            return NO;
+        }
+        float r = sqrtf(r2);
+        float c = r / lkk;
+        float s = x[k] / lkk;
+        l[k * n + k] = r;
+        
+        MAVLAPACKInteger below = MAVLAPACKIntegerFromIndex(n - k - 1);
+        if (below > 0) {
+            float *column = l + k * n + k + 1;
+            float *tail = x + k + 1;
+            cblas_saxpy(below, sign * s, tail, 1, column, 1);
+            cblas_sscal(below, 1.0f / c, column, 1);
+            cblas_sscal(below, c, tail, 1);
+            cblas_saxpy(below, -s, column, 1, tail, 1);
+        }
+    }
+    return YES;
+}
+
+@interface MAVCholeskyFactorization ()
+
+- (instancetype)initWithLowerTriangularValues:(NSData *)values order:(MAVIndex)order;
+
+@end
+
+@implementation MAVCholeskyFactorization
+
+#pragma mark - Init
+
+- (instancetype)initWithMatrix:(MAVMatrix *)matrix
+{
+    NSAssert(matrix.rows == matrix.columns, @"Only square matrices have Cholesky factorizations.");
+    
+    NSMutableData *columnMajorValues = [[matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(matrix.rows);
+    MAVLAPACKInteger lda = n;
+    MAVLAPACKInteger info = 0;
+    
+    if (matrix.precision == MCKPrecisionDouble) {
+        double *a = columnMajorValues.mutableBytes;
+        
+        // info > 0 means the matrix is not positive definite, so no Cholesky factorization exists
+        dpotrf_("L", &n, a, &lda, &info);
+        if (info != 0) {
+            return nil;
+        }
+        
+        // dpotrf leaves the strict upper triangle untouched
+        for (MAVIndex j = 1; j < n; j += 1) {
+            vDSP_vclrD(a + j * n, 1, j);
+        }
+    } else {
+        float *a = columnMajorValues.mutableBytes;
+        
+        // info > 0 means the matrix is not positive definite, so no Cholesky factorization exists
+        spotrf_("L", &n, a, &lda, &info);
+        if (info != 0) {
+            return nil;
+        }
+        
+        // spotrf leaves the strict upper triangle untouched
+        for (MAVIndex j = 1; j < n; j += 1) {
+            vDSP_vclr(a + j * n, 1, j);
+        }
+    }
+    
+    return [self initWithLowerTriangularValues:columnMajorValues order:n];
+}
+
++ (instancetype)choleskyFactorizationOfMatrix:(MAVMatrix *)matrix
+{
+    return [[MAVCholeskyFactorization alloc] initWithMatrix:matrix];
+}
+
+- (instancetype)initWithLowerTriangularValues:(NSData *)values order:(MAVIndex)order
+{
+    self = [super init];
+    if (self) {
+        MAVMatrix *l = [MAVMatrix matrixWithValues:values rows:order columns:order leadingDimension:MAVMatrixLeadingDimensionColumn];
+        
+        // L is lower triangular by construction, so record that for triangular solves and determinants
+        l.triangularComponent = MAVMatrixTriangularComponentLower;
+        
+        _lowerTriangularMatrix = l;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"\nL:%@", self.lowerTriangularMatrix.description];
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    MAVCholeskyFactorization *choleskyCopy = [[self class] allocWithZone:zone];
+    
+    choleskyCopy->_lowerTriangularMatrix = _lowerTriangularMatrix.copy;
+    
+    return choleskyCopy;
+}
+
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:_lowerTriangularMatrix forKey:@"lowerTriangularMatrix"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (self) {
+        _lowerTriangularMatrix = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"lowerTriangularMatrix"];
+        if (_lowerTriangularMatrix == nil) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+#pragma mark - Operations
+
+- (MAVCholeskyFactorization *)factorizationUpdatedWithVector:(MAVVector *)vector
+{
+    return [self factorizationWithRankOneTermOfVector:vector sign:1];
+}
+
+- (MAVCholeskyFactorization *)factorizationDowndatedWithVector:(MAVVector *)vector
+{
+    return [self factorizationWithRankOneTermOfVector:vector sign:-1];
+}
+
+- (MAVCholeskyFactorization *)factorizationScaledByScalar:(NSNumber *)scalar
+{
+    NSAssert([scalar compare:@0] == NSOrderedDescending, @"Only positive multiples of a positive definite matrix have Cholesky factorizations.");
+    
+    MAVIndex n = self.lowerTriangularMatrix.rows;
+    NSMutableData *values = [[self.lowerTriangularMatrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    if (self.lowerTriangularMatrix.precision == MCKPrecisionDouble) {
+        double factor = sqrt(scalar.doubleValue);
+        vDSP_vsmulD(values.mutableBytes, 1, &factor, values.mutableBytes, 1, (vDSP_Length)(n * n));
+    } else {
+        float factor = sqrtf(scalar.floatValue);
+        vDSP_vsmul(values.mutableBytes, 1, &factor, values.mutableBytes, 1, (vDSP_Length)(n * n));
+    }
+    
+    return [[MAVCholeskyFactorization alloc] initWithLowerTriangularValues:values order:n];
+}
+
+#pragma mark - Private
+
+- (MAVCholeskyFactorization *)factorizationWithRankOneTermOfVector:(MAVVector *)vector sign:(int)sign
+{
+    MAVIndex n = self.lowerTriangularMatrix.rows;
+    NSAssert2(vector.length == n, @"Vector length (%lld) must equal the order of the factorized matrix (%lld)", (long long int)vector.length, (long long int)n);
+    NSAssert(vector.precision == self.lowerTriangularMatrix.precision, @"Precisions do not match.");
+    
+    NSMutableData *values = [[self.lowerTriangularMatrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSMutableData *x = [vector.values mutableCopy];
+    
+    BOOL succeeded;
+    if (self.lowerTriangularMatrix.precision == MCKPrecisionDouble) {
+        succeeded = MAVCholeskyRankOneUpdateD(values.mutableBytes, x.mutableBytes, n, sign);
+    } else {
+        succeeded = MAVCholeskyRankOneUpdate(values.mutableBytes, x.mutableBytes, n, sign);
+    }
+    
+    return succeeded ? [[MAVCholeskyFactorization alloc] initWithLowerTriangularValues:values order:n] : nil;
+}
+
+@end
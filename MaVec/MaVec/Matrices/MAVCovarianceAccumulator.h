@@ -0,0 +1,109 @@
+//
+//  MAVCovarianceAccumulator.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import <MCKNumerics/MCKNumerics.h>
+
+#import "MAVMatrix.h"
+#import "MAVTypedefs.h"
+
+@class MAVVector;
+
+/**
+ @class MAVCovarianceAccumulator
+ @description Accumulates the mean and covariance of a stream of samples without keeping the samples, so memory stays proportional to the square of their dimension however many arrive. Each sample or block of samples is centered on its own mean and folded into the running sum of squared deviations with a symmetric rank-1 or rank-k update, combining means as in Welford's and Chan's algorithms, which avoids the cancellation of accumulating raw sums of squares. Only the upper triangle of the sum is stored and updated. Accumulators are not safe to mutate from several threads at once; accumulate on separate threads into separate accumulators and combine them with addAccumulator:.
+ */
+@interface MAVCovarianceAccumulator : NSObject
+
+/**
+ @property dimension
+ @brief The number of values in each sample.
+ */
+@property (nonatomic, readonly, assign) MAVIndex dimension;
+
+/**
+ @property precision
+ @brief The precision of the samples and of the accumulated values.
+ */
+@property (nonatomic, readonly, assign) MCKPrecision precision;
+
+/**
+ @property count
+ @brief The number of samples accumulated.
+ */
+@property (nonatomic, readonly, assign) uint64_t count;
+
+/**
+ @property mean
+ @brief The mean of the samples accumulated, or a vector of zeros if there are none.
+ */
+@property (nonatomic, readonly, strong) MAVVector *mean;
+
+/**
+ @brief Create an accumulator holding no samples.
+ @param dimension The number of values in each sample.
+ @param precision The precision of the samples.
+ @return A new accumulator.
+ */
++ (instancetype)accumulatorWithDimension:(MAVIndex)dimension
+                               precision:(MCKPrecision)precision;
+
+/**
+ @description Computed with a symmetric rank-1 update (see http://www.netlib.org/lapack/explore-html/dc/da8/dsyr_8f.html).
+ @brief Add one sample.
+ @param sample A vector of dimension values with the precision of the accumulator.
+ */
+- (void)addSample:(MAVVector *)sample;
+
+/**
+ @description Computed with a symmetric rank-k update of the block centered on its own mean (see http://www.netlib.org/lapack/explore-html/dc/d05/dsyrk_8f.html), which is much faster than adding the rows one by one.
+ @brief Add a block of samples.
+ @param samples A matrix with the precision of the accumulator and dimension columns, each row of which is a sample.
+ */
+- (void)addSamples:(MAVMatrix *)samples;
+
+/**
+ @brief Add all the samples accumulated by another accumulator, as if they had been added to this one.
+ @param accumulator An accumulator with the dimension and precision of this accumulator.
+ */
+- (void)addAccumulator:(MAVCovarianceAccumulator *)accumulator;
+
+/**
+ @brief Compute the sample covariance matrix of the samples accumulated so far, dividing the sum of squared deviations by one less than the number of samples. More samples can be added afterwards.
+ @param packingMethod MAVMatrixValuePackingMethodPacked to store the upper triangle of the result in column-major packed format, or MAVMatrixValuePackingMethodConventional to store all values in column-major format. Raises an NSInternalInconsistencyException for MAVMatrixValuePackingMethodBand.
+ @return A new symmetric, positive semidefinite matrix of order dimension. Raises an NSInternalInconsistencyException if fewer than two samples have been accumulated.
+ */
+- (MAVMatrix *)covarianceMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod;
+
+/**
+ @brief Compute the Gram matrix XᵀX of the samples accumulated so far, where each row of X is a sample, without centering them on their mean.
+ @param packingMethod MAVMatrixValuePackingMethodPacked to store the upper triangle of the result in column-major packed format, or MAVMatrixValuePackingMethodConventional to store all values in column-major format. Raises an NSInternalInconsistencyException for MAVMatrixValuePackingMethodBand.
+ @return A new symmetric, positive semidefinite matrix of order dimension.
+ */
+- (MAVMatrix *)gramMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod;
+
+@end
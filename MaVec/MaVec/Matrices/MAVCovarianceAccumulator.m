@@ -0,0 +1,250 @@
+//
+//  MAVCovarianceAccumulator.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Accelerate/Accelerate.h>
+
+#import "MAVCovarianceAccumulator.h"
+#import "MAVLAPACKInteger.h"
+#import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix-Protected.h"
+#import "MAVVector.h"
+
+@implementation MAVCovarianceAccumulator
+{
+    // the running mean of the samples
+    NSMutableData *_meanValues;
+    
+    // the upper triangle of the sum of the outer products of the samples' deviations from their mean, in column-major format
+    NSMutableData *_scatterValues;
+    
+    // the deviation of a sample or block mean from the running mean
+    NSMutableData *_deltaValues;
+}
+
++ (instancetype)accumulatorWithDimension:(MAVIndex)dimension
+                               precision:(MCKPrecision)precision
+{
+    return [[self alloc] initWithDimension:dimension precision:precision];
+}
+
+- (instancetype)initWithDimension:(MAVIndex)dimension
+                        precision:(MCKPrecision)precision
+{
+    NSAssert(dimension > 0, @"Samples must have at least one value.");
+    
+    self = [super init];
+    if (self) {
+        _dimension = dimension;
+        _precision = precision;
+        _count = 0;
+        
+        size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+        _meanValues = [NSMutableData dataWithLength:(size_t)dimension * valueSize];
+        _scatterValues = [NSMutableData dataWithLength:(size_t)dimension * (size_t)dimension * valueSize];
+        _deltaValues = [NSMutableData dataWithLength:(size_t)dimension * valueSize];
+    }
+    return self;
+}
+
+#pragma mark - Properties
+
+- (MAVVector *)mean
+{
+    return [MAVVector vectorWithValues:[_meanValues copy] length:self.dimension];
+}
+
+#pragma mark - Accumulation
+
+- (void)addSample:(MAVVector *)sample
+{
+    NSAssert(sample.length == self.dimension, @"Samples must have %lld values, not %lld.", (long long int)self.dimension, (long long int)sample.length);
+    NSAssert(sample.precision == self.precision, @"Samples must have the precision of the accumulator.");
+    
+    [self combineWithCount:1 mean:sample.values.bytes];
+}
+
+- (void)addSamples:(MAVMatrix *)samples
+{
+    NSAssert(samples.columns == self.dimension, @"Samples must have %lld values, not %lld.", (long long int)self.dimension, (long long int)samples.columns);
+    NSAssert(samples.precision == self.precision, @"Samples must have the precision of the accumulator.");
+    
+    // an empty block has no mean, and combining it into an empty accumulator would scale by 0/0
+    if (samples.rows == 0) {
+        return;
+    }
+    
+    MAVIndex count = samples.rows;
+    MAVIndex dimension = self.dimension;
+    NSMutableData *centeredValues = [[samples valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSMutableData *blockMeanValues = [NSMutableData dataWithLength:_meanValues.length];
+    
+    // center each column of the block on its own mean
+    if (self.precision == MCKPrecisionDouble) {
+        double *values = centeredValues.mutableBytes;
+        double *blockMean = blockMeanValues.mutableBytes;
+        for (MAVIndex column = 0; column < dimension; column++) {
+            double *columnValues = values + (size_t)column * (size_t)count;
+            vDSP_meanvD(columnValues, 1, &blockMean[column], (vDSP_Length)count);
+            double negatedMean = -blockMean[column];
+            vDSP_vsaddD(columnValues, 1, &negatedMean, columnValues, 1, (vDSP_Length)count);
+        }
+    } else {
+        float *values = centeredValues.mutableBytes;
+        float *blockMean = blockMeanValues.mutableBytes;
+        for (MAVIndex column = 0; column < dimension; column++) {
+            float *columnValues = values + (size_t)column * (size_t)count;
+            vDSP_meanv(columnValues, 1, &blockMean[column], (vDSP_Length)count);
+            float negatedMean = -blockMean[column];
+            vDSP_vsadd(columnValues, 1, &negatedMean, columnValues, 1, (vDSP_Length)count);
+        }
+    }
+    
+    // add the block's own scatter, then account for the distance between the block and running means
+    MAVMatrix *centered = [MAVMatrix matrixWithValues:centeredValues rows:count columns:dimension];
+    [centered updateSymmetricValues:_scatterValues.mutableBytes
+                triangularComponent:MAVMatrixTriangularComponentUpper
+           withGramProductOfColumns:YES
+                              alpha:1.0
+                               beta:1.0];
+    [self combineWithCount:(uint64_t)count mean:blockMeanValues.bytes];
+}
+
+- (void)addAccumulator:(MAVCovarianceAccumulator *)accumulator
+{
+    NSAssert(accumulator.dimension == self.dimension, @"Accumulators must have the same dimension.");
+    NSAssert(accumulator.precision == self.precision, @"Accumulators must have the same precision.");
+    
+    if (accumulator.count == 0) {
+        return;
+    }
+    
+    vDSP_Length length = (vDSP_Length)self.dimension * (vDSP_Length)self.dimension;
+    if (self.precision == MCKPrecisionDouble) {
+        vDSP_vaddD(_scatterValues.bytes, 1, accumulator->_scatterValues.bytes, 1, _scatterValues.mutableBytes, 1, length);
+    } else {
+        vDSP_vadd(_scatterValues.bytes, 1, accumulator->_scatterValues.bytes, 1, _scatterValues.mutableBytes, 1, length);
+    }
+    [self combineWithCount:accumulator.count mean:accumulator->_meanValues.bytes];
+}
+
+#pragma mark - Results
+
+- (MAVMatrix *)covarianceMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod
+{
+    NSAssert(self.count > 1, @"The covariance of fewer than two samples is undefined.");
+    
+    NSMutableData *values = [_scatterValues mutableCopy];
+    vDSP_Length length = (vDSP_Length)self.dimension * (vDSP_Length)self.dimension;
+    if (self.precision == MCKPrecisionDouble) {
+        double scale = 1.0 / (double)(self.count - 1);
+        vDSP_vsmulD(values.bytes, 1, &scale, values.mutableBytes, 1, length);
+    } else {
+        float scale = (float)(1.0 / (double)(self.count - 1));
+        vDSP_vsmul(values.bytes, 1, &scale, values.mutableBytes, 1, length);
+    }
+    
+    return [self symmetricMatrixWithUpperValues:values packingMethod:packingMethod];
+}
+
+- (MAVMatrix *)gramMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod
+{
+    // XᵀX = Σ(x - μ)(x - μ)ᵀ + nμμᵀ
+    NSMutableData *values = [_scatterValues mutableCopy];
+    MAVLAPACKInteger dimension = MAVLAPACKIntegerFromIndex(self.dimension);
+    if (self.precision == MCKPrecisionDouble) {
+        cblas_dsyr(CblasColMajor, CblasUpper, dimension, (double)self.count, _meanValues.bytes, 1, values.mutableBytes, dimension);
+    } else {
+        cblas_ssyr(CblasColMajor, CblasUpper, dimension, (float)self.count, _meanValues.bytes, 1, values.mutableBytes, dimension);
+    }
+    
+    return [self symmetricMatrixWithUpperValues:values packingMethod:packingMethod];
+}
+
+#pragma mark - Private
+
+/**
+ @brief Fold the mean of count samples into the running mean, after their own scatter has been added, by adding the scatter between the two means: with n = nA + nB and δ = μB - μA, the scatter grows by (nA nB / n) δδᵀ and the mean becomes μA + (nB / n) δ.
+ @param count The number of samples being added.
+ @param mean The mean of the samples being added.
+ */
+- (void)combineWithCount:(uint64_t)count mean:(const void *)mean
+{
+    uint64_t total = self.count + count;
+    double scatterScale = (double)self.count * ((double)count / (double)total);
+    double meanScale = (double)count / (double)total;
+    MAVLAPACKInteger dimension = MAVLAPACKIntegerFromIndex(self.dimension);
+    
+    if (self.precision == MCKPrecisionDouble) {
+        double *delta = _deltaValues.mutableBytes;
+        vDSP_vsubD(_meanValues.bytes, 1, mean, 1, delta, 1, (vDSP_Length)dimension);
+        if (scatterScale > 0.0) {
+            cblas_dsyr(CblasColMajor, CblasUpper, dimension, scatterScale, delta, 1, _scatterValues.mutableBytes, dimension);
+        }
+        cblas_daxpy(dimension, meanScale, delta, 1, _meanValues.mutableBytes, 1);
+    } else {
+        float *delta = _deltaValues.mutableBytes;
+        vDSP_vsub(_meanValues.bytes, 1, mean, 1, delta, 1, (vDSP_Length)dimension);
+        if (scatterScale > 0.0) {
+            cblas_ssyr(CblasColMajor, CblasUpper, dimension, (float)scatterScale, delta, 1, _scatterValues.mutableBytes, dimension);
+        }
+        cblas_saxpy(dimension, (float)meanScale, delta, 1, _meanValues.mutableBytes, 1);
+    }
+    
+    _count = total;
+}
+
+- (MAVMatrix *)symmetricMatrixWithUpperValues:(NSMutableData *)values
+                                packingMethod:(MAVMatrixValuePackingMethod)packingMethod
+{
+    NSAssert(packingMethod != MAVMatrixValuePackingMethodBand, @"Covariance matrices cannot be stored in band format.");
+    
+    MAVMatrix *matrix;
+    if (packingMethod == MAVMatrixValuePackingMethodPacked) {
+        NSData *packedValues = [MAVMatrix packedValuesFromTriangularComponent:MAVMatrixTriangularComponentUpper
+                                                          ofColumnMajorValues:values.bytes
+                                                                        order:self.dimension
+                                                                    precision:self.precision];
+        matrix = [MAVMatrix symmetricMatrixWithPackedValues:packedValues
+                                        triangularComponent:MAVMatrixTriangularComponentUpper
+                                           leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                      order:self.dimension];
+    } else {
+        [MAVMatrix mirrorTriangularComponent:MAVMatrixTriangularComponentUpper
+                         ofColumnMajorValues:values.mutableBytes
+                                       order:self.dimension
+                                   precision:self.precision];
+        matrix = [MAVMatrix matrixWithValues:values
+                                        rows:self.dimension
+                                     columns:self.dimension
+                            leadingDimension:MAVMatrixLeadingDimensionColumn];
+        matrix.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    matrix.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    
+    return matrix;
+}
+
+@end
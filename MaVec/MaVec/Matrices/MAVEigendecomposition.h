@@ -30,7 +30,7 @@
 @class MAVMatrix;
 @class MAVVector;
 
-@interface MAVEigendecomposition : NSObject <NSCopying>
+@interface MAVEigendecomposition : NSObject <NSCopying, NSSecureCoding>
 
 /**
  @property eigenvectors
@@ -58,6 +58,12 @@
  */
 + (instancetype)eigendecompositionOfMatrix:(MAVMatrix *)matrix;
 
+/**
+ @brief Compute the eigendecomposition of αM from this eigendecomposition of M, whose eigenvectors are the same and whose eigenvalues are scaled by α. A negative scalar reverses the order of the eigenvalues, so the eigenvalues of symmetric matrices stay in ascending order.
+ @return A new eigendecomposition of αM.
+ */
+- (MAVEigendecomposition *)decompositionScaledByScalar:(NSNumber *)scalar;
+
 - (NSString *)description;
 
 @end
@@ -29,8 +29,12 @@
 #import <MCKNumerics/MCKNumerics.h>
 
 #import "MAVEigendecomposition.h"
+#import "MAVFixedSizeMatrixKernels.h"
+#import "MAVLAPACKInteger.h"
 #import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix-Protected.h"
 #import "MAVMatrix.h"
+#import "MAVMutableMatrix.h"
 #import "MAVVector.h"
 
 @implementation MAVEigendecomposition
@@ -39,13 +43,17 @@
 {
     self = [super init];
     if (self) {
+        if (matrix.rows <= 3 && matrix.isSymmetric.isYes && [self decomposeSmallSymmetricMatrix:matrix]) {
+            return self;
+        }
+        
         if (matrix.isSymmetric.isYes) {
-            MAVIndex n = matrix.rows;
-            MAVIndex lda = n;
-            MAVIndex lwork = -1;
-            MAVIndex iwkopt;
-            MAVIndex liwork = -1;
-            MAVIndex info;
+            MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(matrix.rows);
+            MAVLAPACKInteger lda = n;
+            MAVLAPACKInteger lwork = -1;
+            MAVLAPACKInteger iwkopt;
+            MAVLAPACKInteger liwork = -1;
+            MAVLAPACKInteger info;
             NSData *a = [matrix valuesFromTriangularComponent:MAVMatrixTriangularComponentLower
                                              leadingDimension:MAVMatrixLeadingDimensionColumn
                                                 packingMethod:MAVMatrixValuePackingMethodConventional];
@@ -56,10 +64,10 @@
                 double wkopt;
                 dsyevd_("V", "L", &n, (double*)a.bytes, &lda, w, &wkopt, &lwork, &iwkopt, &liwork, &info);
                 
-                lwork = (MAVIndex)wkopt;
+                lwork = (MAVLAPACKInteger)wkopt;
                 double *work = malloc(lwork * sizeof(double));
                 liwork = iwkopt;
-                MAVIndex *iwork = malloc(liwork * sizeof(MAVIndex));
+                MAVLAPACKInteger *iwork = malloc(liwork * sizeof(MAVLAPACKInteger));
                 dsyevd_("V", "L", &n, (double *)a.bytes, &lda, w, work, &lwork, iwork, &liwork, &info);
                 
                 free(work);
@@ -77,10 +85,10 @@
                 float wkopt;
                 ssyevd_("V", "L", &n, (float*)a.bytes, &lda, w, &wkopt, &lwork, &iwkopt, &liwork, &info);
                 
-                lwork = (MAVIndex)wkopt;
+                lwork = (MAVLAPACKInteger)wkopt;
                 float *work = malloc(lwork * sizeof(float));
                 liwork = iwkopt;
-                MAVIndex *iwork = malloc(liwork * sizeof(MAVIndex));
+                MAVLAPACKInteger *iwork = malloc(liwork * sizeof(MAVLAPACKInteger));
                 ssyevd_("V", "L", &n, (float *)a.bytes, &lda, w, work, &lwork, iwork, &liwork, &info);
                 
                 free(work);
@@ -94,12 +102,12 @@
                 }
             }
         } else {
-            MAVIndex n = matrix.rows;
-            MAVIndex lda = n;
-            MAVIndex ldvl = n;
-            MAVIndex ldvr = n;
-            MAVIndex lwork = -1;
-            MAVIndex info;
+            MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(matrix.rows);
+            MAVLAPACKInteger lda = n;
+            MAVLAPACKInteger ldvl = n;
+            MAVLAPACKInteger ldvr = n;
+            MAVLAPACKInteger lwork = -1;
+            MAVLAPACKInteger info;
             
             NSData *a = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
             
@@ -112,7 +120,7 @@
                 double wkopt;
                 dgeev_("V", "V", &n, (double *)a.bytes, &lda, wr, wi, vl, &ldvl, vr, &ldvr, &wkopt, &lwork, &info);
                 
-                lwork = (MAVIndex)wkopt;
+                lwork = (MAVLAPACKInteger)wkopt;
                 double *work = malloc(lwork * sizeof(double));
                 dgeev_("V", "V", &n, (double *)a.bytes, &lda, wr, wi, vl, &ldvl, vr, &ldvr, work, &lwork, &info);
                 
@@ -136,7 +144,7 @@
                 float wkopt;
                 sgeev_("V", "V", &n, (float *)a.bytes, &lda, wr, wi, vl, &ldvl, vr, &ldvr, &wkopt, &lwork, &info);
                 
-                lwork = (MAVIndex)wkopt;
+                lwork = (MAVLAPACKInteger)wkopt;
                 float *work = malloc(lwork * sizeof(float));
                 sgeev_("V", "V", &n, (float *)a.bytes, &lda, wr, wi, vl, &ldvl, vr, &ldvr, work, &lwork, &info);
                 
@@ -168,6 +176,87 @@
     return [NSString stringWithFormat:@"\nEigenvectors:%@\nEigenvalues:%@", self.eigenvectors.description, self.eigenvalues.description];
 }
 
+#pragma mark - Updates
+
+- (MAVEigendecomposition *)decompositionScaledByScalar:(NSNumber *)scalar
+{
+    MAVEigendecomposition *decomposition = [self copy];
+    
+    MAVIndex n = self.eigenvalues.length;
+    NSMutableData *eigenvalues = [self.eigenvalues.values mutableCopy];
+    MAVMutableMatrix *eigenvectors = nil;
+    BOOL reverses = [scalar compare:@0] == NSOrderedAscending;
+    if (self.eigenvalues.precision == MCKPrecisionDouble) {
+        double scalarValue = scalar.doubleValue;
+        vDSP_vsmulD(eigenvalues.mutableBytes, 1, &scalarValue, eigenvalues.mutableBytes, 1, n);
+        if (reverses) {
+            vDSP_vrvrsD(eigenvalues.mutableBytes, 1, n);
+        }
+    } else {
+        float scalarValue = scalar.floatValue;
+        vDSP_vsmul(eigenvalues.mutableBytes, 1, &scalarValue, eigenvalues.mutableBytes, 1, n);
+        if (reverses) {
+            vDSP_vrvrs(eigenvalues.mutableBytes, 1, n);
+        }
+    }
+    if (reverses) {
+        eigenvectors = [self.eigenvectors mutableCopy];
+        for (MAVIndex i = 0; i < n / 2; i += 1) {
+            [eigenvectors swapColumnA:i withColumnB:n - 1 - i];
+        }
+    }
+    
+    decomposition.eigenvalues = [MAVVector vectorWithValues:eigenvalues length:n vectorFormat:self.eigenvalues.vectorFormat];
+    if (eigenvectors != nil) {
+        decomposition.eigenvectors = eigenvectors;
+    }
+    
+    return decomposition;
+}
+
+#pragma mark - Private interface
+
+/**
+ @brief Decompose a symmetric matrix of order 3 or less with the closed-form kernels in MAVFixedSizeMatrixKernels.h, producing eigenvalues in ascending order like dsyevd.
+ @return YES if successful, NO if the eigenvalues are too close together for the closed form to be accurate, in which case LAPACK should be used instead.
+ */
+- (BOOL)decomposeSmallSymmetricMatrix:(MAVMatrix *)matrix
+{
+    int n = (int)matrix.rows;
+    double values[9];
+    double eigenvalues[3];
+    double eigenvectors[9];
+    [matrix getFixedSizeRowMajorValues:values];
+    
+    if (!MAVSymmetricEigendecompositionOfOrder(values, eigenvalues, eigenvectors, n)) {
+        return NO;
+    }
+    
+    if (matrix.precision == MCKPrecisionDouble) {
+        _eigenvalues = [MAVVector vectorWithValues:[NSData dataWithBytes:eigenvalues length:n * sizeof(double)] length:n];
+        _eigenvectors = [MAVMatrix matrixWithValues:[NSData dataWithBytes:eigenvectors length:n * n * sizeof(double)]
+                                               rows:n
+                                            columns:n
+                                   leadingDimension:MAVMatrixLeadingDimensionRow];
+    } else {
+        float floatEigenvalues[3];
+        float floatEigenvectors[9];
+        for (int i = 0; i < n; i++) {
+            floatEigenvalues[i] = (float)eigenvalues[i];
+        }
+        for (int i = 0; i < n * n; i++) {
+            floatEigenvectors[i] = (float)eigenvectors[i];
+        }
+        _eigenvalues = [MAVVector vectorWithValues:[NSData dataWithBytes:floatEigenvalues length:n * sizeof(float)] length:n];
+        _eigenvectors = [MAVMatrix matrixWithValues:[NSData dataWithBytes:floatEigenvectors length:n * n * sizeof(float)]
+                                               rows:n
+                                            columns:n
+                                   leadingDimension:MAVMatrixLeadingDimensionRow];
+    }
+    
+    return YES;
+}
+
 #pragma mark - NSCopying
 
 - (id)copyWithZone:(NSZone *)zone
@@ -180,4 +269,30 @@
     return copy;
 }
 
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:_eigenvectors forKey:@"eigenvectors"];
+    [aCoder encodeObject:_eigenvalues forKey:@"eigenvalues"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (self) {
+        _eigenvectors = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"eigenvectors"];
+        _eigenvalues = [aDecoder decodeObjectOfClass:[MAVVector class] forKey:@"eigenvalues"];
+        if (_eigenvectors == nil || _eigenvalues == nil) {
+            return nil;
+        }
+    }
+    return self;
+}
+
 @end
@@ -0,0 +1,48 @@
+//
+//  MAVFactorizationCache-Protected.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import "MAVFactorizationCache.h"
+#import "MAVMatrix-Protected.h"
+
+@interface MAVFactorizationCache ()
+
+/**
+ @return YES if values of the property are stored in the cache, NO otherwise.
+ */
++ (BOOL)cachesProperty:(MAVMatrixLazyProperty)property;
+
+/**
+ @brief Look up the value of a property computed for a matrix with the same values and precision as matrix, counting a hit or miss.
+ @return A copy of the cached value, or nil if none is cached.
+ */
+- (id)objectForMatrix:(MAVMatrix *)matrix property:(MAVMatrixLazyProperty)property;
+
+/**
+ @brief Store the value of a property computed for matrix, evicting the least recently used entries to stay within the byte budget. Values larger than the whole budget are not stored.
+ */
+- (void)setObject:(id)object forMatrix:(MAVMatrix *)matrix property:(MAVMatrixLazyProperty)property;
+
+@end
@@ -0,0 +1,80 @@
+//
+//  MAVFactorizationCache.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+/**
+ @class MAVFactorizationCache
+ @description A process-wide, least recently used cache of the factorizations and other expensive lazily computed properties of matrices, keyed by the content hash, precision and property, so that separate matrix instances with the same values share one computation. When enabled, the QR, LU, Cholesky, singular value and eigen decompositions, inverse, determinant and condition number of a matrix are looked up in the cache before they are computed, and stored in it afterwards. Matching entries are confirmed by comparing the values of the matrices, so hash collisions are never returned. Matrices receive copies of cached objects, which share their values with the cache until they are mutated. The cache is safe to use from any thread.
+ */
+@interface MAVFactorizationCache : NSObject
+
+/**
+ @property enabled
+ @brief YES if matrices consult the cache before computing cacheable properties, NO otherwise. Default value = NO.
+ */
+@property (nonatomic, assign, getter=isEnabled) BOOL enabled;
+
+/**
+ @property byteBudget
+ @brief The maximum number of bytes of values held by the cache, counting the values of cached objects and of the matrices they were computed from. Lowering the budget evicts entries immediately. Default value = 64 MB.
+ */
+@property (nonatomic, assign) size_t byteBudget;
+
+/**
+ @property bytesUsed
+ @brief The number of bytes of values currently held by the cache.
+ */
+@property (nonatomic, readonly, assign) size_t bytesUsed;
+
+/**
+ @property hits
+ @brief The number of lookups that found a cached object since the statistics were last reset.
+ */
+@property (nonatomic, readonly, assign) uint64_t hits;
+
+/**
+ @property misses
+ @brief The number of lookups that found no cached object since the statistics were last reset.
+ */
+@property (nonatomic, readonly, assign) uint64_t misses;
+
+/**
+ @return The cache shared by all matrices in the process.
+ */
++ (instancetype)sharedCache;
+
+/**
+ @brief Evict every entry from the cache.
+ */
+- (void)removeAllObjects;
+
+/**
+ @brief Set the hit and miss counters to zero.
+ */
+- (void)resetStatistics;
+
+@end
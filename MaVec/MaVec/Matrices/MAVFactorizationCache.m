@@ -0,0 +1,297 @@
+//
+//  MAVFactorizationCache.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <pthread.h>
+
+#import "MAVCholeskyFactorization.h"
+#import "MAVEigendecomposition.h"
+#import "MAVFactorizationCache-Protected.h"
+#import "MAVLUFactorization.h"
+#import "MAVQRFactorization.h"
+#import "MAVSingularValueDecomposition.h"
+#import "MAVVector.h"
+
+/**
+ The default byte budget of the shared cache.
+ */
+static const size_t MAVFactorizationCacheDefaultByteBudget = 64 * 1024 * 1024;
+
+/**
+ @brief A value cached for a matrix.
+ */
+@interface MAVFactorizationCacheEntry : NSObject
+
+// a copy of the matrix the value was computed for, sharing its values, to confirm that a matrix with the same content hash has the same values
+@property (strong, nonatomic) MAVMatrix *matrix;
+
+@property (strong, nonatomic) id object;
+
+// the bytes of values held by the matrix and object
+@property (assign, nonatomic) size_t cost;
+
+// the value of the cache's use clock when the entry was last stored or returned
+@property (assign, nonatomic) uint64_t lastUse;
+
+@end
+
+@implementation MAVFactorizationCacheEntry
+@end
+
+@implementation MAVFactorizationCache
+{
+    // guards every other instance variable
+    pthread_mutex_t _mutex;
+    NSMutableDictionary *_entries;
+    uint64_t _useClock;
+    BOOL _enabled;
+    size_t _byteBudget;
+    size_t _bytesUsed;
+    uint64_t _hits;
+    uint64_t _misses;
+}
+
++ (instancetype)sharedCache
+{
+    static MAVFactorizationCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[self alloc] init];
+    });
+    return sharedCache;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mutex, NULL);
+        _entries = [NSMutableDictionary dictionary];
+        _byteBudget = MAVFactorizationCacheDefaultByteBudget;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark - Properties
+
+- (BOOL)isEnabled
+{
+    pthread_mutex_lock(&_mutex);
+    BOOL enabled = _enabled;
+    pthread_mutex_unlock(&_mutex);
+    return enabled;
+}
+
+- (void)setEnabled:(BOOL)enabled
+{
+    pthread_mutex_lock(&_mutex);
+    _enabled = enabled;
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (size_t)byteBudget
+{
+    pthread_mutex_lock(&_mutex);
+    size_t byteBudget = _byteBudget;
+    pthread_mutex_unlock(&_mutex);
+    return byteBudget;
+}
+
+- (void)setByteBudget:(size_t)byteBudget
+{
+    pthread_mutex_lock(&_mutex);
+    _byteBudget = byteBudget;
+    [self evictEntriesLocked];
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (size_t)bytesUsed
+{
+    pthread_mutex_lock(&_mutex);
+    size_t bytesUsed = _bytesUsed;
+    pthread_mutex_unlock(&_mutex);
+    return bytesUsed;
+}
+
+- (uint64_t)hits
+{
+    pthread_mutex_lock(&_mutex);
+    uint64_t hits = _hits;
+    pthread_mutex_unlock(&_mutex);
+    return hits;
+}
+
+- (uint64_t)misses
+{
+    pthread_mutex_lock(&_mutex);
+    uint64_t misses = _misses;
+    pthread_mutex_unlock(&_mutex);
+    return misses;
+}
+
+#pragma mark - Public
+
+- (void)removeAllObjects
+{
+    pthread_mutex_lock(&_mutex);
+    [_entries removeAllObjects];
+    _bytesUsed = 0;
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)resetStatistics
+{
+    pthread_mutex_lock(&_mutex);
+    _hits = 0;
+    _misses = 0;
+    pthread_mutex_unlock(&_mutex);
+}
+
+#pragma mark - Protected
+
++ (BOOL)cachesProperty:(MAVMatrixLazyProperty)property
+{
+    switch (property) {
+        case MAVMatrixLazyPropertyQRFactorization:
+        case MAVMatrixLazyPropertyLUFactorization:
+        case MAVMatrixLazyPropertyCholeskyFactorization:
+        case MAVMatrixLazyPropertySingularValueDecomposition:
+        case MAVMatrixLazyPropertyEigendecomposition:
+        case MAVMatrixLazyPropertyInverse:
+        case MAVMatrixLazyPropertyDeterminant:
+        case MAVMatrixLazyPropertyConditionNumber:
+            return YES;
+            
+        default:
+            return NO;
+    }
+}
+
+- (id)objectForMatrix:(MAVMatrix *)matrix property:(MAVMatrixLazyProperty)property
+{
+    // hash outside the lock, and confirm a match outside it too, since both read every value
+    id<NSCopying> key = [self keyForMatrix:matrix property:property];
+    
+    pthread_mutex_lock(&_mutex);
+    MAVFactorizationCacheEntry *entry = _entries[key];
+    pthread_mutex_unlock(&_mutex);
+    
+    BOOL isMatch = entry != nil && [entry.matrix isEqualToMatrix:matrix];
+    
+    pthread_mutex_lock(&_mutex);
+    if (isMatch) {
+        _hits += 1;
+        entry.lastUse = ++_useClock;
+    } else {
+        _misses += 1;
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    return isMatch ? [entry.object copy] : nil;
+}
+
+- (void)setObject:(id)object forMatrix:(MAVMatrix *)matrix property:(MAVMatrixLazyProperty)property
+{
+    MAVFactorizationCacheEntry *entry = [[MAVFactorizationCacheEntry alloc] init];
+    // only the values are needed to confirm a match, so keep none of the properties cached on the matrix alive
+    entry.matrix = [matrix copyWithoutCachedProperties];
+    entry.object = [object copy];
+    entry.cost = [self costOfObject:matrix] + [self costOfObject:object];
+    id<NSCopying> key = [self keyForMatrix:matrix property:property];
+    
+    pthread_mutex_lock(&_mutex);
+    if (entry.cost <= _byteBudget) {
+        MAVFactorizationCacheEntry *replacedEntry = _entries[key];
+        if (replacedEntry != nil) {
+            _bytesUsed -= replacedEntry.cost;
+        }
+        entry.lastUse = ++_useClock;
+        _entries[key] = entry;
+        _bytesUsed += entry.cost;
+        [self evictEntriesLocked];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+#pragma mark - Private
+
+- (id<NSCopying>)keyForMatrix:(MAVMatrix *)matrix property:(MAVMatrixLazyProperty)property
+{
+    // equal matrices of different precisions have different factorizations
+    return [NSString stringWithFormat:@"%016llx.%d.%d", (unsigned long long)matrix.contentHash, (int)matrix.precision, (int)property];
+}
+
+- (size_t)costOfObject:(id)object
+{
+    if ([object isKindOfClass:[MAVMatrix class]]) {
+        return ((MAVMatrix *)object).values.length;
+    } else if ([object isKindOfClass:[MAVVector class]]) {
+        return ((MAVVector *)object).values.length;
+    } else if ([object isKindOfClass:[MAVQRFactorization class]]) {
+        MAVQRFactorization *qr = object;
+        return [self costOfObject:qr.q] + [self costOfObject:qr.r];
+    } else if ([object isKindOfClass:[MAVLUFactorization class]]) {
+        MAVLUFactorization *lu = object;
+        return [self costOfObject:lu.lowerTriangularMatrix] + [self costOfObject:lu.upperTriangularMatrix] + [self costOfObject:lu.permutationMatrix];
+    } else if ([object isKindOfClass:[MAVCholeskyFactorization class]]) {
+        return [self costOfObject:((MAVCholeskyFactorization *)object).lowerTriangularMatrix];
+    } else if ([object isKindOfClass:[MAVSingularValueDecomposition class]]) {
+        MAVSingularValueDecomposition *svd = object;
+        return [self costOfObject:svd.u] + [self costOfObject:svd.s] + [self costOfObject:svd.vT];
+    } else if ([object isKindOfClass:[MAVEigendecomposition class]]) {
+        MAVEigendecomposition *eigendecomposition = object;
+        return [self costOfObject:eigendecomposition.eigenvectors] + [self costOfObject:eigendecomposition.eigenvalues];
+    } else {
+        return sizeof(double);
+    }
+}
+
+// must be called holding _mutex; evicts the least recently used entries until the cache fits its byte budget
+- (void)evictEntriesLocked
+{
+    while (_bytesUsed > _byteBudget) {
+        id victimKey;
+        MAVFactorizationCacheEntry *victim;
+        for (id key in _entries) {
+            MAVFactorizationCacheEntry *entry = _entries[key];
+            if (victim == nil || entry.lastUse < victim.lastUse) {
+                victim = entry;
+                victimKey = key;
+            }
+        }
+        if (victim == nil) {
+            return;
+        }
+        [_entries removeObjectForKey:victimKey];
+        _bytesUsed -= victim.cost;
+    }
+}
+
+@end
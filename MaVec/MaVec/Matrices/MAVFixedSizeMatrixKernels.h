@@ -0,0 +1,383 @@
+//
+//  MAVFixedSizeMatrixKernels.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+/*
+ Closed-form kernels for matrices of order 2, 3 and 4. Each operates on a
+ row-major array of doubles without allocating, so they inline cheaply. The
+ determinant, adjugate and product kernels do not branch on values. The solve
+ and the conditioning check do: they report singular or ill-conditioned
+ matrices, so callers can fall back to a pivoted LU factorization. The
+ eigendecompositions also branch, to handle repeated eigenvalues.
+ */
+
+#ifndef MAVFixedSizeMatrixKernels_h
+#define MAVFixedSizeMatrixKernels_h
+
+#include <math.h>
+
+/**
+ The largest order of matrix handled by the fixed-size kernels.
+ */
+#define MAV_FIXED_SIZE_MAX_ORDER 4
+
+#pragma mark - Determinants
+
+static inline double MAVDeterminant2x2(const double *m)
+{
+    return m[0] * m[3] - m[1] * m[2];
+}
+
+static inline double MAVDeterminant3x3(const double *m)
+{
+    return m[0] * (m[4] * m[8] - m[5] * m[7])
+         - m[1] * (m[3] * m[8] - m[5] * m[6])
+         + m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+static inline double MAVDeterminant4x4(const double *m)
+{
+    // expand along the first row using 2x2 minors of the bottom two rows
+    double s0 = m[10] * m[15] - m[11] * m[14];
+    double s1 = m[9] * m[15] - m[11] * m[13];
+    double s2 = m[9] * m[14] - m[10] * m[13];
+    double s3 = m[8] * m[15] - m[11] * m[12];
+    double s4 = m[8] * m[14] - m[10] * m[12];
+    double s5 = m[8] * m[13] - m[9] * m[12];
+
+    return m[0] * (m[5] * s0 - m[6] * s1 + m[7] * s2)
+         - m[1] * (m[4] * s0 - m[6] * s3 + m[7] * s4)
+         + m[2] * (m[4] * s1 - m[5] * s3 + m[7] * s5)
+         - m[3] * (m[4] * s2 - m[5] * s4 + m[6] * s5);
+}
+
+static inline double MAVDeterminantOfOrder(const double *m, int order)
+{
+    switch (order) {
+        case 1: return m[0];
+        case 2: return MAVDeterminant2x2(m);
+        case 3: return MAVDeterminant3x3(m);
+        default: return MAVDeterminant4x4(m);
+    }
+}
+
+#pragma mark - Adjugates
+
+/*
+ The adjugate is the transpose of the cofactor matrix, so that A * adj(A) = det(A) * I
+ and the inverse of A is adj(A) / det(A).
+ */
+
+static inline void MAVAdjugate2x2(const double *m, double *adjugate)
+{
+    adjugate[0] = m[3];
+    adjugate[1] = -m[1];
+    adjugate[2] = -m[2];
+    adjugate[3] = m[0];
+}
+
+static inline void MAVAdjugate3x3(const double *m, double *adjugate)
+{
+    adjugate[0] = m[4] * m[8] - m[5] * m[7];
+    adjugate[1] = m[2] * m[7] - m[1] * m[8];
+    adjugate[2] = m[1] * m[5] - m[2] * m[4];
+    adjugate[3] = m[5] * m[6] - m[3] * m[8];
+    adjugate[4] = m[0] * m[8] - m[2] * m[6];
+    adjugate[5] = m[2] * m[3] - m[0] * m[5];
+    adjugate[6] = m[3] * m[7] - m[4] * m[6];
+    adjugate[7] = m[1] * m[6] - m[0] * m[7];
+    adjugate[8] = m[0] * m[4] - m[1] * m[3];
+}
+
+static inline void MAVAdjugate4x4(const double *m, double *adjugate)
+{
+    // 2x2 minors of the top two rows (s) and bottom two rows (c)
+    double s0 = m[0] * m[5] - m[1] * m[4];
+    double s1 = m[0] * m[6] - m[2] * m[4];
+    double s2 = m[0] * m[7] - m[3] * m[4];
+    double s3 = m[1] * m[6] - m[2] * m[5];
+    double s4 = m[1] * m[7] - m[3] * m[5];
+    double s5 = m[2] * m[7] - m[3] * m[6];
+
+    double c5 = m[10] * m[15] - m[11] * m[14];
+    double c4 = m[9] * m[15] - m[11] * m[13];
+    double c3 = m[9] * m[14] - m[10] * m[13];
+    double c2 = m[8] * m[15] - m[11] * m[12];
+    double c1 = m[8] * m[14] - m[10] * m[12];
+    double c0 = m[8] * m[13] - m[9] * m[12];
+
+    adjugate[0] = m[5] * c5 - m[6] * c4 + m[7] * c3;
+    adjugate[1] = -m[1] * c5 + m[2] * c4 - m[3] * c3;
+    adjugate[2] = m[13] * s5 - m[14] * s4 + m[15] * s3;
+    adjugate[3] = -m[9] * s5 + m[10] * s4 - m[11] * s3;
+
+    adjugate[4] = -m[4] * c5 + m[6] * c2 - m[7] * c1;
+    adjugate[5] = m[0] * c5 - m[2] * c2 + m[3] * c1;
+    adjugate[6] = -m[12] * s5 + m[14] * s2 - m[15] * s1;
+    adjugate[7] = m[8] * s5 - m[10] * s2 + m[11] * s1;
+
+    adjugate[8] = m[4] * c4 - m[5] * c2 + m[7] * c0;
+    adjugate[9] = -m[0] * c4 + m[1] * c2 - m[3] * c0;
+    adjugate[10] = m[12] * s4 - m[13] * s2 + m[15] * s0;
+    adjugate[11] = -m[8] * s4 + m[9] * s2 - m[11] * s0;
+
+    adjugate[12] = -m[4] * c3 + m[5] * c1 - m[6] * c0;
+    adjugate[13] = m[0] * c3 - m[1] * c1 + m[2] * c0;
+    adjugate[14] = -m[12] * s3 + m[13] * s1 - m[14] * s0;
+    adjugate[15] = m[8] * s3 - m[9] * s1 + m[10] * s0;
+}
+
+static inline void MAVAdjugateOfOrder(const double *m, double *adjugate, int order)
+{
+    switch (order) {
+        case 1: adjugate[0] = 1.0; break;
+        case 2: MAVAdjugate2x2(m, adjugate); break;
+        case 3: MAVAdjugate3x3(m, adjugate); break;
+        default: MAVAdjugate4x4(m, adjugate); break;
+    }
+}
+
+#pragma mark - Products
+
+static inline void MAVMultiplyOfOrder(const double *a, const double *b, double *c, int order)
+{
+    for (int row = 0; row < order; row++) {
+        for (int col = 0; col < order; col++) {
+            double sum = 0.0;
+            for (int k = 0; k < order; k++) {
+                sum += a[row * order + k] * b[k * order + col];
+            }
+            c[row * order + col] = sum;
+        }
+    }
+}
+
+#pragma mark - Linear systems
+
+/**
+ The smallest ratio of the magnitude of the determinant of a matrix to the product of the Euclidean norms of its rows, which bounds it by Hadamard's inequality, for which the closed-form inverse and solve are trusted. The ratio does not depend on the scale of the rows and approaches zero as they approach linear dependence, where the unpivoted adjugate loses accuracy that a pivoted LU factorization keeps.
+ */
+#define MAV_FIXED_SIZE_MIN_DETERMINANT_RATIO 1.0e-6
+
+/**
+ @brief Decide whether the closed-form inverse and solve are accurate enough for a matrix, by comparing its determinant with the product of the norms of its rows.
+ @return 1 if the adjugate may be used, 0 if the matrix is singular or so ill-conditioned that callers should fall back to a pivoted factorization.
+ */
+static inline int MAVDeterminantIsWellConditionedOfOrder(const double *m, double determinant, int order)
+{
+    double rowNormProduct = 1.0;
+    for (int row = 0; row < order; row++) {
+        double sumOfSquares = 0.0;
+        for (int col = 0; col < order; col++) {
+            sumOfSquares += m[row * order + col] * m[row * order + col];
+        }
+        rowNormProduct *= sqrt(sumOfSquares);
+    }
+    return fabs(determinant) > MAV_FIXED_SIZE_MIN_DETERMINANT_RATIO * rowNormProduct;
+}
+
+/**
+ @brief Solve Ax = b using the adjugate of A.
+ @return The determinant of A. If it is zero, x is left untouched.
+ */
+static inline double MAVSolveOfOrder(const double *a, const double *b, double *x, int order)
+{
+    double adjugate[16];
+    double determinant = MAVDeterminantOfOrder(a, order);
+    if (determinant == 0.0) {
+        return determinant;
+    }
+
+    MAVAdjugateOfOrder(a, adjugate, order);
+    for (int row = 0; row < order; row++) {
+        double sum = 0.0;
+        for (int col = 0; col < order; col++) {
+            sum += adjugate[row * order + col] * b[col];
+        }
+        x[row] = sum / determinant;
+    }
+    return determinant;
+}
+
+#pragma mark - Symmetric eigendecompositions
+
+/*
+ Eigenvalues are written in ascending order, and the eigenvectors are written as the
+ columns of a row-major matrix in the same order, normalized to unit length. The kernels
+ return 0 instead when the closed form would lose accuracy, so callers can fall back to
+ an iterative solver.
+ */
+
+static inline int MAVSymmetricEigendecomposition2x2(const double *m, double *eigenvalues, double *eigenvectors)
+{
+    double a = m[0];
+    double b = m[1];
+    double d = m[3];
+
+    double mean = 0.5 * (a + d);
+    double radius = hypot(0.5 * (a - d), b);
+    eigenvalues[0] = mean - radius;
+    eigenvalues[1] = mean + radius;
+
+    if (radius == 0.0) {
+        // a multiple of the identity, for which any basis is an eigenbasis
+        eigenvectors[0] = 1.0; eigenvectors[1] = 0.0;
+        eigenvectors[2] = 0.0; eigenvectors[3] = 1.0;
+        return 1;
+    }
+
+    // of the two candidate eigenvectors for the larger eigenvalue, take the one less prone to cancellation
+    double x, y;
+    if (a >= d) {
+        x = eigenvalues[1] - d;
+        y = b;
+    } else {
+        x = b;
+        y = eigenvalues[1] - a;
+    }
+    double norm = hypot(x, y);
+    x /= norm;
+    y /= norm;
+
+    eigenvectors[0] = -y; eigenvectors[1] = x;
+    eigenvectors[2] = x;  eigenvectors[3] = y;
+    return 1;
+}
+
+/**
+ @brief Compute the eigenvector of a symmetric 3x3 matrix m for the eigenvalue lambda as the largest cross product of two rows of m - lambda * I, which are orthogonal to it.
+ @return The squared length of the cross product before normalization.
+ */
+static inline double MAVSymmetricEigenvector3x3(const double *m, double lambda, double *vector)
+{
+    double r0[3] = { m[0] - lambda, m[1], m[2] };
+    double r1[3] = { m[3], m[4] - lambda, m[5] };
+    double r2[3] = { m[6], m[7], m[8] - lambda };
+
+    double c01[3] = { r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2], r0[0] * r1[1] - r0[1] * r1[0] };
+    double c02[3] = { r0[1] * r2[2] - r0[2] * r2[1], r0[2] * r2[0] - r0[0] * r2[2], r0[0] * r2[1] - r0[1] * r2[0] };
+    double c12[3] = { r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0] };
+
+    double n01 = c01[0] * c01[0] + c01[1] * c01[1] + c01[2] * c01[2];
+    double n02 = c02[0] * c02[0] + c02[1] * c02[1] + c02[2] * c02[2];
+    double n12 = c12[0] * c12[0] + c12[1] * c12[1] + c12[2] * c12[2];
+
+    const double *best = c01;
+    double bestNorm = n01;
+    if (n02 > bestNorm) {
+        best = c02;
+        bestNorm = n02;
+    }
+    if (n12 > bestNorm) {
+        best = c12;
+        bestNorm = n12;
+    }
+
+    if (bestNorm > 0.0) {
+        double scale = 1.0 / sqrt(bestNorm);
+        vector[0] = best[0] * scale;
+        vector[1] = best[1] * scale;
+        vector[2] = best[2] * scale;
+    }
+    return bestNorm;
+}
+
+static inline int MAVSymmetricEigendecomposition3x3(const double *m, double *eigenvalues, double *eigenvectors)
+{
+    double offDiagonal = m[1] * m[1] + m[2] * m[2] + m[5] * m[5];
+    if (offDiagonal == 0.0) {
+        // diagonal: sort the diagonal values, permuting the standard basis to match
+        int order[3] = { 0, 1, 2 };
+        for (int i = 1; i < 3; i++) {
+            for (int j = i; j > 0 && m[order[j] * 4] < m[order[j - 1] * 4]; j--) {
+                int swap = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = swap;
+            }
+        }
+        for (int j = 0; j < 3; j++) {
+            eigenvalues[j] = m[order[j] * 4];
+            for (int row = 0; row < 3; row++) {
+                eigenvectors[row * 3 + j] = row == order[j] ? 1.0 : 0.0;
+            }
+        }
+        return 1;
+    }
+
+    // trigonometric solution of the characteristic polynomial of the shifted and scaled matrix B = (m - qI) / p
+    double q = (m[0] + m[4] + m[8]) / 3.0;
+    double d0 = m[0] - q;
+    double d1 = m[4] - q;
+    double d2 = m[8] - q;
+    double p = sqrt((d0 * d0 + d1 * d1 + d2 * d2 + 2.0 * offDiagonal) / 6.0);
+    double b[9] = { d0 / p, m[1] / p, m[2] / p, m[3] / p, d1 / p, m[5] / p, m[6] / p, m[7] / p, d2 / p };
+    double r = 0.5 * MAVDeterminant3x3(b);
+    r = r < -1.0 ? -1.0 : (r > 1.0 ? 1.0 : r);
+    double phi = acos(r) / 3.0;
+
+    double largest = q + 2.0 * p * cos(phi);
+    double smallest = q + 2.0 * p * cos(phi + 2.0 * M_PI / 3.0);
+    double middle = 3.0 * q - largest - smallest;
+
+    // eigenvectors of nearly repeated eigenvalues are ill-determined by cross products
+    double scale = fabs(largest) > fabs(smallest) ? fabs(largest) : fabs(smallest);
+    if (largest - middle <= 1e-4 * scale || middle - smallest <= 1e-4 * scale) {
+        return 0;
+    }
+
+    double v0[3], v2[3];
+    if (MAVSymmetricEigenvector3x3(m, smallest, v0) == 0.0 || MAVSymmetricEigenvector3x3(m, largest, v2) == 0.0) {
+        return 0;
+    }
+
+    // complete the orthonormal basis so the eigenvectors are mutually orthogonal by construction
+    double v1[3] = { v2[1] * v0[2] - v2[2] * v0[1], v2[2] * v0[0] - v2[0] * v0[2], v2[0] * v0[1] - v2[1] * v0[0] };
+
+    eigenvalues[0] = smallest;
+    eigenvalues[1] = middle;
+    eigenvalues[2] = largest;
+    for (int row = 0; row < 3; row++) {
+        eigenvectors[row * 3 + 0] = v0[row];
+        eigenvectors[row * 3 + 1] = v1[row];
+        eigenvectors[row * 3 + 2] = v2[row];
+    }
+    return 1;
+}
+
+static inline int MAVSymmetricEigendecompositionOfOrder(const double *m, double *eigenvalues, double *eigenvectors, int order)
+{
+    switch (order) {
+        case 1:
+            eigenvalues[0] = m[0];
+            eigenvectors[0] = 1.0;
+            return 1;
+        case 2: return MAVSymmetricEigendecomposition2x2(m, eigenvalues, eigenvectors);
+        case 3: return MAVSymmetricEigendecomposition3x3(m, eigenvalues, eigenvectors);
+        default: return 0;
+    }
+}
+
+#endif /* MAVFixedSizeMatrixKernels_h */
@@ -35,7 +35,7 @@
  @brief Container class to hold the results of a LU factorization in MAVMatrix objects.
  @description The LU factorization decomposes a matrix A into the product LU, where L is a lower triangular matrix and U is an upper triangular matrix.
  */
-@interface MAVLUFactorization : NSObject <NSCopying>
+@interface MAVLUFactorization : NSObject <NSCopying, NSSecureCoding>
 
 /**
  @property l
@@ -76,6 +76,20 @@
  */
 + (instancetype)luFactorizationOfMatrix:(MAVMatrix *)matrix;
 
+#pragma mark - Updates
+
+/**
+ @brief Compute the factorization of the matrix formed by exchanging two rows of A from this factorization of A. Since A = PLU, exchanging rows of A exchanges the same rows of P and leaves L and U unchanged. Other changes to A, apart from scaling it, have no stable update without pivoting, so matrices changed in any other way must be factorized again.
+ @return A new factorization of the permuted matrix.
+ */
+- (MAVLUFactorization *)factorizationBySwappingRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB;
+
+/**
+ @brief Compute the factorization of αA from this factorization of A, by scaling U by α, which leaves the pivots chosen for A unchanged.
+ @return A new factorization of αA.
+ */
+- (MAVLUFactorization *)factorizationScaledByScalar:(NSNumber *)scalar;
+
 - (NSString *)description;
 
 @end
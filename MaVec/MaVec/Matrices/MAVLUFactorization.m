@@ -28,8 +28,10 @@
 #import <Accelerate/Accelerate.h>
 #import <MCKNumerics/MCKNumerics.h>
 
+#import "MAVLAPACKInteger.h"
 #import "MAVLUFactorization.h"
 #import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix-Protected.h"
 #import "MAVMatrix.h"
 #import "MAVMutableMatrix.h"
 
@@ -45,11 +47,11 @@
     if (self) {
         NSData *columnMajorValues = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
         
-        MAVIndex m = matrix.rows;
-        MAVIndex n = matrix.columns;
-        MAVIndex lda = m;
-        MAVIndex *ipiv = malloc(MIN(m, n) * sizeof(MAVIndex));
-        MAVIndex info = 0;
+        MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(matrix.rows);
+        MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(matrix.columns);
+        MAVLAPACKInteger lda = m;
+        MAVLAPACKInteger *ipiv = malloc(MIN(m, n) * sizeof(MAVLAPACKInteger));
+        MAVLAPACKInteger info = 0;
         MAVMutableMatrix *l = [MAVMutableMatrix matrixWithRows:m columns:n precision:matrix.precision];
         MAVMutableMatrix *u = [MAVMutableMatrix matrixWithRows:n columns:m precision:matrix.precision];
         MAVMutableMatrix *p = [MAVMutableMatrix identityMatrixOfOrder:MIN(m, n) precision:matrix.precision];
@@ -134,6 +136,10 @@
             free(ipiv);
         }
         
+        // L and U are triangular by construction, so record that for triangular solves and determinants
+        l.triangularComponent = MAVMatrixTriangularComponentLower;
+        u.triangularComponent = MAVMatrixTriangularComponentUpper;
+        
         _lowerTriangularMatrix = l;
         _upperTriangularMatrix = u;
         _permutationMatrix = p;
@@ -160,8 +166,71 @@
     luCopy->_lowerTriangularMatrix = _lowerTriangularMatrix.copy;
     luCopy->_upperTriangularMatrix = _upperTriangularMatrix.copy;
     luCopy->_permutationMatrix = _permutationMatrix.copy;
+    luCopy->_numberOfPermutations = _numberOfPermutations;
     
     return luCopy;
 }
 
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:_lowerTriangularMatrix forKey:@"lowerTriangularMatrix"];
+    [aCoder encodeObject:_upperTriangularMatrix forKey:@"upperTriangularMatrix"];
+    [aCoder encodeObject:_permutationMatrix forKey:@"permutationMatrix"];
+    [aCoder encodeInt64:_numberOfPermutations forKey:@"numberOfPermutations"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (self) {
+        _lowerTriangularMatrix = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"lowerTriangularMatrix"];
+        _upperTriangularMatrix = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"upperTriangularMatrix"];
+        _permutationMatrix = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"permutationMatrix"];
+        _numberOfPermutations = (MAVIndex)[aDecoder decodeInt64ForKey:@"numberOfPermutations"];
+        if (_lowerTriangularMatrix == nil || _upperTriangularMatrix == nil || _permutationMatrix == nil) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+#pragma mark - Updates
+
+- (MAVLUFactorization *)factorizationBySwappingRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB
+{
+    NSAssert1(rowA >= 0 && rowA < self.permutationMatrix.rows, @"rowA = %lld is outside the range of possible rows.", (long long int)rowA);
+    NSAssert1(rowB >= 0 && rowB < self.permutationMatrix.rows, @"rowB = %lld is outside the range of possible rows.", (long long int)rowB);
+    
+    MAVLUFactorization *factorization = [self copy];
+    if (rowA == rowB) {
+        return factorization;
+    }
+    
+    // the exchange adds one transposition to P, flipping the sign of the determinant
+    MAVMutableMatrix *p = [self.permutationMatrix mutableCopy];
+    [p swapRowA:rowA withRowB:rowB];
+    factorization->_permutationMatrix = p;
+    factorization->_numberOfPermutations = _numberOfPermutations + 1;
+    
+    return factorization;
+}
+
+- (MAVLUFactorization *)factorizationScaledByScalar:(NSNumber *)scalar
+{
+    MAVLUFactorization *factorization = [self copy];
+    
+    MAVMutableMatrix *u = [self.upperTriangularMatrix mutableCopy];
+    [u multiplyByScalar:scalar];
+    factorization->_upperTriangularMatrix = u;
+    
+    return factorization;
+}
+
 @end
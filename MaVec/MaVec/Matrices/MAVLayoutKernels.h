@@ -0,0 +1,265 @@
+//
+//  MAVLayoutKernels.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+/*
+ Kernels converting between the layouts a square or rectangular array of values
+ can be stored in. An array is described as a number of lines, which are rows
+ for row-major values and columns for column-major values, each holding values
+ at consecutive positions. Transposition and mirroring work through tiles small
+ enough that the lines of a tile stay in cache while it is traversed against its
+ stride, and large arrays are split across threads with MAVParallelForRanges.
+ Packing and unpacking copy whole runs of each line with memcpy.
+
+ A triangle of a square array is described by the part of each line it keeps:
+ the head of line j is positions 0...j, and the tail is positions j...order-1.
+ The upper triangle is made of the heads of column-major lines and the tails of
+ row-major lines, and the lower triangle the reverse.
+ */
+
+#ifndef MAVLayoutKernels_h
+#define MAVLayoutKernels_h
+
+#import "MAVParallel.h"
+#import "MAVTypedefs.h"
+
+/**
+ The number of lines and positions in one tile of a transposition, chosen so that a tile of the source and destination both fit in a level 1 data cache.
+ */
+#define MAV_LAYOUT_TILE_SIZE 32
+
+#pragma mark - Triangles
+
+/**
+ @return YES if a triangle is made of the heads of the lines of an array with the specified leading dimension, NO if it is made of their tails.
+ */
+static inline BOOL MAVTriangleIsMadeOfHeads(MAVMatrixTriangularComponent triangularComponent, MAVMatrixLeadingDimension leadingDimension)
+{
+    return (triangularComponent == MAVMatrixTriangularComponentUpper) == (leadingDimension == MAVMatrixLeadingDimensionColumn);
+}
+
+/**
+ @return The index in a packed array of the first value of a line.
+ */
+static inline size_t MAVPackedOffsetOfLine(size_t line, size_t order, BOOL heads)
+{
+    return heads ? line * (line + 1) / 2 : line * order - line * (line - 1) / 2;
+}
+
+/**
+ @brief Copy the heads or tails of the lines of a square array into a packed array of order * (order + 1) / 2 values.
+ */
+static inline void MAVPackTriangleOfLines(const void *source, size_t order, BOOL heads, size_t elementSize, void *packed)
+{
+    MAVParallelForRanges(order, order / 2, ^(NSRange range) {
+        for (size_t line = range.location; line < NSMaxRange(range); line++) {
+            size_t start = heads ? 0 : line;
+            size_t count = heads ? line + 1 : order - line;
+            memcpy((char *)packed + MAVPackedOffsetOfLine(line, order, heads) * elementSize, (const char *)source + (line * order + start) * elementSize, count * elementSize);
+        }
+    });
+}
+
+/**
+ @brief Copy a packed array into the heads or tails of the lines of a square array, setting the rest of each line to zero.
+ */
+static inline void MAVUnpackTriangleOfLines(const void *packed, size_t order, BOOL heads, size_t elementSize, void *destination)
+{
+    MAVParallelForRanges(order, order, ^(NSRange range) {
+        for (size_t line = range.location; line < NSMaxRange(range); line++) {
+            size_t start = heads ? 0 : line;
+            size_t count = heads ? line + 1 : order - line;
+            char *destinationLine = (char *)destination + line * order * elementSize;
+            memcpy(destinationLine + start * elementSize, (const char *)packed + MAVPackedOffsetOfLine(line, order, heads) * elementSize, count * elementSize);
+            if (heads) {
+                memset(destinationLine + count * elementSize, 0, (order - count) * elementSize);
+            } else {
+                memset(destinationLine, 0, start * elementSize);
+            }
+        }
+    });
+}
+
+/**
+ @brief Set the values outside the heads or tails of the lines of a square array to zero.
+ */
+static inline void MAVZeroOutsideTriangleOfLines(void *values, size_t order, BOOL heads, size_t elementSize)
+{
+    MAVParallelForRanges(order, order / 2, ^(NSRange range) {
+        for (size_t line = range.location; line < NSMaxRange(range); line++) {
+            char *valuesLine = (char *)values + line * order * elementSize;
+            if (heads) {
+                memset(valuesLine + (line + 1) * elementSize, 0, (order - line - 1) * elementSize);
+            } else {
+                memset(valuesLine, 0, line * elementSize);
+            }
+        }
+    });
+}
+
+#pragma mark - Double precision
+
+/*
+ MAVTransposeValuesD copies source, an array of lines each of lineLength values,
+ into destination as lineLength lines each of lines values.
+ MAVTransposeSquareValuesInPlaceD swaps the lines and positions of a square array.
+ MAVMirrorTriangleOfLinesD fills the values outside the heads or tails of the
+ lines of a square array from the triangle they hold, making the array symmetric.
+ */
+
+static inline void MAVTransposeValuesD(const double *source, size_t lines, size_t lineLength, double *destination)
+{
+    size_t bands = (lineLength + MAV_LAYOUT_TILE_SIZE - 1) / MAV_LAYOUT_TILE_SIZE;
+    MAVParallelForRanges(bands, lines * MAV_LAYOUT_TILE_SIZE, ^(NSRange range) {
+        for (size_t band = range.location; band < NSMaxRange(range); band++) {
+            size_t firstPosition = band * MAV_LAYOUT_TILE_SIZE;
+            size_t lastPosition = MIN(firstPosition + MAV_LAYOUT_TILE_SIZE, lineLength);
+            for (size_t firstLine = 0; firstLine < lines; firstLine += MAV_LAYOUT_TILE_SIZE) {
+                size_t lastLine = MIN(firstLine + MAV_LAYOUT_TILE_SIZE, lines);
+                for (size_t position = firstPosition; position < lastPosition; position++) {
+                    double *destinationLine = destination + position * lines;
+                    for (size_t line = firstLine; line < lastLine; line++) {
+                        destinationLine[line] = source[line * lineLength + position];
+                    }
+                }
+            }
+        }
+    });
+}
+
+static inline void MAVTransposeSquareValuesInPlaceD(double *values, size_t order)
+{
+    size_t tiles = (order + MAV_LAYOUT_TILE_SIZE - 1) / MAV_LAYOUT_TILE_SIZE;
+    MAVParallelForRanges(tiles, order * MAV_LAYOUT_TILE_SIZE / 2, ^(NSRange range) {
+        for (size_t tileLine = range.location; tileLine < NSMaxRange(range); tileLine++) {
+            size_t firstLine = tileLine * MAV_LAYOUT_TILE_SIZE;
+            size_t lastLine = MIN(firstLine + MAV_LAYOUT_TILE_SIZE, order);
+            for (size_t firstPosition = firstLine; firstPosition < order; firstPosition += MAV_LAYOUT_TILE_SIZE) {
+                size_t lastPosition = MIN(firstPosition + MAV_LAYOUT_TILE_SIZE, order);
+                for (size_t line = firstLine; line < lastLine; line++) {
+                    for (size_t position = MAX(firstPosition, line + 1); position < lastPosition; position++) {
+                        double value = values[line * order + position];
+                        values[line * order + position] = values[position * order + line];
+                        values[position * order + line] = value;
+                    }
+                }
+            }
+        }
+    });
+}
+
+static inline void MAVMirrorTriangleOfLinesD(double *values, size_t order, BOOL heads)
+{
+    size_t tiles = (order + MAV_LAYOUT_TILE_SIZE - 1) / MAV_LAYOUT_TILE_SIZE;
+    MAVParallelForRanges(tiles, order * MAV_LAYOUT_TILE_SIZE / 2, ^(NSRange range) {
+        for (size_t tileLine = range.location; tileLine < NSMaxRange(range); tileLine++) {
+            size_t firstLine = tileLine * MAV_LAYOUT_TILE_SIZE;
+            size_t lastLine = MIN(firstLine + MAV_LAYOUT_TILE_SIZE, order);
+            size_t firstTilePosition = heads ? firstLine : 0;
+            size_t lastTilePosition = heads ? order : lastLine;
+            for (size_t firstPosition = firstTilePosition; firstPosition < lastTilePosition; firstPosition += MAV_LAYOUT_TILE_SIZE) {
+                size_t lastPosition = MIN(firstPosition + MAV_LAYOUT_TILE_SIZE, order);
+                for (size_t line = firstLine; line < lastLine; line++) {
+                    size_t start = heads ? MAX(firstPosition, line + 1) : firstPosition;
+                    size_t end = heads ? lastPosition : MIN(lastPosition, line);
+                    for (size_t position = start; position < end; position++) {
+                        values[line * order + position] = values[position * order + line];
+                    }
+                }
+            }
+        }
+    });
+}
+
+#pragma mark - Single precision
+
+// single-precision versions of the kernels above
+
+static inline void MAVTransposeValues(const float *source, size_t lines, size_t lineLength, float *destination)
+{
+    size_t bands = (lineLength + MAV_LAYOUT_TILE_SIZE - 1) / MAV_LAYOUT_TILE_SIZE;
+    MAVParallelForRanges(bands, lines * MAV_LAYOUT_TILE_SIZE, ^(NSRange range) {
+        for (size_t band = range.location; band < NSMaxRange(range); band++) {
+            size_t firstPosition = band * MAV_LAYOUT_TILE_SIZE;
+            size_t lastPosition = MIN(firstPosition + MAV_LAYOUT_TILE_SIZE, lineLength);
+            for (size_t firstLine = 0; firstLine < lines; firstLine += MAV_LAYOUT_TILE_SIZE) {
+                size_t lastLine = MIN(firstLine + MAV_LAYOUT_TILE_SIZE, lines);
+                for (size_t position = firstPosition; position < lastPosition; position++) {
+                    float *destinationLine = destination + position * lines;
+                    for (size_t line = firstLine; line < lastLine; line++) {
+                        destinationLine[line] = source[line * lineLength + position];
+                    }
+                }
+            }
+        }
+    });
+}
+
+static inline void MAVTransposeSquareValuesInPlace(float *values, size_t order)
+{
+    size_t tiles = (order + MAV_LAYOUT_TILE_SIZE - 1) / MAV_LAYOUT_TILE_SIZE;
+    MAVParallelForRanges(tiles, order * MAV_LAYOUT_TILE_SIZE / 2, ^(NSRange range) {
+        for (size_t tileLine = range.location; tileLine < NSMaxRange(range); tileLine++) {
+            size_t firstLine = tileLine * MAV_LAYOUT_TILE_SIZE;
+            size_t lastLine = MIN(firstLine + MAV_LAYOUT_TILE_SIZE, order);
+            for (size_t firstPosition = firstLine; firstPosition < order; firstPosition += MAV_LAYOUT_TILE_SIZE) {
+                size_t lastPosition = MIN(firstPosition + MAV_LAYOUT_TILE_SIZE, order);
+                for (size_t line = firstLine; line < lastLine; line++) {
+                    for (size_t position = MAX(firstPosition, line + 1); position < lastPosition; position++) {
+                        float value = values[line * order + position];
+                        values[line * order + position] = values[position * order + line];
+                        values[position * order + line] = value;
+                    }
+                }
+            }
+        }
+    });
+}
+
+static inline void MAVMirrorTriangleOfLines(float *values, size_t order, BOOL heads)
+{
+    size_t tiles = (order + MAV_LAYOUT_TILE_SIZE - 1) / MAV_LAYOUT_TILE_SIZE;
+    MAVParallelForRanges(tiles, order * MAV_LAYOUT_TILE_SIZE / 2, ^(NSRange range) {
+        for (size_t tileLine = range.location; tileLine < NSMaxRange(range); tileLine++) {
+            size_t firstLine = tileLine * MAV_LAYOUT_TILE_SIZE;
+            size_t lastLine = MIN(firstLine + MAV_LAYOUT_TILE_SIZE, order);
+            size_t firstTilePosition = heads ? firstLine : 0;
+            size_t lastTilePosition = heads ? order : lastLine;
+            for (size_t firstPosition = firstTilePosition; firstPosition < lastTilePosition; firstPosition += MAV_LAYOUT_TILE_SIZE) {
+                size_t lastPosition = MIN(firstPosition + MAV_LAYOUT_TILE_SIZE, order);
+                for (size_t line = firstLine; line < lastLine; line++) {
+                    size_t start = heads ? MAX(firstPosition, line + 1) : firstPosition;
+                    size_t end = heads ? lastPosition : MIN(lastPosition, line);
+                    for (size_t position = start; position < end; position++) {
+                        values[line * order + position] = values[position * order + line];
+                    }
+                }
+            }
+        }
+    });
+}
+
+#endif /* MAVLayoutKernels_h */
@@ -53,6 +53,45 @@ typedef enum : UInt8 {
  */
 MAVMatrixNorm;
 
+typedef enum : UInt8 {
+    MAVMatrixLazyPropertyTranspose,
+    MAVMatrixLazyPropertyDeterminant,
+    MAVMatrixLazyPropertyInverse,
+    MAVMatrixLazyPropertyConditionNumber,
+    MAVMatrixLazyPropertyQRFactorization,
+    MAVMatrixLazyPropertyLUFactorization,
+    MAVMatrixLazyPropertySingularValueDecomposition,
+    MAVMatrixLazyPropertyEigendecomposition,
+    MAVMatrixLazyPropertySymmetric,
+    MAVMatrixLazyPropertyZero,
+    MAVMatrixLazyPropertyIdentity,
+    MAVMatrixLazyPropertyDefiniteness,
+    MAVMatrixLazyPropertyDiagonalValues,
+    MAVMatrixLazyPropertyTrace,
+    MAVMatrixLazyPropertyNormInfinity,
+    MAVMatrixLazyPropertyNormL1,
+    MAVMatrixLazyPropertyNormMax,
+    MAVMatrixLazyPropertyNormFroebenius,
+    MAVMatrixLazyPropertyMinorMatrix,
+    MAVMatrixLazyPropertyCofactorMatrix,
+    MAVMatrixLazyPropertyAdjugate,
+    MAVMatrixLazyPropertyCholeskyFactorization
+}
+/**
+ Constants identifying the lazily computed properties of a matrix, used to track which of them are being computed.
+ */
+MAVMatrixLazyProperty;
+
+/**
+ The bit representing a lazily computed property in a mask of properties.
+ */
+#define MAVMatrixLazyPropertyMask(property) (1u << (property))
+
+/**
+ A mask of all the lazily computed properties of a matrix.
+ */
+#define MAVMatrixLazyPropertiesAll (MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyCholeskyFactorization + 1) - 1u)
+
 @interface MAVMatrix ()
 
 // public readonly properties redeclared as readwrite
@@ -62,6 +101,7 @@ MAVMatrixNorm;
 @property (strong, readwrite, nonatomic) MAVMatrix *transpose;
 @property (strong, readwrite, nonatomic) MAVQRFactorization *qrFactorization;
 @property (strong, readwrite, nonatomic) MAVLUFactorization *luFactorization;
+@property (strong, readwrite, nonatomic) MAVCholeskyFactorization *choleskyFactorization;
 @property (strong, readwrite, nonatomic) MAVSingularValueDecomposition *singularValueDecomposition;
 @property (strong, readwrite, nonatomic) MAVEigendecomposition *eigendecomposition;
 @property (strong, readwrite, nonatomic) MAVMatrix *inverse;
@@ -83,25 +123,138 @@ MAVMatrixNorm;
 @property (assign, readwrite, nonatomic) MAVMatrixTriangularComponent triangularComponent;
 @property (assign, readwrite, nonatomic) MCKPrecision precision;
 
+// structural hint set by operations known to produce symmetric positive semidefinite results, like AᵀA
+@property (strong, nonatomic) MCKTribool *positiveSemidefinite;
+
 // private properties for band matrices
 @property (assign, nonatomic) MAVIndex bandwidth;
 @property (assign, nonatomic) MAVIndex numberOfBandValues;
 @property (assign, nonatomic) MAVIndex upperCodiagonals;
 
 /**
- @brief Generates specified number of floating-point values.
+ @brief Generates specified number of floating-point values, distributed uniformly on [-1, 1) and drawn from the default MAVRandomGenerator.
  @param size Amount of random values to generate.
  @return C array point containing specified number of random values.
  */
 + (NSData *)randomArrayOfSize:(size_t)size
                     precision:(MCKPrecision)precision;
 
+/**
+ @brief Create an immutable matrix sharing the values of this one, with none of its lazily computed properties except symmetry, which packed storage needs to unpack its values, for holding on to the values without keeping anything derived from them alive.
+ */
+- (MAVMatrix *)copyWithoutCachedProperties;
+
+/**
+ @brief Test in constant time whether another matrix holds the same values as this one because one is an unmutated copy of the other, or the same instance. Matrices with equal but separately stored values are not detected.
+ @param matrix The matrix to compare with this one, which may be nil.
+ @return YES if both matrices share one array of values in the same storage format, NO otherwise.
+ */
+- (BOOL)sharesValuesWithMatrix:(MAVMatrix *)matrix;
+
+/**
+ @brief Return the values of this matrix for writing in place, first copying them if they are shared with a copy of this matrix. Only mutable matrices write to their values.
+ @return The values of this matrix, which this matrix alone references.
+ */
+- (NSMutableData *)mutableValues;
+
 /**
  @brief Sets all calculated properties to default states.
  @param breakSymmetry YES if a symmetrical matrix has lost symmetry, NO if it should maintain it
  */
 - (void)resetToDefaultStateAndBreakSymmetry:(BOOL)breakSymmetry;
 
+/**
+ @brief Set a subset of the calculated properties to default states, keeping the others. The content hash and, for conventional storage, the triangular component are always reset, as they describe the values rather than anything derived from them.
+ @param properties A mask of the properties to reset, built with MAVMatrixLazyPropertyMask. The definiteness bit also covers the positive semidefinite hint.
+ */
+- (void)resetLazyProperties:(UInt32)properties;
+
+/**
+ @brief Compute C = alpha * AᵀA + beta * C, or C = alpha * AAᵀ + beta * C, with a symmetric rank-k update, where A is this matrix.
+ @param values A square, column-major array of values for C, of which only the specified triangle is referenced and updated.
+ @param triangularComponent The triangle of C to reference and update, either MAVMatrixTriangularComponentUpper or MAVMatrixTriangularComponentLower.
+ @param ofColumns YES to compute with AᵀA, NO to compute with AAᵀ.
+ @param alpha The scalar multiplying the Gram matrix.
+ @param beta The scalar multiplying C. If 0, C need not be initialized.
+ */
+- (void)updateSymmetricValues:(void *)values
+          triangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+     withGramProductOfColumns:(BOOL)ofColumns
+                        alpha:(double)alpha
+                         beta:(double)beta;
+
+/**
+ @brief Extract a triangle of a square, column-major array of values into column-major packed format.
+ @param triangularComponent The triangle to extract, either MAVMatrixTriangularComponentUpper or MAVMatrixTriangularComponentLower.
+ @return The packed values of the specified triangle.
+ */
++ (NSData *)packedValuesFromTriangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+                            ofColumnMajorValues:(const void *)values
+                                          order:(MAVIndex)order
+                                      precision:(MCKPrecision)precision;
+
+/**
+ @brief Copy a triangle of a square, column-major array of values into the opposite triangle in place, making the values symmetric.
+ @param triangularComponent The triangle to copy from, either MAVMatrixTriangularComponentUpper or MAVMatrixTriangularComponentLower.
+ */
++ (void)mirrorTriangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+              ofColumnMajorValues:(void *)values
+                            order:(MAVIndex)order
+                        precision:(MCKPrecision)precision;
+
+/**
+ @brief Return a lazily computed property, computing it at most once even when several threads ask for it at the same time: the first thread runs computeBlock while the others wait for its result. Once a value is published, reading it takes no lock. Values are only safe to share across threads while the matrix is not being mutated.
+ @param property The property being computed.
+ @param storage The instance variable backing the property.
+ @param computeBlock A block computing the value of the property, which must not assign to storage itself.
+ @return The cached or newly computed value of the property.
+ */
+- (id)lazyValueForProperty:(MAVMatrixLazyProperty)property
+                   storage:(__strong id *)storage
+              computeBlock:(id (^)(void))computeBlock;
+
+/**
+ @brief Like lazyValueForProperty:storage:computeBlock:, for properties whose uncomputed state is an unknown tribool rather than nil.
+ */
+- (MCKTribool *)lazyTriboolForProperty:(MAVMatrixLazyProperty)property
+                               storage:(__strong id *)storage
+                          computeBlock:(id (^)(void))computeBlock;
+
+/**
+ @brief Return the value of a lazily computed property if it has already been computed, without computing it.
+ @return The cached value of the property, or nil if it has not been computed. Definiteness is boxed in an NSNumber.
+ */
+- (id)cachedValueForProperty:(MAVMatrixLazyProperty)property;
+
+/**
+ @brief Publish a value for a lazily computed property, as returned by cachedValueForProperty:, for mutations that can derive the new value of a property from the old one. Passing nil leaves the property as it is.
+ */
+- (void)setCachedValue:(id)value forProperty:(MAVMatrixLazyProperty)property;
+
+/**
+ @brief Wait until no other thread is computing a lazy property, then claim it for the calling thread unless it has been computed in the meantime.
+ @param isCached A block reporting whether the property's value has been published, called while holding the lock that guards the property.
+ @return YES if the caller must compute and publish the property and then call finishComputingLazyProperty:, NO if it is already cached.
+ */
+- (BOOL)beginComputingLazyProperty:(MAVMatrixLazyProperty)property isCached:(BOOL (^)(void))isCached;
+
+/**
+ @brief Release a lazy property claimed with beginComputingLazyProperty:isCached: after publishing its value, waking any threads waiting for it.
+ */
+- (void)finishComputingLazyProperty:(MAVMatrixLazyProperty)property;
+
+/**
+ @brief Determine whether this matrix is upper or lower triangular. Packed and band storage answer from their structure; conventionally stored values are scanned for nonzero entries off the diagonal.
+ @return MAVMatrixTriangularComponentUpper or MAVMatrixTriangularComponentLower if the matrix is triangular (diagonal matrices report MAVMatrixTriangularComponentUpper), or MAVMatrixTriangularComponentBoth if it is not triangular or not square.
+ */
+- (MAVMatrixTriangularComponent)inferredTriangularComponent;
+
+/**
+ @brief Copy the values of a square matrix of order no greater than MAV_FIXED_SIZE_MAX_ORDER into a row-major array of doubles for the closed-form kernels in MAVFixedSizeMatrixKernels.h, without boxing any values.
+ @param values An array with room for at least rows * columns values.
+ */
+- (void)getFixedSizeRowMajorValues:(double *)values;
+
 /**
  @description Documentation on usage and other details can be found at http://publib.boulder.ibm.com/infocenter/clresctr/vxrx/index.jsp?topic=%2Fcom.ibm.cluster.essl.v5r2.essl100.doc%2Fam5gr_llange.htm. More information about different matrix norms can be found at http://en.wikipedia.org/wiki/Matrix_norm.
  @brief Compute the desired norm of this matrix.
@@ -32,6 +32,7 @@
 
 @class MAVSingularValueDecomposition;
 @class MAVLUFactorization;
+@class MAVCholeskyFactorization;
 @class MAVQRFactorization;
 @class MAVEigendecomposition;
 @class MAVVector;
@@ -39,9 +40,9 @@
 
 /**
  @class MAVMatrix
- @description A class providing storage and operations for matrices of double-precision floating point numbers, where underlying details governing how the two-dimensional structure is reduced to the one-dimensional array containing its values (packing, leading dimension, or other internal value representation method) is abstracted away for any operation or property.
+ @description A class providing storage and operations for matrices of double-precision floating point numbers, where underlying details governing how the two-dimensional structure is reduced to the one-dimensional array containing its values (packing, leading dimension, or other internal value representation method) is abstracted away for any operation or property. Lazy-loaded properties are computed at most once, even when read from several threads at the same time, so an immutable matrix may be shared between threads.
  */
-@interface MAVMatrix : NSObject <NSCopying, NSMutableCopying>
+@interface MAVMatrix : NSObject <NSCopying, NSMutableCopying, NSSecureCoding>
 
 /**
  @property rows 
@@ -87,13 +88,13 @@
 
 /**
  @property determinant
- @brief The determinant of this matrix. (Lazy-loaded)
+ @brief The determinant of this matrix. Matrices of order 4 or less use a closed-form cofactor expansion, and triangular matrices use the product of their diagonal values, without factorization. (Lazy-loaded)
  */
 @property (nonatomic, readonly, strong) NSNumber *determinant;
 
 /**
  @property inverse
- @brief The (pseudo)inverse of this matrix. (Lazy-loaded)
+ @brief The (pseudo)inverse of this matrix. Triangular matrices are inverted with dtrtri/dtptri, and other matrices of order 4 or less from their adjugate unless they are too ill-conditioned for it, in which case they are inverted through an LU factorization like larger matrices; a singular matrix has a nil inverse. (Lazy-loaded)
  */
 @property (nonatomic, readonly, strong) MAVMatrix *inverse;
 
@@ -134,6 +135,13 @@
  */
 @property (nonatomic, readonly, strong) MAVLUFactorization *luFactorization;
 
+/**
+ @property choleskyFactorization
+ @description Uses the Accelerate framework function dpotrf_, see http://www.netlib.org/lapack/explore-html/d0/d8a/dpotrf_8f.html. Mutating a matrix through MAVMutableMatrix updates its cached Cholesky factorization in O(n²) operations where the mutation is a symmetric rank-one change, instead of discarding it.
+ @brief An MAVCholeskyFactorization object containing the lower triangular matrix of the Cholesky factorization of this matrix, or nil if this matrix is not symmetric positive definite. (Lazy-loaded)
+ */
+@property (nonatomic, readonly, strong) MAVCholeskyFactorization *choleskyFactorization;
+
 /**
  @property singularValueDecomposition
  @description Uses the Accelerate framework function dgesdd_. Examples of dgesdd_(...) usage found at http://software.intel.com/sites/products/documentation/doclib/mkl_sa/11/mkl_lapack_examples/lapacke_dgesdd_row.c.htm and http://stackoverflow.com/questions/5047503/lapack-svd-singular-value-decomposition Good documentation exists at http://www.netlib.org/lapack/lug/node53.html and http://www.nag.com/numeric/FL/nagdoc_fl22/xhtml/F08/f08kdf.xml. See http://www.netlib.org/lapack/lug/node38.html for general documentation.
@@ -143,7 +151,7 @@
 
 /**
  @property eigendecomposition
- @brief Computes the eigendecomposition (spectral factorization) of this matrix. Documentation found at ... . (Lazy-loaded)
+ @brief Computes the eigendecomposition (spectral factorization) of this matrix. Symmetric matrices of order 3 or less are decomposed in closed form unless their eigenvalues are nearly repeated. Documentation found at ... . (Lazy-loaded)
  */
 @property (nonatomic, readonly, strong) MAVEigendecomposition *eigendecomposition;
 
@@ -171,6 +179,12 @@
  */
 @property (nonatomic, readonly, assign) MAVMatrixDefiniteness definiteness;
 
+/**
+ @property contentHash
+ @brief A 64-bit hash of the values of this matrix in column-major order, computed from their values rather than how they are stored, so matrices that are equal have equal hashes whatever their precision, packing method or leading dimension. (Lazy-loaded)
+ */
+@property (nonatomic, readonly, assign) uint64_t contentHash;
+
 /**
  @property diagnoalValues
  @brief A vector containing the values on the main diagonalfrom top to bottom. (Lazy-loaded)
@@ -213,6 +227,12 @@
  */
 @property (nonatomic, readonly, assign) MCKPrecision precision;
 
+/**
+ @property archivesFactorizations
+ @brief Whether archiving this matrix also archives whichever of its QR, LU, singular value and eigendecompositions, inverse, determinant and condition number have already been computed, so that a matrix unarchived from the archive need not compute them again. Its values are always archived exactly as they are stored, so packed and band matrices stay compact. Defaults to NO.
+ */
+@property (nonatomic, assign) BOOL archivesFactorizations;
+
 
 #pragma mark - Constructors
 
@@ -236,6 +256,7 @@
 #pragma mark - NSObject overrides
 
 /**
+ @description Matrices stored identically are compared with memcmp, and matrices whose content hashes differ are unequal, so values are only compared one by one when their storage differs and their hashes match. NaN values are equal to each other.
  @return YES if otherMatrix is either this MAVMatrix instance or is identical in dimension and contains identical values at all positions, NO otherwise.
  */
 - (BOOL)isEqualToMatrix:(MAVMatrix *)otherMatrix;
@@ -245,6 +266,11 @@
  */
 - (BOOL)isEqual:(id)object;
 
+/**
+ @return The content hash of this matrix, so that equal matrices have equal hashes and matrices can be used as dictionary keys and set members. Mutable matrices must not be mutated while they are used as keys.
+ */
+- (NSUInteger)hash;
+
 /**
  @return An NSString that can represent the values of this matrix in the usual two-dimensional human-readable format.
  */
@@ -313,6 +339,24 @@
  */
 - (NSArray *)columnVectors;
 
+#pragma mark - Symmetric products
+
+/**
+ @description Computed with a symmetric rank-k update (see http://www.netlib.org/lapack/explore-html/dc/d05/dsyrk_8f.html), which only computes one triangle of the result and reads this matrix' values in place.
+ @brief Compute the Gram matrix AᵀA of this matrix.
+ @param packingMethod MAVMatrixValuePackingMethodPacked to store the upper triangle of the result in column-major packed format, or MAVMatrixValuePackingMethodConventional to store all values in column-major format. Raises an NSInternalInconsistencyException for MAVMatrixValuePackingMethodBand.
+ @return A new symmetric matrix whose order is the number of columns in this matrix.
+ */
+- (MAVMatrix *)gramMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod;
+
+/**
+ @description Computed with a symmetric rank-k update (see http://www.netlib.org/lapack/explore-html/dc/d05/dsyrk_8f.html), which only computes one triangle of the result and reads this matrix' values in place.
+ @brief Compute the outer Gram matrix AAᵀ of this matrix.
+ @param packingMethod MAVMatrixValuePackingMethodPacked to store the upper triangle of the result in column-major packed format, or MAVMatrixValuePackingMethodConventional to store all values in column-major format. Raises an NSInternalInconsistencyException for MAVMatrixValuePackingMethodBand.
+ @return A new symmetric matrix whose order is the number of rows in this matrix.
+ */
+- (MAVMatrix *)outerGramMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod;
+
 #pragma mark - Subscripting
 
 /**
@@ -325,12 +369,25 @@
 #pragma mark - Class-level operations
 
 /**
- @description Good documentation for solving Ax=b where A is a square matrix located  at http://www.netlib.org/lapack/double/dgesv.f and example at http://software.intel.com/sites/products/documentation/doclib/mkl_sa/11/mkl_lapack_examples/dgesv_ex.c.htm. When A is a general m x n matrix, see documentation at http://www.netlib.org/lapack/double/dgels.f and example at http://software.intel.com/sites/products/documentation/doclib/mkl_sa/11/mkl_lapack_examples/dgels_ex.c.htm
+ @description Good documentation for solving Ax=b where A is a square matrix located  at http://www.netlib.org/lapack/double/dgesv.f and example at http://software.intel.com/sites/products/documentation/doclib/mkl_sa/11/mkl_lapack_examples/dgesv_ex.c.htm. When A is a general m x n matrix, see documentation at http://www.netlib.org/lapack/double/dgels.f and example at http://software.intel.com/sites/products/documentation/doclib/mkl_sa/11/mkl_lapack_examples/dgels_ex.c.htm. When A is upper or lower triangular, the system is solved by substitution without factoring A; see http://www.netlib.org/lapack/double/dtrtrs.f and http://www.netlib.org/lapack/double/dtptrs.f. Other square matrices of order 4 or less are solved in closed form using the adjugate of A, unless the rows of A are so close to linearly dependent that the adjugate would lose accuracy, when it is solved with dgesv.
  @return A column vector containing coefficients for unknows to solve a linear system Ax=B, or nil if the system cannot be solved. Raises an NSInvalidArgumentException if A and B are of incompatible dimension.
  */
 + (MAVVector *)solveLinearSystemWithMatrixA:(MAVMatrix *)A
                                     valuesB:(MAVVector *)B;
 
+/**
+ @description Factors A in single precision, which is roughly twice as fast and moves half as much memory as a double-precision factorization, then iteratively refines the solution using double-precision residuals until it reaches double-precision accuracy. If refinement does not converge, A is refactored and the system solved in double precision. Symmetric matrices known to be positive semidefinite use a Cholesky factorization (see http://www.netlib.org/lapack/explore-html/db/d69/dsposv_8f.html), otherwise an LU factorization is used (see http://www.netlib.org/lapack/explore-html/db/df4/dsgesv_8f.html).
+ @param A A square, double-precision matrix of coefficients.
+ @param B A double-precision vector of values.
+ @param refinementIterations If not NULL, set to the amount of refinement iterations performed, or 0 if the solution was computed in double precision.
+ @param didFallBackToDoublePrecision If not NULL, set to YES if refinement stalled or the single-precision factorization failed, so that A had to be factored in double precision.
+ @return A column vector containing coefficients for unknowns to solve a linear system Ax=B, or nil if the system cannot be solved. Raises an NSInternalInconsistencyException, in builds with assertions enabled, if A is not square, B does not have one value per row of A, or A or B are not double precision.
+ */
++ (MAVVector *)solveLinearSystemUsingMixedPrecisionWithMatrixA:(MAVMatrix *)A
+                                                       valuesB:(MAVVector *)B
+                                          refinementIterations:(MAVIndex *)refinementIterations
+                                  didFallBackToDoublePrecision:(BOOL *)didFallBackToDoublePrecision;
+
 /**
  @brief Multiplies an array of matrices together. Uses the Hu-Shing polygon partitioning method to determine the optimum order of multiplication to minimize the amount of operations. http://www.cs.ust.hk/mjg_lib/bibs/DPSu/DPSu.Files/0213017.pdf
  @param matrices An NSArray of MAVMatrix objects.
@@ -27,19 +27,110 @@
 
 #import <Accelerate/Accelerate.h>
 #import <MCKNumerics/MCKNumerics.h>
+#import <pthread.h>
+#import <stdatomic.h>
 
+#import "MAVCholeskyFactorization.h"
+#import "MAVContentHash.h"
 #import "MAVEigendecomposition.h"
+#import "MAVFactorizationCache-Protected.h"
+#import "MAVFixedSizeMatrixKernels.h"
+#import "MAVLAPACKInteger.h"
 #import "MAVLUFactorization.h"
+#import "MAVLayoutKernels.h"
 #import "MAVMatrix+MAVMatrixFactory.h"
 #import "MAVMatrix-Protected.h"
 #import "MAVMatrix.h"
 #import "MAVMutableMatrix.h"
+#import "MAVParallel.h"
 #import "MAVQRFactorization.h"
+#import "MAVRandomGenerator.h"
 #import "MAVSingularValueDecomposition.h"
+#import "MAVValueBuffer.h"
 #import "MAVVector.h"
 #import "NSData+MAVMatrixData.h"
 
+// keys of the values and structure of archived matrices
+static NSString *const MAVMatrixValuesKey = @"values";
+static NSString *const MAVMatrixRowsKey = @"rows";
+static NSString *const MAVMatrixColumnsKey = @"columns";
+static NSString *const MAVMatrixLeadingDimensionKey = @"leadingDimension";
+static NSString *const MAVMatrixPackingMethodKey = @"packingMethod";
+static NSString *const MAVMatrixTriangularComponentKey = @"triangularComponent";
+static NSString *const MAVMatrixPrecisionKey = @"precision";
+static NSString *const MAVMatrixUpperCodiagonalsKey = @"upperCodiagonals";
+static NSString *const MAVMatrixBandwidthKey = @"bandwidth";
+static NSString *const MAVMatrixSymmetricKey = @"symmetric";
+static NSString *const MAVMatrixPositiveSemidefiniteKey = @"positiveSemidefinite";
+static NSString *const MAVMatrixDefinitenessKey = @"definiteness";
+static NSString *const MAVMatrixArchivesFactorizationsKey = @"archivesFactorizations";
+
+// keys of the cached results archived when archivesFactorizations is YES
+static NSString *const MAVMatrixQRFactorizationKey = @"qrFactorization";
+static NSString *const MAVMatrixLUFactorizationKey = @"luFactorization";
+static NSString *const MAVMatrixCholeskyFactorizationKey = @"choleskyFactorization";
+static NSString *const MAVMatrixSingularValueDecompositionKey = @"singularValueDecomposition";
+static NSString *const MAVMatrixEigendecompositionKey = @"eigendecomposition";
+static NSString *const MAVMatrixInverseKey = @"inverse";
+static NSString *const MAVMatrixDeterminantKey = @"determinant";
+static NSString *const MAVMatrixConditionNumberKey = @"conditionNumber";
+
+/**
+ @brief Scan a square, conventionally stored array of values for nonzero entries on either side of the diagonal.
+ @return MAVMatrixTriangularComponentUpper if no entries below the diagonal are nonzero (including diagonal matrices), MAVMatrixTriangularComponentLower if no entries above the diagonal are nonzero, otherwise MAVMatrixTriangularComponentBoth.
+ */
+static MAVMatrixTriangularComponent MAVTriangularComponentOfValues(const void *values, MAVIndex order, MAVMatrixLeadingDimension leadingDimension, MCKPrecision precision)
+{
+    BOOL hasValuesAboveDiagonal = NO;
+    BOOL hasValuesBelowDiagonal = NO;
+    for (MAVIndex col = 0; col < order && !(hasValuesAboveDiagonal && hasValuesBelowDiagonal); col++) {
+        for (MAVIndex row = 0; row < order; row++) {
+            if (row == col) {
+                continue;
+            }
+            size_t index = leadingDimension == MAVMatrixLeadingDimensionColumn ? col * order + row : row * order + col;
+            BOOL isNonzero = precision == MCKPrecisionDouble ? ((double *)values)[index] != 0.0 : ((float *)values)[index] != 0.0f;
+            if (isNonzero) {
+                if (row > col) {
+                    hasValuesBelowDiagonal = YES;
+                } else {
+                    hasValuesAboveDiagonal = YES;
+                }
+            }
+        }
+    }
+    
+    if (!hasValuesBelowDiagonal) {
+        return MAVMatrixTriangularComponentUpper;
+    } else if (!hasValuesAboveDiagonal) {
+        return MAVMatrixTriangularComponentLower;
+    } else {
+        return MAVMatrixTriangularComponentBoth;
+    }
+}
+
+/**
+ @return YES if a lazily computed value has been published, where an unknown tribool counts as not yet computed.
+ */
+static BOOL MAVLazyValueIsCached(id value, BOOL isTribool)
+{
+    return value != nil && !(isTribool && ((MCKTribool *)value).triboolValue == MCKTriboolValueUnknown);
+}
+
 @implementation MAVMatrix
+{
+    // guards _lazyPropertiesInFlight, a bitmask of MAVMatrixLazyProperty values being computed by some thread; threads needing one of them wait on the condition
+    pthread_mutex_t _lazyPropertyMutex;
+    pthread_cond_t _lazyPropertyCondition;
+    UInt32 _lazyPropertiesInFlight;
+    
+    // holds the values, possibly shared with copies of this matrix
+    MAVValueBuffer *_valueBuffer;
+    
+    // the content hash is a scalar, published like the definiteness with its own barrier
+    uint64_t _contentHash;
+    BOOL _hasContentHash;
+}
 
 #pragma mark - Constructors
 
@@ -55,7 +146,7 @@
         _leadingDimension = leadingDimension;
         _packingMethod = packingMethod;
         _triangularComponent = triangularComponent;
-        _values = [[self class] isSubclassOfClass:[MAVMutableMatrix class]] ? [values mutableCopy] : values;
+        _valueBuffer = [[self class] isSubclassOfClass:[MAVMutableMatrix class]] ? [MAVValueBuffer bufferWithMutableData:[values mutableCopy]] : [MAVValueBuffer bufferWithData:values];
         _rows = rows;
         _columns = columns;
         
@@ -81,244 +172,236 @@
     return self;
 }
 
+#pragma mark - Values
+
+- (NSData *)values
+{
+    return _valueBuffer.data;
+}
+
+- (void)setValues:(NSData *)values
+{
+    [_valueBuffer relinquish];
+    _valueBuffer = [MAVValueBuffer bufferWithData:values];
+}
+
+- (NSMutableData *)mutableValues
+{
+    _valueBuffer = [_valueBuffer writableBuffer];
+    return (NSMutableData *)_valueBuffer.data;
+}
+
 #pragma mark - Lazy-loaded properties
 
 - (MAVMatrix *)transpose
 {
-    if (_transpose == nil) {
-        NSData *aVals = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
-        if ([aVals containsSinglePrecisionValues:(self.rows * self.columns)]) {
-            float *tVals = malloc(self.rows * self.columns * sizeof(float));
-            vDSP_mtrans(aVals.bytes, 1, tVals, 1, self.columns, self.rows);
-            _transpose = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:tVals length:aVals.length] rows:self.columns columns:self.rows];
-        } else  {
-            double *tVals = malloc(self.rows * self.columns * sizeof(double));
-            vDSP_mtransD(aVals.bytes, 1, tVals, 1, self.columns, self.rows);
-            _transpose = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:tVals length:aVals.length] rows:self.columns columns:self.rows];
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyTranspose storage:(__strong id *)&_transpose computeBlock:^id{
+        // the row-major values of a matrix are the column-major values of its transpose, so one layout conversion suffices
+        NSData *tVals = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
+        MAVMatrix *transpose = [MAVMatrix matrixWithValues:tVals rows:self.columns columns:self.rows];
+        
+        // transposition preserves symmetry and definiteness, and swaps which triangle holds nonzero values
+        transpose.symmetric = _symmetric;
+        transpose.positiveSemidefinite = _positiveSemidefinite;
+        MAVMatrixTriangularComponent triangularComponent = [self inferredTriangularComponent];
+        if (triangularComponent == MAVMatrixTriangularComponentUpper) {
+            transpose.triangularComponent = MAVMatrixTriangularComponentLower;
+        } else if (triangularComponent == MAVMatrixTriangularComponentLower) {
+            transpose.triangularComponent = MAVMatrixTriangularComponentUpper;
         }
-    }
-    
-    return _transpose;
+        return transpose;
+    }];
 }
 
 - (NSNumber *)determinant
 {
-    if (_determinant == nil) {
-        if (_rows == 2 && _columns == 2) {
-            if (self[0][0].isDoublePrecision) {
-                double a = self[0][0].doubleValue;
-                double b = self[0][1].doubleValue;
-                double c = self[1][0].doubleValue;
-                double d = self[1][1].doubleValue;
-                
-                _determinant = @(a * d - b * c);
-            } else {
-                float a = self[0][0].floatValue;
-                float b = self[0][1].floatValue;
-                float c = self[1][0].floatValue;
-                float d = self[1][1].floatValue;
-                
-                _determinant = @(a * d - b * c);
-            }
-        } else if (_rows == 3 && _columns == 3) {
-            if (self[0][0].isDoublePrecision) {
-                double a = self[0][0].doubleValue;
-                double b = self[0][1].doubleValue;
-                double c = self[0][2].doubleValue;
-                double d = self[1][0].doubleValue;
-                double e = self[1][1].doubleValue;
-                double f = self[1][2].doubleValue;
-                double g = self[2][0].doubleValue;
-                double h = self[2][1].doubleValue;
-                double i = self[2][2].doubleValue;
-                
-                _determinant = @(a * e * i + b * f * g + c * d * h - g * e * c - h * f * a - i * d * b);
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyDeterminant storage:(__strong id *)&_determinant computeBlock:^id{
+        NSNumber *determinant;
+        if (_rows == _columns && _rows <= MAV_FIXED_SIZE_MAX_ORDER) {
+            // closed-form cofactor expansion, read straight from the values without a factorization
+            double values[MAV_FIXED_SIZE_MAX_ORDER * MAV_FIXED_SIZE_MAX_ORDER];
+            [self getFixedSizeRowMajorValues:values];
+            double closedFormDeterminant = MAVDeterminantOfOrder(values, (int)_rows);
+            if (self.precision == MCKPrecisionDouble) {
+                determinant = @(closedFormDeterminant);
             } else {
-                float a = self[0][0].floatValue;
-                float b = self[0][1].floatValue;
-                float c = self[0][2].floatValue;
-                float d = self[1][0].floatValue;
-                float e = self[1][1].floatValue;
-                float f = self[1][2].floatValue;
-                float g = self[2][0].floatValue;
-                float h = self[2][1].floatValue;
-                float i = self[2][2].floatValue;
-                
-                _determinant = @(a * e * i + b * f * g + c * d * h - g * e * c - h * f * a - i * d * b);
+                determinant = @((float)closedFormDeterminant);
             }
+        } else if ([self inferredTriangularComponent] != MAVMatrixTriangularComponentBoth) {
+            // the determinant of a triangular matrix is the product of its diagonal entries
+            determinant = self.diagonalValues.productOfValues;
         } else {
             NSNumber *product = self.luFactorization.upperTriangularMatrix.diagonalValues.productOfValues;
             if (product.isDoublePrecision) {
-                _determinant = @(self.luFactorization.upperTriangularMatrix.diagonalValues.productOfValues.doubleValue * pow(-1.0, self.luFactorization.numberOfPermutations));
+                determinant = @(self.luFactorization.upperTriangularMatrix.diagonalValues.productOfValues.doubleValue * pow(-1.0, self.luFactorization.numberOfPermutations));
             } else {
-                _determinant = @(self.luFactorization.upperTriangularMatrix.diagonalValues.productOfValues.floatValue * powf(-1.0f, self.luFactorization.numberOfPermutations));
+                determinant = @(self.luFactorization.upperTriangularMatrix.diagonalValues.productOfValues.floatValue * powf(-1.0f, self.luFactorization.numberOfPermutations));
             }
         }
-    }
-    
-    return _determinant;
+        return determinant;
+    }];
 }
 
 - (MAVMatrix *)inverse
 {
-    if (_inverse == nil) {
-        if (_rows == _columns) {
-            NSData *columnMajorData = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
-            
-            MAVIndex m = _rows;
-            MAVIndex n = _columns;
-            
-            MAVIndex lda = m;
-            
-            MAVIndex *ipiv = malloc(MIN(m, n) * sizeof(MAVIndex));
-            
-            MAVIndex info = 0;
-            
-            void *a;
-            if ([columnMajorData containsDoublePrecisionValues:(m * n)]) {
-                a = (double *)columnMajorData.bytes;
-                
-                // compute factorization
-                dgetrf_(&m, &n, a, &lda, ipiv, &info);
-                
-                double wkopt;
-                MAVIndex lwork = -1;
-                
-                // query optimal workspace size
-                dgetri_(&m, a, &lda, ipiv, &wkopt, &lwork, &info);
-                
-                lwork = (MAVIndex)wkopt;
-                double *work = malloc(lwork * sizeof(double));
-                
-                // calculate the inverse
-                dgetri_(&m, a, &lda, ipiv, work, &lwork, &info);
-                
-                free(ipiv);
-                free(work);
-            } else {
-                a = (float *)columnMajorData.bytes;
-                
-                // compute factorization
-                sgetrf_(&m, &n, a, &lda, ipiv, &info);
-                
-                float wkopt;
-                MAVIndex lwork = -1;
-                
-                // query optimal workspace size
-                sgetri_(&m, a, &lda, ipiv, &wkopt, &lwork, &info);
-                
-                lwork = (MAVIndex)wkopt;
-                float *work = malloc(lwork * sizeof(float));
-                
-                // calculate the inverse
-                sgetri_(&m, a, &lda, ipiv, work, &lwork, &info);
-                
-                free(ipiv);
-                free(work);
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyInverse storage:(__strong id *)&_inverse computeBlock:^id{
+        MAVMatrix *inverse;
+        MAVMatrixTriangularComponent triangularComponent = [self inferredTriangularComponent];
+        if (triangularComponent != MAVMatrixTriangularComponentBoth) {
+            inverse = [self inverseOfTriangularComponent:triangularComponent];
+        } else if (_rows == _columns) {
+            // small matrices use the closed form unless they are too ill-conditioned for it
+            if (_rows <= MAV_FIXED_SIZE_MAX_ORDER) {
+                inverse = [self inverseOfFixedSizeMatrix];
+            }
+            if (inverse == nil && self.positiveSemidefinite.isYes) {
+                // use a Cholesky factorization if the matrix is known to be symmetric positive (semi)definite, falling back to LU if it is singular
+                inverse = [self inverseOfPositiveDefiniteMatrix] ?: [self inverseOfGeneralMatrix];
+            } else if (inverse == nil) {
+                inverse = [self inverseOfGeneralMatrix];
             }
-            
-			_inverse = [MAVMatrix matrixWithValues:[NSData dataWithBytes:a length:columnMajorData.length]
-			                                  rows:_rows
-			                               columns:_columns
-			                      leadingDimension:MAVMatrixLeadingDimensionColumn];
         }
-    }
-    
-    return _inverse;
+        return inverse;
+    }];
 }
 
 - (NSNumber *)conditionNumber
 {
-    if (_conditionNumber == nil) {
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyConditionNumber storage:(__strong id *)&_conditionNumber computeBlock:^id{
+        NSNumber *conditionNumber;
         NSData *rowMajorValues = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
-        MAVIndex m = self.rows;
-        MAVIndex n = self.columns;
-        if ([rowMajorValues containsDoublePrecisionValues:(m * n)]) {
+        MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(self.rows);
+        MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(self.columns);
+        if ([rowMajorValues containsDoublePrecisionValues:(self.rows * self.columns)]) {
             double *values = (double *)rowMajorValues.bytes;
             double norm = dlange_("1", &m, &n, values, &m, nil);
             
-            MAVIndex lda = self.rows;
-            MAVIndex *ipiv = malloc(m * sizeof(MAVIndex));
-            MAVIndex info;
+            MAVLAPACKInteger lda = m;
+            MAVLAPACKInteger *ipiv = malloc(m * sizeof(MAVLAPACKInteger));
+            MAVLAPACKInteger info;
             dgetrf_(&m, &n, values, &lda, ipiv, &info);
             
             double conditionReciprocal;
             double *work = malloc(4 * m * sizeof(double));
-            MAVIndex *iwork = malloc(m * sizeof(MAVIndex));
+            MAVLAPACKInteger *iwork = malloc(m * sizeof(MAVLAPACKInteger));
             dgecon_("1", &m, values, &lda, &norm, &conditionReciprocal, work, iwork, &info);
             
             free(ipiv);
             free(work);
             free(iwork);
             
-            _conditionNumber = @(1.0 / conditionReciprocal);
+            conditionNumber = @(1.0 / conditionReciprocal);
         } else {
             float *values = (float *)rowMajorValues.bytes;
             
             float norm = (float)slange_("1", &m, &n, values, &m, nil);
             
-            MAVIndex lda = self.rows;
-            MAVIndex *ipiv = malloc(m * sizeof(MAVIndex));
-            MAVIndex info;
+            MAVLAPACKInteger lda = m;
+            MAVLAPACKInteger *ipiv = malloc(m * sizeof(MAVLAPACKInteger));
+            MAVLAPACKInteger info;
             sgetrf_(&m, &n, values, &lda, ipiv, &info);
             
             float conditionReciprocal;
             float *work = malloc(4 * m * sizeof(float));
-            MAVIndex *iwork = malloc(m * sizeof(MAVIndex));
+            MAVLAPACKInteger *iwork = malloc(m * sizeof(MAVLAPACKInteger));
             sgecon_("1", &m, values, &lda, &norm, &conditionReciprocal, work, iwork, &info);
             
             free(ipiv);
             free(work);
             free(iwork);
             
-            _conditionNumber = @(1.0f / conditionReciprocal);
+            conditionNumber = @(1.0f / conditionReciprocal);
         }
-    }
-    
-    return _conditionNumber;
+        return conditionNumber;
+    }];
 }
 
 - (MAVQRFactorization *)qrFactorization
 {
-    if (_qrFactorization == nil) {
-        _qrFactorization = [MAVQRFactorization qrFactorizationOfMatrix:self];
-    }
-    
-    return _qrFactorization;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyQRFactorization storage:(__strong id *)&_qrFactorization computeBlock:^id{
+        return [MAVQRFactorization qrFactorizationOfMatrix:self];
+    }];
 }
 
 - (MAVLUFactorization *)luFactorization
 {
-    if (_luFactorization == nil) {
-        _luFactorization = [MAVLUFactorization luFactorizationOfMatrix:self];
-    }
-    
-    return _luFactorization;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyLUFactorization storage:(__strong id *)&_luFactorization computeBlock:^id{
+        return [MAVLUFactorization luFactorizationOfMatrix:self];
+    }];
+}
+
+- (MAVCholeskyFactorization *)choleskyFactorization
+{
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyCholeskyFactorization storage:(__strong id *)&_choleskyFactorization computeBlock:^id{
+        if (self.rows != self.columns || !self.isSymmetric.isYes) {
+            return nil;
+        }
+        return [MAVCholeskyFactorization choleskyFactorizationOfMatrix:self];
+    }];
 }
 
 - (MAVSingularValueDecomposition *)singularValueDecomposition
 {
-    if (_singularValueDecomposition == nil) {
-        _singularValueDecomposition = [MAVSingularValueDecomposition singularValueDecompositionWithMatrix:self];
-    }
-    
-    return _singularValueDecomposition;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertySingularValueDecomposition storage:(__strong id *)&_singularValueDecomposition computeBlock:^id{
+        return [MAVSingularValueDecomposition singularValueDecompositionWithMatrix:self];
+    }];
 }
 
 - (MAVEigendecomposition *)eigendecomposition
 {
-    if (_eigendecomposition == nil) {
-        _eigendecomposition = [MAVEigendecomposition eigendecompositionOfMatrix:self];
-    }
-    
-    return _eigendecomposition;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyEigendecomposition storage:(__strong id *)&_eigendecomposition computeBlock:^id{
+        return [MAVEigendecomposition eigendecompositionOfMatrix:self];
+    }];
 }
 
 - (MCKTribool *)isSymmetric
 {
-    if (_symmetric.triboolValue == MCKTriboolValueUnknown) {
+    return [self lazyTriboolForProperty:MAVMatrixLazyPropertySymmetric storage:(__strong id *)&_symmetric computeBlock:^id{
+        MCKTribool *symmetric;
         if (self.rows != self.columns) {
-            _symmetric = [MCKTribool triboolWithValue:MCKTriboolValueNo];
+            symmetric = [MCKTribool triboolWithValue:MCKTriboolValueNo];
+        } else if (self.rows <= MAV_FIXED_SIZE_MAX_ORDER) {
+            double values[MAV_FIXED_SIZE_MAX_ORDER * MAV_FIXED_SIZE_MAX_ORDER];
+            [self getFixedSizeRowMajorValues:values];
+            BOOL isSymmetric = YES;
+            for (MAVIndex i = 0; i < self.rows; i++) {
+                for (MAVIndex j = i + 1; j < self.columns; j++) {
+                    if (values[i * self.rows + j] != values[j * self.rows + i]) {
+                        isSymmetric = NO;
+                    }
+                }
+            }
+            symmetric = [MCKTribool triboolWithValue:isSymmetric ? MCKTriboolValueYes : MCKTriboolValueNo];
+        } else if (self.packingMethod == MAVMatrixValuePackingMethodConventional) {
+            // the layout doesn't matter, since the transpose of a symmetric matrix is itself
+            size_t n = self.rows;
+            BOOL isAsymmetric;
+            if (self.precision == MCKPrecisionDouble) {
+                const double *values = self.values.bytes;
+                isAsymmetric = MAVParallelAnyRange(n, n / 2, ^BOOL(NSRange range) {
+                    for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                        for (size_t j = i + 1; j < n; j++) {
+                            if (values[i * n + j] != values[j * n + i]) {
+                                return YES;
+                            }
+                        }
+                    }
+                    return NO;
+                });
+            } else {
+                const float *values = self.values.bytes;
+                isAsymmetric = MAVParallelAnyRange(n, n / 2, ^BOOL(NSRange range) {
+                    for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                        for (size_t j = i + 1; j < n; j++) {
+                            if (values[i * n + j] != values[j * n + i]) {
+                                return YES;
+                            }
+                        }
+                    }
+                    return NO;
+                });
+            }
+            symmetric = [MCKTribool triboolWithValue:isAsymmetric ? MCKTriboolValueNo : MCKTriboolValueYes];
         } else {
             BOOL isSymmetric = YES;
             for (MAVIndex i = 0; i < self.rows; i++) {
@@ -329,35 +412,91 @@
                     }
                 }
             }
-            _symmetric = [MCKTribool triboolWithValue:isSymmetric ? MCKTriboolValueYes : MCKTriboolValueNo];
+            symmetric = [MCKTribool triboolWithValue:isSymmetric ? MCKTriboolValueYes : MCKTriboolValueNo];
         }
-    }
-    
-    return _symmetric;
+        return symmetric;
+    }];
 }
 
 - (MCKTribool *)isZero
 {
-    if (_isZero.triboolValue == MCKTriboolValueUnknown) {
+    return [self lazyTriboolForProperty:MAVMatrixLazyPropertyZero storage:(__strong id *)&_isZero computeBlock:^id{
         MCKTriboolValue isZero = MCKTriboolValueYes;
-        for (MAVIndex rowIndex = 0; rowIndex < self.rows; rowIndex++) {
-            if ([[[self rowVectorForRow:rowIndex] isZero] isNo]) {
-                isZero = MCKTriboolValueNo;
-                break;
+        if (self.packingMethod != MAVMatrixValuePackingMethodBand) {
+            // conventional and packed storage hold only values of the matrix, so it is zero if they all are
+            BOOL hasNonzeroValue;
+            if (self.precision == MCKPrecisionDouble) {
+                const double *values = self.values.bytes;
+                hasNonzeroValue = MAVParallelAnyRange(self.values.length / sizeof(double), 1, ^BOOL(NSRange range) {
+                    for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                        if (values[i] != 0.0) {
+                            return YES;
+                        }
+                    }
+                    return NO;
+                });
+            } else {
+                const float *values = self.values.bytes;
+                hasNonzeroValue = MAVParallelAnyRange(self.values.length / sizeof(float), 1, ^BOOL(NSRange range) {
+                    for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                        if (values[i] != 0.0f) {
+                            return YES;
+                        }
+                    }
+                    return NO;
+                });
+            }
+            isZero = hasNonzeroValue ? MCKTriboolValueNo : MCKTriboolValueYes;
+        } else {
+            for (MAVIndex rowIndex = 0; rowIndex < self.rows; rowIndex++) {
+                if ([[[self rowVectorForRow:rowIndex] isZero] isNo]) {
+                    isZero = MCKTriboolValueNo;
+                    break;
+                }
             }
         }
-        _isZero = [MCKTribool triboolWithValue:isZero];
-    }
-    return _isZero;
+        return [MCKTribool triboolWithValue:isZero];
+    }];
 }
 
 - (MCKTribool *)isIdentity
 {
-    if (_isIdentity.triboolValue == MCKTriboolValueUnknown) {
+    return [self lazyTriboolForProperty:MAVMatrixLazyPropertyIdentity storage:(__strong id *)&_isIdentity computeBlock:^id{
         MCKTriboolValue isIdentity = MCKTriboolValueYes;
         if (self.rows != self.columns) {
             isIdentity = MCKTriboolValueNo;
         }
+        else if (self.packingMethod == MAVMatrixValuePackingMethodConventional) {
+            // the identity is the same in either layout
+            size_t n = self.rows;
+            BOOL differsFromIdentity;
+            if (self.precision == MCKPrecisionDouble) {
+                const double *values = self.values.bytes;
+                differsFromIdentity = MAVParallelAnyRange(n, n, ^BOOL(NSRange range) {
+                    for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                        for (size_t j = 0; j < n; j++) {
+                            if (values[i * n + j] != (i == j ? 1.0 : 0.0)) {
+                                return YES;
+                            }
+                        }
+                    }
+                    return NO;
+                });
+            } else {
+                const float *values = self.values.bytes;
+                differsFromIdentity = MAVParallelAnyRange(n, n, ^BOOL(NSRange range) {
+                    for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                        for (size_t j = 0; j < n; j++) {
+                            if (values[i * n + j] != (i == j ? 1.0f : 0.0f)) {
+                                return YES;
+                            }
+                        }
+                    }
+                    return NO;
+                });
+            }
+            isIdentity = differsFromIdentity ? MCKTriboolValueNo : MCKTriboolValueYes;
+        }
         else {
             isIdentity = self.diagonalValues.isIdentity.triboolValue;
             if (isIdentity) {
@@ -371,48 +510,90 @@
                 }
             }
         }
-        _isIdentity = [MCKTribool triboolWithValue:isIdentity];
+        return [MCKTribool triboolWithValue:isIdentity];
+    }];
+}
+
+- (uint64_t)contentHash
+{
+    // racing threads compute the same hash, so it is published without claiming the property
+    BOOL hasContentHash = _hasContentHash;
+    atomic_thread_fence(memory_order_acquire);
+    if (hasContentHash) {
+        return _contentHash;
+    }
+    
+    MAVContentHashState state;
+    MAVContentHashInit(&state, ((uint64_t)(uint32_t)self.rows << 32) | (uint64_t)(uint32_t)self.columns);
+    BOOL isCanonical = self.packingMethod == MAVMatrixValuePackingMethodConventional && self.leadingDimension == MAVMatrixLeadingDimensionColumn;
+    NSData *values = isCanonical ? self.values : [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    size_t count = (size_t)self.rows * (size_t)self.columns;
+    if (self.precision == MCKPrecisionDouble) {
+        MAVContentHashUpdateD(&state, values.bytes, count);
+    } else {
+        MAVContentHashUpdate(&state, values.bytes, count);
     }
-    return _isIdentity;
+    uint64_t contentHash = MAVContentHashFinish(&state);
+    
+    _contentHash = contentHash;
+    atomic_thread_fence(memory_order_release);
+    _hasContentHash = YES;
+    
+    return contentHash;
 }
 
 - (MAVMatrixDefiniteness)definiteness
 {
-    if (self.isSymmetric && _definiteness == MAVMatrixDefinitenessUnknown) {
-        BOOL hasFoundEigenvalueStrictlyGreaterThanZero = NO;
-        BOOL hasFoundEigenvalueStrictlyLesserThanZero = NO;
-        BOOL hasFoundEigenvalueEqualToZero = NO;
-        MAVVector *eigenvalues = self.eigendecomposition.eigenvalues;
-        for (MAVIndex i = 0; i < eigenvalues.length; i += 1) {
-            NSNumber *eigenvalue = [eigenvalues valueAtIndex:i];
-            if ([eigenvalue compare:@0] == NSOrderedDescending) {
-                hasFoundEigenvalueStrictlyGreaterThanZero = YES;
-            }
-            else if ([eigenvalue compare:@0] == NSOrderedAscending) {
-                hasFoundEigenvalueStrictlyLesserThanZero = YES;
-            }
-            else {
-                hasFoundEigenvalueEqualToZero = YES;
-            }
-        }
-        if (hasFoundEigenvalueEqualToZero) {
-            // will be semidefinite or indefinite
-            if (hasFoundEigenvalueStrictlyGreaterThanZero && !hasFoundEigenvalueStrictlyLesserThanZero) {
-                _definiteness = MAVMatrixDefinitenessPositiveSemidefinite;
-            } else if (!hasFoundEigenvalueStrictlyGreaterThanZero && hasFoundEigenvalueStrictlyLesserThanZero) {
-                _definiteness = MAVMatrixDefinitenessNegativeSemidefinite;
-            } else {
-                _definiteness = MAVMatrixDefinitenessIndefinite;
+    // the definiteness is a scalar, so it is published with its own barrier rather than through lazyValueForProperty:
+    MAVMatrixDefiniteness cachedDefiniteness = _definiteness;
+    atomic_thread_fence(memory_order_acquire);
+    if (cachedDefiniteness != MAVMatrixDefinitenessUnknown) {
+        return cachedDefiniteness;
+    }
+    
+    if (self.isSymmetric.isYes && [self beginComputingLazyProperty:MAVMatrixLazyPropertyDefiniteness isCached:^BOOL{ return _definiteness != MAVMatrixDefinitenessUnknown; }]) {
+        @try {
+            MAVMatrixDefiniteness definiteness;
+            BOOL hasFoundEigenvalueStrictlyGreaterThanZero = NO;
+            BOOL hasFoundEigenvalueStrictlyLesserThanZero = NO;
+            BOOL hasFoundEigenvalueEqualToZero = NO;
+            MAVVector *eigenvalues = self.eigendecomposition.eigenvalues;
+            for (MAVIndex i = 0; i < eigenvalues.length; i += 1) {
+                NSNumber *eigenvalue = [eigenvalues valueAtIndex:i];
+                if ([eigenvalue compare:@0] == NSOrderedDescending) {
+                    hasFoundEigenvalueStrictlyGreaterThanZero = YES;
+                }
+                else if ([eigenvalue compare:@0] == NSOrderedAscending) {
+                    hasFoundEigenvalueStrictlyLesserThanZero = YES;
+                }
+                else {
+                    hasFoundEigenvalueEqualToZero = YES;
+                }
             }
-        } else {
-            // will be definite or indefinite (but not semidefinite)
-            if (hasFoundEigenvalueStrictlyGreaterThanZero && !hasFoundEigenvalueStrictlyLesserThanZero) {
-                _definiteness = MAVMatrixDefinitenessPositiveDefinite;
-            } else if (!hasFoundEigenvalueStrictlyGreaterThanZero && hasFoundEigenvalueStrictlyLesserThanZero) {
-                _definiteness = MAVMatrixDefinitenessNegativeDefinite;
+            if (hasFoundEigenvalueEqualToZero) {
+                // will be semidefinite or indefinite
+                if (hasFoundEigenvalueStrictlyGreaterThanZero && !hasFoundEigenvalueStrictlyLesserThanZero) {
+                    definiteness = MAVMatrixDefinitenessPositiveSemidefinite;
+                } else if (!hasFoundEigenvalueStrictlyGreaterThanZero && hasFoundEigenvalueStrictlyLesserThanZero) {
+                    definiteness = MAVMatrixDefinitenessNegativeSemidefinite;
+                } else {
+                    definiteness = MAVMatrixDefinitenessIndefinite;
+                }
             } else {
-                _definiteness = MAVMatrixDefinitenessIndefinite;
+                // will be definite or indefinite (but not semidefinite)
+                if (hasFoundEigenvalueStrictlyGreaterThanZero && !hasFoundEigenvalueStrictlyLesserThanZero) {
+                    definiteness = MAVMatrixDefinitenessPositiveDefinite;
+                } else if (!hasFoundEigenvalueStrictlyGreaterThanZero && hasFoundEigenvalueStrictlyLesserThanZero) {
+                    definiteness = MAVMatrixDefinitenessNegativeDefinite;
+                } else {
+                    definiteness = MAVMatrixDefinitenessIndefinite;
+                }
             }
+            atomic_thread_fence(memory_order_release);
+            _definiteness = definiteness;
+        }
+        @finally {
+            [self finishComputingLazyProperty:MAVMatrixLazyPropertyDefiniteness];
         }
     }
     return _definiteness;
@@ -420,7 +601,8 @@
 
 - (MAVVector *)diagonalValues
 {
-    if (_diagonalValues == nil) {
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyDiagonalValues storage:(__strong id *)&_diagonalValues computeBlock:^id{
+        MAVVector *diagonalValues;
         MAVIndex length = MIN(self.rows, self.columns);
         
         if (self[0][0].isDoublePrecision) {
@@ -428,61 +610,57 @@
             for (MAVIndex i = 0; i < length; i += 1) {
                 values[i] = [self valueAtRow:i column:i].doubleValue;
             }
-            _diagonalValues = [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:values length:length * sizeof(double)] length:length vectorFormat:MAVVectorFormatRowVector];
+            diagonalValues = [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:values length:length * sizeof(double)] length:length vectorFormat:MAVVectorFormatRowVector];
         } else {
             float *values = malloc(length * sizeof(float));
             for (MAVIndex i = 0; i < length; i += 1) {
                 values[i] = [self valueAtRow:i column:i].floatValue;
             }
-            _diagonalValues = [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:values length:length * sizeof(float)] length:length vectorFormat:MAVVectorFormatRowVector];
+            diagonalValues = [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:values length:length * sizeof(float)] length:length vectorFormat:MAVVectorFormatRowVector];
         }
-    }
-    return _diagonalValues;
+        return diagonalValues;
+    }];
 }
 
 - (NSNumber *)trace
 {
-    if (_trace == nil) {
-        _trace = self.diagonalValues.sumOfValues;
-    }
-    return _trace;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyTrace storage:(__strong id *)&_trace computeBlock:^id{
+        return self.diagonalValues.sumOfValues;
+    }];
 }
 
 - (NSNumber *)normInfinity
 {
-    if (_normInfinity == nil) {
-        _normInfinity = [self normOfType:MAVMatrixNormInfinity];
-    }
-    return _normInfinity;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyNormInfinity storage:(__strong id *)&_normInfinity computeBlock:^id{
+        return [self normOfType:MAVMatrixNormInfinity];
+    }];
 }
 
 - (NSNumber *)normL1
 {
-    if (_normL1 == nil) {
-        _normL1 = [self normOfType:MAVMatrixNormL1];
-    }
-    return _normL1;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyNormL1 storage:(__strong id *)&_normL1 computeBlock:^id{
+        return [self normOfType:MAVMatrixNormL1];
+    }];
 }
 
 - (NSNumber *)normMax
 {
-    if (_normMax == nil) {
-        _normMax = [self normOfType:MAVMatrixNormMax];
-    }
-    return _normMax;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyNormMax storage:(__strong id *)&_normMax computeBlock:^id{
+        return [self normOfType:MAVMatrixNormMax];
+    }];
 }
 
 - (NSNumber *)normFroebenius
 {
-    if (_normFroebenius == nil) {
-        _normFroebenius = [self normOfType:MAVMatrixNormFroebenius];
-    }
-    return _normFroebenius;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyNormFroebenius storage:(__strong id *)&_normFroebenius computeBlock:^id{
+        return [self normOfType:MAVMatrixNormFroebenius];
+    }];
 }
 
 - (MAVMatrix *)minorMatrix
 {
-    if (_minorMatrix == nil) {
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyMinorMatrix storage:(__strong id *)&_minorMatrix computeBlock:^id{
+        MAVMatrix *minorMatrix;
         if ([self.values containsDoublePrecisionValues:(self.rows * self.columns)]) {
             double *minorValues = malloc(self.rows * self.columns * sizeof(double));
             
@@ -508,10 +686,10 @@
                 }
             }
             
-			_minorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:minorValues length:self.values.length]
-			                                      rows:self.rows
-			                                   columns:self.columns
-			                          leadingDimension:MAVMatrixLeadingDimensionRow];
+			minorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:minorValues length:self.values.length]
+			                                     rows:self.rows
+			                                  columns:self.columns
+			                         leadingDimension:MAVMatrixLeadingDimensionRow];
         } else {
             float *minorValues = malloc(self.rows * self.columns * sizeof(float));
             
@@ -537,20 +715,20 @@
                 }
             }
             
-			_minorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:minorValues length:self.values.length]
-			                                      rows:self.rows
-			                                   columns:self.columns
-			                          leadingDimension:MAVMatrixLeadingDimensionRow];
+			minorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:minorValues length:self.values.length]
+			                                     rows:self.rows
+			                                  columns:self.columns
+			                         leadingDimension:MAVMatrixLeadingDimensionRow];
         }
         
-    }
-    
-    return _minorMatrix;
+        return minorMatrix;
+    }];
 }
 
 - (MAVMatrix *)cofactorMatrix
 {
-    if (_cofactorMatrix == nil) {
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyCofactorMatrix storage:(__strong id *)&_cofactorMatrix computeBlock:^id{
+        MAVMatrix *cofactorMatrix;
         if (self.precision == MCKPrecisionDouble) {
             size_t size = self.rows * self.columns * sizeof(double);
             double *cofactors = malloc(size);
@@ -564,10 +742,10 @@
                 }
             }
             
-			_cofactorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:cofactors length:size]
-			                                         rows:self.rows
-			                                      columns:self.columns
-			                             leadingDimension:MAVMatrixLeadingDimensionRow];
+			cofactorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:cofactors length:size]
+			                                        rows:self.rows
+			                                     columns:self.columns
+			                            leadingDimension:MAVMatrixLeadingDimensionRow];
         } else {
             size_t size = self.rows * self.columns * sizeof(float);
             float *cofactors = malloc(size);
@@ -581,23 +759,20 @@
                 }
             }
             
-			_cofactorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:cofactors length:size]
-			                                         rows:self.rows
-			                                      columns:self.columns
-			                             leadingDimension:MAVMatrixLeadingDimensionRow];
+			cofactorMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:cofactors length:size]
+			                                        rows:self.rows
+			                                     columns:self.columns
+			                            leadingDimension:MAVMatrixLeadingDimensionRow];
         }
-    }
-    
-    return _cofactorMatrix;
+        return cofactorMatrix;
+    }];
 }
 
 - (MAVMatrix *)adjugate
 {
-    if (_adjugate == nil) {
-        _adjugate = self.cofactorMatrix.transpose;
-    }
-    
-    return _adjugate;
+    return [self lazyValueForProperty:MAVMatrixLazyPropertyAdjugate storage:(__strong id *)&_adjugate computeBlock:^id{
+        return self.cofactorMatrix.transpose;
+    }];
 }
 
 #pragma mark - NSObject overrides
@@ -606,16 +781,36 @@
 {
     if (!([otherMatrix isKindOfClass:[MAVMatrix class]] && self.rows == otherMatrix.rows && self.columns == otherMatrix.columns)) {
         return NO;
-    } else {
-        for (MAVIndex row = 0; row < self.rows; row += 1) {
-            for (MAVIndex col = 0; col < self.columns; col += 1) {
-                if ([[self valueAtRow:row column:col] compare:[otherMatrix valueAtRow:row column:col]] != NSOrderedSame) {
-                    return NO;
-                }
-            }
-        }
+    }
+    
+    // identically stored values are equal if their bytes are
+    BOOL hasIdenticalStorage = self.precision == otherMatrix.precision
+    && self.packingMethod == otherMatrix.packingMethod
+    && self.leadingDimension == otherMatrix.leadingDimension
+    && (self.packingMethod == MAVMatrixValuePackingMethodConventional
+        || (self.packingMethod == MAVMatrixValuePackingMethodPacked && self.triangularComponent == otherMatrix.triangularComponent && self.isSymmetric.isYes == otherMatrix.isSymmetric.isYes)
+        || (self.packingMethod == MAVMatrixValuePackingMethodBand && self.bandwidth == otherMatrix.bandwidth && self.upperCodiagonals == otherMatrix.upperCodiagonals));
+    if (hasIdenticalStorage && self.values.length == otherMatrix.values.length
+        && (self.values.bytes == otherMatrix.values.bytes || memcmp(self.values.bytes, otherMatrix.values.bytes, self.values.length) == 0)) {
         return YES;
     }
+    
+    if (self.contentHash != otherMatrix.contentHash) {
+        return NO;
+    }
+    
+    // the hashes collide or the values differ only in their storage or in the sign of zeros, so compare the values
+    NSData *values = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    NSData *otherValues = [otherMatrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    size_t count = (size_t)self.rows * (size_t)self.columns;
+    for (size_t i = 0; i < count; i++) {
+        double value = self.precision == MCKPrecisionDouble ? ((const double *)values.bytes)[i] : ((const float *)values.bytes)[i];
+        double otherValue = otherMatrix.precision == MCKPrecisionDouble ? ((const double *)otherValues.bytes)[i] : ((const float *)otherValues.bytes)[i];
+        if (value != otherValue && !(value != value && otherValue != otherValue)) {
+            return NO;
+        }
+    }
+    return YES;
 }
 
 - (BOOL)isEqual:(id)object
@@ -629,6 +824,11 @@
     }
 }
 
+- (NSUInteger)hash
+{
+    return (NSUInteger)self.contentHash;
+}
+
 - (NSString *)description
 {
     MAVIndex padding;
@@ -678,37 +878,29 @@
             if (self.precision == MCKPrecisionDouble) {
                 size_t size = self.rows * self.columns * sizeof(double);
                 double *values = malloc(size);
+                const double *selfValues = self.values.bytes;
                 if (self.leadingDimension == leadingDimension) {
-                    for (size_t i = 0; i < self.rows * self.columns; i += 1) {
-                        values[i] = ((double *)self.values.bytes)[i];
-                    }
+                    MAVParallelForRanges(self.rows * self.columns, 1, ^(NSRange range) {
+                        memcpy(values + range.location, selfValues + range.location, range.length * sizeof(double));
+                    });
                 } else {
-                    size_t i = 0;
-                    for (MAVIndex j = 0; j < (leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns); j++) {
-                        for (MAVIndex k = 0; k < (leadingDimension == MAVMatrixLeadingDimensionRow ? self.columns : self.rows); k++) {
-                            size_t idx = ((i * (leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns)) % (self.columns * self.rows)) + j;
-                            values[i] = ((double *)self.values.bytes)[idx];
-                            i++;
-                        }
-                    }
+                    size_t lines = self.leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns;
+                    size_t lineLength = self.leadingDimension == MAVMatrixLeadingDimensionRow ? self.columns : self.rows;
+                    MAVTransposeValuesD(selfValues, lines, lineLength, values);
                 }
                 data = [NSData dataWithBytesNoCopy:values length:size];
             } else {
                 size_t size = self.rows * self.columns * sizeof(float);
                 float *values = malloc(size);
+                const float *selfValues = self.values.bytes;
                 if (self.leadingDimension == leadingDimension) {
-                    for (size_t i = 0; i < self.rows * self.columns; i += 1) {
-                        values[i] = ((float *)self.values.bytes)[i];
-                    }
+                    MAVParallelForRanges(self.rows * self.columns, 1, ^(NSRange range) {
+                        memcpy(values + range.location, selfValues + range.location, range.length * sizeof(float));
+                    });
                 } else {
-                    size_t i = 0;
-                    for (MAVIndex j = 0; j < (leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns); j++) {
-                        for (MAVIndex k = 0; k < (leadingDimension == MAVMatrixLeadingDimensionRow ? self.columns : self.rows); k++) {
-                            size_t idx = ((i * (leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns)) % (self.columns * self.rows)) + j;
-                            values[i] = ((float *)self.values.bytes)[idx];
-                            i++;
-                        }
-                    }
+                    size_t lines = self.leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns;
+                    size_t lineLength = self.leadingDimension == MAVMatrixLeadingDimensionRow ? self.columns : self.rows;
+                    MAVTransposeValues(selfValues, lines, lineLength, values);
                 }
                 data = [NSData dataWithBytesNoCopy:values length:size];
             }
@@ -736,71 +928,25 @@
             if (self.precision == MCKPrecisionDouble) {
                 size_t size = self.rows * self.columns * sizeof(double);
                 double *values = malloc(size);
-                size_t k = 0; // current index in ivar array
-                size_t z = 0; // current index in constructing array
-                for (MAVIndex i = 0; i < self.columns; i += 1) {
-                    for (MAVIndex j = 0; j < self.columns; j += 1) {
-                        BOOL shouldTakePackedValue = (self.triangularComponent == MAVMatrixTriangularComponentUpper)
-                        ? (self.leadingDimension == MAVMatrixLeadingDimensionColumn ? j <= i : i <= j)
-                        : (self.leadingDimension == MAVMatrixLeadingDimensionColumn ? i <= j : j <= i);
-                        if (shouldTakePackedValue) {
-                            double value = ((double *)self.values.bytes)[k++];
-                            values[z++] = value;
-                        } else if (self.isSymmetric.isYes) {
-                            double value = [self valueAtRow:i column:j].doubleValue;
-                            values[z++] = value;
-                        } else {
-                            values[z++] = 0.0;
-                        }
-                    }
-                }
-                if (self.leadingDimension != leadingDimension) {
-                    double *cvalues = malloc(self.rows * self.columns * sizeof(double));
-                    size_t i = 0;
-                    for (MAVIndex j = 0; j < self.columns; j++) {
-                        for (MAVIndex row = 0; row < self.rows; row++) {
-                            size_t idx = ((i * self.columns) % (self.columns * self.rows)) + j;
-                            cvalues[i] = values[idx];
-                            i++;
-                        }
-                    }
-                    free(values);
-                    values = cvalues;
+                BOOL heads = MAVTriangleIsMadeOfHeads(self.triangularComponent, self.leadingDimension);
+                MAVUnpackTriangleOfLines(self.values.bytes, self.columns, heads, sizeof(double), values);
+                if (_symmetric.isYes) {
+                    // a symmetric matrix has the same values in either layout; packed storage always knows whether it holds one
+                    MAVMirrorTriangleOfLinesD(values, self.columns, heads);
+                } else if (self.leadingDimension != leadingDimension) {
+                    MAVTransposeSquareValuesInPlaceD(values, self.columns);
                 }
                 data = [NSData dataWithBytesNoCopy:values length:size];
             } else {
                 size_t size = self.rows * self.columns * sizeof(float);
                 float *values = malloc(size);
-                size_t k = 0; // current index in ivar array
-                size_t z = 0; // current index in constructing array
-                for (MAVIndex i = 0; i < self.columns; i += 1) {
-                    for (MAVIndex j = 0; j < self.columns; j += 1) {
-                        BOOL shouldTakePackedValue = (self.triangularComponent == MAVMatrixTriangularComponentUpper)
-                        ? (self.leadingDimension == MAVMatrixLeadingDimensionColumn ? j <= i : i <= j)
-                        : (self.leadingDimension == MAVMatrixLeadingDimensionColumn ? i <= j : j <= i);
-                        if (shouldTakePackedValue) {
-                            float value = ((float *)self.values.bytes)[k++];
-                            values[z++] = value;
-                        } else if (self.isSymmetric.isYes) {
-                            float value = [self valueAtRow:i column:j].floatValue;
-                            values[z++] = value;
-                        } else {
-                            values[z++] = 0.f;
-                        }
-                    }
-                }
-                if (self.leadingDimension != leadingDimension) {
-                    float *cvalues = malloc(self.rows * self.columns * sizeof(float));
-                    size_t i = 0;
-                    for (MAVIndex j = 0; j < self.columns; j++) {
-                        for (MAVIndex row = 0; row < self.rows; row++) {
-                            size_t idx = ((i * self.columns) % (self.columns * self.rows)) + j;
-                            cvalues[i] = values[idx];
-                            i++;
-                        }
-                    }
-                    free(values);
-                    values = cvalues;
+                BOOL heads = MAVTriangleIsMadeOfHeads(self.triangularComponent, self.leadingDimension);
+                MAVUnpackTriangleOfLines(self.values.bytes, self.columns, heads, sizeof(float), values);
+                if (_symmetric.isYes) {
+                    // a symmetric matrix has the same values in either layout; packed storage always knows whether it holds one
+                    MAVMirrorTriangleOfLines(values, self.columns, heads);
+                } else if (self.leadingDimension != leadingDimension) {
+                    MAVTransposeSquareValuesInPlace(values, self.columns);
                 }
                 data = [NSData dataWithBytesNoCopy:values length:size];
             }
@@ -837,31 +983,31 @@
              */
             if (self.precision == MCKPrecisionDouble) {
                 size_t size = self.rows * self.columns * sizeof(double);
-                double *values = malloc(size);
-                for (MAVIndex i = 0; i < self.columns; i += 1) {
-                    for (MAVIndex j = 0; j < self.columns; j += 1) {
-                        size_t indexIntoBandArray = ( i - j + self.upperCodiagonals ) * self.columns + j;
-                        size_t indexIntoUnpackedArray = (leadingDimension == MAVMatrixLeadingDimensionColumn ? j : i) * self.columns + (leadingDimension == MAVMatrixLeadingDimensionColumn ? i : j);
-                        if (indexIntoBandArray < self.bandwidth * self.columns) {
-                            values[indexIntoUnpackedArray] = ((double *)self.values.bytes)[indexIntoBandArray];
-                        } else {
-                            values[indexIntoUnpackedArray] = 0.0;
-                        }
+                double *values = calloc(self.rows * self.columns, sizeof(double));
+                const double *bandValues = self.values.bytes;
+                // each row of the band array holds one diagonal, which is written along the diagonal of the unpacked array
+                MAVIndex n = self.columns;
+                for (MAVIndex band = 0; band < self.bandwidth; band++) {
+                    MAVIndex offset = band - self.upperCodiagonals; // row - column of the values on this diagonal
+                    for (MAVIndex col = MAX(0, -offset); col < MIN(n, n - offset); col++) {
+                        MAVIndex row = col + offset;
+                        size_t indexIntoUnpackedArray = leadingDimension == MAVMatrixLeadingDimensionColumn ? col * n + row : row * n + col;
+                        values[indexIntoUnpackedArray] = bandValues[band * n + col];
                     }
                 }
                 data = [NSData dataWithBytesNoCopy:values length:size];
             } else {
                 size_t size = self.rows * self.columns * sizeof(float);
-                float *values = malloc(size);
-                for (MAVIndex i = 0; i < self.columns; i += 1) {
-                    for (MAVIndex j = 0; j < self.columns; j += 1) {
-                        size_t indexIntoBandArray = ( i - j + self.upperCodiagonals ) * self.columns + j;
-                        size_t indexIntoUnpackedArray = (leadingDimension == MAVMatrixLeadingDimensionColumn ? j : i) * self.columns + (leadingDimension == MAVMatrixLeadingDimensionColumn ? i : j);
-                        if (indexIntoBandArray < self.bandwidth * self.columns) {
-                            values[indexIntoUnpackedArray] = ((float *)self.values.bytes)[indexIntoBandArray];
-                        } else {
-                            values[indexIntoUnpackedArray] = 0.0f;
-                        }
+                float *values = calloc(self.rows * self.columns, sizeof(float));
+                const float *bandValues = self.values.bytes;
+                // each row of the band array holds one diagonal, which is written along the diagonal of the unpacked array
+                MAVIndex n = self.columns;
+                for (MAVIndex band = 0; band < self.bandwidth; band++) {
+                    MAVIndex offset = band - self.upperCodiagonals; // row - column of the values on this diagonal
+                    for (MAVIndex col = MAX(0, -offset); col < MIN(n, n - offset); col++) {
+                        MAVIndex row = col + offset;
+                        size_t indexIntoUnpackedArray = leadingDimension == MAVMatrixLeadingDimensionColumn ? col * n + row : row * n + col;
+                        values[indexIntoUnpackedArray] = bandValues[band * n + col];
                     }
                 }
                 data = [NSData dataWithBytesNoCopy:values length:size];
@@ -882,51 +1028,19 @@
     
     NSData *data;
     
-    size_t numberOfValues = packingMethod == MAVMatrixValuePackingMethodPacked ? ((self.rows * (self.rows + 1)) / 2) : self.rows * self.rows;
-    size_t i = 0;
-    MAVIndex outerLimit = self.leadingDimension == MAVMatrixLeadingDimensionRow ? self.rows : self.columns;
-    MAVIndex innerLimit = self.leadingDimension == MAVMatrixLeadingDimensionRow ? self.columns : self.rows;
-    
-    if (self.precision == MCKPrecisionDouble) {
-        size_t size = numberOfValues * sizeof(double);
-        double *values = malloc(size);
-        for (MAVIndex j = 0; j < outerLimit; j++) {
-            for (MAVIndex k = 0; k < innerLimit; k++) {
-                MAVIndex row = leadingDimension == MAVMatrixLeadingDimensionRow ? j : k;
-                MAVIndex col = leadingDimension == MAVMatrixLeadingDimensionRow ? k : j;
-                
-                BOOL shouldStoreValueForLowerTriangle = triangularComponent == MAVMatrixTriangularComponentLower && col <= row;
-                BOOL shouldStoreValueForUpperTriangle = triangularComponent == MAVMatrixTriangularComponentUpper && row <= col;
-                
-                if (shouldStoreValueForLowerTriangle || shouldStoreValueForUpperTriangle) {
-                    double value = [self valueAtRow:row column:col].doubleValue;
-                    values[i++] = value;
-                } else if (packingMethod == MAVMatrixValuePackingMethodConventional) {
-                    values[i++] = 0.0;
-                }
-            }
-        }
+    // extract the heads or tails of the lines of the values in the requested layout
+    NSData *conventionalValues = [self valuesWithLeadingDimension:leadingDimension];
+    size_t elementSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    BOOL heads = MAVTriangleIsMadeOfHeads(triangularComponent, leadingDimension);
+    if (packingMethod == MAVMatrixValuePackingMethodPacked) {
+        size_t size = (self.rows * (self.rows + 1)) / 2 * elementSize;
+        void *values = malloc(size);
+        MAVPackTriangleOfLines(conventionalValues.bytes, self.rows, heads, elementSize, values);
         data = [NSData dataWithBytesNoCopy:values length:size];
     } else {
-        size_t size = numberOfValues * sizeof(float);
-        float *values = malloc(size);
-        for (MAVIndex j = 0; j < outerLimit; j++) {
-            for (MAVIndex k = 0; k < innerLimit; k++) {
-                MAVIndex row = leadingDimension == MAVMatrixLeadingDimensionRow ? j : k;
-                MAVIndex col = leadingDimension == MAVMatrixLeadingDimensionRow ? k : j;
-                
-                BOOL shouldStoreValueForLowerTriangle = triangularComponent == MAVMatrixTriangularComponentLower && col <= row;
-                BOOL shouldStoreValueForUpperTriangle = triangularComponent == MAVMatrixTriangularComponentUpper && row <= col;
-                
-                if (shouldStoreValueForLowerTriangle || shouldStoreValueForUpperTriangle) {
-                    float value = [self valueAtRow:row column:col].floatValue;
-                    values[i++] = value;
-                } else if (packingMethod == MAVMatrixValuePackingMethodConventional) {
-                    values[i++] = 0.0f;
-                }
-            }
-        }
-        data = [NSData dataWithBytesNoCopy:values length:size];
+        NSMutableData *values = [conventionalValues mutableCopy];
+        MAVZeroOutsideTriangleOfLines(values.mutableBytes, self.rows, heads, elementSize);
+        data = values;
     }
     
     return data;
@@ -1154,6 +1268,18 @@
     return vectors;
 }
 
+#pragma mark - Symmetric products
+
+- (MAVMatrix *)gramMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod
+{
+    return [self gramMatrixOfColumns:YES packingMethod:packingMethod];
+}
+
+- (MAVMatrix *)outerGramMatrixWithPackingMethod:(MAVMatrixValuePackingMethod)packingMethod
+{
+    return [self gramMatrixOfColumns:NO packingMethod:packingMethod];
+}
+
 #pragma mark - Subscripting
 
 - (MAVVector *)objectAtIndexedSubscript:(MAVIndex)idx
@@ -1170,6 +1296,28 @@
 {
     NSAssert(A.precision == B.precision, @"Precisions do not match.");
     
+    MAVMatrixTriangularComponent triangularComponent = [A inferredTriangularComponent];
+    if (triangularComponent != MAVMatrixTriangularComponentBoth) {
+        // solve for triangular matrix A by forward or back substitution
+        return [self solveTriangularLinearSystemWithMatrixA:A valuesB:B triangularComponent:triangularComponent];
+    }
+    
+    if (A.rows == A.columns && A.rows <= MAV_FIXED_SIZE_MAX_ORDER) {
+        // solve for small square matrix A in closed form, unless it is too ill-conditioned and needs a pivoted factorization
+        MAVVector *solution = [self solveFixedSizeLinearSystemWithMatrixA:A valuesB:B];
+        if (solution != nil) {
+            return solution;
+        }
+    }
+    
+    if (A.rows == A.columns && (A.positiveSemidefinite.isYes || [A cachedValueForProperty:MAVMatrixLazyPropertyCholeskyFactorization] != nil)) {
+        // solve for symmetric positive definite matrix A with its (possibly updated) Cholesky factorization, falling back to LU if A is singular
+        MAVVector *solution = [self solvePositiveDefiniteLinearSystemWithMatrixA:A valuesB:B];
+        if (solution != nil) {
+            return solution;
+        }
+    }
+    
     MAVVector *coefficientVector;
     
     NSData *aData = [A valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
@@ -1177,17 +1325,17 @@
     if (A.rows == A.columns) {
         // solve for square matrix A
         
-        MAVIndex n = A.rows;
-        MAVIndex nrhs = 1;
-        MAVIndex lda = n;
-        MAVIndex ldb = n;
-        MAVIndex info;
-        MAVIndex *ipiv = malloc(n * sizeof(MAVIndex));
+        MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(A.rows);
+        MAVLAPACKInteger nrhs = 1;
+        MAVLAPACKInteger lda = n;
+        MAVLAPACKInteger ldb = n;
+        MAVLAPACKInteger info;
+        MAVLAPACKInteger *ipiv = malloc(n * sizeof(MAVLAPACKInteger));
         MAVIndex nb = B.length;
         
         if (A.precision == MCKPrecisionDouble) {
-            double *a = malloc(n * n * sizeof(double));
-            for (size_t i = 0; i < n * n; i++) {
+            double *a = malloc((size_t)n * n * sizeof(double));
+            for (size_t i = 0; i < (size_t)n * n; i++) {
                 a[i] = ((double*)aData.bytes)[i];
             }
             double *b = malloc(nb * sizeof(double));
@@ -1214,8 +1362,8 @@
 				coefficientVector = [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:solutionValues length:size] length:n];
             }
         } else {
-            float *a = malloc(n * n * sizeof(float));
-            for (size_t i = 0; i < n * n; i++) {
+            float *a = malloc((size_t)n * n * sizeof(float));
+            for (size_t i = 0; i < (size_t)n * n; i++) {
                 a[i] = ((float*)aData.bytes)[i];
             }
             float *b = malloc(nb * sizeof(float));
@@ -1257,20 +1405,20 @@
          minimum norm solution vectors;
          */
         
-        MAVIndex m = A.rows;
-        MAVIndex n = A.columns;
-        MAVIndex nrhs = 1;
-        MAVIndex lda = A.rows;
-        MAVIndex ldb = A.rows;
-        MAVIndex info;
-        MAVIndex lwork = -1;
+        MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(A.rows);
+        MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(A.columns);
+        MAVLAPACKInteger nrhs = 1;
+        MAVLAPACKInteger lda = m;
+        MAVLAPACKInteger ldb = m;
+        MAVLAPACKInteger info;
+        MAVLAPACKInteger lwork = -1;
         MAVIndex nb = B.length;
         
         if (A.precision == MCKPrecisionDouble) {
             double wkopt;
             double* work;
-            double *a = malloc(m * n * sizeof(double));
-            for (size_t i = 0; i < m * n; i++) {
+            double *a = malloc((size_t)m * n * sizeof(double));
+            for (size_t i = 0; i < (size_t)m * n; i++) {
                 a[i] = ((double *)aData.bytes)[i];
             }
             double *b = malloc(nb * sizeof(double));
@@ -1281,7 +1429,7 @@
             // get the optimal workspace
             dgels_("No transpose", &m, &n, &nrhs, a, &lda, b, &ldb, &wkopt, &lwork, &info);
             
-            lwork = (MAVIndex)wkopt;
+            lwork = (MAVLAPACKInteger)wkopt;
             work = (double*)malloc(lwork * sizeof(double));
             
             // solve the system of equations
@@ -1306,8 +1454,8 @@
         } else {
             float wkopt;
             float* work;
-            float *a = malloc(m * n * sizeof(float));
-            for (MAVIndex i = 0; i < m * n; i++) {
+            float *a = malloc((size_t)m * n * sizeof(float));
+            for (MAVIndex i = 0; i < (MAVIndex)m * n; i++) {
                 a[i] = ((float *)aData.bytes)[i];
             }
             float *b = malloc(nb * sizeof(float));
@@ -1318,7 +1466,7 @@
             // get the optimal workspace
             sgels_("No transpose", &m, &n, &nrhs, a, &lda, b, &ldb, &wkopt, &lwork, &info);
             
-            lwork = (MAVIndex)wkopt;
+            lwork = (MAVLAPACKInteger)wkopt;
             work = (float*)malloc(lwork * sizeof(float));
             
             // solve the system of equations
@@ -1346,69 +1494,307 @@
     return coefficientVector;
 }
 
-+ (MAVMatrix *)productOfMatrices:(NSArray *)matrices
-{
-    // TODO: implement hu-shing partitioning algorithm
-    
-    return nil;
-}
-
-#pragma mark - NSCopying
-
-- (id)copyWithZone:(NSZone *)zone
++ (MAVVector *)solveLinearSystemUsingMixedPrecisionWithMatrixA:(MAVMatrix *)A
+                                                       valuesB:(MAVVector *)B
+                                          refinementIterations:(MAVIndex *)refinementIterations
+                                  didFallBackToDoublePrecision:(BOOL *)didFallBackToDoublePrecision
 {
-    MAVMatrix *matrixCopy = [[self class] allocWithZone:zone];
+    NSAssert(A.rows == A.columns, @"Mixed-precision solves require a square matrix A.");
+    NSAssert(B.length == A.rows, @"B must have one value per row of A.");
+    NSAssert(A.precision == MCKPrecisionDouble && B.precision == MCKPrecisionDouble, @"Mixed-precision solves refine toward double precision, so A and B must be double precision.");
     
-    [self deepCopyMatrix:self intoNewMatrix:matrixCopy mutable:NO];
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(A.rows);
+    MAVLAPACKInteger nrhs = 1;
+    MAVLAPACKInteger lda = n;
+    MAVLAPACKInteger ldb = n;
+    MAVLAPACKInteger ldx = n;
+    MAVLAPACKInteger iter = 0;
+    MAVLAPACKInteger info = 0;
     
-    return matrixCopy;
-}
-
-#pragma mark - NSMutableCopying
-
-- (id)mutableCopyWithZone:(NSZone *)zone
-{
-    MAVMutableMatrix *mutableCopy = [MAVMutableMatrix allocWithZone:zone];
+    // the routines overwrite a with a factorization, so always work on a copy
+    NSData *aData = [A valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    double *a = (double *)aData.bytes;
     
-    [self deepCopyMatrix:self intoNewMatrix:mutableCopy mutable:YES];
+    size_t size = n * sizeof(double);
+    double *b = malloc(size);
+    for (MAVIndex i = 0; i < n; i++) {
+        b[i] = ((double *)B.values.bytes)[i];
+    }
+    double *x = malloc(size);
+    double *work = malloc(n * nrhs * sizeof(double));
+    float *swork = malloc((size_t)n * (n + nrhs) * sizeof(float));
+    
+    BOOL solved = NO;
+    if (A.positiveSemidefinite.isYes) {
+        dsposv_("U", &n, &nrhs, a, &lda, b, &ldb, x, &ldx, work, swork, &iter, &info);
+        
+        // info > 0 means A is not positive definite, so retry with LU on a fresh copy of A
+        solved = info == 0;
+        if (!solved) {
+            aData = [A valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+            a = (double *)aData.bytes;
+        }
+    }
+    if (!solved) {
+        MAVLAPACKInteger *ipiv = malloc(n * sizeof(MAVLAPACKInteger));
+        dsgesv_(&n, &nrhs, a, &lda, ipiv, b, &ldb, x, &ldx, work, swork, &iter, &info);
+        free(ipiv);
+    }
+    
+    free(b);
+    free(work);
+    free(swork);
+    
+    // iter < 0 means the single-precision factorization failed or refinement stalled, and the solution came from a double-precision factorization
+    if (refinementIterations != NULL) {
+        *refinementIterations = MAX(iter, 0);
+    }
+    if (didFallBackToDoublePrecision != NULL) {
+        *didFallBackToDoublePrecision = iter < 0;
+    }
+    
+    if (info != 0) {
+        free(x);
+        return nil;
+    }
+    
+    return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:x length:size] length:n];
+}
+
++ (MAVMatrix *)productOfMatrices:(NSArray *)matrices
+{
+    // TODO: implement hu-shing partitioning algorithm
+    
+    return nil;
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    MAVMatrix *matrixCopy = [[[self class] allocWithZone:zone] init];
+    
+    [self copyMatrix:self intoNewMatrix:matrixCopy];
+    
+    return matrixCopy;
+}
+
+#pragma mark - NSMutableCopying
+
+- (id)mutableCopyWithZone:(NSZone *)zone
+{
+    MAVMutableMatrix *mutableCopy = [[MAVMutableMatrix allocWithZone:zone] init];
+    
+    [self copyMatrix:self intoNewMatrix:mutableCopy];
     
     return mutableCopy;
 }
 
-#pragma mark - Private interface
+#pragma mark - NSSecureCoding
 
-- (void)deepCopyMatrix:(MAVMatrix *)matrix intoNewMatrix:(MAVMatrix *)newMatrix mutable:(BOOL)mutable
++ (BOOL)supportsSecureCoding
 {
-    newMatrix->_columns = matrix->_columns;
-    newMatrix->_rows = matrix->_rows;
-    newMatrix->_leadingDimension = matrix->_leadingDimension;
-    newMatrix->_triangularComponent = matrix->_triangularComponent;
-    newMatrix->_packingMethod = matrix->_packingMethod;
-    newMatrix->_definiteness = matrix->_definiteness;
-    newMatrix->_precision = matrix->_precision;
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    // values are archived in their raw storage layout, with no boxing or expansion of packed and band storage
+    [aCoder encodeObject:self.values forKey:MAVMatrixValuesKey];
+    [aCoder encodeInt64:self.rows forKey:MAVMatrixRowsKey];
+    [aCoder encodeInt64:self.columns forKey:MAVMatrixColumnsKey];
+    [aCoder encodeInt32:self.leadingDimension forKey:MAVMatrixLeadingDimensionKey];
+    [aCoder encodeInt32:self.packingMethod forKey:MAVMatrixPackingMethodKey];
+    [aCoder encodeInt32:self.triangularComponent forKey:MAVMatrixTriangularComponentKey];
+    [aCoder encodeInt32:self.precision forKey:MAVMatrixPrecisionKey];
+    if (self.packingMethod == MAVMatrixValuePackingMethodBand) {
+        [aCoder encodeInt64:self.upperCodiagonals forKey:MAVMatrixUpperCodiagonalsKey];
+        [aCoder encodeInt64:self.bandwidth forKey:MAVMatrixBandwidthKey];
+    }
     
-    if (_precision == MCKPrecisionDouble) {
-        double *values = malloc(matrix->_values.length);
-        for (MAVIndex i = 0; i < matrix->_values.length / sizeof(double); i++) {
-            values[i] = ((double *)matrix->_values.bytes)[i];
-        }
-        if ( mutable ) {
-            newMatrix->_values = [NSMutableData dataWithBytesNoCopy:values length:matrix->_values.length];
-        } else {
-            newMatrix->_values = [NSData dataWithBytesNoCopy:values length:matrix->_values.length];
-        }
-    } else {
-        float *values = malloc(matrix->_values.length);
-        for (MAVIndex i = 0; i < matrix->_values.length / sizeof(float); i++) {
-            values[i] = ((float *)matrix->_values.bytes)[i];
+    // cheap structural knowledge is always kept; reading the instance variables never triggers a computation
+    [aCoder encodeInt32:_symmetric.triboolValue forKey:MAVMatrixSymmetricKey];
+    [aCoder encodeInt32:_positiveSemidefinite.triboolValue forKey:MAVMatrixPositiveSemidefiniteKey];
+    [aCoder encodeInt32:_definiteness forKey:MAVMatrixDefinitenessKey];
+    
+    [aCoder encodeBool:self.archivesFactorizations forKey:MAVMatrixArchivesFactorizationsKey];
+    if (self.archivesFactorizations) {
+        [aCoder encodeObject:_qrFactorization forKey:MAVMatrixQRFactorizationKey];
+        [aCoder encodeObject:_luFactorization forKey:MAVMatrixLUFactorizationKey];
+        [aCoder encodeObject:_choleskyFactorization forKey:MAVMatrixCholeskyFactorizationKey];
+        [aCoder encodeObject:_singularValueDecomposition forKey:MAVMatrixSingularValueDecompositionKey];
+        [aCoder encodeObject:_eigendecomposition forKey:MAVMatrixEigendecompositionKey];
+        [aCoder encodeObject:_inverse forKey:MAVMatrixInverseKey];
+        [aCoder encodeObject:_determinant forKey:MAVMatrixDeterminantKey];
+        [aCoder encodeObject:_conditionNumber forKey:MAVMatrixConditionNumberKey];
+    }
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    NSData *values = [aDecoder decodeObjectOfClass:[NSData class] forKey:MAVMatrixValuesKey];
+    int64_t rows = [aDecoder decodeInt64ForKey:MAVMatrixRowsKey];
+    int64_t columns = [aDecoder decodeInt64ForKey:MAVMatrixColumnsKey];
+    int32_t leadingDimension = [aDecoder decodeInt32ForKey:MAVMatrixLeadingDimensionKey];
+    int32_t packingMethod = [aDecoder decodeInt32ForKey:MAVMatrixPackingMethodKey];
+    int32_t triangularComponent = [aDecoder decodeInt32ForKey:MAVMatrixTriangularComponentKey];
+    int32_t precision = [aDecoder decodeInt32ForKey:MAVMatrixPrecisionKey];
+    int64_t upperCodiagonals = [aDecoder decodeInt64ForKey:MAVMatrixUpperCodiagonalsKey];
+    int64_t bandwidth = [aDecoder decodeInt64ForKey:MAVMatrixBandwidthKey];
+    int32_t definiteness = [aDecoder decodeInt32ForKey:MAVMatrixDefinitenessKey];
+    
+    // archives may come from anywhere, so refuse any whose structure disagrees with its values
+    if (![self isValidArchivedMatrixWithValues:values
+                                          rows:rows
+                                       columns:columns
+                              leadingDimension:leadingDimension
+                                 packingMethod:packingMethod
+                           triangularComponent:triangularComponent
+                                     precision:precision
+                              upperCodiagonals:upperCodiagonals
+                                     bandwidth:bandwidth]
+        || definiteness < 0 || definiteness > MAVMatrixDefinitenessUnknown) {
+        return nil;
+    }
+    
+    self = [self initWithValues:values
+                           rows:(MAVIndex)rows
+                        columns:(MAVIndex)columns
+               leadingDimension:(MAVMatrixLeadingDimension)leadingDimension
+                  packingMethod:(MAVMatrixValuePackingMethod)packingMethod
+            triangularComponent:(MAVMatrixTriangularComponent)triangularComponent];
+    if (self) {
+        _precision = (MCKPrecision)precision;
+        if (packingMethod == MAVMatrixValuePackingMethodBand) {
+            _upperCodiagonals = (MAVIndex)upperCodiagonals;
+            _bandwidth = (MAVIndex)bandwidth;
+            _numberOfBandValues = (MAVIndex)(bandwidth * rows);
         }
-        if ( mutable ) {
-            newMatrix->_values = [NSMutableData dataWithBytesNoCopy:values length:matrix->_values.length];
-        } else {
-            newMatrix->_values = [NSData dataWithBytesNoCopy:values length:matrix->_values.length];
+        
+        _symmetric = [self decodeTriboolForKey:MAVMatrixSymmetricKey coder:aDecoder];
+        _positiveSemidefinite = [self decodeTriboolForKey:MAVMatrixPositiveSemidefiniteKey coder:aDecoder];
+        _definiteness = (MAVMatrixDefiniteness)definiteness;
+        
+        _archivesFactorizations = [aDecoder decodeBoolForKey:MAVMatrixArchivesFactorizationsKey];
+        if (_archivesFactorizations) {
+            _qrFactorization = [aDecoder decodeObjectOfClass:[MAVQRFactorization class] forKey:MAVMatrixQRFactorizationKey];
+            _luFactorization = [aDecoder decodeObjectOfClass:[MAVLUFactorization class] forKey:MAVMatrixLUFactorizationKey];
+            _choleskyFactorization = [aDecoder decodeObjectOfClass:[MAVCholeskyFactorization class] forKey:MAVMatrixCholeskyFactorizationKey];
+            _singularValueDecomposition = [aDecoder decodeObjectOfClass:[MAVSingularValueDecomposition class] forKey:MAVMatrixSingularValueDecompositionKey];
+            _eigendecomposition = [aDecoder decodeObjectOfClass:[MAVEigendecomposition class] forKey:MAVMatrixEigendecompositionKey];
+            _inverse = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:MAVMatrixInverseKey];
+            _determinant = [aDecoder decodeObjectOfClass:[NSNumber class] forKey:MAVMatrixDeterminantKey];
+            _conditionNumber = [aDecoder decodeObjectOfClass:[NSNumber class] forKey:MAVMatrixConditionNumberKey];
         }
     }
+    return self;
+}
+
+#pragma mark - Private interface
+
+/**
+ @return YES if the structure decoded from an archive describes a matrix whose storage holds exactly the archived values, NO otherwise.
+ */
+- (BOOL)isValidArchivedMatrixWithValues:(NSData *)values
+                                   rows:(int64_t)rows
+                                columns:(int64_t)columns
+                       leadingDimension:(int32_t)leadingDimension
+                          packingMethod:(int32_t)packingMethod
+                    triangularComponent:(int32_t)triangularComponent
+                              precision:(int32_t)precision
+                       upperCodiagonals:(int64_t)upperCodiagonals
+                              bandwidth:(int64_t)bandwidth
+{
+    if (values == nil || rows < 0 || columns < 0
+        || (leadingDimension != MAVMatrixLeadingDimensionRow && leadingDimension != MAVMatrixLeadingDimensionColumn)
+        || (triangularComponent != MAVMatrixTriangularComponentUpper && triangularComponent != MAVMatrixTriangularComponentLower && triangularComponent != MAVMatrixTriangularComponentBoth)
+        || (precision != MCKPrecisionSingle && precision != MCKPrecisionDouble)) {
+        return NO;
+    }
+    
+    // the archived values bound the number of values the structure may describe, so counting them cannot overflow
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    if (values.length % valueSize != 0) {
+        return NO;
+    }
+    uint64_t archivedValues = values.length / valueSize;
+    
+    uint64_t numberOfValues;
+    switch (packingMethod) {
+        case MAVMatrixValuePackingMethodConventional:
+            if (columns > 0 && (uint64_t)rows > archivedValues / (uint64_t)columns) {
+                return NO;
+            }
+            numberOfValues = (uint64_t)(rows * columns);
+            break;
+            
+        case MAVMatrixValuePackingMethodPacked:
+            if (rows != columns || triangularComponent == MAVMatrixTriangularComponentBoth) {
+                return NO;
+            }
+            if (rows > 0 && (uint64_t)rows + 1 > UINT64_MAX / (uint64_t)rows) {
+                return NO;
+            }
+            numberOfValues = (uint64_t)rows * ((uint64_t)rows + 1) / 2;
+            break;
+            
+        case MAVMatrixValuePackingMethodBand:
+            if (rows != columns || upperCodiagonals < 0 || bandwidth <= upperCodiagonals || (rows > 0 && (upperCodiagonals >= rows || bandwidth - upperCodiagonals - 1 >= rows))) {
+                return NO;
+            }
+            if (rows > 0 && (uint64_t)bandwidth > archivedValues / (uint64_t)rows) {
+                return NO;
+            }
+            numberOfValues = (uint64_t)(bandwidth * rows);
+            break;
+            
+        default:
+            return NO;
+    }
     
+    return archivedValues == numberOfValues;
+}
+
+/**
+ @return The tribool archived under key, or an unknown tribool if the archived value is not a tribool value.
+ */
+- (MCKTribool *)decodeTriboolForKey:(NSString *)key coder:(NSCoder *)aDecoder
+{
+    int32_t value = [aDecoder decodeInt32ForKey:key];
+    if (value != MCKTriboolValueYes && value != MCKTriboolValueNo) {
+        value = MCKTriboolValueUnknown;
+    }
+    return [MCKTribool triboolWithValue:(MCKTriboolValue)value];
+}
+
+- (MAVMatrix *)copyWithoutCachedProperties
+{
+    MAVMatrix *matrixCopy = [[MAVMatrix alloc] init];
+    
+    [self copyValuesOfMatrix:self intoNewMatrix:matrixCopy];
+    
+    return matrixCopy;
+}
+
+- (BOOL)sharesValuesWithMatrix:(MAVMatrix *)matrix
+{
+    // a buffer only has several owners until one of them writes to it, so owners with the same storage format hold the same matrix
+    return matrix != nil
+        && _valueBuffer == matrix->_valueBuffer
+        && _rows == matrix->_rows
+        && _columns == matrix->_columns
+        && _leadingDimension == matrix->_leadingDimension
+        && _packingMethod == matrix->_packingMethod
+        && _triangularComponent == matrix->_triangularComponent
+        && _bandwidth == matrix->_bandwidth
+        && _upperCodiagonals == matrix->_upperCodiagonals;
+}
+
+- (void)copyMatrix:(MAVMatrix *)matrix intoNewMatrix:(MAVMatrix *)newMatrix
+{
+    [self copyValuesOfMatrix:matrix intoNewMatrix:newMatrix];
+    
+    newMatrix->_definiteness = matrix->_definiteness;
     newMatrix->_transpose = matrix->_transpose.copy;
     newMatrix->_determinant = matrix->_determinant.copy;
     newMatrix->_inverse = matrix->_inverse.copy;
@@ -1416,12 +1802,13 @@
     newMatrix->_conditionNumber = matrix->_conditionNumber.copy;
     newMatrix->_qrFactorization = matrix->_qrFactorization.copy;
     newMatrix->_luFactorization = matrix->_luFactorization.copy;
+    newMatrix->_choleskyFactorization = matrix->_choleskyFactorization.copy;
     newMatrix->_singularValueDecomposition = matrix->_singularValueDecomposition.copy;
     newMatrix->_eigendecomposition = matrix->_eigendecomposition.copy;
     newMatrix->_diagonalValues = matrix->_diagonalValues.copy;
     newMatrix->_minorMatrix = matrix->_minorMatrix.copy;
     newMatrix->_cofactorMatrix = matrix->_cofactorMatrix.copy;
-    newMatrix->_symmetric = matrix->_symmetric.copy;
+    newMatrix->_positiveSemidefinite = matrix->_positiveSemidefinite.copy;
     newMatrix->_isIdentity = matrix->_isIdentity.copy;
     newMatrix->_isZero = matrix->_isZero.copy;
     newMatrix->_trace = matrix->_trace.copy;
@@ -1429,34 +1816,818 @@
     newMatrix->_normL1 = matrix->_normL1.copy;
     newMatrix->_normFroebenius = matrix->_normFroebenius.copy;
     newMatrix->_normMax = matrix->_normMax.copy;
+}
+
+// copies the dimensions, storage format and values of a matrix, but none of the properties computed from them
+- (void)copyValuesOfMatrix:(MAVMatrix *)matrix intoNewMatrix:(MAVMatrix *)newMatrix
+{
+    newMatrix->_columns = matrix->_columns;
+    newMatrix->_rows = matrix->_rows;
+    newMatrix->_leadingDimension = matrix->_leadingDimension;
+    newMatrix->_triangularComponent = matrix->_triangularComponent;
+    newMatrix->_packingMethod = matrix->_packingMethod;
+    // packed storage mirrors its values only if the matrix is symmetric, so the flag is part of the storage format
+    newMatrix->_symmetric = matrix->_symmetric.copy;
+    newMatrix->_precision = matrix->_precision;
+    newMatrix->_archivesFactorizations = matrix->_archivesFactorizations;
+    newMatrix->_contentHash = matrix->_contentHash;
+    newMatrix->_hasContentHash = matrix->_hasContentHash;
     
     newMatrix->_bandwidth = matrix->_bandwidth;
     newMatrix->_numberOfBandValues = matrix->_numberOfBandValues;
     newMatrix->_upperCodiagonals = matrix->_upperCodiagonals;
+    
+    // share the values; whichever matrix mutates them first copies them
+    [newMatrix->_valueBuffer relinquish];
+    newMatrix->_valueBuffer = [matrix->_valueBuffer sharedBuffer];
 }
 
-+ (NSData *)randomArrayOfSize:(size_t)size
-                    precision:(MCKPrecision)precision
+- (id)lazyValueForProperty:(MAVMatrixLazyProperty)property
+                   storage:(__strong id *)storage
+              computeBlock:(id (^)(void))computeBlock
 {
-    NSData *data;
+    return [self lazyValueForProperty:property storage:storage isTribool:NO computeBlock:computeBlock];
+}
+
+- (MCKTribool *)lazyTriboolForProperty:(MAVMatrixLazyProperty)property
+                               storage:(__strong id *)storage
+                          computeBlock:(id (^)(void))computeBlock
+{
+    return [self lazyValueForProperty:property storage:storage isTribool:YES computeBlock:computeBlock];
+}
+
+- (id)lazyValueForProperty:(MAVMatrixLazyProperty)property
+                   storage:(__strong id *)storage
+                 isTribool:(BOOL)isTribool
+              computeBlock:(id (^)(void))computeBlock
+{
+    // published values are never modified afterwards, so once one is visible it can be returned without locking
+    id value = *storage;
+    atomic_thread_fence(memory_order_acquire);
+    if (MAVLazyValueIsCached(value, isTribool)) {
+        return value;
+    }
     
-    if (precision == MCKPrecisionDouble) {
-        size_t dataSize = size * sizeof(double);
-        double *values = malloc(dataSize);
-        for (MAVIndex i = 0; i < size; i += 1) {
-            values[i] = [NSNumber mck_randomDouble].doubleValue;
+    if (![self beginComputingLazyProperty:property isCached:^BOOL{ return MAVLazyValueIsCached(*storage, isTribool); }]) {
+        return *storage;
+    }
+    
+    // clear the in-flight bit even if the computation raises, so that waiting readers wake up and retry instead of blocking forever
+    @try {
+        // equal matrices computed elsewhere in the process may have left the value in the shared cache
+        MAVFactorizationCache *cache = [MAVFactorizationCache cachesProperty:property] ? [MAVFactorizationCache sharedCache] : nil;
+        BOOL usesCache = cache.isEnabled;
+        value = usesCache ? [cache objectForMatrix:self property:property] : nil;
+        if (value == nil) {
+            value = computeBlock();
+            if (usesCache && value != nil) {
+                [cache setObject:value forMatrix:self property:property];
+            }
+        }
+        
+        // make the fully constructed value visible before the pointer to it
+        atomic_thread_fence(memory_order_release);
+        *storage = value;
+    }
+    @finally {
+        [self finishComputingLazyProperty:property];
+    }
+    
+    return value;
+}
+
+- (id)cachedValueForProperty:(MAVMatrixLazyProperty)property
+{
+    id value;
+    switch (property) {
+        case MAVMatrixLazyPropertyTranspose:
+            value = _transpose;
+            break;
+            
+        case MAVMatrixLazyPropertyDeterminant:
+            value = _determinant;
+            break;
+            
+        case MAVMatrixLazyPropertyInverse:
+            value = _inverse;
+            break;
+            
+        case MAVMatrixLazyPropertyConditionNumber:
+            value = _conditionNumber;
+            break;
+            
+        case MAVMatrixLazyPropertyQRFactorization:
+            value = _qrFactorization;
+            break;
+            
+        case MAVMatrixLazyPropertyLUFactorization:
+            value = _luFactorization;
+            break;
+            
+        case MAVMatrixLazyPropertyCholeskyFactorization:
+            value = _choleskyFactorization;
+            break;
+            
+        case MAVMatrixLazyPropertySingularValueDecomposition:
+            value = _singularValueDecomposition;
+            break;
+            
+        case MAVMatrixLazyPropertyEigendecomposition:
+            value = _eigendecomposition;
+            break;
+            
+        case MAVMatrixLazyPropertyDiagonalValues:
+            value = _diagonalValues;
+            break;
+            
+        case MAVMatrixLazyPropertyTrace:
+            value = _trace;
+            break;
+            
+        case MAVMatrixLazyPropertyNormInfinity:
+            value = _normInfinity;
+            break;
+            
+        case MAVMatrixLazyPropertyNormL1:
+            value = _normL1;
+            break;
+            
+        case MAVMatrixLazyPropertyNormMax:
+            value = _normMax;
+            break;
+            
+        case MAVMatrixLazyPropertyNormFroebenius:
+            value = _normFroebenius;
+            break;
+            
+        case MAVMatrixLazyPropertyMinorMatrix:
+            value = _minorMatrix;
+            break;
+            
+        case MAVMatrixLazyPropertyCofactorMatrix:
+            value = _cofactorMatrix;
+            break;
+            
+        case MAVMatrixLazyPropertyAdjugate:
+            value = _adjugate;
+            break;
+            
+        // tribools are only cached once they are known
+        case MAVMatrixLazyPropertySymmetric:
+            return MAVLazyValueIsCached(_symmetric, YES) ? _symmetric : nil;
+            
+        case MAVMatrixLazyPropertyZero:
+            return MAVLazyValueIsCached(_isZero, YES) ? _isZero : nil;
+            
+        case MAVMatrixLazyPropertyIdentity:
+            return MAVLazyValueIsCached(_isIdentity, YES) ? _isIdentity : nil;
+            
+        case MAVMatrixLazyPropertyDefiniteness:
+            return _definiteness == MAVMatrixDefinitenessUnknown ? nil : @(_definiteness);
+    }
+    
+    // pairs with the release fence that publishes the value
+    atomic_thread_fence(memory_order_acquire);
+    
+    return value;
+}
+
+- (void)setCachedValue:(id)value forProperty:(MAVMatrixLazyProperty)property
+{
+    if (value == nil) {
+        return;
+    }
+    
+    // make the fully constructed value visible before the pointer to it
+    atomic_thread_fence(memory_order_release);
+    switch (property) {
+        case MAVMatrixLazyPropertyTranspose:
+            _transpose = value;
+            break;
+            
+        case MAVMatrixLazyPropertyDeterminant:
+            _determinant = value;
+            break;
+            
+        case MAVMatrixLazyPropertyInverse:
+            _inverse = value;
+            break;
+            
+        case MAVMatrixLazyPropertyConditionNumber:
+            _conditionNumber = value;
+            break;
+            
+        case MAVMatrixLazyPropertyQRFactorization:
+            _qrFactorization = value;
+            break;
+            
+        case MAVMatrixLazyPropertyLUFactorization:
+            _luFactorization = value;
+            break;
+            
+        case MAVMatrixLazyPropertyCholeskyFactorization:
+            _choleskyFactorization = value;
+            break;
+            
+        case MAVMatrixLazyPropertySingularValueDecomposition:
+            _singularValueDecomposition = value;
+            break;
+            
+        case MAVMatrixLazyPropertyEigendecomposition:
+            _eigendecomposition = value;
+            break;
+            
+        case MAVMatrixLazyPropertySymmetric:
+            _symmetric = value;
+            break;
+            
+        case MAVMatrixLazyPropertyZero:
+            _isZero = value;
+            break;
+            
+        case MAVMatrixLazyPropertyIdentity:
+            _isIdentity = value;
+            break;
+            
+        case MAVMatrixLazyPropertyDefiniteness:
+            _definiteness = (MAVMatrixDefiniteness)[value integerValue];
+            break;
+            
+        case MAVMatrixLazyPropertyDiagonalValues:
+            _diagonalValues = value;
+            break;
+            
+        case MAVMatrixLazyPropertyTrace:
+            _trace = value;
+            break;
+            
+        case MAVMatrixLazyPropertyNormInfinity:
+            _normInfinity = value;
+            break;
+            
+        case MAVMatrixLazyPropertyNormL1:
+            _normL1 = value;
+            break;
+            
+        case MAVMatrixLazyPropertyNormMax:
+            _normMax = value;
+            break;
+            
+        case MAVMatrixLazyPropertyNormFroebenius:
+            _normFroebenius = value;
+            break;
+            
+        case MAVMatrixLazyPropertyMinorMatrix:
+            _minorMatrix = value;
+            break;
+            
+        case MAVMatrixLazyPropertyCofactorMatrix:
+            _cofactorMatrix = value;
+            break;
+            
+        case MAVMatrixLazyPropertyAdjugate:
+            _adjugate = value;
+            break;
+    }
+}
+
+- (BOOL)beginComputingLazyProperty:(MAVMatrixLazyProperty)property isCached:(BOOL (^)(void))isCached
+{
+    UInt32 mask = MAVMatrixLazyPropertyMask(property);
+    
+    pthread_mutex_lock(&_lazyPropertyMutex);
+    while ((_lazyPropertiesInFlight & mask) != 0) {
+        pthread_cond_wait(&_lazyPropertyCondition, &_lazyPropertyMutex);
+    }
+    BOOL shouldCompute = !isCached();
+    if (shouldCompute) {
+        _lazyPropertiesInFlight |= mask;
+    }
+    pthread_mutex_unlock(&_lazyPropertyMutex);
+    
+    return shouldCompute;
+}
+
+- (void)finishComputingLazyProperty:(MAVMatrixLazyProperty)property
+{
+    pthread_mutex_lock(&_lazyPropertyMutex);
+    _lazyPropertiesInFlight &= ~MAVMatrixLazyPropertyMask(property);
+    pthread_cond_broadcast(&_lazyPropertyCondition);
+    pthread_mutex_unlock(&_lazyPropertyMutex);
+}
+
+- (MAVMatrixTriangularComponent)inferredTriangularComponent
+{
+    if (self.rows != self.columns) {
+        return MAVMatrixTriangularComponentBoth;
+    }
+    
+    switch (self.packingMethod) {
+            
+        case MAVMatrixValuePackingMethodPacked: {
+            // packed storage only holds one triangle, so unless the other is mirrored the declared component is exact
+            if (!_symmetric.isYes) {
+                return self.triangularComponent;
+            }
+        } break;
+            
+        case MAVMatrixValuePackingMethodBand: {
+            // band matrices with no codiagonals on one side of the diagonal are triangular by construction
+            MAVIndex lowerCodiagonals = self.bandwidth - self.upperCodiagonals - 1;
+            if (lowerCodiagonals == 0) {
+                return MAVMatrixTriangularComponentUpper;
+            } else if (self.upperCodiagonals == 0) {
+                return MAVMatrixTriangularComponentLower;
+            }
+        } break;
+            
+        case MAVMatrixValuePackingMethodConventional: {
+            // a declared component is set by operations known to produce triangular results
+            if (self.triangularComponent != MAVMatrixTriangularComponentBoth) {
+                return self.triangularComponent;
+            }
+            
+            // scan the values in place rather than unpacking a copy
+            return MAVTriangularComponentOfValues(self.values.bytes, self.rows, self.leadingDimension, self.precision);
+        } break;
+            
+        default: break;
+    }
+    
+    NSData *columnMajorValues = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    return MAVTriangularComponentOfValues(columnMajorValues.bytes, self.rows, MAVMatrixLeadingDimensionColumn, self.precision);
+}
+
++ (MAVVector *)solveTriangularLinearSystemWithMatrixA:(MAVMatrix *)A
+                                              valuesB:(MAVVector *)B
+                                  triangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+{
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(A.rows);
+    MAVLAPACKInteger nrhs = 1;
+    MAVLAPACKInteger lda = n;
+    MAVLAPACKInteger ldb = n;
+    MAVLAPACKInteger info = 0;
+    char *uplo = triangularComponent == MAVMatrixTriangularComponentUpper ? "U" : "L";
+    
+    // packed triangles can be handed to LAPACK as-is, everything else is unpacked into a full column-major array
+    BOOL usePackedStorage = A.packingMethod == MAVMatrixValuePackingMethodPacked;
+    NSData *aData = usePackedStorage
+    ? [A valuesFromTriangularComponent:triangularComponent leadingDimension:MAVMatrixLeadingDimensionColumn packingMethod:MAVMatrixValuePackingMethodPacked]
+    : [A valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    if (A.precision == MCKPrecisionDouble) {
+        size_t size = n * sizeof(double);
+        double *b = malloc(size);
+        for (MAVIndex i = 0; i < n; i++) {
+            b[i] = ((double *)B.values.bytes)[i];
+        }
+        
+        if (usePackedStorage) {
+            dtptrs_(uplo, "N", "N", &n, &nrhs, (double *)aData.bytes, b, &ldb, &info);
+        } else {
+            dtrtrs_(uplo, "N", "N", &n, &nrhs, (double *)aData.bytes, &lda, b, &ldb, &info);
+        }
+        
+        if (info != 0) {
+            free(b);
+            return nil;
         }
-        data = [NSData dataWithBytesNoCopy:values length:dataSize];
+        
+        return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:b length:size] length:n];
     } else {
-        size_t dataSize = size * sizeof(float);
-        float *values = malloc(dataSize);
-        for (MAVIndex i = 0; i < size; i += 1) {
-            values[i] = [NSNumber mck_randomFloat].floatValue;
+        size_t size = n * sizeof(float);
+        float *b = malloc(size);
+        for (MAVIndex i = 0; i < n; i++) {
+            b[i] = ((float *)B.values.bytes)[i];
+        }
+        
+        if (usePackedStorage) {
+            stptrs_(uplo, "N", "N", &n, &nrhs, (float *)aData.bytes, b, &ldb, &info);
+        } else {
+            strtrs_(uplo, "N", "N", &n, &nrhs, (float *)aData.bytes, &lda, b, &ldb, &info);
+        }
+        
+        if (info != 0) {
+            free(b);
+            return nil;
         }
-        data = [NSData dataWithBytesNoCopy:values length:dataSize];
+        
+        return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:b length:size] length:n];
     }
+}
+
+- (MAVMatrix *)inverseOfTriangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+{
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(self.rows);
+    MAVLAPACKInteger lda = n;
+    MAVLAPACKInteger info = 0;
+    char *uplo = triangularComponent == MAVMatrixTriangularComponentUpper ? "U" : "L";
     
-    return data;
+    if (self.packingMethod == MAVMatrixValuePackingMethodPacked) {
+        NSData *packedValues = [self valuesFromTriangularComponent:triangularComponent
+                                                  leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                     packingMethod:MAVMatrixValuePackingMethodPacked];
+        if (self.precision == MCKPrecisionDouble) {
+            dtptri_(uplo, "N", &n, (double *)packedValues.bytes, &info);
+        } else {
+            stptri_(uplo, "N", &n, (float *)packedValues.bytes, &info);
+        }
+        
+        // info > 0 means a zero on the diagonal, so the matrix is singular
+        if (info != 0) {
+            return nil;
+        }
+        
+        return [MAVMatrix triangularMatrixWithPackedValues:packedValues
+                                     ofTriangularComponent:triangularComponent
+                                          leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                     order:n];
+    } else {
+        NSData *columnMajorValues = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+        if (self.precision == MCKPrecisionDouble) {
+            dtrtri_(uplo, "N", &n, (double *)columnMajorValues.bytes, &lda, &info);
+        } else {
+            strtri_(uplo, "N", &n, (float *)columnMajorValues.bytes, &lda, &info);
+        }
+        
+        // info > 0 means a zero on the diagonal, so the matrix is singular
+        if (info != 0) {
+            return nil;
+        }
+        
+        return [MAVMatrix matrixWithValues:columnMajorValues
+                                      rows:n
+                                   columns:n
+                          leadingDimension:MAVMatrixLeadingDimensionColumn];
+    }
+}
+
+- (MAVMatrix *)inverseOfGeneralMatrix
+{
+    NSData *columnMajorData = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(_rows);
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(_columns);
+    
+    MAVLAPACKInteger lda = m;
+    
+    MAVLAPACKInteger *ipiv = malloc(MIN(m, n) * sizeof(MAVLAPACKInteger));
+    
+    MAVLAPACKInteger info = 0;
+    
+    void *a;
+    if ([columnMajorData containsDoublePrecisionValues:(_rows * _columns)]) {
+        a = (double *)columnMajorData.bytes;
+        
+        // compute factorization; info > 0 means the matrix is singular
+        dgetrf_(&m, &n, a, &lda, ipiv, &info);
+        if (info != 0) {
+            free(ipiv);
+            return nil;
+        }
+        
+        double wkopt;
+        MAVLAPACKInteger lwork = -1;
+        
+        // query optimal workspace size
+        dgetri_(&m, a, &lda, ipiv, &wkopt, &lwork, &info);
+        
+        lwork = (MAVLAPACKInteger)wkopt;
+        double *work = malloc(lwork * sizeof(double));
+        
+        // calculate the inverse
+        dgetri_(&m, a, &lda, ipiv, work, &lwork, &info);
+        
+        free(ipiv);
+        free(work);
+    } else {
+        a = (float *)columnMajorData.bytes;
+        
+        // compute factorization; info > 0 means the matrix is singular
+        sgetrf_(&m, &n, a, &lda, ipiv, &info);
+        if (info != 0) {
+            free(ipiv);
+            return nil;
+        }
+        
+        float wkopt;
+        MAVLAPACKInteger lwork = -1;
+        
+        // query optimal workspace size
+        sgetri_(&m, a, &lda, ipiv, &wkopt, &lwork, &info);
+        
+        lwork = (MAVLAPACKInteger)wkopt;
+        float *work = malloc(lwork * sizeof(float));
+        
+        // calculate the inverse
+        sgetri_(&m, a, &lda, ipiv, work, &lwork, &info);
+        
+        free(ipiv);
+        free(work);
+    }
+    
+    return [MAVMatrix matrixWithValues:[NSData dataWithBytes:a length:columnMajorData.length]
+                                  rows:_rows
+                               columns:_columns
+                      leadingDimension:MAVMatrixLeadingDimensionColumn];
+}
+
+- (MAVMatrix *)inverseOfPositiveDefiniteMatrix
+{
+    NSData *columnMajorValues = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(_rows);
+    MAVLAPACKInteger lda = n;
+    MAVLAPACKInteger info = 0;
+    
+    if (self.precision == MCKPrecisionDouble) {
+        double *a = (double *)columnMajorValues.bytes;
+        
+        // compute the Cholesky factorization; info > 0 means the matrix is not positive definite
+        dpotrf_("U", &n, a, &lda, &info);
+        if (info != 0) {
+            return nil;
+        }
+        
+        // calculate the inverse into the upper triangle, then mirror it into the lower
+        dpotri_("U", &n, a, &lda, &info);
+        if (info != 0) {
+            return nil;
+        }
+        [MAVMatrix mirrorTriangularComponent:MAVMatrixTriangularComponentUpper ofColumnMajorValues:a order:n precision:MCKPrecisionDouble];
+    } else {
+        float *a = (float *)columnMajorValues.bytes;
+        
+        // compute the Cholesky factorization; info > 0 means the matrix is not positive definite
+        spotrf_("U", &n, a, &lda, &info);
+        if (info != 0) {
+            return nil;
+        }
+        
+        // calculate the inverse into the upper triangle, then mirror it into the lower
+        spotri_("U", &n, a, &lda, &info);
+        if (info != 0) {
+            return nil;
+        }
+        [MAVMatrix mirrorTriangularComponent:MAVMatrixTriangularComponentUpper ofColumnMajorValues:a order:n precision:MCKPrecisionSingle];
+    }
+    
+    MAVMatrix *inverse = [MAVMatrix matrixWithValues:columnMajorValues
+                                                rows:n
+                                             columns:n
+                                    leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    // the inverse of a symmetric positive definite matrix is also symmetric positive definite
+    inverse.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    inverse.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    
+    return inverse;
+}
+
++ (MAVVector *)solvePositiveDefiniteLinearSystemWithMatrixA:(MAVMatrix *)A
+                                                    valuesB:(MAVVector *)B
+{
+    // the factorization is cached, so later solves with A, or with A after rank-one updates, only take O(n²) operations
+    MAVCholeskyFactorization *cholesky = A.choleskyFactorization;
+    
+    // no Cholesky factorization exists if the matrix is not positive definite
+    if (cholesky == nil) {
+        return nil;
+    }
+    
+    NSData *lData = [cholesky.lowerTriangularMatrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(A.rows);
+    MAVLAPACKInteger nrhs = 1;
+    MAVLAPACKInteger lda = n;
+    MAVLAPACKInteger ldb = n;
+    MAVLAPACKInteger info = 0;
+    
+    if (A.precision == MCKPrecisionDouble) {
+        size_t size = n * sizeof(double);
+        double *b = malloc(size);
+        for (MAVIndex i = 0; i < n; i++) {
+            b[i] = ((double *)B.values.bytes)[i];
+        }
+        
+        dpotrs_("L", &n, &nrhs, (double *)lData.bytes, &lda, b, &ldb, &info);
+        
+        return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:b length:size] length:n];
+    } else {
+        size_t size = n * sizeof(float);
+        float *b = malloc(size);
+        for (MAVIndex i = 0; i < n; i++) {
+            b[i] = ((float *)B.values.bytes)[i];
+        }
+        
+        spotrs_("L", &n, &nrhs, (float *)lData.bytes, &lda, b, &ldb, &info);
+        
+        return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:b length:size] length:n];
+    }
+}
+
+- (void)getFixedSizeRowMajorValues:(double *)values
+{
+    NSAssert(self.rows == self.columns && self.rows <= MAV_FIXED_SIZE_MAX_ORDER, @"Only square matrices of order %d or less have fixed-size values", MAV_FIXED_SIZE_MAX_ORDER);
+    
+    // conventionally stored values are read in place; packed and band values are unpacked first
+    BOOL isConventional = self.packingMethod == MAVMatrixValuePackingMethodConventional;
+    NSData *data = isConventional ? self.values : [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
+    BOOL isColumnMajor = isConventional && self.leadingDimension == MAVMatrixLeadingDimensionColumn;
+    
+    MAVIndex n = self.rows;
+    for (MAVIndex row = 0; row < n; row++) {
+        for (MAVIndex col = 0; col < n; col++) {
+            size_t index = isColumnMajor ? col * n + row : row * n + col;
+            if (self.precision == MCKPrecisionDouble) {
+                values[row * n + col] = ((const double *)data.bytes)[index];
+            } else {
+                values[row * n + col] = ((const float *)data.bytes)[index];
+            }
+        }
+    }
+}
+
+- (MAVMatrix *)inverseOfFixedSizeMatrix
+{
+    int n = (int)_rows;
+    double values[MAV_FIXED_SIZE_MAX_ORDER * MAV_FIXED_SIZE_MAX_ORDER];
+    double adjugate[MAV_FIXED_SIZE_MAX_ORDER * MAV_FIXED_SIZE_MAX_ORDER];
+    [self getFixedSizeRowMajorValues:values];
+    
+    double determinant = MAVDeterminantOfOrder(values, n);
+    if (!MAVDeterminantIsWellConditionedOfOrder(values, determinant, n)) {
+        return nil;
+    }
+    MAVAdjugateOfOrder(values, adjugate, n);
+    
+    NSData *inverseValues;
+    if (self.precision == MCKPrecisionDouble) {
+        size_t size = n * n * sizeof(double);
+        double *a = malloc(size);
+        for (int i = 0; i < n * n; i++) {
+            a[i] = adjugate[i] / determinant;
+        }
+        inverseValues = [NSData dataWithBytesNoCopy:a length:size];
+    } else {
+        size_t size = n * n * sizeof(float);
+        float *a = malloc(size);
+        for (int i = 0; i < n * n; i++) {
+            a[i] = (float)(adjugate[i] / determinant);
+        }
+        inverseValues = [NSData dataWithBytesNoCopy:a length:size];
+    }
+    
+    MAVMatrix *inverse = [MAVMatrix matrixWithValues:inverseValues
+                                                rows:n
+                                             columns:n
+                                    leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    // the inverse of a symmetric positive definite matrix is also symmetric positive definite
+    if (_symmetric.isYes) {
+        inverse.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    if (_positiveSemidefinite.isYes) {
+        inverse.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    
+    return inverse;
+}
+
++ (MAVVector *)solveFixedSizeLinearSystemWithMatrixA:(MAVMatrix *)A
+                                             valuesB:(MAVVector *)B
+{
+    NSAssert(B.length == A.rows, @"B must have as many values as A has rows");
+    
+    int n = (int)A.rows;
+    double a[MAV_FIXED_SIZE_MAX_ORDER * MAV_FIXED_SIZE_MAX_ORDER];
+    double b[MAV_FIXED_SIZE_MAX_ORDER];
+    double x[MAV_FIXED_SIZE_MAX_ORDER];
+    [A getFixedSizeRowMajorValues:a];
+    for (int i = 0; i < n; i++) {
+        b[i] = A.precision == MCKPrecisionDouble ? ((const double *)B.values.bytes)[i] : ((const float *)B.values.bytes)[i];
+    }
+    
+    double determinant = MAVSolveOfOrder(a, b, x, n);
+    if (!MAVDeterminantIsWellConditionedOfOrder(a, determinant, n)) {
+        return nil;
+    }
+    
+    if (A.precision == MCKPrecisionDouble) {
+        size_t size = n * sizeof(double);
+        double *solutionValues = malloc(size);
+        for (int i = 0; i < n; i++) {
+            solutionValues[i] = x[i];
+        }
+        return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:solutionValues length:size] length:n];
+    } else {
+        size_t size = n * sizeof(float);
+        float *solutionValues = malloc(size);
+        for (int i = 0; i < n; i++) {
+            solutionValues[i] = (float)x[i];
+        }
+        return [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:solutionValues length:size] length:n];
+    }
+}
+
+- (MAVMatrix *)gramMatrixOfColumns:(BOOL)ofColumns packingMethod:(MAVMatrixValuePackingMethod)packingMethod
+{
+    NSAssert(packingMethod != MAVMatrixValuePackingMethodBand, @"Gram matrices cannot be stored in band format.");
+    
+    MAVIndex order = ofColumns ? self.columns : self.rows;
+    size_t size = order * order * (self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
+    void *values = malloc(size);
+    
+    // only the upper triangle is computed
+    [self updateSymmetricValues:values
+            triangularComponent:MAVMatrixTriangularComponentUpper
+       withGramProductOfColumns:ofColumns
+                          alpha:1.0
+                           beta:0.0];
+    
+    MAVMatrix *gram;
+    if (packingMethod == MAVMatrixValuePackingMethodPacked) {
+        NSData *packedValues = [MAVMatrix packedValuesFromTriangularComponent:MAVMatrixTriangularComponentUpper
+                                                          ofColumnMajorValues:values
+                                                                        order:order
+                                                                    precision:self.precision];
+        free(values);
+        gram = [MAVMatrix symmetricMatrixWithPackedValues:packedValues
+                                      triangularComponent:MAVMatrixTriangularComponentUpper
+                                         leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                    order:order];
+    } else {
+        [MAVMatrix mirrorTriangularComponent:MAVMatrixTriangularComponentUpper
+                         ofColumnMajorValues:values
+                                       order:order
+                                   precision:self.precision];
+        gram = [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:values length:size]
+                                      rows:order
+                                   columns:order
+                          leadingDimension:MAVMatrixLeadingDimensionColumn];
+        gram.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    gram.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    
+    return gram;
+}
+
+- (void)updateSymmetricValues:(void *)values
+          triangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+     withGramProductOfColumns:(BOOL)ofColumns
+                        alpha:(double)alpha
+                         beta:(double)beta
+{
+    // read conventional values in place; row-major storage of A is column-major storage of Aᵀ, which swaps the transposition
+    BOOL isConventional = self.packingMethod == MAVMatrixValuePackingMethodConventional;
+    NSData *aValues = isConventional ? self.values : [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    BOOL isColumnMajor = !isConventional || self.leadingDimension == MAVMatrixLeadingDimensionColumn;
+    
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(ofColumns ? self.columns : self.rows);
+    MAVLAPACKInteger k = MAVLAPACKIntegerFromIndex(ofColumns ? self.rows : self.columns);
+    MAVLAPACKInteger lda = MAVLAPACKIntegerFromIndex(isColumnMajor ? self.rows : self.columns);
+    enum CBLAS_UPLO uplo = triangularComponent == MAVMatrixTriangularComponentUpper ? CblasUpper : CblasLower;
+    enum CBLAS_TRANSPOSE trans = ofColumns == isColumnMajor ? CblasTrans : CblasNoTrans;
+    
+    if (self.precision == MCKPrecisionDouble) {
+        cblas_dsyrk(CblasColMajor, uplo, trans, n, k, alpha, aValues.bytes, lda, beta, values, n);
+    } else {
+        cblas_ssyrk(CblasColMajor, uplo, trans, n, k, (float)alpha, aValues.bytes, lda, (float)beta, values, n);
+    }
+}
+
++ (NSData *)packedValuesFromTriangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+                            ofColumnMajorValues:(const void *)values
+                                          order:(MAVIndex)order
+                                      precision:(MCKPrecision)precision
+{
+    size_t elementSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    size_t size = (order * (order + 1)) / 2 * elementSize;
+    void *packedValues = malloc(size);
+    MAVPackTriangleOfLines(values, order, MAVTriangleIsMadeOfHeads(triangularComponent, MAVMatrixLeadingDimensionColumn), elementSize, packedValues);
+    
+    return [NSData dataWithBytesNoCopy:packedValues length:size];
+}
+
++ (void)mirrorTriangularComponent:(MAVMatrixTriangularComponent)triangularComponent
+              ofColumnMajorValues:(void *)values
+                            order:(MAVIndex)order
+                        precision:(MCKPrecision)precision
+{
+    BOOL heads = MAVTriangleIsMadeOfHeads(triangularComponent, MAVMatrixLeadingDimensionColumn);
+    if (precision == MCKPrecisionDouble) {
+        MAVMirrorTriangleOfLinesD(values, order, heads);
+    } else {
+        MAVMirrorTriangleOfLines(values, order, heads);
+    }
+}
+
++ (NSData *)randomArrayOfSize:(size_t)size
+                    precision:(MCKPrecision)precision
+{
+    return [[MAVRandomGenerator defaultGenerator] valuesWithDistribution:MAVRandomDistributionUniform
+                                                                   count:size
+                                                               precision:precision];
 }
 
 - (instancetype)init
@@ -1465,7 +2636,7 @@
     if (self) {
         _rows = 0;
         _columns = 0;
-        _values = nil;
+        _valueBuffer = nil;
         _precision = MCKPrecisionSingle;
         
         _leadingDimension = MAVMatrixLeadingDimensionColumn;
@@ -1474,45 +2645,142 @@
         // ???: should this be reset to default state for non-idempotent mutations?
         _triangularComponent = MAVMatrixTriangularComponentBoth;
         
+        pthread_mutex_init(&_lazyPropertyMutex, NULL);
+        pthread_cond_init(&_lazyPropertyCondition, NULL);
+        _lazyPropertiesInFlight = 0;
+        
         [self resetToDefaultStateAndBreakSymmetry:YES];
     }
     return self;
 }
 
+- (void)dealloc
+{
+    [_valueBuffer relinquish];
+    pthread_cond_destroy(&_lazyPropertyCondition);
+    pthread_mutex_destroy(&_lazyPropertyMutex);
+}
+
 - (void)resetToDefaultStateAndBreakSymmetry:(BOOL)breakSymmetry
 {
-    _qrFactorization = nil;
-    _luFactorization = nil;
-    _singularValueDecomposition = nil;
-    _eigendecomposition = nil;
-    _inverse = nil;
-    _transpose = nil;
-    _conditionNumber = nil;
-    _determinant = nil;
-    _diagonalValues = nil;
-    _trace = nil;
-    _adjugate = nil;
-    _minorMatrix = nil;
-    _cofactorMatrix = nil;
-    _normInfinity = nil;
-    _normL1 = nil;
-    _normMax = nil;
-    _normFroebenius = nil;
-
-    if (breakSymmetry) {
-        _symmetric = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
-    }
-    _isIdentity = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
-    _isZero = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
-    _definiteness = MAVMatrixDefinitenessUnknown;
+    UInt32 properties = MAVMatrixLazyPropertiesAll;
+    if (!breakSymmetry) {
+        properties &= ~MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertySymmetric);
+    }
+    [self resetLazyProperties:properties];
+}
+
+- (void)resetLazyProperties:(UInt32)properties
+{
+    for (MAVMatrixLazyProperty property = 0; property <= MAVMatrixLazyPropertyCholeskyFactorization; property += 1) {
+        if ((properties & MAVMatrixLazyPropertyMask(property)) == 0) {
+            continue;
+        }
+        switch (property) {
+            case MAVMatrixLazyPropertyTranspose:
+                _transpose = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyDeterminant:
+                _determinant = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyInverse:
+                _inverse = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyConditionNumber:
+                _conditionNumber = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyQRFactorization:
+                _qrFactorization = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyLUFactorization:
+                _luFactorization = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyCholeskyFactorization:
+                _choleskyFactorization = nil;
+                break;
+                
+            case MAVMatrixLazyPropertySingularValueDecomposition:
+                _singularValueDecomposition = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyEigendecomposition:
+                _eigendecomposition = nil;
+                break;
+                
+            case MAVMatrixLazyPropertySymmetric:
+                _symmetric = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
+                break;
+                
+            case MAVMatrixLazyPropertyZero:
+                _isZero = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
+                break;
+                
+            case MAVMatrixLazyPropertyIdentity:
+                _isIdentity = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
+                break;
+                
+            case MAVMatrixLazyPropertyDefiniteness:
+                _definiteness = MAVMatrixDefinitenessUnknown;
+                _positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
+                break;
+                
+            case MAVMatrixLazyPropertyDiagonalValues:
+                _diagonalValues = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyTrace:
+                _trace = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyNormInfinity:
+                _normInfinity = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyNormL1:
+                _normL1 = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyNormMax:
+                _normMax = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyNormFroebenius:
+                _normFroebenius = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyMinorMatrix:
+                _minorMatrix = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyCofactorMatrix:
+                _cofactorMatrix = nil;
+                break;
+                
+            case MAVMatrixLazyPropertyAdjugate:
+                _adjugate = nil;
+                break;
+        }
+    }
+    _hasContentHash = NO;
+    
+    // packed storage defines its triangular component, but for conventional storage it's only a structural hint
+    if (_packingMethod == MAVMatrixValuePackingMethodConventional) {
+        _triangularComponent = MAVMatrixTriangularComponentBoth;
+    }
 }
 
 - (NSNumber *)normOfType:(MAVMatrixNorm)normType
 {
     NSNumber *normResult;
     
-    MAVIndex m = self.rows;
-    MAVIndex n = self.columns;
+    MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(self.rows);
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(self.columns);
     NSData *valueData = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
     char *norm = "";
     if (normType == MAVMatrixNormL1) {
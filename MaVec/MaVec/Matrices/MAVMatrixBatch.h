@@ -0,0 +1,157 @@
+//
+//  MAVMatrixBatch.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import <MCKNumerics/MCKNumerics.h>
+
+#import "MAVTypedefs.h"
+
+@class MAVMatrix;
+
+/**
+ @class MAVMatrixBatch
+ @description An immutable collection of square matrices of order 2, 3 or 4, stored in structure-of-arrays layout: the value at a given row and column of every matrix in the batch is contiguous, so the value at (row, column) of the matrix at index i is found at values[(row * order + column) * count + i]. Operations on a batch run the same closed-form kernel over every matrix with unit-stride memory access and no per-matrix objects, and are split across threads for large batches.
+ */
+@interface MAVMatrixBatch : NSObject
+
+/**
+ @property order
+ @brief The number of rows and columns in each matrix of the batch.
+ */
+@property (nonatomic, readonly, assign) MAVIndex order;
+
+/**
+ @property count
+ @brief The number of matrices in the batch.
+ */
+@property (nonatomic, readonly, assign) size_t count;
+
+/**
+ @property values
+ @brief A one-dimensional C array of floating point values in structure-of-arrays layout.
+ */
+@property (nonatomic, readonly, strong) NSData *values;
+
+/**
+ @property precision
+ @brief Whether the batch values are single- or double-precision.
+ */
+@property (nonatomic, readonly, assign) MCKPrecision precision;
+
+#pragma mark - Constructors
+
+/**
+ @brief Construct a new MAVMatrixBatch object.
+ @param values A one-dimensional array of order * order * count floating-point values in structure-of-arrays layout.
+ @param order The number of rows and columns in each matrix, either 2, 3 or 4.
+ @param count The number of matrices in the batch.
+ @return A new MAVMatrixBatch object.
+ */
+- (instancetype)initWithValues:(NSData *)values
+                         order:(MAVIndex)order
+                         count:(size_t)count;
+
+/**
+ @brief Class convenience method to construct a new MAVMatrixBatch object.
+ @param values A one-dimensional array of order * order * count floating-point values in structure-of-arrays layout.
+ @param order The number of rows and columns in each matrix, either 2, 3 or 4.
+ @param count The number of matrices in the batch.
+ @return A new MAVMatrixBatch object.
+ */
++ (instancetype)batchWithValues:(NSData *)values
+                          order:(MAVIndex)order
+                          count:(size_t)count;
+
+/**
+ @brief Construct a new MAVMatrixBatch object by gathering the values of an array of matrices.
+ @param matrices An array of square MAVMatrix objects of the same order and precision.
+ @return A new MAVMatrixBatch object.
+ */
++ (instancetype)batchWithMatrices:(NSArray *)matrices;
+
+/**
+ @brief Construct a new MAVMatrixBatch object containing copies of the identity matrix.
+ @param order The number of rows and columns in each matrix, either 2, 3 or 4.
+ @param count The number of matrices in the batch.
+ @param precision The precision of the values in the batch.
+ @return A new MAVMatrixBatch object.
+ */
++ (instancetype)identityBatchOfOrder:(MAVIndex)order
+                               count:(size_t)count
+                           precision:(MCKPrecision)precision;
+
+#pragma mark - Inspection
+
+/**
+ @brief Gather the values of one matrix from the batch.
+ @param index The index of the matrix in the batch.
+ @return A new MAVMatrix object with row-major conventional storage.
+ */
+- (MAVMatrix *)matrixAtIndex:(size_t)index;
+
+#pragma mark - Operations
+
+/**
+ @brief Multiply each matrix in this batch by the matrix at the same index in another batch. If either batch contains a single matrix, it is applied to every matrix in the other batch.
+ @param batch The batch of right-hand matrices, of the same order and precision as this batch.
+ @return A new MAVMatrixBatch object containing the products.
+ */
+- (MAVMatrixBatch *)batchByMultiplyingByBatch:(MAVMatrixBatch *)batch;
+
+/**
+ @return A new MAVMatrixBatch object containing the transpose of each matrix in this batch.
+ */
+- (MAVMatrixBatch *)transposedBatch;
+
+/**
+ @return A one-dimensional C array holding the determinant of each matrix in this batch, in the batch's precision.
+ */
+- (NSData *)determinants;
+
+/**
+ @brief Invert each matrix in this batch using its adjugate, without pivoting. The inverse of a singular matrix, whose determinant is exactly 0, is filled with NaN instead of failing the whole batch; a nearly singular matrix yields very large or infinite entries rather than nil, so check the determinants first when the batch may contain ill-conditioned matrices.
+ @return A new MAVMatrixBatch object containing the inverses.
+ */
+- (MAVMatrixBatch *)invertedBatch;
+
+/**
+ @brief Multiply column vectors by the matrices in this batch.
+ @param vectorValues A one-dimensional C array of vectors of length order, in structure-of-arrays layout (component r of vector i is found at vectorValues[r * vectorCount + i]). The number of vectors must equal the number of matrices, unless the batch contains a single matrix, which is then applied to every vector.
+ @return A one-dimensional C array of the transformed vectors in the same layout.
+ */
+- (NSData *)transformVectorValues:(NSData *)vectorValues;
+
+#pragma mark - Enumeration
+
+/**
+ @brief Call a block over contiguous ranges of matrix indices which together cover the whole batch. Large batches are split into chunks that run concurrently, so the block must be safe to call from several threads at once and must not assume any order between ranges.
+ @param block The block to call with each range of matrix indices.
+ */
+- (void)enumerateMatrixRangesConcurrentlyUsingBlock:(void (^)(NSRange range))block;
+
+@end
@@ -0,0 +1,613 @@
+//
+//  MAVMatrixBatch.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Accelerate/Accelerate.h>
+
+#import "MAVMatrixBatch.h"
+#import "MAVMatrix.h"
+#import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVFixedSizeMatrixKernels.h"
+
+/**
+ The number of matrices handled by one task when a batch is split across threads. Batches no larger than this run on the calling thread.
+ */
+static const size_t MAVMatrixBatchChunkSize = 4096;
+
+static void MAVEnumerateBatchRanges(size_t count, void (^block)(NSRange range))
+{
+    if (count <= MAVMatrixBatchChunkSize) {
+        block(NSMakeRange(0, count));
+        return;
+    }
+
+    size_t chunks = (count + MAVMatrixBatchChunkSize - 1) / MAVMatrixBatchChunkSize;
+    dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+        size_t location = chunk * MAVMatrixBatchChunkSize;
+        block(NSMakeRange(location, MIN(MAVMatrixBatchChunkSize, count - location)));
+    });
+}
+
+#pragma mark - Kernels
+
+/*
+ Every kernel works on whole component planes, the count values of one row and column of
+ every matrix, which lie at values[k * stride] for component k. Kernels come in a double-
+ precision variant, suffixed D like vDSP's, and a single-precision one, so both precisions
+ are read and written in place. Products accumulate plane by plane with vDSP, where a step
+ of 0 broadcasts the planes of a single matrix as scalars. Determinants and inverses are
+ written out per order as closed-form expressions of the planes, evaluated in one loop over
+ the batch index with unit stride in every plane, which the compiler vectorizes across
+ matrices. The planes of the output are known not to overlap, which the compiler cannot
+ prove for a stride only known at run time, so those loops assume it.
+ */
+
+static void MAVMultiplyBatchKernelD(const double *a, size_t aStride, size_t aStep,
+                                    const double *b, size_t bStride, size_t bStep,
+                                    double *c, size_t cStride, size_t n, int order)
+{
+    for (int row = 0; row < order; row++) {
+        for (int col = 0; col < order; col++) {
+            double *cPlane = c + (row * order + col) * cStride;
+            for (int k = 0; k < order; k++) {
+                const double *aPlane = a + (row * order + k) * aStride;
+                const double *bPlane = b + (k * order + col) * bStride;
+                if (aStep == 0) {
+                    if (k == 0) {
+                        vDSP_vsmulD(bPlane, (vDSP_Stride)bStep, aPlane, cPlane, 1, n);
+                    } else {
+                        vDSP_vsmaD(bPlane, (vDSP_Stride)bStep, aPlane, cPlane, 1, cPlane, 1, n);
+                    }
+                } else if (bStep == 0) {
+                    if (k == 0) {
+                        vDSP_vsmulD(aPlane, 1, bPlane, cPlane, 1, n);
+                    } else {
+                        vDSP_vsmaD(aPlane, 1, bPlane, cPlane, 1, cPlane, 1, n);
+                    }
+                } else {
+                    if (k == 0) {
+                        vDSP_vmulD(aPlane, 1, bPlane, 1, cPlane, 1, n);
+                    } else {
+                        vDSP_vmaD(aPlane, 1, bPlane, 1, cPlane, 1, cPlane, 1, n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void MAVMultiplyBatchKernel(const float *a, size_t aStride, size_t aStep,
+                                   const float *b, size_t bStride, size_t bStep,
+                                   float *c, size_t cStride, size_t n, int order)
+{
+    for (int row = 0; row < order; row++) {
+        for (int col = 0; col < order; col++) {
+            float *cPlane = c + (row * order + col) * cStride;
+            for (int k = 0; k < order; k++) {
+                const float *aPlane = a + (row * order + k) * aStride;
+                const float *bPlane = b + (k * order + col) * bStride;
+                if (aStep == 0) {
+                    if (k == 0) {
+                        vDSP_vsmul(bPlane, (vDSP_Stride)bStep, aPlane, cPlane, 1, n);
+                    } else {
+                        vDSP_vsma(bPlane, (vDSP_Stride)bStep, aPlane, cPlane, 1, cPlane, 1, n);
+                    }
+                } else if (bStep == 0) {
+                    if (k == 0) {
+                        vDSP_vsmul(aPlane, 1, bPlane, cPlane, 1, n);
+                    } else {
+                        vDSP_vsma(aPlane, 1, bPlane, cPlane, 1, cPlane, 1, n);
+                    }
+                } else {
+                    if (k == 0) {
+                        vDSP_vmul(aPlane, 1, bPlane, 1, cPlane, 1, n);
+                    } else {
+                        vDSP_vma(aPlane, 1, bPlane, 1, cPlane, 1, cPlane, 1, n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void MAVTransformBatchKernelD(const double *a, size_t aStride, size_t aStep,
+                                     const double *v, size_t vStride,
+                                     double *w, size_t wStride, size_t n, int order)
+{
+    for (int row = 0; row < order; row++) {
+        double *wPlane = w + row * wStride;
+        for (int col = 0; col < order; col++) {
+            const double *aPlane = a + (row * order + col) * aStride;
+            const double *vPlane = v + col * vStride;
+            if (aStep == 0) {
+                if (col == 0) {
+                    vDSP_vsmulD(vPlane, 1, aPlane, wPlane, 1, n);
+                } else {
+                    vDSP_vsmaD(vPlane, 1, aPlane, wPlane, 1, wPlane, 1, n);
+                }
+            } else {
+                if (col == 0) {
+                    vDSP_vmulD(aPlane, 1, vPlane, 1, wPlane, 1, n);
+                } else {
+                    vDSP_vmaD(aPlane, 1, vPlane, 1, wPlane, 1, wPlane, 1, n);
+                }
+            }
+        }
+    }
+}
+
+static void MAVTransformBatchKernel(const float *a, size_t aStride, size_t aStep,
+                                    const float *v, size_t vStride,
+                                    float *w, size_t wStride, size_t n, int order)
+{
+    for (int row = 0; row < order; row++) {
+        float *wPlane = w + row * wStride;
+        for (int col = 0; col < order; col++) {
+            const float *aPlane = a + (row * order + col) * aStride;
+            const float *vPlane = v + col * vStride;
+            if (aStep == 0) {
+                if (col == 0) {
+                    vDSP_vsmul(vPlane, 1, aPlane, wPlane, 1, n);
+                } else {
+                    vDSP_vsma(vPlane, 1, aPlane, wPlane, 1, wPlane, 1, n);
+                }
+            } else {
+                if (col == 0) {
+                    vDSP_vmul(aPlane, 1, vPlane, 1, wPlane, 1, n);
+                } else {
+                    vDSP_vma(aPlane, 1, vPlane, 1, wPlane, 1, wPlane, 1, n);
+                }
+            }
+        }
+    }
+}
+
+/*
+ The closed-form kernels are defined once per order by the macros below and instantiated
+ for each precision. Dividing into one and adding zero times the quotient gives NaN, without
+ a branch, when the determinant is 0.
+ */
+
+#define MAV_A(row, col) a[((row) * MAV_BATCH_ORDER + (col)) * aStride + j]
+#define MAV_C(row, col) c[((row) * MAV_BATCH_ORDER + (col)) * cStride + j]
+
+#define MAV_BATCH_ORDER 2
+#define MAV_DEFINE_DETERMINANT_BATCH_KERNEL_2(real, name) \
+static void name(const real *restrict a, size_t aStride, real *restrict determinants, size_t n) \
+{ \
+    _Pragma("clang loop vectorize(assume_safety)") \
+    for (size_t j = 0; j < n; j++) { \
+        determinants[j] = MAV_A(0, 0) * MAV_A(1, 1) - MAV_A(0, 1) * MAV_A(1, 0); \
+    } \
+}
+
+#define MAV_DEFINE_INVERSE_BATCH_KERNEL_2(real, name) \
+static void name(const real *restrict a, size_t aStride, real *restrict c, size_t cStride, size_t n) \
+{ \
+    _Pragma("clang loop vectorize(assume_safety)") \
+    for (size_t j = 0; j < n; j++) { \
+        real determinant = MAV_A(0, 0) * MAV_A(1, 1) - MAV_A(0, 1) * MAV_A(1, 0); \
+        real inverse = (real)1 / determinant; \
+        real scale = inverse + (real)0 * inverse; \
+        MAV_C(0, 0) = MAV_A(1, 1) * scale; \
+        MAV_C(0, 1) = -MAV_A(0, 1) * scale; \
+        MAV_C(1, 0) = -MAV_A(1, 0) * scale; \
+        MAV_C(1, 1) = MAV_A(0, 0) * scale; \
+    } \
+}
+
+MAV_DEFINE_DETERMINANT_BATCH_KERNEL_2(double, MAVDeterminantBatchKernel2D)
+MAV_DEFINE_DETERMINANT_BATCH_KERNEL_2(float, MAVDeterminantBatchKernel2)
+MAV_DEFINE_INVERSE_BATCH_KERNEL_2(double, MAVInverseBatchKernel2D)
+MAV_DEFINE_INVERSE_BATCH_KERNEL_2(float, MAVInverseBatchKernel2)
+#undef MAV_DEFINE_DETERMINANT_BATCH_KERNEL_2
+#undef MAV_DEFINE_INVERSE_BATCH_KERNEL_2
+#undef MAV_BATCH_ORDER
+
+#define MAV_BATCH_ORDER 3
+#define MAV_DEFINE_DETERMINANT_BATCH_KERNEL_3(real, name) \
+static void name(const real *restrict a, size_t aStride, real *restrict determinants, size_t n) \
+{ \
+    _Pragma("clang loop vectorize(assume_safety)") \
+    for (size_t j = 0; j < n; j++) { \
+        determinants[j] = MAV_A(0, 0) * (MAV_A(1, 1) * MAV_A(2, 2) - MAV_A(1, 2) * MAV_A(2, 1)) \
+                        + MAV_A(0, 1) * (MAV_A(1, 2) * MAV_A(2, 0) - MAV_A(1, 0) * MAV_A(2, 2)) \
+                        + MAV_A(0, 2) * (MAV_A(1, 0) * MAV_A(2, 1) - MAV_A(1, 1) * MAV_A(2, 0)); \
+    } \
+}
+
+/* the cofactors of the first row also give the determinant */
+#define MAV_DEFINE_INVERSE_BATCH_KERNEL_3(real, name) \
+static void name(const real *restrict a, size_t aStride, real *restrict c, size_t cStride, size_t n) \
+{ \
+    _Pragma("clang loop vectorize(assume_safety)") \
+    for (size_t j = 0; j < n; j++) { \
+        real c00 = MAV_A(1, 1) * MAV_A(2, 2) - MAV_A(1, 2) * MAV_A(2, 1); \
+        real c01 = MAV_A(1, 2) * MAV_A(2, 0) - MAV_A(1, 0) * MAV_A(2, 2); \
+        real c02 = MAV_A(1, 0) * MAV_A(2, 1) - MAV_A(1, 1) * MAV_A(2, 0); \
+        real determinant = MAV_A(0, 0) * c00 + MAV_A(0, 1) * c01 + MAV_A(0, 2) * c02; \
+        real inverse = (real)1 / determinant; \
+        real scale = inverse + (real)0 * inverse; \
+        MAV_C(0, 0) = c00 * scale; \
+        MAV_C(0, 1) = (MAV_A(0, 2) * MAV_A(2, 1) - MAV_A(0, 1) * MAV_A(2, 2)) * scale; \
+        MAV_C(0, 2) = (MAV_A(0, 1) * MAV_A(1, 2) - MAV_A(0, 2) * MAV_A(1, 1)) * scale; \
+        MAV_C(1, 0) = c01 * scale; \
+        MAV_C(1, 1) = (MAV_A(0, 0) * MAV_A(2, 2) - MAV_A(0, 2) * MAV_A(2, 0)) * scale; \
+        MAV_C(1, 2) = (MAV_A(0, 2) * MAV_A(1, 0) - MAV_A(0, 0) * MAV_A(1, 2)) * scale; \
+        MAV_C(2, 0) = c02 * scale; \
+        MAV_C(2, 1) = (MAV_A(0, 1) * MAV_A(2, 0) - MAV_A(0, 0) * MAV_A(2, 1)) * scale; \
+        MAV_C(2, 2) = (MAV_A(0, 0) * MAV_A(1, 1) - MAV_A(0, 1) * MAV_A(1, 0)) * scale; \
+    } \
+}
+
+MAV_DEFINE_DETERMINANT_BATCH_KERNEL_3(double, MAVDeterminantBatchKernel3D)
+MAV_DEFINE_DETERMINANT_BATCH_KERNEL_3(float, MAVDeterminantBatchKernel3)
+MAV_DEFINE_INVERSE_BATCH_KERNEL_3(double, MAVInverseBatchKernel3D)
+MAV_DEFINE_INVERSE_BATCH_KERNEL_3(float, MAVInverseBatchKernel3)
+#undef MAV_DEFINE_DETERMINANT_BATCH_KERNEL_3
+#undef MAV_DEFINE_INVERSE_BATCH_KERNEL_3
+#undef MAV_BATCH_ORDER
+
+/*
+ Order 4 expands along the first two rows: s holds the 2 x 2 minors of rows 0 and 1 and
+ t those of rows 2 and 3, from which the determinant and every cofactor follow.
+ */
+#define MAV_BATCH_ORDER 4
+#define MAV_MINORS_OF_ORDER_4(real) \
+    real s0 = MAV_A(0, 0) * MAV_A(1, 1) - MAV_A(1, 0) * MAV_A(0, 1); \
+    real s1 = MAV_A(0, 0) * MAV_A(1, 2) - MAV_A(1, 0) * MAV_A(0, 2); \
+    real s2 = MAV_A(0, 0) * MAV_A(1, 3) - MAV_A(1, 0) * MAV_A(0, 3); \
+    real s3 = MAV_A(0, 1) * MAV_A(1, 2) - MAV_A(1, 1) * MAV_A(0, 2); \
+    real s4 = MAV_A(0, 1) * MAV_A(1, 3) - MAV_A(1, 1) * MAV_A(0, 3); \
+    real s5 = MAV_A(0, 2) * MAV_A(1, 3) - MAV_A(1, 2) * MAV_A(0, 3); \
+    real t0 = MAV_A(2, 0) * MAV_A(3, 1) - MAV_A(3, 0) * MAV_A(2, 1); \
+    real t1 = MAV_A(2, 0) * MAV_A(3, 2) - MAV_A(3, 0) * MAV_A(2, 2); \
+    real t2 = MAV_A(2, 0) * MAV_A(3, 3) - MAV_A(3, 0) * MAV_A(2, 3); \
+    real t3 = MAV_A(2, 1) * MAV_A(3, 2) - MAV_A(3, 1) * MAV_A(2, 2); \
+    real t4 = MAV_A(2, 1) * MAV_A(3, 3) - MAV_A(3, 1) * MAV_A(2, 3); \
+    real t5 = MAV_A(2, 2) * MAV_A(3, 3) - MAV_A(3, 2) * MAV_A(2, 3); \
+    real determinant = s0 * t5 - s1 * t4 + s2 * t3 + s3 * t2 - s4 * t1 + s5 * t0;
+
+#define MAV_DEFINE_DETERMINANT_BATCH_KERNEL_4(real, name) \
+static void name(const real *restrict a, size_t aStride, real *restrict determinants, size_t n) \
+{ \
+    _Pragma("clang loop vectorize(assume_safety)") \
+    for (size_t j = 0; j < n; j++) { \
+        MAV_MINORS_OF_ORDER_4(real) \
+        determinants[j] = determinant; \
+    } \
+}
+
+#define MAV_DEFINE_INVERSE_BATCH_KERNEL_4(real, name) \
+static void name(const real *restrict a, size_t aStride, real *restrict c, size_t cStride, size_t n) \
+{ \
+    _Pragma("clang loop vectorize(assume_safety)") \
+    for (size_t j = 0; j < n; j++) { \
+        MAV_MINORS_OF_ORDER_4(real) \
+        real inverse = (real)1 / determinant; \
+        real scale = inverse + (real)0 * inverse; \
+        MAV_C(0, 0) = ( MAV_A(1, 1) * t5 - MAV_A(1, 2) * t4 + MAV_A(1, 3) * t3) * scale; \
+        MAV_C(0, 1) = (-MAV_A(0, 1) * t5 + MAV_A(0, 2) * t4 - MAV_A(0, 3) * t3) * scale; \
+        MAV_C(0, 2) = ( MAV_A(3, 1) * s5 - MAV_A(3, 2) * s4 + MAV_A(3, 3) * s3) * scale; \
+        MAV_C(0, 3) = (-MAV_A(2, 1) * s5 + MAV_A(2, 2) * s4 - MAV_A(2, 3) * s3) * scale; \
+        MAV_C(1, 0) = (-MAV_A(1, 0) * t5 + MAV_A(1, 2) * t2 - MAV_A(1, 3) * t1) * scale; \
+        MAV_C(1, 1) = ( MAV_A(0, 0) * t5 - MAV_A(0, 2) * t2 + MAV_A(0, 3) * t1) * scale; \
+        MAV_C(1, 2) = (-MAV_A(3, 0) * s5 + MAV_A(3, 2) * s2 - MAV_A(3, 3) * s1) * scale; \
+        MAV_C(1, 3) = ( MAV_A(2, 0) * s5 - MAV_A(2, 2) * s2 + MAV_A(2, 3) * s1) * scale; \
+        MAV_C(2, 0) = ( MAV_A(1, 0) * t4 - MAV_A(1, 1) * t2 + MAV_A(1, 3) * t0) * scale; \
+        MAV_C(2, 1) = (-MAV_A(0, 0) * t4 + MAV_A(0, 1) * t2 - MAV_A(0, 3) * t0) * scale; \
+        MAV_C(2, 2) = ( MAV_A(3, 0) * s4 - MAV_A(3, 1) * s2 + MAV_A(3, 3) * s0) * scale; \
+        MAV_C(2, 3) = (-MAV_A(2, 0) * s4 + MAV_A(2, 1) * s2 - MAV_A(2, 3) * s0) * scale; \
+        MAV_C(3, 0) = (-MAV_A(1, 0) * t3 + MAV_A(1, 1) * t1 - MAV_A(1, 2) * t0) * scale; \
+        MAV_C(3, 1) = ( MAV_A(0, 0) * t3 - MAV_A(0, 1) * t1 + MAV_A(0, 2) * t0) * scale; \
+        MAV_C(3, 2) = (-MAV_A(3, 0) * s3 + MAV_A(3, 1) * s1 - MAV_A(3, 2) * s0) * scale; \
+        MAV_C(3, 3) = ( MAV_A(2, 0) * s3 - MAV_A(2, 1) * s1 + MAV_A(2, 2) * s0) * scale; \
+    } \
+}
+
+MAV_DEFINE_DETERMINANT_BATCH_KERNEL_4(double, MAVDeterminantBatchKernel4D)
+MAV_DEFINE_DETERMINANT_BATCH_KERNEL_4(float, MAVDeterminantBatchKernel4)
+MAV_DEFINE_INVERSE_BATCH_KERNEL_4(double, MAVInverseBatchKernel4D)
+MAV_DEFINE_INVERSE_BATCH_KERNEL_4(float, MAVInverseBatchKernel4)
+#undef MAV_DEFINE_DETERMINANT_BATCH_KERNEL_4
+#undef MAV_DEFINE_INVERSE_BATCH_KERNEL_4
+#undef MAV_MINORS_OF_ORDER_4
+#undef MAV_BATCH_ORDER
+
+#undef MAV_A
+#undef MAV_C
+
+@implementation MAVMatrixBatch
+
+#pragma mark - Constructors
+
+- (instancetype)initWithValues:(NSData *)values
+                         order:(MAVIndex)order
+                         count:(size_t)count
+{
+    self = [super init];
+    if (self) {
+        NSAssert(order >= 2 && order <= MAV_FIXED_SIZE_MAX_ORDER, @"Batches may only contain matrices of order 2, 3 or 4");
+        NSAssert(count > 0, @"Batches must contain at least one matrix");
+
+        _values = values;
+        _order = order;
+        _count = count;
+        _precision = [values containsDoublePrecisionValues:(order * order * count)] ? MCKPrecisionDouble : MCKPrecisionSingle;
+    }
+    return self;
+}
+
++ (instancetype)batchWithValues:(NSData *)values
+                          order:(MAVIndex)order
+                          count:(size_t)count
+{
+    return [[self alloc] initWithValues:values order:order count:count];
+}
+
++ (instancetype)batchWithMatrices:(NSArray *)matrices
+{
+    NSAssert(matrices.count > 0, @"Must supply at least one matrix");
+
+    MAVMatrix *firstMatrix = matrices.firstObject;
+    MAVIndex order = firstMatrix.rows;
+    MCKPrecision precision = firstMatrix.precision;
+    size_t count = matrices.count;
+    size_t components = order * order;
+    size_t elementSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+
+    char *values = malloc(components * count * elementSize);
+    [matrices enumerateObjectsUsingBlock:^(MAVMatrix *matrix, NSUInteger index, BOOL *stop) {
+        NSAssert(matrix.rows == order && matrix.columns == order, @"All matrices in a batch must be square and of the same order");
+        NSAssert(matrix.precision == precision, @"All matrices in a batch must have the same precision");
+
+        const char *matrixValues = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow].bytes;
+        for (size_t k = 0; k < components; k++) {
+            memcpy(values + (k * count + index) * elementSize, matrixValues + k * elementSize, elementSize);
+        }
+    }];
+
+    return [self batchWithValues:[NSData dataWithBytesNoCopy:values length:components * count * elementSize]
+                           order:order
+                           count:count];
+}
+
++ (instancetype)identityBatchOfOrder:(MAVIndex)order
+                               count:(size_t)count
+                           precision:(MCKPrecision)precision
+{
+    size_t components = order * order;
+    NSData *values;
+
+    if (precision == MCKPrecisionDouble) {
+        size_t size = components * count * sizeof(double);
+        double *identityValues = malloc(size);
+        for (MAVIndex row = 0; row < order; row++) {
+            for (MAVIndex col = 0; col < order; col++) {
+                double value = row == col ? 1.0 : 0.0;
+                vDSP_vfillD(&value, identityValues + (row * order + col) * count, 1, count);
+            }
+        }
+        values = [NSData dataWithBytesNoCopy:identityValues length:size];
+    } else {
+        size_t size = components * count * sizeof(float);
+        float *identityValues = malloc(size);
+        for (MAVIndex row = 0; row < order; row++) {
+            for (MAVIndex col = 0; col < order; col++) {
+                float value = row == col ? 1.0f : 0.0f;
+                vDSP_vfill(&value, identityValues + (row * order + col) * count, 1, count);
+            }
+        }
+        values = [NSData dataWithBytesNoCopy:identityValues length:size];
+    }
+
+    return [self batchWithValues:values order:order count:count];
+}
+
+#pragma mark - Inspection
+
+- (MAVMatrix *)matrixAtIndex:(size_t)index
+{
+    NSAssert(index < self.count, @"index (%lu) must be less than the number of matrices in the batch (%lu)", (unsigned long)index, (unsigned long)self.count);
+
+    size_t components = self.order * self.order;
+    size_t elementSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    const char *batchValues = self.values.bytes;
+    char *values = malloc(components * elementSize);
+    for (size_t k = 0; k < components; k++) {
+        memcpy(values + k * elementSize, batchValues + (k * self.count + index) * elementSize, elementSize);
+    }
+
+    return [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:values length:components * elementSize]
+                                  rows:self.order
+                               columns:self.order
+                      leadingDimension:MAVMatrixLeadingDimensionRow];
+}
+
+#pragma mark - Operations
+
+- (MAVMatrixBatch *)batchByMultiplyingByBatch:(MAVMatrixBatch *)batch
+{
+    NSAssert(self.order == batch.order, @"Batches must contain matrices of the same order");
+    NSAssert(self.precision == batch.precision, @"Batches must have the same precision");
+    NSAssert(self.count == batch.count || self.count == 1 || batch.count == 1, @"Batches must contain the same number of matrices, unless one contains a single matrix");
+
+    int order = (int)self.order;
+    size_t components = order * order;
+    size_t count = MAX(self.count, batch.count);
+    MCKPrecision precision = self.precision;
+    size_t elementSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    void *product = malloc(components * count * elementSize);
+
+    MAVEnumerateBatchRanges(count, ^(NSRange range) {
+        size_t aLocation = self.count == 1 ? 0 : range.location;
+        size_t bLocation = batch.count == 1 ? 0 : range.location;
+        size_t aStep = self.count == 1 ? 0 : 1;
+        size_t bStep = batch.count == 1 ? 0 : 1;
+
+        if (precision == MCKPrecisionDouble) {
+            MAVMultiplyBatchKernelD((const double *)self.values.bytes + aLocation, self.count, aStep,
+                                    (const double *)batch.values.bytes + bLocation, batch.count, bStep,
+                                    (double *)product + range.location, count, range.length, order);
+        } else {
+            MAVMultiplyBatchKernel((const float *)self.values.bytes + aLocation, self.count, aStep,
+                                   (const float *)batch.values.bytes + bLocation, batch.count, bStep,
+                                   (float *)product + range.location, count, range.length, order);
+        }
+    });
+
+    return [MAVMatrixBatch batchWithValues:[NSData dataWithBytesNoCopy:product length:components * count * elementSize]
+                                     order:order
+                                     count:count];
+}
+
+- (MAVMatrixBatch *)transposedBatch
+{
+    MAVIndex order = self.order;
+    size_t count = self.count;
+    size_t elementSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    size_t size = order * order * count * elementSize;
+    const char *values = self.values.bytes;
+    char *transposedValues = malloc(size);
+
+    // in structure-of-arrays layout, transposition just swaps whole component arrays
+    MAVEnumerateBatchRanges(count, ^(NSRange range) {
+        for (MAVIndex row = 0; row < order; row++) {
+            for (MAVIndex col = 0; col < order; col++) {
+                memcpy(transposedValues + ((col * order + row) * count + range.location) * elementSize,
+                       values + ((row * order + col) * count + range.location) * elementSize,
+                       range.length * elementSize);
+            }
+        }
+    });
+
+    return [MAVMatrixBatch batchWithValues:[NSData dataWithBytesNoCopy:transposedValues length:size]
+                                     order:order
+                                     count:count];
+}
+
+- (NSData *)determinants
+{
+    int order = (int)self.order;
+    size_t count = self.count;
+    MCKPrecision precision = self.precision;
+    size_t elementSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    void *determinants = malloc(count * elementSize);
+
+    MAVEnumerateBatchRanges(count, ^(NSRange range) {
+        if (precision == MCKPrecisionDouble) {
+            const double *a = (const double *)self.values.bytes + range.location;
+            double *d = (double *)determinants + range.location;
+            switch (order) {
+                case 2: MAVDeterminantBatchKernel2D(a, count, d, range.length); break;
+                case 3: MAVDeterminantBatchKernel3D(a, count, d, range.length); break;
+                default: MAVDeterminantBatchKernel4D(a, count, d, range.length); break;
+            }
+        } else {
+            const float *a = (const float *)self.values.bytes + range.location;
+            float *d = (float *)determinants + range.location;
+            switch (order) {
+                case 2: MAVDeterminantBatchKernel2(a, count, d, range.length); break;
+                case 3: MAVDeterminantBatchKernel3(a, count, d, range.length); break;
+                default: MAVDeterminantBatchKernel4(a, count, d, range.length); break;
+            }
+        }
+    });
+
+    return [NSData dataWithBytesNoCopy:determinants length:count * elementSize];
+}
+
+- (MAVMatrixBatch *)invertedBatch
+{
+    int order = (int)self.order;
+    size_t components = order * order;
+    size_t count = self.count;
+    MCKPrecision precision = self.precision;
+    size_t elementSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    void *inverses = malloc(components * count * elementSize);
+
+    MAVEnumerateBatchRanges(count, ^(NSRange range) {
+        if (precision == MCKPrecisionDouble) {
+            const double *a = (const double *)self.values.bytes + range.location;
+            double *c = (double *)inverses + range.location;
+            switch (order) {
+                case 2: MAVInverseBatchKernel2D(a, count, c, count, range.length); break;
+                case 3: MAVInverseBatchKernel3D(a, count, c, count, range.length); break;
+                default: MAVInverseBatchKernel4D(a, count, c, count, range.length); break;
+            }
+        } else {
+            const float *a = (const float *)self.values.bytes + range.location;
+            float *c = (float *)inverses + range.location;
+            switch (order) {
+                case 2: MAVInverseBatchKernel2(a, count, c, count, range.length); break;
+                case 3: MAVInverseBatchKernel3(a, count, c, count, range.length); break;
+                default: MAVInverseBatchKernel4(a, count, c, count, range.length); break;
+            }
+        }
+    });
+
+    return [MAVMatrixBatch batchWithValues:[NSData dataWithBytesNoCopy:inverses length:components * count * elementSize]
+                                     order:order
+                                     count:count];
+}
+
+- (NSData *)transformVectorValues:(NSData *)vectorValues
+{
+    int order = (int)self.order;
+    MCKPrecision precision = self.precision;
+    size_t elementSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    size_t vectorCount = vectorValues.length / (order * elementSize);
+    NSAssert(vectorValues.length == vectorCount * order * elementSize, @"Vector values must have the same precision as the batch and contain a whole number of vectors");
+    NSAssert(vectorCount == self.count || self.count == 1, @"Must supply one vector per matrix, unless the batch contains a single matrix");
+
+    void *transformed = malloc(vectorValues.length);
+
+    MAVEnumerateBatchRanges(vectorCount, ^(NSRange range) {
+        size_t aLocation = self.count == 1 ? 0 : range.location;
+        size_t aStep = self.count == 1 ? 0 : 1;
+
+        if (precision == MCKPrecisionDouble) {
+            MAVTransformBatchKernelD((const double *)self.values.bytes + aLocation, self.count, aStep,
+                                     (const double *)vectorValues.bytes + range.location, vectorCount,
+                                     (double *)transformed + range.location, vectorCount, range.length, order);
+        } else {
+            MAVTransformBatchKernel((const float *)self.values.bytes + aLocation, self.count, aStep,
+                                    (const float *)vectorValues.bytes + range.location, vectorCount,
+                                    (float *)transformed + range.location, vectorCount, range.length, order);
+        }
+    });
+
+    return [NSData dataWithBytesNoCopy:transformed length:vectorValues.length];
+}
+
+#pragma mark - Enumeration
+
+- (void)enumerateMatrixRangesConcurrentlyUsingBlock:(void (^)(NSRange range))block
+{
+    MAVEnumerateBatchRanges(self.count, block);
+}
+
+@end
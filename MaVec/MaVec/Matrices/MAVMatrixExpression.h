@@ -0,0 +1,119 @@
+//
+//  MAVMatrixExpression.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import <MCKNumerics/MCKNumerics.h>
+
+#import "MAVTypedefs.h"
+
+@class MAVMatrix;
+
+/**
+ @class MAVMatrixExpression
+ @description An immutable, deferred matrix expression built from matrices with products, sums, differences, scalar multiples and transposes. Building an expression only records the operations and checks their dimensions; evaluate computes the whole expression at once. Evaluation rewrites the expression as a sum of scaled matrices and scaled products of matrices, then accumulates every product into the result with GEMM's β parameter and every matrix with axpy, starting from a scaled copy if there are no products. Transposes are passed to BLAS as flags, and conventionally stored matrices are read in their own layout, so an expression like A·B + C·D − αE allocates only its result. A temporary is only allocated for a factor of a product that is itself a sum or a product, like the A + B in (A + B)·C.
+ */
+@interface MAVMatrixExpression : NSObject
+
+/**
+ @property rows
+ @brief The number of rows in the value of the expression.
+ */
+@property (nonatomic, readonly, assign) MAVIndex rows;
+
+/**
+ @property columns
+ @brief The number of columns in the value of the expression.
+ */
+@property (nonatomic, readonly, assign) MAVIndex columns;
+
+/**
+ @property precision
+ @brief The precision of the matrices in the expression, which must all be the same.
+ */
+@property (nonatomic, readonly, assign) MCKPrecision precision;
+
+#pragma mark - Constructors
+
+/**
+ @brief Construct an expression whose value is a matrix.
+ @param matrix The matrix, which should not be mutated until any expression containing it has been evaluated.
+ @return A new MAVMatrixExpression object.
+ */
++ (instancetype)expressionWithMatrix:(MAVMatrix *)matrix;
+
+#pragma mark - Operations
+
+/**
+ @return A new expression for the product of this expression and another (self · expression). Raises an NSInternalInconsistencyException if the dimensions or precisions do not agree.
+ */
+- (MAVMatrixExpression *)expressionByMultiplyingByExpression:(MAVMatrixExpression *)expression;
+
+/**
+ @return A new expression for the product of this expression and a matrix (self · matrix).
+ */
+- (MAVMatrixExpression *)expressionByMultiplyingByMatrix:(MAVMatrix *)matrix;
+
+/**
+ @return A new expression for the sum of this expression and another. Raises an NSInternalInconsistencyException if the dimensions or precisions do not agree.
+ */
+- (MAVMatrixExpression *)expressionByAddingExpression:(MAVMatrixExpression *)expression;
+
+/**
+ @return A new expression for the sum of this expression and a matrix.
+ */
+- (MAVMatrixExpression *)expressionByAddingMatrix:(MAVMatrix *)matrix;
+
+/**
+ @return A new expression for the difference of this expression and another (self - expression). Raises an NSInternalInconsistencyException if the dimensions or precisions do not agree.
+ */
+- (MAVMatrixExpression *)expressionBySubtractingExpression:(MAVMatrixExpression *)expression;
+
+/**
+ @return A new expression for the difference of this expression and a matrix (self - matrix).
+ */
+- (MAVMatrixExpression *)expressionBySubtractingMatrix:(MAVMatrix *)matrix;
+
+/**
+ @return A new expression for the product of this expression and a scalar.
+ */
+- (MAVMatrixExpression *)expressionByMultiplyingByScalar:(NSNumber *)scalar;
+
+/**
+ @return A new expression for the transpose of this expression.
+ */
+- (MAVMatrixExpression *)transposedExpression;
+
+#pragma mark - Evaluation
+
+/**
+ @brief Compute the value of the expression.
+ @return A new MAVMatrix object with column-major conventional storage.
+ */
+- (MAVMatrix *)evaluate;
+
+@end
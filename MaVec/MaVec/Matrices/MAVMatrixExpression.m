@@ -0,0 +1,377 @@
+//
+//  MAVMatrixExpression.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Accelerate/Accelerate.h>
+
+#import "MAVLAPACKInteger.h"
+#import "MAVMatrixExpression.h"
+#import "MAVMatrix.h"
+#import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVParallel.h"
+
+typedef enum : UInt8 {
+    MAVMatrixExpressionTypeMatrix,
+    MAVMatrixExpressionTypeProduct,
+    MAVMatrixExpressionTypeSum,
+    MAVMatrixExpressionTypeScalarMultiple,
+    MAVMatrixExpressionTypeTranspose
+}
+/**
+ Constants describing the operation at the root of an expression.
+ */
+MAVMatrixExpressionType;
+
+/**
+ @brief One term of an expression rewritten as a sum: a scaled matrix if right is nil, otherwise a scaled product of two matrices, either of which may be transposed.
+ */
+@interface MAVMatrixExpressionTerm : NSObject
+
+@property (assign, nonatomic) double coefficient;
+@property (strong, nonatomic) MAVMatrix *left;
+@property (assign, nonatomic) BOOL leftTransposed;
+@property (strong, nonatomic) MAVMatrix *right;
+@property (assign, nonatomic) BOOL rightTransposed;
+
+@end
+
+@implementation MAVMatrixExpressionTerm
+
+@end
+
+/**
+ @brief Find the values of a matrix to pass to BLAS as a column-major operand. Conventionally stored values are used in place, since row-major values are the column-major values of the transpose; packed and band values are unpacked.
+ @param transposed YES if the operand is the transpose of the matrix.
+ @param transpose Set to the transposition BLAS must apply to the returned values to obtain the operand.
+ @param leadingDimension Set to the distance between the columns of the returned values.
+ */
+static NSData *MAVColumnMajorOperandValues(MAVMatrix *matrix, BOOL transposed, enum CBLAS_TRANSPOSE *transpose, MAVIndex *leadingDimension)
+{
+    NSData *values;
+    BOOL isRowMajor;
+    if (matrix.packingMethod == MAVMatrixValuePackingMethodConventional) {
+        values = matrix.values;
+        isRowMajor = matrix.leadingDimension == MAVMatrixLeadingDimensionRow;
+    } else {
+        values = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+        isRowMajor = NO;
+    }
+    *transpose = transposed != isRowMajor ? CblasTrans : CblasNoTrans;
+    *leadingDimension = isRowMajor ? matrix.columns : matrix.rows;
+    return values;
+}
+
+@interface MAVMatrixExpression ()
+
+@property (nonatomic, readwrite, assign) MAVIndex rows;
+@property (nonatomic, readwrite, assign) MAVIndex columns;
+@property (nonatomic, readwrite, assign) MCKPrecision precision;
+
+@property (assign, nonatomic) MAVMatrixExpressionType type;
+@property (strong, nonatomic) MAVMatrix *matrix;
+@property (strong, nonatomic) MAVMatrixExpression *left;
+@property (strong, nonatomic) MAVMatrixExpression *right;
+@property (assign, nonatomic) double scalar;
+
+@end
+
+@implementation MAVMatrixExpression
+
+#pragma mark - Constructors
+
++ (instancetype)expressionWithMatrix:(MAVMatrix *)matrix
+{
+    MAVMatrixExpression *expression = [[self alloc] init];
+    expression.type = MAVMatrixExpressionTypeMatrix;
+    expression.matrix = matrix;
+    expression.rows = matrix.rows;
+    expression.columns = matrix.columns;
+    expression.precision = matrix.precision;
+    return expression;
+}
+
+#pragma mark - Operations
+
+- (MAVMatrixExpression *)expressionByMultiplyingByExpression:(MAVMatrixExpression *)expression
+{
+    NSAssert(self.columns == expression.rows, @"self does not have an equal amount of columns as rows in expression");
+    NSAssert(self.precision == expression.precision, @"Precisions do not match.");
+    
+    MAVMatrixExpression *product = [[MAVMatrixExpression alloc] init];
+    product.type = MAVMatrixExpressionTypeProduct;
+    product.left = self;
+    product.right = expression;
+    product.rows = self.rows;
+    product.columns = expression.columns;
+    product.precision = self.precision;
+    return product;
+}
+
+- (MAVMatrixExpression *)expressionByMultiplyingByMatrix:(MAVMatrix *)matrix
+{
+    return [self expressionByMultiplyingByExpression:[MAVMatrixExpression expressionWithMatrix:matrix]];
+}
+
+- (MAVMatrixExpression *)expressionByAddingExpression:(MAVMatrixExpression *)expression
+{
+    NSAssert(self.rows == expression.rows, @"Expressions have mismatched amounts of rows.");
+    NSAssert(self.columns == expression.columns, @"Expressions have mismatched amounts of columns.");
+    NSAssert(self.precision == expression.precision, @"Precisions do not match.");
+    
+    MAVMatrixExpression *sum = [[MAVMatrixExpression alloc] init];
+    sum.type = MAVMatrixExpressionTypeSum;
+    sum.left = self;
+    sum.right = expression;
+    sum.rows = self.rows;
+    sum.columns = self.columns;
+    sum.precision = self.precision;
+    return sum;
+}
+
+- (MAVMatrixExpression *)expressionByAddingMatrix:(MAVMatrix *)matrix
+{
+    return [self expressionByAddingExpression:[MAVMatrixExpression expressionWithMatrix:matrix]];
+}
+
+- (MAVMatrixExpression *)expressionBySubtractingExpression:(MAVMatrixExpression *)expression
+{
+    return [self expressionByAddingExpression:[expression expressionByMultiplyingByScalar:@(-1.0)]];
+}
+
+- (MAVMatrixExpression *)expressionBySubtractingMatrix:(MAVMatrix *)matrix
+{
+    return [self expressionBySubtractingExpression:[MAVMatrixExpression expressionWithMatrix:matrix]];
+}
+
+- (MAVMatrixExpression *)expressionByMultiplyingByScalar:(NSNumber *)scalar
+{
+    MAVMatrixExpression *multiple = [[MAVMatrixExpression alloc] init];
+    multiple.type = MAVMatrixExpressionTypeScalarMultiple;
+    multiple.left = self;
+    multiple.scalar = scalar.doubleValue;
+    multiple.rows = self.rows;
+    multiple.columns = self.columns;
+    multiple.precision = self.precision;
+    return multiple;
+}
+
+- (MAVMatrixExpression *)transposedExpression
+{
+    MAVMatrixExpression *transpose = [[MAVMatrixExpression alloc] init];
+    transpose.type = MAVMatrixExpressionTypeTranspose;
+    transpose.left = self;
+    transpose.rows = self.columns;
+    transpose.columns = self.rows;
+    transpose.precision = self.precision;
+    return transpose;
+}
+
+#pragma mark - Evaluation
+
+- (MAVMatrix *)evaluate
+{
+    NSArray *terms = [self terms];
+    
+    size_t valueCount = self.rows * self.columns;
+    size_t size = valueCount * (self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
+    void *values = malloc(size);
+    
+    // products go first, so the first one can overwrite the uninitialized result with β = 0
+    BOOL initialized = NO;
+    for (MAVMatrixExpressionTerm *term in terms) {
+        if (term.right != nil) {
+            [self accumulateProductTerm:term intoValues:values initialized:initialized];
+            initialized = YES;
+        }
+    }
+    for (MAVMatrixExpressionTerm *term in terms) {
+        if (term.right == nil) {
+            [self accumulateMatrixTerm:term intoValues:values initialized:initialized];
+            initialized = YES;
+        }
+    }
+    
+    return [MAVMatrix matrixWithValues:[NSData dataWithBytesNoCopy:values length:size] rows:self.rows columns:self.columns];
+}
+
+#pragma mark - Private
+
+/**
+ @brief Rewrite this expression as a sum of scaled matrices and scaled products of two matrices. Factors of products which are not a single scaled matrix are evaluated into temporary matrices.
+ @return An array of MAVMatrixExpressionTerm objects.
+ */
+- (NSArray *)terms
+{
+    switch (self.type) {
+            
+        case MAVMatrixExpressionTypeMatrix: {
+            MAVMatrixExpressionTerm *term = [[MAVMatrixExpressionTerm alloc] init];
+            term.coefficient = 1.0;
+            term.left = self.matrix;
+            return @[term];
+        }
+            
+        case MAVMatrixExpressionTypeSum:
+            return [[self.left terms] arrayByAddingObjectsFromArray:[self.right terms]];
+            
+        case MAVMatrixExpressionTypeScalarMultiple: {
+            NSArray *terms = [self.left terms];
+            for (MAVMatrixExpressionTerm *term in terms) {
+                term.coefficient *= self.scalar;
+            }
+            return terms;
+        }
+            
+        case MAVMatrixExpressionTypeTranspose: {
+            // (αA)ᵀ = αAᵀ and (αAB)ᵀ = αBᵀAᵀ
+            NSArray *terms = [self.left terms];
+            for (MAVMatrixExpressionTerm *term in terms) {
+                if (term.right == nil) {
+                    term.leftTransposed = !term.leftTransposed;
+                } else {
+                    MAVMatrix *left = term.left;
+                    BOOL leftTransposed = term.leftTransposed;
+                    term.left = term.right;
+                    term.leftTransposed = !term.rightTransposed;
+                    term.right = left;
+                    term.rightTransposed = !leftTransposed;
+                }
+            }
+            return terms;
+        }
+            
+        case MAVMatrixExpressionTypeProduct: {
+            MAVMatrixExpressionTerm *leftFactor = [self.left factorTerm];
+            MAVMatrixExpressionTerm *rightFactor = [self.right factorTerm];
+            MAVMatrixExpressionTerm *term = [[MAVMatrixExpressionTerm alloc] init];
+            term.coefficient = leftFactor.coefficient * rightFactor.coefficient;
+            term.left = leftFactor.left;
+            term.leftTransposed = leftFactor.leftTransposed;
+            term.right = rightFactor.left;
+            term.rightTransposed = rightFactor.leftTransposed;
+            return @[term];
+        }
+            
+        default: return nil;
+    }
+}
+
+/**
+ @return A single term holding a scaled, possibly transposed matrix with the value of this expression, evaluating the expression into a temporary matrix unless it already is one.
+ */
+- (MAVMatrixExpressionTerm *)factorTerm
+{
+    NSArray *terms = [self terms];
+    MAVMatrixExpressionTerm *term = terms.firstObject;
+    if (terms.count != 1 || term.right != nil) {
+        term = [[MAVMatrixExpressionTerm alloc] init];
+        term.coefficient = 1.0;
+        term.left = [self evaluate];
+    }
+    return term;
+}
+
+- (void)accumulateProductTerm:(MAVMatrixExpressionTerm *)term intoValues:(void *)values initialized:(BOOL)initialized
+{
+    enum CBLAS_TRANSPOSE leftTranspose, rightTranspose;
+    MAVIndex leftLeadingDimension, rightLeadingDimension;
+    NSData *leftValues = MAVColumnMajorOperandValues(term.left, term.leftTransposed, &leftTranspose, &leftLeadingDimension);
+    NSData *rightValues = MAVColumnMajorOperandValues(term.right, term.rightTransposed, &rightTranspose, &rightLeadingDimension);
+    MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(self.rows);
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(self.columns);
+    MAVLAPACKInteger k = MAVLAPACKIntegerFromIndex(term.leftTransposed ? term.left.rows : term.left.columns);
+    MAVLAPACKInteger lda = MAVLAPACKIntegerFromIndex(leftLeadingDimension);
+    MAVLAPACKInteger ldb = MAVLAPACKIntegerFromIndex(rightLeadingDimension);
+    
+    if (self.precision == MCKPrecisionDouble) {
+        cblas_dgemm(CblasColMajor, leftTranspose, rightTranspose, m, n, k, term.coefficient, leftValues.bytes, lda, rightValues.bytes, ldb, initialized ? 1.0 : 0.0, values, m);
+    } else {
+        cblas_sgemm(CblasColMajor, leftTranspose, rightTranspose, m, n, k, (float)term.coefficient, leftValues.bytes, lda, rightValues.bytes, ldb, initialized ? 1.0f : 0.0f, values, m);
+    }
+}
+
+- (void)accumulateMatrixTerm:(MAVMatrixExpressionTerm *)term intoValues:(void *)values initialized:(BOOL)initialized
+{
+    enum CBLAS_TRANSPOSE transpose;
+    MAVIndex leadingDimension;
+    NSData *termValues = MAVColumnMajorOperandValues(term.left, term.leftTransposed, &transpose, &leadingDimension);
+    MAVIndex rows = self.rows;
+    
+    if (transpose == CblasNoTrans) {
+        // the values are already laid out like the result, so scale or accumulate them in one pass
+        size_t valueCount = self.rows * self.columns;
+        if (self.precision == MCKPrecisionDouble) {
+            const double *source = termValues.bytes;
+            double coefficient = term.coefficient;
+            MAVParallelForRanges(valueCount, 1, ^(NSRange range) {
+                if (initialized) {
+                    vDSP_vsmaD(source + range.location, 1, &coefficient, (double *)values + range.location, 1, (double *)values + range.location, 1, range.length);
+                } else {
+                    vDSP_vsmulD(source + range.location, 1, &coefficient, (double *)values + range.location, 1, range.length);
+                }
+            });
+        } else {
+            const float *source = termValues.bytes;
+            float coefficient = (float)term.coefficient;
+            MAVParallelForRanges(valueCount, 1, ^(NSRange range) {
+                if (initialized) {
+                    vDSP_vsma(source + range.location, 1, &coefficient, (float *)values + range.location, 1, (float *)values + range.location, 1, range.length);
+                } else {
+                    vDSP_vsmul(source + range.location, 1, &coefficient, (float *)values + range.location, 1, range.length);
+                }
+            });
+        }
+    } else {
+        // each column of the result is a row of the values, read with a stride of the leading dimension
+        if (self.precision == MCKPrecisionDouble) {
+            const double *source = termValues.bytes;
+            double coefficient = term.coefficient;
+            MAVParallelForRanges(self.columns, rows, ^(NSRange range) {
+                for (size_t col = range.location; col < NSMaxRange(range); col++) {
+                    if (initialized) {
+                        vDSP_vsmaD(source + col, leadingDimension, &coefficient, (double *)values + col * rows, 1, (double *)values + col * rows, 1, rows);
+                    } else {
+                        vDSP_vsmulD(source + col, leadingDimension, &coefficient, (double *)values + col * rows, 1, rows);
+                    }
+                }
+            });
+        } else {
+            const float *source = termValues.bytes;
+            float coefficient = (float)term.coefficient;
+            MAVParallelForRanges(self.columns, rows, ^(NSRange range) {
+                for (size_t col = range.location; col < NSMaxRange(range); col++) {
+                    if (initialized) {
+                        vDSP_vsma(source + col, leadingDimension, &coefficient, (float *)values + col * rows, 1, (float *)values + col * rows, 1, rows);
+                    } else {
+                        vDSP_vsmul(source + col, leadingDimension, &coefficient, (float *)values + col * rows, 1, rows);
+                    }
+                }
+            });
+        }
+    }
+}
+
+@end
@@ -153,4 +153,45 @@
  */
 - (MAVMutableMatrix *)subtractMatrix:(MAVMatrix *)matrix;
 
+/**
+ *  Replaces the receiving symmetric matrix C with alpha * AᵀA + beta * C in
+ *  place using a symmetric rank-k update, which only computes one triangle of
+ *  the result and keeps packed storage packed.
+ *
+ *  @param matrix The matrix A whose Gram matrix AᵀA is accumulated.
+ *  @param alpha  The scalar multiplying AᵀA.
+ *  @param beta   The scalar multiplying the receiving matrix. If 0, the
+ *  receiving matrix' previous values are ignored.
+ *
+ *  @warning Raises an NSInternalInconsistencyException, in builds with
+ *  assertions enabled, if the receiving matrix is not square of order A.cols,
+ *  or if it is not symmetric and beta ≠ 0.
+ *
+ *  @return A reference to the receiving matrix.
+ */
+- (MAVMutableMatrix *)updateWithGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                             alpha:(NSNumber *)alpha
+                                              beta:(NSNumber *)beta;
+
+/**
+ *  Replaces the receiving symmetric matrix C with alpha * AAᵀ + beta * C in
+ *  place using a symmetric rank-k update, like
+ *  updateWithGramMatrixOfMatrix:alpha:beta: but with the outer Gram matrix of
+ *  A, whose entries are the dot products of its rows.
+ *
+ *  @param matrix The matrix A whose outer Gram matrix AAᵀ is accumulated.
+ *  @param alpha  The scalar multiplying AAᵀ.
+ *  @param beta   The scalar multiplying the receiving matrix. If 0, the
+ *  receiving matrix' previous values are ignored.
+ *
+ *  @warning Raises an NSInternalInconsistencyException, in builds with
+ *  assertions enabled, if the receiving matrix is not square of order A.rows,
+ *  or if it is not symmetric and beta ≠ 0.
+ *
+ *  @return A reference to the receiving matrix.
+ */
+- (MAVMutableMatrix *)updateWithOuterGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                                  alpha:(NSNumber *)alpha
+                                                   beta:(NSNumber *)beta;
+
 @end
@@ -28,18 +28,95 @@
 #import <Accelerate/Accelerate.h>
 #import <MCKNumerics/MCKNumerics.h>
 
+#import "MAVCholeskyFactorization.h"
 #import "MAVConstants.h"
+#import "MAVEigendecomposition.h"
+#import "MAVLAPACKInteger.h"
+#import "MAVLUFactorization.h"
 #import "MAVMatrix-Protected.h"
 #import "MAVMutableMatrix-Protected.h"
 #import "MAVMutableMatrix.h"
+#import "MAVMutableVector.h"
+#import "MAVParallel.h"
+#import "MAVQRFactorization.h"
+#import "MAVSingularValueDecomposition.h"
 #import "MAVVector.h"
 
-@interface MAVMutableMatrix ()
+/**
+ How a mutating operation affects the lazily computed properties of a matrix, as masks built with MAVMatrixLazyPropertyMask. Properties in neither mask are reset, and symmetry is tracked separately by each operation.
+ */
+typedef struct {
+    // properties whose values the operation leaves unchanged
+    UInt32 preserved;
+    
+    // properties whose new values are cheaply derived from their old ones, when they are cached
+    UInt32 transformed;
+} MAVMatrixPropertyDependencies;
+
+#define MAVMatrixLazyPropertyNormsMask (MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyNormInfinity) | MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyNormL1) | MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyNormMax) | MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyNormFroebenius))
+
+static const MAVMatrixPropertyDependencies MAVMatrixPropertyDependenciesOfOperation[] = {
+    // permuting rows or columns permutes the inverse and singular vectors, flips the sign of the determinant and keeps the norms
+    [MAVMatrixMutatingOperationRowSwap] = {
+        .preserved = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyZero) |
+                     MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyConditionNumber) |
+                     MAVMatrixLazyPropertyNormsMask,
+        .transformed = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyTranspose) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyDeterminant) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyInverse) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyQRFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyLUFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertySingularValueDecomposition)
+    },
+    [MAVMatrixMutatingOperationColumnSwap] = {
+        .preserved = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyZero) |
+                     MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyConditionNumber) |
+                     MAVMatrixLazyPropertyNormsMask,
+        .transformed = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyTranspose) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyDeterminant) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyInverse) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyQRFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertySingularValueDecomposition)
+    },
+    
+    // assignments are low-rank changes, which only the orthogonal and Cholesky factorizations can follow stably
+    [MAVMatrixMutatingOperationAssignmentValue] = {
+        .transformed = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyQRFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyCholeskyFactorization)
+    },
+    [MAVMatrixMutatingOperationAssignmentRow] = {
+        .transformed = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyQRFactorization)
+    },
+    [MAVMatrixMutatingOperationAssignmentColumn] = {
+        .transformed = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyQRFactorization)
+    },
+    
+    // a nonzero scalar rescales nearly everything: see scaledValue:ofProperty:byScalar:
+    [MAVMatrixMutatingOperationMutliplyScalar] = {
+        .preserved = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyZero) |
+                     MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyConditionNumber),
+        .transformed = MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyTranspose) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyDeterminant) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyInverse) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyQRFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyLUFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyCholeskyFactorization) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertySingularValueDecomposition) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyEigendecomposition) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyDefiniteness) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyDiagonalValues) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyTrace) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyMinorMatrix) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyCofactorMatrix) |
+                       MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertyAdjugate) |
+                       MAVMatrixLazyPropertyNormsMask
+    },
+};
 
-@property (strong, nonatomic, readwrite) NSMutableData *values;
+@interface MAVMutableMatrix ()
 
 /**
- *  Reset the calculated state data of this matrix if a mutable operation invalidates it.
+ *  Reset the calculated state data of this matrix if a mutable operation invalidates it, keeping the properties the operation preserves and transforming the ones it can update cheaply, as listed in MAVMatrixPropertyDependenciesOfOperation. Must be called before the operation changes any values.
  *
  *  @param operation The mutating operation being performed on this matrix.
  *  @param input     The input to the mutating operation.
@@ -52,12 +129,89 @@
                              atRow:(MAVIndex)row
                             column:(MAVIndex)column;
 
+/**
+ *  Store a value at a position specified by row and column without invalidating any state, for mutations that invalidate it once for all the values they change.
+ *
+ *  @param value  The value to store.
+ *  @param row    The row in which the value will be stored.
+ *  @param column The column in which the value will be stored.
+ */
+- (void)storeValue:(NSNumber *)value atRow:(MAVIndex)row column:(MAVIndex)column;
+
+/**
+ *  Compute the value a cached property of this matrix will have after a mutation from its value before it, which must be called before the mutation changes any values.
+ *
+ *  @return The transformed value, or nil if none was cached or the operation cannot transform it.
+ */
+- (id)transformedValueOfProperty:(MAVMatrixLazyProperty)property
+                    forOperation:(MAVMatrixMutatingOperation)operation
+                           input:(id)input
+                           atRow:(MAVIndex)row
+                          column:(MAVIndex)column;
+
+/**
+ *  Compute the value of a property of this matrix after exchanging two of its rows or columns, from its cached value.
+ *
+ *  @param rows YES if rows are exchanged, NO if columns are.
+ */
+- (id)permutedValue:(id)value
+         ofProperty:(MAVMatrixLazyProperty)property
+     bySwappingRows:(BOOL)rows
+             indexA:(MAVIndex)indexA
+             indexB:(MAVIndex)indexB;
+
+/**
+ *  Compute the value of a property of this matrix after multiplying it by a nonzero scalar, from its cached value.
+ */
+- (id)scaledValue:(id)value
+       ofProperty:(MAVMatrixLazyProperty)property
+         byScalar:(NSNumber *)scalar;
+
+/**
+ *  Compute the factorizations of this matrix after a mutation from the cached factorizations before it, which must be called before the mutation changes any values.
+ *
+ *  @return The updated factorization, or nil if none was cached or the mutation has no stable update, in which case the matrix is refactored when the factorization is next needed.
+ */
+- (MAVQRFactorization *)qrFactorizationUpdatedForOperation:(MAVMatrixMutatingOperation)operation
+                                                     input:(id)input
+                                                     atRow:(MAVIndex)row
+                                                    column:(MAVIndex)column;
+- (MAVLUFactorization *)luFactorizationUpdatedForOperation:(MAVMatrixMutatingOperation)operation
+                                                     input:(id)input
+                                                     atRow:(MAVIndex)row
+                                                    column:(MAVIndex)column;
+- (MAVCholeskyFactorization *)choleskyFactorizationUpdatedForOperation:(MAVMatrixMutatingOperation)operation
+                                                                 input:(id)input
+                                                                 atRow:(MAVIndex)row
+                                                                column:(MAVIndex)column;
+
+/**
+ *  Replace this symmetric matrix C with alpha * AᵀA + beta * C, or alpha * AAᵀ + beta * C if ofColumns is NO, after the order of C has been checked.
+ */
+- (MAVMutableMatrix *)updateWithGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                         ofColumns:(BOOL)ofColumns
+                                             alpha:(NSNumber *)alpha
+                                              beta:(NSNumber *)beta;
+
+/**
+ *  Compute the Cholesky factorization of beta * self + alpha * AᵀA (or AAᵀ if ofColumns is NO) from the cached factorization of this matrix with one rank-one update or downdate per row (or column) of A, when A has fewer of them than this matrix has rows.
+ *
+ *  @return The updated factorization, or nil if none was cached, beta is not positive, A has too many rows (or columns) or a downdate failed.
+ */
+- (MAVCholeskyFactorization *)choleskyFactorizationUpdatedWithGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                                                       ofColumns:(BOOL)ofColumns
+                                                                           alpha:(NSNumber *)alpha
+                                                                            beta:(NSNumber *)beta;
+
+/**
+ *  Create a vector with a single nonzero value, in the precision of this matrix.
+ */
+- (MAVVector *)unitVectorOfLength:(MAVIndex)length index:(MAVIndex)index scale:(double)scale;
+
 @end
 
 @implementation MAVMutableMatrix
 
-@dynamic values;
-
 #pragma mark - Public
 
 - (void)swapRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB
@@ -65,18 +219,18 @@
     NSAssert1(rowA < self.rows, @"rowA = %lld is outside the range of possible rows.", (long long int)rowA);
     NSAssert1(rowB < self.rows, @"rowB = %lld is outside the range of possible rows.", (long long int)rowB);
     
+    [self invalidateStateIfOperation:MAVMatrixMutatingOperationRowSwap
+              notIdempotentWithInput:nil
+                               atRow:rowA
+                              column:rowB];
+    
     // TODO: implement using cblas_dswap
     
     for (MAVIndex i = 0; i < self.columns; i++) {
         NSNumber *temp = [self valueAtRow:rowA column:i];
-        [self setEntryAtRow:rowA column:i toValue:[self valueAtRow:rowB column:i]];
-        [self setEntryAtRow:rowB column:i toValue:temp];
+        [self storeValue:[self valueAtRow:rowB column:i] atRow:rowA column:i];
+        [self storeValue:temp atRow:rowB column:i];
     }
-    
-    [self invalidateStateIfOperation:MAVMatrixMutatingOperationRowSwap
-              notIdempotentWithInput:nil
-                               atRow:rowA
-                              column:rowB];
 }
 
 - (void)swapColumnA:(MAVIndex)columnA withColumnB:(MAVIndex)columnB
@@ -84,18 +238,18 @@
     NSAssert1(columnA < self.columns, @"columnA = %lld is outside the range of possible columns.", (long long int)columnA);
     NSAssert1(columnB < self.columns, @"columnB = %lld is outside the range of possible columns.", (long long int)columnB);
     
+    [self invalidateStateIfOperation:MAVMatrixMutatingOperationColumnSwap
+              notIdempotentWithInput:nil
+                               atRow:columnA
+                              column:columnB];
+    
     // TODO: implement using cblas_dswap
     
     for (MAVIndex i = 0; i < self.rows; i++) {
         NSNumber *temp = [self valueAtRow:i column:columnA];
-        [self setEntryAtRow:i column:columnA toValue:[self valueAtRow:i column:columnB]];
-        [self setEntryAtRow:i column:columnB toValue:temp];
+        [self storeValue:[self valueAtRow:i column:columnB] atRow:i column:columnA];
+        [self storeValue:temp atRow:i column:columnB];
     }
-    
-    [self invalidateStateIfOperation:MAVMatrixMutatingOperationColumnSwap
-              notIdempotentWithInput:nil
-                               atRow:columnA
-                              column:columnB];
 }
 
 - (void)setEntryAtRow:(MAVIndex)row column:(MAVIndex)column toValue:(NSNumber *)value
@@ -111,7 +265,12 @@
               notIdempotentWithInput:value
                                atRow:row
                               column:column];
+    
+    [self storeValue:value atRow:row column:column];
+}
 
+- (void)storeValue:(NSNumber *)value atRow:(MAVIndex)row column:(MAVIndex)column
+{
     size_t index;
     switch (self.packingMethod) {
             
@@ -147,12 +306,12 @@
     if (self.precision == MCKPrecisionDouble) {
         double *newValue = malloc(sizeof(double));
         newValue[0] = value.doubleValue;
-        [self.values replaceBytesInRange:NSMakeRange(index * sizeof(double), sizeof(double)) withBytes:newValue length:sizeof(double)];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(index * sizeof(double), sizeof(double)) withBytes:newValue length:sizeof(double)];
         free(newValue);
     } else {
         float *newValue = malloc(sizeof(float));
         newValue[0] = value.floatValue;
-        [self.values replaceBytesInRange:NSMakeRange(index * sizeof(float), sizeof(float)) withBytes:newValue length:sizeof(float)];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(index * sizeof(float), sizeof(float)) withBytes:newValue length:sizeof(float)];
         free(newValue);
     }
 }
@@ -168,7 +327,7 @@
                               column:kMAVNoCoordinate];
     
     for (MAVIndex i = 0; i < self.columns; i++) {
-        [self setEntryAtRow:row column:i toValue:vector[i]];
+        [self storeValue:vector[i] atRow:row column:i];
     }
 }
 
@@ -183,7 +342,7 @@
                               column:column];
     
     for (MAVIndex i = 0; i < self.rows; i++) {
-        [self setEntryAtRow:i column:column toValue:vector[i]];
+        [self storeValue:vector[i] atRow:i column:column];
     }
 }
 
@@ -203,23 +362,45 @@
         NSData *aVals = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
         NSData *bVals = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
         
+        // infer the structure of the product before overwriting the values: the product is a Gram product when B = Aᵀ (or A is symmetric and B = A), which is known without reading values when one operand shares its values with the other's cached transpose
+        BOOL isGramProduct = NO;
+        if (self.rows == matrix.columns && self.columns == matrix.rows) {
+            isGramProduct = [matrix sharesValuesWithMatrix:[self cachedValueForProperty:MAVMatrixLazyPropertyTranspose]]
+                || [self sharesValuesWithMatrix:[matrix cachedValueForProperty:MAVMatrixLazyPropertyTranspose]]
+                || ([self sharesValuesWithMatrix:matrix] && [[self cachedValueForProperty:MAVMatrixLazyPropertySymmetric] isYes]);
+        }
+        MAVMatrixTriangularComponent triangularComponent = [self inferredTriangularComponent];
+        if (triangularComponent != [matrix inferredTriangularComponent]) {
+            triangularComponent = MAVMatrixTriangularComponentBoth;
+        }
+        
         if (self.precision == MCKPrecisionDouble) {
             size_t size = self.rows * matrix.columns * sizeof(double);
             double *cVals = malloc(size);
             vDSP_mmulD(aVals.bytes, 1, bVals.bytes, 1, cVals, 1, self.rows, matrix.columns, self.columns);
-            [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:cVals length:size];
+            [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:cVals length:size];
             free(cVals);
         } else {
             size_t size = self.rows * matrix.columns * sizeof(float);
             float *cVals = malloc(size);
             vDSP_mmul(aVals.bytes, 1, bVals.bytes, 1, cVals, 1, self.rows, matrix.columns, self.columns);
-            [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:cVals length:size];
+            [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:cVals length:size];
             free(cVals);
         }
         
         self.columns = matrix.columns;
         self.leadingDimension = MAVMatrixLeadingDimensionRow;
-        [self resetToDefaultStateAndBreakSymmetry:NO];
+        self.packingMethod = MAVMatrixValuePackingMethodConventional;
+        [self resetToDefaultStateAndBreakSymmetry:YES];
+        
+        if (isGramProduct) {
+            // AᵀA and AAᵀ are symmetric positive semidefinite
+            self.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+            self.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+        } else if (triangularComponent != MAVMatrixTriangularComponentBoth) {
+            // products of upper (lower) triangular matrices are upper (lower) triangular
+            self.triangularComponent = triangularComponent;
+        }
     }
     
     return self;
@@ -232,16 +413,7 @@
     NSAssert(self.precision == matrix.precision, @"Precisions do not match.");
     
     if (matrix.isZero.isNo) {
-        for (MAVIndex i = 0; i < self.rows; i++) {
-            for (MAVIndex j = 0; j < self.columns; j++) {
-                if (self.precision == MCKPrecisionDouble) {
-                    [self setEntryAtRow:i column:j toValue:@([self valueAtRow:i column:j].doubleValue + [matrix valueAtRow:i column:j].doubleValue)];
-                } else {
-                    [self setEntryAtRow:i column:j toValue:@([self valueAtRow:i column:j].floatValue + [matrix valueAtRow:i column:j].floatValue)];
-                }
-            }
-        }
-        [self resetToDefaultStateAndBreakSymmetry:YES];
+        [self combineValuesWithMatrix:matrix operation:MAVMatrixMutatingOperationAddMatrix];
     }
     
     return self;
@@ -254,16 +426,7 @@
     NSAssert(self.precision == matrix.precision, @"Precisions do not match.");
     
     if (matrix.isZero.isNo) {
-        for (MAVIndex i = 0; i < self.rows; i++) {
-            for (MAVIndex j = 0; j < self.columns; j++) {
-                if (self.precision == MCKPrecisionDouble) {
-                    [self setEntryAtRow:i column:j toValue:@([self valueAtRow:i column:j].doubleValue - [matrix valueAtRow:i column:j].doubleValue)];
-                } else {
-                    [self setEntryAtRow:i column:j toValue:@([self valueAtRow:i column:j].floatValue - [matrix valueAtRow:i column:j].floatValue)];
-                }
-            }
-        }
-        [self resetToDefaultStateAndBreakSymmetry:YES];
+        [self combineValuesWithMatrix:matrix operation:MAVMatrixMutatingOperationSubtractMatrix];
     }
     
     return self;
@@ -276,18 +439,18 @@
     
     short order = self.leadingDimension == MAVMatrixLeadingDimensionColumn ? CblasColMajor : CblasRowMajor;
     short transpose = CblasNoTrans;
-    MAVIndex rows = self.rows;
-    MAVIndex cols = self.columns;
+    MAVLAPACKInteger rows = MAVLAPACKIntegerFromIndex(self.rows);
+    MAVLAPACKInteger cols = MAVLAPACKIntegerFromIndex(self.columns);
     
     if (self.precision == MCKPrecisionDouble) {
         double *result = calloc(vector.length, sizeof(double));
         cblas_dgemv(order, transpose, rows, cols, 1.0, self.values.bytes, rows, vector.values.bytes, 1, 1.0, result, 1);
-        [self.values replaceBytesInRange:NSMakeRange(0, vector.values.length) withBytes:result length:vector.values.length];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, vector.values.length) withBytes:result length:vector.values.length];
         free(result);
     } else {
         float *result = calloc(vector.length, sizeof(float));
         cblas_sgemv(order, transpose, rows, cols, 1.0f, self.values.bytes, rows, vector.values.bytes, 1, 1.0f, result, 1);
-        [self.values replaceBytesInRange:NSMakeRange(0, vector.values.length) withBytes:result length:vector.values.length];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, vector.values.length) withBytes:result length:vector.values.length];
         free(result);
     }
     
@@ -310,27 +473,34 @@
 - (MAVMutableMatrix *)multiplyByScalar:(NSNumber *)scalar
 {
     if (![scalar isEqualToNumber:@1]) {
-        size_t valueCount = self.rows * self.columns;
+        // scaling preserves triangularity, and positive scaling preserves semidefiniteness; cached properties are rescaled rather than reset
+        MAVMatrixTriangularComponent triangularComponent = self.triangularComponent;
+        BOOL preservesPositiveSemidefiniteness = self.positiveSemidefinite.isYes && [scalar compare:@0] == NSOrderedDescending;
+        
+        [self invalidateStateIfOperation:MAVMatrixMutatingOperationMutliplyScalar
+                  notIdempotentWithInput:scalar
+                                   atRow:kMAVNoCoordinate
+                                  column:kMAVNoCoordinate];
+        
+        size_t valueCount = self.values.length / (self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
         if (self.precision == MCKPrecisionDouble) {
-            size_t size = valueCount * sizeof(double);
-            double *values = malloc(size);
-            for (size_t i = 0; i < valueCount; i++) {
-                values[i] = ((double *)self.values.bytes)[i] * scalar.doubleValue;
-            }
-            [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:values];
-            free(values);
+            double *values = self.mutableValues.mutableBytes;
+            double scalarValue = scalar.doubleValue;
+            MAVParallelForRanges(valueCount, 1, ^(NSRange range) {
+                vDSP_vsmulD(values + range.location, 1, &scalarValue, values + range.location, 1, range.length);
+            });
         }
         else {
-            size_t size = valueCount * sizeof(float);
-            float *values = malloc(size);
-            for (size_t i = 0; i < valueCount; i++) {
-                values[i] = ((float *)self.values.bytes)[i] * scalar.floatValue;
-            }
-            [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:values];
-            free(values);
+            float *values = self.mutableValues.mutableBytes;
+            float scalarValue = scalar.floatValue;
+            MAVParallelForRanges(valueCount, 1, ^(NSRange range) {
+                vDSP_vsmul(values + range.location, 1, &scalarValue, values + range.location, 1, range.length);
+            });
+        }
+        self.triangularComponent = triangularComponent;
+        if (preservesPositiveSemidefiniteness) {
+            self.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
         }
-        // ???: should only a subset of derived properties be reset?
-        [self resetToDefaultStateAndBreakSymmetry:NO];
     }
     
     return self;
@@ -341,18 +511,136 @@
     NSAssert(self.rows == self.columns, @"Cannot raise a non-square matrix to exponents.");
     
     MAVMatrix *original = [self copy];
+    BOOL isSymmetric = original.isSymmetric.isYes;
     for (NSUInteger i = 0; i < power - 1; i += 1) {
         [self multiplyByMatrix:original];
     }
     
+    if (isSymmetric && power > 1) {
+        // powers of a symmetric matrix are symmetric; even powers, and any powers of a positive semidefinite matrix, are positive semidefinite
+        self.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+        if (power % 2 == 0 || original.positiveSemidefinite.isYes) {
+            self.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+        }
+    }
+    
     return self;
 }
 
+- (MAVMutableMatrix *)updateWithGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                             alpha:(NSNumber *)alpha
+                                              beta:(NSNumber *)beta
+{
+    NSAssert(self.rows == matrix.columns && self.columns == matrix.columns, @"Receiving matrix must be square of order equal to the amount of columns in matrix.");
+    
+    return [self updateWithGramMatrixOfMatrix:matrix ofColumns:YES alpha:alpha beta:beta];
+}
+
+- (MAVMutableMatrix *)updateWithOuterGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                                  alpha:(NSNumber *)alpha
+                                                   beta:(NSNumber *)beta
+{
+    NSAssert(self.rows == matrix.rows && self.columns == matrix.rows, @"Receiving matrix must be square of order equal to the amount of rows in matrix.");
+    
+    return [self updateWithGramMatrixOfMatrix:matrix ofColumns:NO alpha:alpha beta:beta];
+}
+
 #pragma mark - Private
 
+- (MAVMutableMatrix *)updateWithGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                         ofColumns:(BOOL)ofColumns
+                                             alpha:(NSNumber *)alpha
+                                              beta:(NSNumber *)beta
+{
+    NSAssert(self.precision == matrix.precision, @"Precisions do not match.");
+    BOOL overwritesValues = [beta isEqualToNumber:@0];
+    NSAssert(overwritesValues || self.isSymmetric.isYes, @"Receiving matrix must be symmetric unless it is overwritten (beta = 0).");
+    
+    // sums of positive semidefinite matrices with nonnegative weights are positive semidefinite
+    BOOL preservesPositiveSemidefiniteness = [alpha compare:@0] != NSOrderedAscending && (overwritesValues || ([beta compare:@0] == NSOrderedDescending && self.positiveSemidefinite.isYes));
+    
+    // a few rows change the matrix by a low-rank term, so a cached Cholesky factorization can be updated for less than it costs to refactor
+    MAVCholeskyFactorization *choleskyFactorization = overwritesValues ? nil : [self choleskyFactorizationUpdatedWithGramMatrixOfMatrix:matrix ofColumns:ofColumns alpha:alpha beta:beta];
+    
+    MAVIndex order = self.rows;
+    if (self.packingMethod == MAVMatrixValuePackingMethodBand) {
+        [self convertInternalRepresentationToColumnMajorConventional];
+    }
+    
+    if (self.packingMethod == MAVMatrixValuePackingMethodConventional) {
+        // symmetric values are identical in row- and column-major order, so update them in place
+        [matrix updateSymmetricValues:self.mutableValues.mutableBytes
+                  triangularComponent:MAVMatrixTriangularComponentUpper
+             withGramProductOfColumns:ofColumns
+                                alpha:alpha.doubleValue
+                                 beta:beta.doubleValue];
+        [MAVMatrix mirrorTriangularComponent:MAVMatrixTriangularComponentUpper
+                         ofColumnMajorValues:self.mutableValues.mutableBytes
+                                       order:order
+                                   precision:self.precision];
+    } else {
+        // the upper triangle packed by columns has the same order as the lower triangle packed by rows, and vice versa
+        MAVMatrixTriangularComponent component = (self.triangularComponent == MAVMatrixTriangularComponentUpper) == (self.leadingDimension == MAVMatrixLeadingDimensionColumn)
+        ? MAVMatrixTriangularComponentUpper
+        : MAVMatrixTriangularComponentLower;
+        NSMutableData *columnMajorValues = overwritesValues
+        ? [NSMutableData dataWithLength:order * order * (self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float))]
+        : [NSMutableData dataWithData:[self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn]];
+        [matrix updateSymmetricValues:columnMajorValues.mutableBytes
+                  triangularComponent:component
+             withGramProductOfColumns:ofColumns
+                                alpha:alpha.doubleValue
+                                 beta:beta.doubleValue];
+        self.values = [MAVMatrix packedValuesFromTriangularComponent:component
+                                                 ofColumnMajorValues:columnMajorValues.bytes
+                                                               order:order
+                                                           precision:self.precision];
+    }
+    
+    [self resetToDefaultStateAndBreakSymmetry:NO];
+    self.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    self.choleskyFactorization = choleskyFactorization;
+    if (preservesPositiveSemidefiniteness || choleskyFactorization != nil) {
+        self.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    
+    return self;
+}
+
+- (MAVCholeskyFactorization *)choleskyFactorizationUpdatedWithGramMatrixOfMatrix:(MAVMatrix *)matrix
+                                                                       ofColumns:(BOOL)ofColumns
+                                                                           alpha:(NSNumber *)alpha
+                                                                            beta:(NSNumber *)beta
+{
+    MAVIndex terms = ofColumns ? matrix.rows : matrix.columns;
+    MAVCholeskyFactorization *choleskyFactorization = [self cachedValueForProperty:MAVMatrixLazyPropertyCholeskyFactorization];
+    if (choleskyFactorization == nil || [beta compare:@0] != NSOrderedDescending || terms >= self.rows) {
+        return nil;
+    }
+    
+    // βLLᵀ + αAᵀA = (√β L)(√β L)ᵀ ± Σ (√|α| aᵢ)(√|α| aᵢ)ᵀ over the rows aᵢ of A, or over its columns for AAᵀ
+    if (![beta isEqualToNumber:@1]) {
+        choleskyFactorization = [choleskyFactorization factorizationScaledByScalar:beta];
+    }
+    NSComparisonResult sign = [alpha compare:@0];
+    if (sign == NSOrderedSame) {
+        return choleskyFactorization;
+    }
+    NSNumber *scale = self.precision == MCKPrecisionDouble ? @(sqrt(fabs(alpha.doubleValue))) : @(sqrtf(fabsf(alpha.floatValue)));
+    for (MAVIndex i = 0; i < terms && choleskyFactorization != nil; i += 1) {
+        MAVMutableVector *term = [(ofColumns ? [matrix rowVectorForRow:i] : [matrix columnVectorForColumn:i]) mutableCopy];
+        [term multiplyByScalar:scale];
+        
+        // a failed downdate means the result is no longer safely positive definite, so let it be refactored
+        choleskyFactorization = sign == NSOrderedDescending ? [choleskyFactorization factorizationUpdatedWithVector:term] : [choleskyFactorization factorizationDowndatedWithVector:term];
+    }
+    
+    return choleskyFactorization;
+}
+
 - (void)convertInternalRepresentationToColumnMajorConventional
 {
-    self.values = [NSMutableData dataWithData:[self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn]];
+    self.values = [self valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
     self.packingMethod = MAVMatrixValuePackingMethodConventional;
     self.leadingDimension = MAVMatrixLeadingDimensionColumn;
     self.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
@@ -382,11 +670,17 @@
             
         case MAVMatrixMutatingOperationRowSwap: {
             isIdempotent = [[self rowVectorForRow:row] isEqualToVector:[self rowVectorForRow:column]];
+            if (!isIdempotent && self.isSymmetric.isYes) {
+                preservesSymmetry = MCKTriboolValueNo;
+            }
             break;
         }
 
         case MAVMatrixMutatingOperationColumnSwap: {
             isIdempotent = [[self columnVectorForColumn:row] isEqualToVector:[self columnVectorForColumn:column]];
+            if (!isIdempotent && self.isSymmetric.isYes) {
+                preservesSymmetry = MCKTriboolValueNo;
+            }
             break;
         }
             
@@ -425,7 +719,9 @@
         }
 
         case MAVMatrixMutatingOperationMutliplyScalar: {
-            // handled in multiplyByScalar:
+            NSAssert([input isKindOfClass:[NSNumber class]], @"Input should be of type NSNumber.");
+            isIdempotent = [input isEqualToNumber:@1];
+            preservesSymmetry = MCKTriboolValueYes;
             break;
         }
 
@@ -456,7 +752,350 @@
         [self convertInternalRepresentationToColumnMajorConventional];
     }
     if (!isIdempotent) {
-        [self resetToDefaultStateAndBreakSymmetry:preservesSymmetry == MCKTriboolValueNo];
+        MAVMatrixPropertyDependencies dependencies = MAVMatrixPropertyDependenciesOfOperation[operation];
+        if (operation == MAVMatrixMutatingOperationMutliplyScalar && [input isEqualToNumber:@0]) {
+            // the zero matrix keeps nothing of the matrix it came from
+            dependencies = (MAVMatrixPropertyDependencies){ 0, 0 };
+        }
+        
+        // derive the new values of the cached properties the operation can carry across it, while the old values are still in place
+        __strong id transformedValues[MAVMatrixLazyPropertyCholeskyFactorization + 1] = { nil };
+        for (MAVMatrixLazyProperty property = 0; property <= MAVMatrixLazyPropertyCholeskyFactorization; property += 1) {
+            if ((dependencies.transformed & MAVMatrixLazyPropertyMask(property)) != 0) {
+                transformedValues[property] = [self transformedValueOfProperty:property forOperation:operation input:input atRow:row column:column];
+            }
+        }
+        
+        UInt32 invalidatedProperties = MAVMatrixLazyPropertiesAll & ~dependencies.preserved;
+        if (preservesSymmetry != MCKTriboolValueNo) {
+            invalidatedProperties &= ~MAVMatrixLazyPropertyMask(MAVMatrixLazyPropertySymmetric);
+        }
+        [self resetLazyProperties:invalidatedProperties];
+        
+        for (MAVMatrixLazyProperty property = 0; property <= MAVMatrixLazyPropertyCholeskyFactorization; property += 1) {
+            [self setCachedValue:transformedValues[property] forProperty:property];
+        }
+        if (transformedValues[MAVMatrixLazyPropertyCholeskyFactorization] != nil) {
+            // only positive definite matrices have Cholesky factorizations
+            self.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+        }
+    }
+}
+
+- (id)transformedValueOfProperty:(MAVMatrixLazyProperty)property
+                    forOperation:(MAVMatrixMutatingOperation)operation
+                           input:(id)input
+                           atRow:(MAVIndex)row
+                          column:(MAVIndex)column
+{
+    // factorizations carry across the mutation with O(n²) updates instead of being discarded, where a stable update exists
+    switch (property) {
+        case MAVMatrixLazyPropertyQRFactorization:
+            return [self qrFactorizationUpdatedForOperation:operation input:input atRow:row column:column];
+            
+        case MAVMatrixLazyPropertyLUFactorization:
+            return [self luFactorizationUpdatedForOperation:operation input:input atRow:row column:column];
+            
+        case MAVMatrixLazyPropertyCholeskyFactorization:
+            return [self choleskyFactorizationUpdatedForOperation:operation input:input atRow:row column:column];
+            
+        default:
+            break;
+    }
+    
+    id value = [self cachedValueForProperty:property];
+    if (value == nil) {
+        return nil;
+    }
+    
+    switch (operation) {
+        case MAVMatrixMutatingOperationRowSwap:
+            return [self permutedValue:value ofProperty:property bySwappingRows:YES indexA:row indexB:column];
+            
+        case MAVMatrixMutatingOperationColumnSwap:
+            return [self permutedValue:value ofProperty:property bySwappingRows:NO indexA:row indexB:column];
+            
+        case MAVMatrixMutatingOperationMutliplyScalar:
+            return [self scaledValue:value ofProperty:property byScalar:input];
+            
+        default:
+            return nil;
+    }
+}
+
+- (id)permutedValue:(id)value
+         ofProperty:(MAVMatrixLazyProperty)property
+     bySwappingRows:(BOOL)rows
+             indexA:(MAVIndex)indexA
+             indexB:(MAVIndex)indexB
+{
+    switch (property) {
+        case MAVMatrixLazyPropertyDeterminant: {
+            // a transposition flips the sign of the determinant
+            NSNumber *determinant = value;
+            return self.precision == MCKPrecisionDouble ? @(-determinant.doubleValue) : @(-determinant.floatValue);
+        }
+            
+        case MAVMatrixLazyPropertyTranspose:
+        case MAVMatrixLazyPropertyInverse: {
+            // (PA)ᵀ = AᵀPᵀ and (PA)⁻¹ = A⁻¹Pᵀ, so exchanging rows of A exchanges columns of its transpose and inverse, and vice versa
+            MAVMutableMatrix *matrix = [value mutableCopy];
+            if (rows) {
+                [matrix swapColumnA:indexA withColumnB:indexB];
+            } else {
+                [matrix swapRowA:indexA withRowB:indexB];
+            }
+            return matrix;
+        }
+            
+        case MAVMatrixLazyPropertySingularValueDecomposition: {
+            MAVSingularValueDecomposition *singularValueDecomposition = value;
+            return rows
+            ? [singularValueDecomposition decompositionBySwappingRowA:indexA withRowB:indexB]
+            : [singularValueDecomposition decompositionBySwappingColumnA:indexA withColumnB:indexB];
+        }
+            
+        default:
+            return nil;
+    }
+}
+
+- (id)scaledValue:(id)value
+       ofProperty:(MAVMatrixLazyProperty)property
+         byScalar:(NSNumber *)scalar
+{
+    double alpha = scalar.doubleValue;
+    double factor;
+    switch (property) {
+        case MAVMatrixLazyPropertyTranspose:
+        case MAVMatrixLazyPropertyDiagonalValues:
+        case MAVMatrixLazyPropertyTrace:
+            factor = alpha;
+            break;
+            
+        case MAVMatrixLazyPropertyNormInfinity:
+        case MAVMatrixLazyPropertyNormL1:
+        case MAVMatrixLazyPropertyNormMax:
+        case MAVMatrixLazyPropertyNormFroebenius:
+            factor = fabs(alpha);
+            break;
+            
+        case MAVMatrixLazyPropertyInverse:
+            factor = 1.0 / alpha;
+            break;
+            
+        case MAVMatrixLazyPropertyDeterminant:
+            factor = pow(alpha, self.rows);
+            break;
+            
+        case MAVMatrixLazyPropertyMinorMatrix:
+        case MAVMatrixLazyPropertyCofactorMatrix:
+        case MAVMatrixLazyPropertyAdjugate:
+            // each minor is the determinant of a submatrix of order n - 1
+            factor = pow(alpha, self.rows - 1);
+            break;
+            
+        case MAVMatrixLazyPropertySingularValueDecomposition:
+            return [(MAVSingularValueDecomposition *)value decompositionScaledByScalar:scalar];
+            
+        case MAVMatrixLazyPropertyEigendecomposition:
+            return [(MAVEigendecomposition *)value decompositionScaledByScalar:scalar];
+            
+        case MAVMatrixLazyPropertyDefiniteness: {
+            // a negative scalar negates the quadratic form xᵀAx
+            if (alpha > 0.0) {
+                return value;
+            }
+            switch ((MAVMatrixDefiniteness)[value integerValue]) {
+                case MAVMatrixDefinitenessPositiveDefinite:
+                    return @(MAVMatrixDefinitenessNegativeDefinite);
+                    
+                case MAVMatrixDefinitenessPositiveSemidefinite:
+                    return @(MAVMatrixDefinitenessNegativeSemidefinite);
+                    
+                case MAVMatrixDefinitenessNegativeDefinite:
+                    return @(MAVMatrixDefinitenessPositiveDefinite);
+                    
+                case MAVMatrixDefinitenessNegativeSemidefinite:
+                    return @(MAVMatrixDefinitenessPositiveSemidefinite);
+                    
+                default:
+                    return value;
+            }
+        }
+            
+        default:
+            return nil;
+    }
+    
+    if ([value isKindOfClass:[MAVMatrix class]]) {
+        return [(MAVMutableMatrix *)[value mutableCopy] multiplyByScalar:@(factor)];
+    } else if ([value isKindOfClass:[MAVVector class]]) {
+        return [(MAVMutableVector *)[value mutableCopy] multiplyByScalar:@(factor)];
+    } else {
+        NSNumber *number = value;
+        return self.precision == MCKPrecisionDouble ? @(number.doubleValue * factor) : @((float)(number.floatValue * factor));
+    }
+}
+
+- (MAVQRFactorization *)qrFactorizationUpdatedForOperation:(MAVMatrixMutatingOperation)operation
+                                                     input:(id)input
+                                                     atRow:(MAVIndex)row
+                                                    column:(MAVIndex)column
+{
+    MAVQRFactorization *qrFactorization = [self cachedValueForProperty:MAVMatrixLazyPropertyQRFactorization];
+    if (qrFactorization == nil) {
+        return nil;
+    }
+    
+    // assignments are rank-one updates A + uvᵀ, with u or v a unit vector
+    switch (operation) {
+            
+        case MAVMatrixMutatingOperationRowSwap:
+            return [qrFactorization factorizationBySwappingRowA:row withRowB:column];
+            
+        case MAVMatrixMutatingOperationColumnSwap:
+            return [qrFactorization factorizationBySwappingColumnA:row withColumnB:column];
+            
+        case MAVMatrixMutatingOperationMutliplyScalar:
+            return [qrFactorization factorizationScaledByScalar:input];
+            
+        case MAVMatrixMutatingOperationAssignmentValue: {
+            double difference = ((NSNumber *)input).doubleValue - [self valueAtRow:row column:column].doubleValue;
+            return [qrFactorization factorizationUpdatedWithColumnVector:[self unitVectorOfLength:self.rows index:row scale:1.0]
+                                                               rowVector:[self unitVectorOfLength:self.columns index:column scale:difference]];
+        }
+            
+        case MAVMatrixMutatingOperationAssignmentRow: {
+            MAVMutableVector *difference = [(MAVVector *)input mutableCopy];
+            [difference subtractVector:[self rowVectorForRow:row]];
+            return [qrFactorization factorizationUpdatedWithColumnVector:[self unitVectorOfLength:self.rows index:row scale:1.0]
+                                                               rowVector:difference];
+        }
+            
+        case MAVMatrixMutatingOperationAssignmentColumn: {
+            MAVMutableVector *difference = [(MAVVector *)input mutableCopy];
+            [difference subtractVector:[self columnVectorForColumn:column]];
+            return [qrFactorization factorizationUpdatedWithColumnVector:difference
+                                                               rowVector:[self unitVectorOfLength:self.columns index:column scale:1.0]];
+        }
+            
+        default:
+            return nil;
+    }
+}
+
+- (MAVLUFactorization *)luFactorizationUpdatedForOperation:(MAVMatrixMutatingOperation)operation
+                                                     input:(id)input
+                                                     atRow:(MAVIndex)row
+                                                    column:(MAVIndex)column
+{
+    MAVLUFactorization *luFactorization = [self cachedValueForProperty:MAVMatrixLazyPropertyLUFactorization];
+    if (luFactorization == nil) {
+        return nil;
+    }
+    
+    // without pivoting, only row exchanges and scaling have a stable update
+    switch (operation) {
+            
+        case MAVMatrixMutatingOperationRowSwap:
+            return [luFactorization factorizationBySwappingRowA:row withRowB:column];
+            
+        case MAVMatrixMutatingOperationMutliplyScalar:
+            return [luFactorization factorizationScaledByScalar:input];
+            
+        default:
+            return nil;
+    }
+}
+
+- (MAVCholeskyFactorization *)choleskyFactorizationUpdatedForOperation:(MAVMatrixMutatingOperation)operation
+                                                                 input:(id)input
+                                                                 atRow:(MAVIndex)row
+                                                                column:(MAVIndex)column
+{
+    MAVCholeskyFactorization *choleskyFactorization = [self cachedValueForProperty:MAVMatrixLazyPropertyCholeskyFactorization];
+    if (choleskyFactorization == nil) {
+        return nil;
+    }
+    
+    // positive multiples of a positive definite matrix are positive definite
+    if (operation == MAVMatrixMutatingOperationMutliplyScalar) {
+        return [input compare:@0] == NSOrderedDescending ? [choleskyFactorization factorizationScaledByScalar:input] : nil;
+    }
+    
+    // of the other mutations preserving symmetry, only assigning a diagonal value is a symmetric rank-one change
+    if (operation != MAVMatrixMutatingOperationAssignmentValue || row != column) {
+        return nil;
+    }
+    
+    double difference = ((NSNumber *)input).doubleValue - [self valueAtRow:row column:column].doubleValue;
+    MAVVector *vector = [self unitVectorOfLength:self.rows index:row scale:sqrt(fabs(difference))];
+    
+    // a failed downdate means the matrix is no longer safely positive definite, so let it be refactored
+    return difference > 0.0 ? [choleskyFactorization factorizationUpdatedWithVector:vector] : [choleskyFactorization factorizationDowndatedWithVector:vector];
+}
+
+- (MAVVector *)unitVectorOfLength:(MAVIndex)length index:(MAVIndex)index scale:(double)scale
+{
+    NSMutableData *values;
+    if (self.precision == MCKPrecisionDouble) {
+        values = [NSMutableData dataWithLength:length * sizeof(double)];
+        ((double *)values.mutableBytes)[index] = scale;
+    } else {
+        values = [NSMutableData dataWithLength:length * sizeof(float)];
+        ((float *)values.mutableBytes)[index] = (float)scale;
+    }
+    return [MAVVector vectorWithValues:values length:length];
+}
+
+- (void)combineValuesWithMatrix:(MAVMatrix *)matrix operation:(MAVMatrixMutatingOperation)operation
+{
+    // sums and differences of symmetric (triangular) matrices are symmetric (triangular), and sums of positive semidefinite matrices are positive semidefinite
+    BOOL preservesSymmetry = self.isSymmetric.isYes && matrix.isSymmetric.isYes;
+    BOOL preservesPositiveSemidefiniteness = operation == MAVMatrixMutatingOperationAddMatrix && self.positiveSemidefinite.isYes && matrix.positiveSemidefinite.isYes;
+    MAVMatrixTriangularComponent triangularComponent = [self inferredTriangularComponent];
+    if (triangularComponent != [matrix inferredTriangularComponent]) {
+        triangularComponent = MAVMatrixTriangularComponentBoth;
+    }
+    
+    // packed and band values can be combined directly if both matrices store them identically, otherwise unpack them
+    BOOL hasIdenticalStorage = self.packingMethod == matrix.packingMethod
+    && self.leadingDimension == matrix.leadingDimension
+    && (self.packingMethod == MAVMatrixValuePackingMethodConventional
+        || (self.packingMethod == MAVMatrixValuePackingMethodPacked && self.triangularComponent == matrix.triangularComponent && self.isSymmetric.isYes == matrix.isSymmetric.isYes)
+        || (self.packingMethod == MAVMatrixValuePackingMethodBand && self.bandwidth == matrix.bandwidth && self.upperCodiagonals == matrix.upperCodiagonals));
+    if (!hasIdenticalStorage && self.packingMethod != MAVMatrixValuePackingMethodConventional) {
+        [self convertInternalRepresentationToColumnMajorConventional];
+        hasIdenticalStorage = matrix.packingMethod == MAVMatrixValuePackingMethodConventional && matrix.leadingDimension == MAVMatrixLeadingDimensionColumn;
+    }
+    NSData *otherValues = hasIdenticalStorage ? matrix.values : [matrix valuesWithLeadingDimension:self.leadingDimension];
+    
+    if (self.precision == MCKPrecisionDouble) {
+        vDSP_Length valueCount = self.values.length / sizeof(double);
+        if (operation == MAVMatrixMutatingOperationAddMatrix) {
+            vDSP_vaddD(self.values.bytes, 1, otherValues.bytes, 1, self.mutableValues.mutableBytes, 1, valueCount);
+        } else {
+            vDSP_vsubD(otherValues.bytes, 1, self.values.bytes, 1, self.mutableValues.mutableBytes, 1, valueCount);
+        }
+    } else {
+        vDSP_Length valueCount = self.values.length / sizeof(float);
+        if (operation == MAVMatrixMutatingOperationAddMatrix) {
+            vDSP_vadd(self.values.bytes, 1, otherValues.bytes, 1, self.mutableValues.mutableBytes, 1, valueCount);
+        } else {
+            vDSP_vsub(otherValues.bytes, 1, self.values.bytes, 1, self.mutableValues.mutableBytes, 1, valueCount);
+        }
+    }
+    
+    [self resetToDefaultStateAndBreakSymmetry:!preservesSymmetry];
+    if (preservesSymmetry) {
+        self.symmetric = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    if (preservesPositiveSemidefiniteness) {
+        self.positiveSemidefinite = [MCKTribool triboolWithValue:MCKTriboolValueYes];
+    }
+    if (self.packingMethod == MAVMatrixValuePackingMethodConventional && triangularComponent != MAVMatrixTriangularComponentBoth) {
+        self.triangularComponent = triangularComponent;
     }
 }
 
@@ -27,13 +27,16 @@
 
 #import <Foundation/Foundation.h>
 
+#import "MAVTypedefs.h"
+
 @class MAVMatrix;
+@class MAVVector;
 
 /**
  @brief Container class to hold the results of a QR factorization in MAVMatrix objects.
  @description The QR factorization decomposes a matrix A into the product QR, where Q is an orthogonal matrix and R is an upper triangular matrix.
  */
-@interface MAVQRFactorization : NSObject <NSCopying>
+@interface MAVQRFactorization : NSObject <NSCopying, NSSecureCoding>
 
 /**
  @property q
@@ -75,6 +78,68 @@
  */
 - (MAVQRFactorization *)thinFactorization;
 
+#pragma mark - Updates
+
+/**
+ @description The following methods compute the factorization of a modified matrix from this factorization in O(m²) operations, instead of the O(m²n) needed to factorize it again, by applying Givens rotations to Q and R as described in section 6.5 of Golub and Van Loan, Matrix Computations (4th edition). Orthogonal updates are as stable as refactoring, although rounding errors accumulate slowly over many successive updates. They are only defined for full factorizations, not for thin ones.
+ @brief Compute the factorization of A + uvᵀ from this factorization of the m x n matrix A.
+ @param columnVector The vector u, of length m.
+ @param rowVector The vector v, of length n.
+ @return A new factorization of A + uvᵀ.
+ */
+- (MAVQRFactorization *)factorizationUpdatedWithColumnVector:(MAVVector *)columnVector
+                                                   rowVector:(MAVVector *)rowVector;
+
+/**
+ @brief Compute the factorization of the matrix formed by inserting a row into A, from this factorization of A.
+ @param vector The row to insert, of length n.
+ @param row The index the new row will have, from 0 to m inclusive.
+ @return A new factorization of the (m + 1) x n matrix.
+ */
+- (MAVQRFactorization *)factorizationByInsertingRowVector:(MAVVector *)vector
+                                                    atRow:(MAVIndex)row;
+
+/**
+ @brief Compute the factorization of the matrix formed by removing a row from A, from this factorization of A.
+ @param row The index of the row to remove.
+ @return A new factorization of the (m - 1) x n matrix.
+ */
+- (MAVQRFactorization *)factorizationByRemovingRow:(MAVIndex)row;
+
+/**
+ @brief Compute the factorization of the matrix formed by inserting a column into A, from this factorization of A.
+ @param vector The column to insert, of length m.
+ @param column The index the new column will have, from 0 to n inclusive.
+ @return A new factorization of the m x (n + 1) matrix.
+ */
+- (MAVQRFactorization *)factorizationByInsertingColumnVector:(MAVVector *)vector
+                                                    atColumn:(MAVIndex)column;
+
+/**
+ @brief Compute the factorization of the matrix formed by removing a column from A, from this factorization of A.
+ @param column The index of the column to remove.
+ @return A new factorization of the m x (n - 1) matrix.
+ */
+- (MAVQRFactorization *)factorizationByRemovingColumn:(MAVIndex)column;
+
+/**
+ @brief Compute the factorization of the matrix formed by exchanging two rows of A, which only permutes the rows of Q.
+ @return A new factorization of the permuted matrix.
+ */
+- (MAVQRFactorization *)factorizationBySwappingRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB;
+
+/**
+ @brief Compute the factorization of the matrix formed by exchanging two columns of A, as the rank-one update of A by (aᵦ - aₐ)(eₐ - eᵦ)ᵀ.
+ @return A new factorization of the permuted matrix.
+ */
+- (MAVQRFactorization *)factorizationBySwappingColumnA:(MAVIndex)columnA withColumnB:(MAVIndex)columnB;
+
+/**
+ @brief Compute the factorization of αA from this factorization of A, by scaling R by α.
+ @return A new factorization of αA.
+ */
+- (MAVQRFactorization *)factorizationScaledByScalar:(NSNumber *)scalar;
+
 - (NSString *)description;
 
 @end
@@ -28,16 +28,168 @@
 #import <Accelerate/Accelerate.h>
 #import <MCKNumerics/MCKNumerics.h>
 
+#import "MAVLAPACKInteger.h"
 #import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix-Protected.h"
 #import "MAVMatrix.h"
 #import "MAVMutableMatrix.h"
 #import "MAVQRFactorization.h"
+#import "MAVVector.h"
+
+/**
+ @brief The working state of an update to a QR factorization: the values of Q, m x m, and R, m x n, both column-major in the precision of the factorization.
+ */
+typedef struct {
+    void *q;
+    void *r;
+    MAVIndex rows;
+    MAVIndex columns;
+    MCKPrecision precision;
+} MAVQRUpdate;
+
+static double MAVQRValue(const void *values, size_t index, MCKPrecision precision)
+{
+    return precision == MCKPrecisionDouble ? ((const double *)values)[index] : ((const float *)values)[index];
+}
+
+static void MAVQRSetValue(void *values, size_t index, double value, MCKPrecision precision)
+{
+    if (precision == MCKPrecisionDouble) {
+        ((double *)values)[index] = value;
+    } else {
+        ((float *)values)[index] = (float)value;
+    }
+}
+
+/**
+ @brief Set the values below the diagonal of a column-major matrix to exactly zero, removing the rounding residue left by Householder reflections or rotations so the matrix can be flagged upper triangular without triangular solves and determinants silently ignoring nonzero values.
+ */
+static void MAVQRZeroValuesBelowDiagonal(void *values, MAVIndex rows, MAVIndex columns, MCKPrecision precision)
+{
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    for (MAVIndex column = 0; column < MIN(rows - 1, columns); column++) {
+        uint8_t *below = (uint8_t *)values + ((size_t)column * (size_t)rows + (size_t)column + 1) * valueSize;
+        memset(below, 0, (size_t)(rows - column - 1) * valueSize);
+    }
+}
+
+/**
+ @brief Compute the Givens rotation [c s; -s c] taking (a, b) to (r, 0).
+ */
+static void MAVQRGivens(double a, double b, double *c, double *s)
+{
+    double r = hypot(a, b);
+    if (r == 0.0) {
+        *c = 1.0;
+        *s = 0.0;
+    } else {
+        *c = a / r;
+        *s = b / r;
+    }
+}
+
+/**
+ @brief Rotate rows i and j of R, from the specified column on, and columns i and j of Q by the same Givens rotation, so that their product is unchanged.
+ */
+static void MAVQRRotate(MAVQRUpdate *update, MAVIndex i, MAVIndex j, MAVIndex fromColumn, double c, double s)
+{
+    MAVIndex m = update->rows;
+    MAVLAPACKInteger count = MAVLAPACKIntegerFromIndex(update->columns - fromColumn);
+    MAVLAPACKInteger stride = MAVLAPACKIntegerFromIndex(m);
+    if (update->precision == MCKPrecisionDouble) {
+        double *q = update->q;
+        double *r = update->r;
+        if (count > 0) {
+            cblas_drot(count, r + fromColumn * m + i, stride, r + fromColumn * m + j, stride, c, s);
+        }
+        cblas_drot(stride, q + i * m, 1, q + j * m, 1, c, s);
+    } else {
+        float *q = update->q;
+        float *r = update->r;
+        if (count > 0) {
+            cblas_srot(count, r + fromColumn * m + i, stride, r + fromColumn * m + j, stride, (float)c, (float)s);
+        }
+        cblas_srot(stride, q + i * m, 1, q + j * m, 1, (float)c, (float)s);
+    }
+}
+
+/**
+ @brief Restore R to upper triangular form when it is upper Hessenberg from the specified column on, by zeroing its subdiagonal from the top down.
+ */
+static void MAVQRRetriangularize(MAVQRUpdate *update, MAVIndex fromColumn)
+{
+    MAVIndex m = update->rows;
+    for (MAVIndex k = fromColumn; k < MIN(m - 1, update->columns); k += 1) {
+        double c, s;
+        MAVQRGivens(MAVQRValue(update->r, k * m + k, update->precision), MAVQRValue(update->r, k * m + k + 1, update->precision), &c, &s);
+        MAVQRRotate(update, k, k + 1, k, c, s);
+        MAVQRSetValue(update->r, k * m + k + 1, 0.0, update->precision);
+    }
+}
+
+/**
+ @brief Compute w = Qᵀu.
+ */
+static void MAVQRTransposeProduct(MAVQRUpdate *update, const double *u, double *w)
+{
+    MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(update->rows);
+    if (update->precision == MCKPrecisionDouble) {
+        cblas_dgemv(CblasColMajor, CblasTrans, m, m, 1.0, update->q, m, u, 1, 0.0, w, 1);
+    } else {
+        float *uValues = malloc(m * sizeof(float));
+        float *wValues = malloc(m * sizeof(float));
+        vDSP_vdpsp(u, 1, uValues, 1, m);
+        cblas_sgemv(CblasColMajor, CblasTrans, m, m, 1.0f, update->q, m, uValues, 1, 0.0f, wValues, 1);
+        vDSP_vspdp(wValues, 1, w, 1, m);
+        free(uValues);
+        free(wValues);
+    }
+}
+
+/**
+ @brief Update Q and R in place to factorize QR + Qwvᵀ, overwriting w.
+ */
+static void MAVQRRankOneUpdate(MAVQRUpdate *update, double *w, const double *v)
+{
+    MAVIndex m = update->rows;
+    
+    // reduce w to a multiple of e₁ from the bottom up, which leaves R upper Hessenberg
+    for (MAVIndex k = m - 1; k > 0; k -= 1) {
+        double c, s;
+        MAVQRGivens(w[k - 1], w[k], &c, &s);
+        w[k - 1] = c * w[k - 1] + s * w[k];
+        w[k] = 0.0;
+        MAVQRRotate(update, k - 1, k, MIN(k - 1, update->columns), c, s);
+    }
+    
+    // the update now only touches the first row of R
+    for (MAVIndex j = 0; j < update->columns; j += 1) {
+        size_t index = j * m;
+        MAVQRSetValue(update->r, index, MAVQRValue(update->r, index, update->precision) + w[0] * v[j], update->precision);
+    }
+    
+    MAVQRRetriangularize(update, 0);
+}
+
+static void MAVQRGetDoubleValues(MAVVector *vector, double *values)
+{
+    if (vector.precision == MCKPrecisionDouble) {
+        memcpy(values, vector.values.bytes, vector.length * sizeof(double));
+    } else {
+        vDSP_vspdp(vector.values.bytes, 1, values, 1, vector.length);
+    }
+}
 
 @interface MAVQRFactorization ()
 
 @property (assign, nonatomic) MAVIndex rows;
 @property (assign, nonatomic) MAVIndex columns;
 
+- (MAVQRFactorization *)factorizationWithQValues:(NSData *)qValues
+                                         rValues:(NSData *)rValues
+                                            rows:(MAVIndex)rows
+                                         columns:(MAVIndex)columns;
+
 @end
 
 @implementation MAVQRFactorization
@@ -49,30 +201,30 @@
     // usage can be found at http://publib.boulder.ibm.com/infocenter/clresctr/vxrx/index.jsp?topic=%2Fcom.ibm.cluster.essl.v5r2.essl100.doc%2Fam5gr_hdgeqrf.htm
     self = [super init];
     if (self) {
-        MAVIndex m = matrix.rows;
-        MAVIndex n = matrix.columns;
-        _rows = m;
-        _columns = n;
-        MAVIndex lwork = -1;
-        MAVIndex info;
+        MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(matrix.rows);
+        MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(matrix.columns);
+        _rows = matrix.rows;
+        _columns = matrix.columns;
+        MAVLAPACKInteger lwork = -1;
+        MAVLAPACKInteger info;
         NSData *values = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
         
         NSData *data;
         
         if (matrix.precision == MCKPrecisionDouble) {
-            size_t size = m * m * sizeof(double);
+            size_t size = (size_t)m * m * sizeof(double);
             double *a = malloc(size);
-            for (MAVIndex i = 0; i < m * n; i += 1) {
+            for (MAVIndex i = 0; i < (MAVIndex)m * n; i += 1) {
                 a[i] = ((double *)values.bytes)[i];
             }
-            MAVIndex lda = m;
+            MAVLAPACKInteger lda = m;
             double *tau = malloc(MIN(m, n) * sizeof(double));
             double wkopt;
             
             // query the optimal workspace size
             dgeqrf_(&m, &n, a, &lda, tau, &wkopt, &lwork, &info);
             
-            lwork = (MAVIndex)wkopt;
+            lwork = (MAVLAPACKInteger)wkopt;
             double *work = malloc(lwork * sizeof(double));
             
             // perform the factorization
@@ -85,7 +237,7 @@
             dorgqr_(&m, &m, &n, a, &lda, tau, &wkopt, &lwork, &info);
             
             // extract the matrix
-            lwork = (MAVIndex)wkopt;
+            lwork = (MAVLAPACKInteger)wkopt;
             free(work);
             work = malloc(lwork * sizeof(double));
             dorgqr_(&m, &m, &n, a, &lda, tau, work, &lwork, &info);
@@ -95,19 +247,19 @@
             
             data = [NSData dataWithBytesNoCopy:a length:size];
         } else {
-            size_t size = m * m * sizeof(float);
+            size_t size = (size_t)m * m * sizeof(float);
             float *a = malloc(size);
-            for (MAVIndex i = 0; i < m * n; i += 1) {
+            for (MAVIndex i = 0; i < (MAVIndex)m * n; i += 1) {
                 a[i] = ((float *)values.bytes)[i];
             }
-            MAVIndex lda = m;
+            MAVLAPACKInteger lda = m;
             float *tau = malloc(MIN(m, n) * sizeof(float));
             float wkopt;
             
             // query the optimal workspace size
             sgeqrf_(&m, &n, a, &lda, tau, &wkopt, &lwork, &info);
             
-            lwork = (MAVIndex)wkopt;
+            lwork = (MAVLAPACKInteger)wkopt;
             float *work = malloc(lwork * sizeof(float));
             
             // perform the factorization
@@ -120,7 +272,7 @@
             sorgqr_(&m, &m, &n, a, &lda, tau, &wkopt, &lwork, &info);
             
             // extract the matrix
-            lwork = (MAVIndex)wkopt;
+            lwork = (MAVLAPACKInteger)wkopt;
             free(work);
             work = malloc(lwork * sizeof(float));
             sorgqr_(&m, &m, &n, a, &lda, tau, work, &lwork, &info);
@@ -135,7 +287,13 @@
         _q = [MAVMatrix matrixWithValues:data rows:m columns:m leadingDimension:MAVMatrixLeadingDimensionColumn];
         
         // compute r by multiplying the transpose of q by the input matrix
-        _r = [[_q.transpose mutableCopy] multiplyByMatrix:matrix];
+        MAVMutableMatrix *product = [[_q.transpose mutableCopy] multiplyByMatrix:matrix];
+        NSMutableData *rValues = [[product valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+        
+        // r is upper triangular by construction, but rounding leaves tiny values below its diagonal
+        MAVQRZeroValuesBelowDiagonal(rValues.mutableBytes, m, n, matrix.precision);
+        _r = [MAVMatrix matrixWithValues:rValues rows:m columns:n leadingDimension:MAVMatrixLeadingDimensionColumn];
+        _r.triangularComponent = MAVMatrixTriangularComponentUpper;
     }
     return self;
 }
@@ -164,6 +322,36 @@
     return qrCopy;
 }
 
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:_q forKey:@"q"];
+    [aCoder encodeObject:_r forKey:@"r"];
+    [aCoder encodeInt64:_rows forKey:@"rows"];
+    [aCoder encodeInt64:_columns forKey:@"columns"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (self) {
+        _q = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"q"];
+        _r = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"r"];
+        _rows = (MAVIndex)[aDecoder decodeInt64ForKey:@"rows"];
+        _columns = (MAVIndex)[aDecoder decodeInt64ForKey:@"columns"];
+        if (_q == nil || _r == nil) {
+            return nil;
+        }
+    }
+    return self;
+}
+
 #pragma mark - Operations
 
 - (MAVQRFactorization *)thinFactorization
@@ -182,4 +370,269 @@
     return thin;
 }
 
+#pragma mark - Updates
+
+- (MAVQRFactorization *)factorizationUpdatedWithColumnVector:(MAVVector *)columnVector
+                                                   rowVector:(MAVVector *)rowVector
+{
+    NSAssert2(columnVector.length == self.rows, @"Column vector length (%lld) must equal the amount of rows in the factorized matrix (%lld)", (long long int)columnVector.length, (long long int)self.rows);
+    NSAssert2(rowVector.length == self.columns, @"Row vector length (%lld) must equal the amount of columns in the factorized matrix (%lld)", (long long int)rowVector.length, (long long int)self.columns);
+    NSAssert(columnVector.precision == self.q.precision && rowVector.precision == self.q.precision, @"Precisions do not match.");
+    
+    MAVIndex m = self.rows;
+    MAVIndex n = self.columns;
+    NSMutableData *qValues = [[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSMutableData *rValues = [[self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    MAVQRUpdate update = { qValues.mutableBytes, rValues.mutableBytes, m, n, self.q.precision };
+    
+    double *u = malloc(m * sizeof(double));
+    double *v = malloc(n * sizeof(double));
+    double *w = malloc(m * sizeof(double));
+    MAVQRGetDoubleValues(columnVector, u);
+    MAVQRGetDoubleValues(rowVector, v);
+    
+    // A + uvᵀ = Q(R + wvᵀ) with w = Qᵀu
+    MAVQRTransposeProduct(&update, u, w);
+    MAVQRRankOneUpdate(&update, w, v);
+    
+    free(u);
+    free(v);
+    free(w);
+    
+    return [self factorizationWithQValues:qValues rValues:rValues rows:m columns:n];
+}
+
+- (MAVQRFactorization *)factorizationByInsertingRowVector:(MAVVector *)vector
+                                                    atRow:(MAVIndex)row
+{
+    NSAssert2(vector.length == self.columns, @"Vector length (%lld) must equal the amount of columns in the factorized matrix (%lld)", (long long int)vector.length, (long long int)self.columns);
+    NSAssert2(row >= 0 && row <= self.rows, @"row (%lld) must be <= the amount of rows in the factorized matrix (%lld)", (long long int)row, (long long int)self.rows);
+    NSAssert(vector.precision == self.q.precision, @"Precisions do not match.");
+    
+    MAVIndex m = self.rows;
+    MAVIndex n = self.columns;
+    MAVIndex newM = m + 1;
+    MCKPrecision precision = self.q.precision;
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSData *q = [self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    NSData *r = [self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    NSMutableData *qValues = [NSMutableData dataWithLength:newM * newM * valueSize];
+    NSMutableData *rValues = [NSMutableData dataWithLength:newM * n * valueSize];
+    
+    // with the new row x first, [xᵀ; A] = diag(1, Q)[xᵀ; R], whose R is upper Hessenberg; then move the new row of Q into place
+    MAVQRSetValue(qValues.mutableBytes, row, 1.0, precision);
+    for (MAVIndex i = 0; i < newM; i += 1) {
+        if (i == row) {
+            continue;
+        }
+        MAVIndex oldRow = i < row ? i : i - 1;
+        for (MAVIndex k = 0; k < m; k += 1) {
+            MAVQRSetValue(qValues.mutableBytes, (k + 1) * newM + i, MAVQRValue(q.bytes, k * m + oldRow, precision), precision);
+        }
+    }
+    for (MAVIndex j = 0; j < n; j += 1) {
+        MAVQRSetValue(rValues.mutableBytes, j * newM, MAVQRValue(vector.values.bytes, j, precision), precision);
+        for (MAVIndex i = 0; i < m; i += 1) {
+            MAVQRSetValue(rValues.mutableBytes, j * newM + i + 1, MAVQRValue(r.bytes, j * m + i, precision), precision);
+        }
+    }
+    
+    MAVQRUpdate update = { qValues.mutableBytes, rValues.mutableBytes, newM, n, precision };
+    MAVQRRetriangularize(&update, 0);
+    
+    return [self factorizationWithQValues:qValues rValues:rValues rows:newM columns:n];
+}
+
+- (MAVQRFactorization *)factorizationByRemovingRow:(MAVIndex)row
+{
+    NSAssert2(row >= 0 && row < self.rows, @"row (%lld) must be < the amount of rows in the factorized matrix (%lld)", (long long int)row, (long long int)self.rows);
+    NSAssert(self.rows > 1, @"Cannot remove the only row of a matrix.");
+    
+    MAVIndex m = self.rows;
+    MAVIndex n = self.columns;
+    MAVIndex newM = m - 1;
+    MCKPrecision precision = self.q.precision;
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *q = [[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSMutableData *r = [[self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    MAVQRUpdate update = { q.mutableBytes, r.mutableBytes, m, n, precision };
+    
+    // reduce the removed row of Q to ±e₁ from the right, which leaves R upper Hessenberg; the first column of Q is then ±e at the removed row, and the remaining rows of R are upper triangular
+    for (MAVIndex k = m - 1; k > 0; k -= 1) {
+        double c, s;
+        MAVQRGivens(MAVQRValue(q.bytes, (k - 1) * m + row, precision), MAVQRValue(q.bytes, k * m + row, precision), &c, &s);
+        MAVQRRotate(&update, k - 1, k, MIN(k - 1, n), c, s);
+        MAVQRSetValue(q.mutableBytes, k * m + row, 0.0, precision);
+    }
+    
+    NSMutableData *qValues = [NSMutableData dataWithLength:newM * newM * valueSize];
+    NSMutableData *rValues = [NSMutableData dataWithLength:newM * n * valueSize];
+    for (MAVIndex k = 1; k < m; k += 1) {
+        for (MAVIndex i = 0; i < m; i += 1) {
+            if (i == row) {
+                continue;
+            }
+            MAVIndex newRow = i < row ? i : i - 1;
+            MAVQRSetValue(qValues.mutableBytes, (k - 1) * newM + newRow, MAVQRValue(q.bytes, k * m + i, precision), precision);
+        }
+    }
+    for (MAVIndex j = 0; j < n; j += 1) {
+        for (MAVIndex i = 1; i < m; i += 1) {
+            MAVQRSetValue(rValues.mutableBytes, j * newM + i - 1, MAVQRValue(r.bytes, j * m + i, precision), precision);
+        }
+    }
+    
+    return [self factorizationWithQValues:qValues rValues:rValues rows:newM columns:n];
+}
+
+- (MAVQRFactorization *)factorizationByInsertingColumnVector:(MAVVector *)vector
+                                                    atColumn:(MAVIndex)column
+{
+    NSAssert2(vector.length == self.rows, @"Vector length (%lld) must equal the amount of rows in the factorized matrix (%lld)", (long long int)vector.length, (long long int)self.rows);
+    NSAssert2(column >= 0 && column <= self.columns, @"column (%lld) must be <= the amount of columns in the factorized matrix (%lld)", (long long int)column, (long long int)self.columns);
+    NSAssert(vector.precision == self.q.precision, @"Precisions do not match.");
+    
+    MAVIndex m = self.rows;
+    MAVIndex n = self.columns;
+    MAVIndex newN = n + 1;
+    MCKPrecision precision = self.q.precision;
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *qValues = [[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSData *r = [self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    NSMutableData *rValues = [NSMutableData dataWithLength:m * newN * valueSize];
+    MAVQRUpdate update = { qValues.mutableBytes, rValues.mutableBytes, m, newN, precision };
+    
+    // the new column of R is Qᵀa
+    double *a = malloc(m * sizeof(double));
+    double *w = malloc(m * sizeof(double));
+    MAVQRGetDoubleValues(vector, a);
+    MAVQRTransposeProduct(&update, a, w);
+    for (MAVIndex j = 0; j < newN; j += 1) {
+        for (MAVIndex i = 0; i < m; i += 1) {
+            double value = j == column ? w[i] : MAVQRValue(r.bytes, (j < column ? j : j - 1) * m + i, precision);
+            MAVQRSetValue(rValues.mutableBytes, j * m + i, value, precision);
+        }
+    }
+    free(a);
+    free(w);
+    
+    // zero the new column below the diagonal from the bottom up; the rotated rows only hold values from the new column on, so R stays triangular
+    for (MAVIndex k = m - 1; k > column; k -= 1) {
+        double c, s;
+        MAVQRGivens(MAVQRValue(rValues.bytes, column * m + k - 1, precision), MAVQRValue(rValues.bytes, column * m + k, precision), &c, &s);
+        MAVQRRotate(&update, k - 1, k, column, c, s);
+        MAVQRSetValue(rValues.mutableBytes, column * m + k, 0.0, precision);
+    }
+    
+    return [self factorizationWithQValues:qValues rValues:rValues rows:m columns:newN];
+}
+
+- (MAVQRFactorization *)factorizationByRemovingColumn:(MAVIndex)column
+{
+    NSAssert2(column >= 0 && column < self.columns, @"column (%lld) must be < the amount of columns in the factorized matrix (%lld)", (long long int)column, (long long int)self.columns);
+    NSAssert(self.columns > 1, @"Cannot remove the only column of a matrix.");
+    
+    MAVIndex m = self.rows;
+    MAVIndex newN = self.columns - 1;
+    MCKPrecision precision = self.q.precision;
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *qValues = [[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSMutableData *rValues = [[self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    
+    // removing a column of R leaves it upper Hessenberg from that column on
+    [rValues replaceBytesInRange:NSMakeRange(column * m * valueSize, m * valueSize) withBytes:NULL length:0];
+    MAVQRUpdate update = { qValues.mutableBytes, rValues.mutableBytes, m, newN, precision };
+    MAVQRRetriangularize(&update, column);
+    
+    return [self factorizationWithQValues:qValues rValues:rValues rows:m columns:newN];
+}
+
+- (MAVQRFactorization *)factorizationBySwappingRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB
+{
+    NSAssert1(rowA >= 0 && rowA < self.rows, @"rowA = %lld is outside the range of possible rows.", (long long int)rowA);
+    NSAssert1(rowB >= 0 && rowB < self.rows, @"rowB = %lld is outside the range of possible rows.", (long long int)rowB);
+    
+    MAVIndex m = self.rows;
+    MAVLAPACKInteger count = MAVLAPACKIntegerFromIndex(m);
+    NSMutableData *qValues = [[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    if (self.q.precision == MCKPrecisionDouble) {
+        cblas_dswap(count, (double *)qValues.mutableBytes + rowA, count, (double *)qValues.mutableBytes + rowB, count);
+    } else {
+        cblas_sswap(count, (float *)qValues.mutableBytes + rowA, count, (float *)qValues.mutableBytes + rowB, count);
+    }
+    
+    MAVQRFactorization *factorization = [self copy];
+    factorization->_q = [MAVMatrix matrixWithValues:qValues rows:m columns:m leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    return factorization;
+}
+
+- (MAVQRFactorization *)factorizationBySwappingColumnA:(MAVIndex)columnA withColumnB:(MAVIndex)columnB
+{
+    NSAssert1(columnA >= 0 && columnA < self.columns, @"columnA = %lld is outside the range of possible columns.", (long long int)columnA);
+    NSAssert1(columnB >= 0 && columnB < self.columns, @"columnB = %lld is outside the range of possible columns.", (long long int)columnB);
+    
+    if (columnA == columnB) {
+        return [self copy];
+    }
+    
+    MAVIndex m = self.rows;
+    MAVIndex n = self.columns;
+    MCKPrecision precision = self.q.precision;
+    NSMutableData *qValues = [[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    NSMutableData *rValues = [[self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    MAVQRUpdate update = { qValues.mutableBytes, rValues.mutableBytes, m, n, precision };
+    
+    // Qᵀ(aᵦ - aₐ) is simply rᵦ - rₐ, so no product with Q is needed
+    double *w = malloc(m * sizeof(double));
+    double *v = calloc(n, sizeof(double));
+    for (MAVIndex i = 0; i < m; i += 1) {
+        w[i] = MAVQRValue(rValues.bytes, columnB * m + i, precision) - MAVQRValue(rValues.bytes, columnA * m + i, precision);
+    }
+    v[columnA] = 1.0;
+    v[columnB] = -1.0;
+    MAVQRRankOneUpdate(&update, w, v);
+    free(w);
+    free(v);
+    
+    return [self factorizationWithQValues:qValues rValues:rValues rows:m columns:n];
+}
+
+- (MAVQRFactorization *)factorizationScaledByScalar:(NSNumber *)scalar
+{
+    MAVIndex m = self.rows;
+    MAVIndex n = self.columns;
+    NSMutableData *rValues = [[self.r valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] mutableCopy];
+    if (self.r.precision == MCKPrecisionDouble) {
+        double factor = scalar.doubleValue;
+        vDSP_vsmulD(rValues.mutableBytes, 1, &factor, rValues.mutableBytes, 1, (vDSP_Length)(m * n));
+    } else {
+        float factor = scalar.floatValue;
+        vDSP_vsmul(rValues.mutableBytes, 1, &factor, rValues.mutableBytes, 1, (vDSP_Length)(m * n));
+    }
+    
+    return [self factorizationWithQValues:[self.q valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] rValues:rValues rows:m columns:n];
+}
+
+#pragma mark - Private
+
+- (MAVQRFactorization *)factorizationWithQValues:(NSData *)qValues
+                                         rValues:(NSData *)rValues
+                                            rows:(MAVIndex)rows
+                                         columns:(MAVIndex)columns
+{
+    MAVQRFactorization *factorization = [[MAVQRFactorization alloc] init];
+    
+    factorization->_rows = rows;
+    factorization->_columns = columns;
+    factorization->_q = [MAVMatrix matrixWithValues:qValues rows:rows columns:rows leadingDimension:MAVMatrixLeadingDimensionColumn];
+    NSMutableData *upperValues = [rValues mutableCopy];
+    MAVQRZeroValuesBelowDiagonal(upperValues.mutableBytes, rows, columns, self.q.precision);
+    MAVMatrix *r = [MAVMatrix matrixWithValues:upperValues rows:rows columns:columns leadingDimension:MAVMatrixLeadingDimensionColumn];
+    r.triangularComponent = MAVMatrixTriangularComponentUpper;
+    factorization->_r = r;
+    
+    return factorization;
+}
+
 @end
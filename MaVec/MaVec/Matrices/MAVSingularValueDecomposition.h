@@ -27,13 +27,15 @@
 
 #import <Foundation/Foundation.h>
 
+#import "MAVTypedefs.h"
+
 @class MAVMatrix;
 
 /**
  @brief Container class to hold the results of a singular value decomposition in MAVMatrix objects.
  @description The singular value decomposition factors an m x m matrix M into the product UΣV^T (V^T = transpose of V), where U is an m x m unitary matrix, Σ is an m x n diagonal matrix and V^T is the transpose of an n x n unitary matrix. The values on Σ's diagonal are nonnegative real numbers, called the singular values of M.
  */
-@interface MAVSingularValueDecomposition : NSObject <NSCopying>
+@interface MAVSingularValueDecomposition : NSObject <NSCopying, NSSecureCoding>
 
 /**
  @property u
@@ -67,4 +69,22 @@
  */
 + (instancetype)singularValueDecompositionWithMatrix:(MAVMatrix *)matrix;
 
+/**
+ @brief Compute the decomposition of αM from this decomposition of M, by scaling the singular values by |α| and negating U if α is negative.
+ @return A new decomposition of αM.
+ */
+- (MAVSingularValueDecomposition *)decompositionScaledByScalar:(NSNumber *)scalar;
+
+/**
+ @brief Compute the decomposition of the matrix formed by exchanging two rows of M, which only exchanges the same rows of U.
+ @return A new decomposition of the permuted matrix.
+ */
+- (MAVSingularValueDecomposition *)decompositionBySwappingRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB;
+
+/**
+ @brief Compute the decomposition of the matrix formed by exchanging two columns of M, which only exchanges the same columns of V^T.
+ @return A new decomposition of the permuted matrix.
+ */
+- (MAVSingularValueDecomposition *)decompositionBySwappingColumnA:(MAVIndex)columnA withColumnB:(MAVIndex)columnB;
+
 @end
@@ -28,8 +28,10 @@
 #import <Accelerate/Accelerate.h>
 #import <MCKNumerics/MCKNumerics.h>
 
+#import "MAVLAPACKInteger.h"
 #import "MAVMatrix+MAVMatrixFactory.h"
 #import "MAVMatrix.h"
+#import "MAVMutableMatrix.h"
 #import "MAVSingularValueDecomposition.h"
 
 @implementation MAVSingularValueDecomposition
@@ -38,25 +40,25 @@
 {
     self = [super init];
     if (self) {
-        MAVIndex lwork = -1;
-        MAVIndex m = matrix.rows;
-        MAVIndex n = matrix.columns;
+        MAVLAPACKInteger lwork = -1;
+        MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex(matrix.rows);
+        MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex(matrix.columns);
         MAVIndex numSingularValues = MIN(m, n);
-        MAVIndex *iwork = malloc(8 * numSingularValues);
-        MAVIndex info = 0;
+        MAVLAPACKInteger *iwork = malloc(8 * numSingularValues * sizeof(MAVLAPACKInteger));
+        MAVLAPACKInteger info = 0;
         
         if (matrix.precision == MCKPrecisionDouble) {
             double workSize;
             double *work = &workSize;
             double *singularValues = malloc(numSingularValues * sizeof(double));
-            double *values = malloc(m * n * sizeof(double));
-            for (size_t i = 0; i < m * n; i++) {
+            double *values = malloc((size_t)m * n * sizeof(double));
+            for (size_t i = 0; i < (size_t)m * n; i++) {
                 values[i] = ((double *)matrix.values.bytes)[i];
             }
             
-            size_t uSize = m * m * sizeof(double);
-            size_t vTSize = n * n * sizeof(double);
-            size_t sSize = m * n * sizeof(double);
+            size_t uSize = (size_t)m * m * sizeof(double);
+            size_t vTSize = (size_t)n * n * sizeof(double);
+            size_t sSize = (size_t)m * n * sizeof(double);
             double *uValues = malloc(uSize);
             double *vTValues = malloc(vTSize);
             double *sValues = malloc(sSize);
@@ -64,7 +66,7 @@
             // call first with lwork = -1 to determine optimal size of working array
             dgesvd_("A", "A", &m, &n, values, &m, singularValues, uValues, &m, vTValues, &n, work, &lwork, &info);
             
-            lwork = (MAVIndex)workSize;
+            lwork = (MAVLAPACKInteger)workSize;
             work = malloc(lwork * sizeof(double));
             
             // now run the actual decomposition
@@ -101,14 +103,14 @@
             float workSize;
             float *work = &workSize;
             float *singularValues = malloc(numSingularValues * sizeof(float));
-            float *values = malloc(m * n * sizeof(float));
-            for (size_t i = 0; i < m * n; i++) {
+            float *values = malloc((size_t)m * n * sizeof(float));
+            for (size_t i = 0; i < (size_t)m * n; i++) {
                 values[i] = ((float *)matrix.values.bytes)[i];
             }
             
-            size_t uSize = m * m * sizeof(float);
-            size_t vTSize = n * n * sizeof(float);
-            size_t sSize = m * n * sizeof(float);
+            size_t uSize = (size_t)m * m * sizeof(float);
+            size_t vTSize = (size_t)n * n * sizeof(float);
+            size_t sSize = (size_t)m * n * sizeof(float);
             float *uValues = malloc(uSize);
             float *vTValues = malloc(vTSize);
             float *sValues = malloc(sSize);
@@ -116,7 +118,7 @@
             // call first with lwork = -1 to determine optimal size of working array
             sgesvd_("A", "A", &m, &n, values, &m, singularValues, uValues, &m, vTValues, &n, work, &lwork, &info);
             
-            lwork = (MAVIndex)workSize;
+            lwork = (MAVLAPACKInteger)workSize;
             work = malloc(lwork * sizeof(float));
             
             // now run the actual decomposition
@@ -159,6 +161,48 @@
     return [[MAVSingularValueDecomposition alloc] initWithMatrix:matrix];
 }
 
+#pragma mark - Updates
+
+- (MAVSingularValueDecomposition *)decompositionScaledByScalar:(NSNumber *)scalar
+{
+    MAVSingularValueDecomposition *decomposition = [self copy];
+    
+    // singular values are nonnegative, so the sign of the scalar goes into U
+    BOOL isNegative = [scalar compare:@0] == NSOrderedAscending;
+    MAVMutableMatrix *s = [self.s mutableCopy];
+    [s multiplyByScalar:isNegative ? @(-scalar.doubleValue) : scalar];
+    decomposition->_s = s;
+    if (isNegative) {
+        MAVMutableMatrix *u = [self.u mutableCopy];
+        [u multiplyByScalar:@(-1)];
+        decomposition->_u = u;
+    }
+    
+    return decomposition;
+}
+
+- (MAVSingularValueDecomposition *)decompositionBySwappingRowA:(MAVIndex)rowA withRowB:(MAVIndex)rowB
+{
+    MAVSingularValueDecomposition *decomposition = [self copy];
+    
+    MAVMutableMatrix *u = [self.u mutableCopy];
+    [u swapRowA:rowA withRowB:rowB];
+    decomposition->_u = u;
+    
+    return decomposition;
+}
+
+- (MAVSingularValueDecomposition *)decompositionBySwappingColumnA:(MAVIndex)columnA withColumnB:(MAVIndex)columnB
+{
+    MAVSingularValueDecomposition *decomposition = [self copy];
+    
+    MAVMutableMatrix *vT = [self.vT mutableCopy];
+    [vT swapColumnA:columnA withColumnB:columnB];
+    decomposition->_vT = vT;
+    
+    return decomposition;
+}
+
 #pragma mark - NSCopying
 
 - (id)copyWithZone:(NSZone *)zone
@@ -172,4 +216,32 @@
     return svdCopy;
 }
 
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:_u forKey:@"u"];
+    [aCoder encodeObject:_s forKey:@"s"];
+    [aCoder encodeObject:_vT forKey:@"vT"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (self) {
+        _u = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"u"];
+        _s = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"s"];
+        _vT = [aDecoder decodeObjectOfClass:[MAVMatrix class] forKey:@"vT"];
+        if (_u == nil || _s == nil || _vT == nil) {
+            return nil;
+        }
+    }
+    return self;
+}
+
 @end
@@ -0,0 +1,238 @@
+//
+//  MAVTiledMatrix.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import <MCKNumerics/MCKNumerics.h>
+
+#import "MAVTypedefs.h"
+
+@class MAVMatrix;
+
+/**
+ The version of the tiled matrix file format.
+ */
+#define MAV_TILED_MATRIX_FILE_VERSION 1
+
+/**
+ The domain of errors in tiled computations that are not errors reading or writing the tile file, which are reported in MAVMatrixFileErrorDomain or NSPOSIXErrorDomain.
+ */
+extern NSString *const MAVTiledMatrixErrorDomain;
+
+typedef enum : NSInteger {
+    /**
+     A diagonal tile was not positive definite during a Cholesky factorization, so the matrix is not positive definite.
+     */
+    MAVTiledMatrixErrorNotPositiveDefinite
+}
+/**
+ Constants describing errors in MAVTiledMatrixErrorDomain.
+ */
+MAVTiledMatrixError;
+
+/**
+ @class MAVTiledMatrix
+ @description A dense matrix too large to hold in memory, stored in a file as square, column-major tiles of tileOrder rows and columns. The file starts with a header block of MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT bytes holding the signature "MAVTILES", the format version, the tile order, rows, columns and size of a value, all little-endian, followed by the tiles in column-major tile order. Tiles on the bottom and right edges are padded with zeros to full size. Tiles are read on demand into a least recently used cache whose size is bounded by memoryBudget; modified tiles are written back when they are evicted or the matrix is synchronized. The tiled operations load the tiles for their next step on a background queue while they compute the current one. A tiled matrix must not be used from more than one thread at a time.
+ */
+@interface MAVTiledMatrix : NSObject
+
+/**
+ @property url
+ @brief The file URL of the tile file.
+ */
+@property (nonatomic, readonly, strong) NSURL *url;
+
+/**
+ @property rows
+ @brief The number of rows in the matrix.
+ */
+@property (nonatomic, readonly, assign) MAVIndex rows;
+
+/**
+ @property columns
+ @brief The number of columns in the matrix.
+ */
+@property (nonatomic, readonly, assign) MAVIndex columns;
+
+/**
+ @property tileOrder
+ @brief The number of rows and columns in each tile.
+ */
+@property (nonatomic, readonly, assign) MAVIndex tileOrder;
+
+/**
+ @property tileRows
+ @brief The number of rows of tiles.
+ */
+@property (nonatomic, readonly, assign) MAVIndex tileRows;
+
+/**
+ @property tileColumns
+ @brief The number of columns of tiles.
+ */
+@property (nonatomic, readonly, assign) MAVIndex tileColumns;
+
+/**
+ @property precision
+ @brief The precision of the values in the matrix.
+ */
+@property (nonatomic, readonly, assign) MCKPrecision precision;
+
+/**
+ @property memoryBudget
+ @brief The maximum number of bytes of tiles to keep cached in memory. Tiles in use by an operation are never evicted, so the cache may briefly exceed a budget smaller than the three or four tiles an operation works on at once. Lowering the budget evicts tiles immediately.
+ */
+@property (nonatomic, assign) size_t memoryBudget;
+
+/**
+ @property bytesRead
+ @brief The number of bytes of tiles read from the file since the matrix was opened.
+ */
+@property (nonatomic, readonly, assign) uint64_t bytesRead;
+
+/**
+ @property bytesWritten
+ @brief The number of bytes of tiles written to the file since the matrix was opened.
+ */
+@property (nonatomic, readonly, assign) uint64_t bytesWritten;
+
+#pragma mark - Constructors
+
+/**
+ @brief Create a tile file holding a matrix of zeros. Tiles of zeros are not written until they are modified, so on file systems supporting sparse files the new file takes almost no space.
+ @param url The file URL of the tile file to create, replacing any existing file.
+ @param rows The number of rows in the matrix.
+ @param columns The number of columns in the matrix.
+ @param tileOrder The number of rows and columns in each tile.
+ @param precision The precision of the values in the matrix.
+ @param memoryBudget The maximum number of bytes of tiles to cache in memory.
+ @param error If the file cannot be created, set to an error describing the problem.
+ @return A new tiled matrix of zeros, or nil if the file could not be created.
+ */
++ (instancetype)tiledMatrixWithURL:(NSURL *)url
+                              rows:(MAVIndex)rows
+                           columns:(MAVIndex)columns
+                         tileOrder:(MAVIndex)tileOrder
+                         precision:(MCKPrecision)precision
+                      memoryBudget:(size_t)memoryBudget
+                             error:(NSError **)error;
+
+/**
+ @brief Open an existing tile file.
+ @param url The file URL of the tile file.
+ @param memoryBudget The maximum number of bytes of tiles to cache in memory.
+ @param error If the file cannot be opened or is not a valid tile file, set to an error describing the problem.
+ @return A tiled matrix backed by the file, or nil if it could not be opened.
+ */
++ (instancetype)tiledMatrixWithContentsOfURL:(NSURL *)url
+                                memoryBudget:(size_t)memoryBudget
+                                       error:(NSError **)error;
+
+/**
+ @brief Create a tile file holding the values of an in-memory matrix, in any packing method.
+ @param matrix The matrix to copy into tiles.
+ @param url The file URL of the tile file to create, replacing any existing file.
+ @param tileOrder The number of rows and columns in each tile.
+ @param memoryBudget The maximum number of bytes of tiles to cache in memory.
+ @param error If the file cannot be written, set to an error describing the problem.
+ @return A new tiled matrix with the values of matrix, or nil if the file could not be written.
+ */
++ (instancetype)tiledMatrixWithMatrix:(MAVMatrix *)matrix
+                                  URL:(NSURL *)url
+                            tileOrder:(MAVIndex)tileOrder
+                         memoryBudget:(size_t)memoryBudget
+                                error:(NSError **)error;
+
+#pragma mark - Tiles
+
+/**
+ @brief Copy a tile into an ordinary in-memory matrix. Tiles on the bottom and right edges are trimmed to the rows and columns of the matrix they cover.
+ @param tileRow The row of the tile.
+ @param tileColumn The column of the tile.
+ @return A new column-major matrix holding the values of the tile.
+ */
+- (MAVMatrix *)tileAtRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn;
+
+/**
+ @brief Replace the values of a tile with those of an in-memory matrix.
+ @param tile A matrix of the same precision with the rows and columns of the tile, trimmed at the edges like those returned by tileAtRow:column:, in any packing method.
+ @param tileRow The row of the tile.
+ @param tileColumn The column of the tile.
+ */
+- (void)setTile:(MAVMatrix *)tile atRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn;
+
+/**
+ @brief Load a tile into the cache on a background queue, so that a later call to tileAtRow:column: does not wait for the file.
+ @param tileRow The row of the tile.
+ @param tileColumn The column of the tile.
+ */
+- (void)prefetchTileAtRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn;
+
+/**
+ @brief Copy the whole matrix into an ordinary in-memory matrix.
+ @return A new column-major matrix holding the values of every tile.
+ */
+- (MAVMatrix *)matrix;
+
+/**
+ @brief Write every modified tile in the cache back to the file.
+ @param error If a tile could not be read or written since the last synchronization, set to an error describing the first such failure.
+ @return YES if every tile read and write succeeded, NO otherwise.
+ */
+- (BOOL)synchronizeWithError:(NSError **)error;
+
+#pragma mark - Operations
+
+/**
+ @brief Multiply this matrix by another tiled matrix, one pair of tiles at a time, writing the product to a new tile file.
+ @param tiledMatrix A tiled matrix with as many rows as this matrix has columns, and the same tile order and precision.
+ @param url The file URL of the tile file to create for the product.
+ @param error If a tile file cannot be read or written, set to an error describing the problem.
+ @return A new tiled matrix holding the product, with the memory budget of this matrix, or nil if a tile file could not be read or written.
+ */
+- (MAVTiledMatrix *)productWithTiledMatrix:(MAVTiledMatrix *)tiledMatrix
+                                       URL:(NSURL *)url
+                                     error:(NSError **)error;
+
+/**
+ @brief Transpose this matrix one tile at a time, writing the transpose to a new tile file.
+ @param url The file URL of the tile file to create for the transpose.
+ @param error If a tile file cannot be read or written, set to an error describing the problem.
+ @return A new tiled matrix holding the transpose, with the memory budget of this matrix, or nil if a tile file could not be read or written.
+ */
+- (MAVTiledMatrix *)transposeWithURL:(NSURL *)url
+                               error:(NSError **)error;
+
+/**
+ @brief Compute the Cholesky factor L of this symmetric positive definite matrix, with A = LLᵀ, by the right-looking tiled algorithm: each step factors a diagonal tile, solves the tiles below it, and updates the trailing tiles. Only the lower triangle of this matrix is read.
+ @param url The file URL of the tile file to create for the factor.
+ @param error If a tile file cannot be read or written, or the matrix is not positive definite, set to an error describing the problem.
+ @return A new lower triangular tiled matrix holding the Cholesky factor, with the memory budget of this matrix, or nil if the factorization failed.
+ */
+- (MAVTiledMatrix *)choleskyFactorWithURL:(NSURL *)url
+                                    error:(NSError **)error;
+
+@end
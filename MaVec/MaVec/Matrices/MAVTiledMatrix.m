@@ -0,0 +1,880 @@
+//
+//  MAVTiledMatrix.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Accelerate/Accelerate.h>
+#import <errno.h>
+#import <fcntl.h>
+#import <pthread.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+#import "MAVFileIO.h"
+#import "MAVLAPACKInteger.h"
+#import "MAVLayoutKernels.h"
+#import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix.h"
+#import "MAVTiledMatrix.h"
+
+NSString *const MAVTiledMatrixErrorDomain = @"com.amproductions.mavec.tiled-matrix";
+
+/**
+ The signature at the start of every tile file.
+ */
+static const char MAVTiledMatrixFileSignature[8] = { 'M', 'A', 'V', 'T', 'I', 'L', 'E', 'S' };
+
+/**
+ The number of bytes of the header block holding fields; the rest of the block is zero padding.
+ */
+#define MAV_TILED_MATRIX_FILE_HEADER_FIELDS_LENGTH 40
+
+static BOOL MAVReadTileFully(int fileDescriptor, void *bytes, size_t length, off_t offset)
+{
+    uint8_t *cursor = bytes;
+    while (length > 0) {
+        ssize_t count = pread(fileDescriptor, cursor, length, offset);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return NO;
+        }
+        if (count == 0) {
+            errno = EIO;
+            return NO;
+        }
+        cursor += count;
+        offset += count;
+        length -= (size_t)count;
+    }
+    return YES;
+}
+
+static BOOL MAVWriteTileFully(int fileDescriptor, const void *bytes, size_t length, off_t offset)
+{
+    const uint8_t *cursor = bytes;
+    while (length > 0) {
+        ssize_t count = pwrite(fileDescriptor, cursor, length, offset);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return NO;
+        }
+        cursor += count;
+        offset += count;
+        length -= (size_t)count;
+    }
+    return YES;
+}
+
+/**
+ @brief A tile held in the cache of a tiled matrix.
+ */
+@interface MAVCachedTile : NSObject
+
+// the full, zero-padded tile of tileOrder * tileOrder values
+@property (strong, nonatomic) NSMutableData *values;
+
+// NO while the tile is being read from the file
+@property (assign, nonatomic) BOOL loaded;
+
+// YES if the values have been modified since they were read or last written
+@property (assign, nonatomic) BOOL dirty;
+
+// the number of operations using the tile, which may not evict it while this is nonzero
+@property (assign, nonatomic) NSUInteger pins;
+
+// the value of the cache's use clock when the tile was last pinned
+@property (assign, nonatomic) uint64_t lastUse;
+
+@end
+
+@implementation MAVCachedTile
+@end
+
+@interface MAVTiledMatrix ()
+
+@property (nonatomic, readwrite, strong) NSURL *url;
+@property (nonatomic, readwrite, assign) MAVIndex rows;
+@property (nonatomic, readwrite, assign) MAVIndex columns;
+@property (nonatomic, readwrite, assign) MAVIndex tileOrder;
+@property (nonatomic, readwrite, assign) MAVIndex tileRows;
+@property (nonatomic, readwrite, assign) MAVIndex tileColumns;
+@property (nonatomic, readwrite, assign) MCKPrecision precision;
+
+@end
+
+@implementation MAVTiledMatrix
+{
+    int _fileDescriptor;
+    size_t _tileLength;
+    
+    // guards the cache, the I/O statistics and the first I/O error
+    pthread_mutex_t _cacheMutex;
+    pthread_cond_t _tileLoadedCondition;
+    NSMutableDictionary *_cachedTiles;
+    size_t _cachedLength;
+    uint64_t _useClock;
+    size_t _memoryBudget;
+    uint64_t _bytesRead;
+    uint64_t _bytesWritten;
+    NSError *_ioError;
+}
+
+#pragma mark - Constructors
+
+- (instancetype)initWithURL:(NSURL *)url
+             fileDescriptor:(int)fileDescriptor
+                       rows:(MAVIndex)rows
+                    columns:(MAVIndex)columns
+                  tileOrder:(MAVIndex)tileOrder
+                  precision:(MCKPrecision)precision
+               memoryBudget:(size_t)memoryBudget
+{
+    self = [super init];
+    if (self) {
+        _url = url;
+        _fileDescriptor = fileDescriptor;
+        _rows = rows;
+        _columns = columns;
+        _tileOrder = tileOrder;
+        _tileRows = (rows + tileOrder - 1) / tileOrder;
+        _tileColumns = (columns + tileOrder - 1) / tileOrder;
+        _precision = precision;
+        _tileLength = (size_t)tileOrder * (size_t)tileOrder * (precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
+        
+        pthread_mutex_init(&_cacheMutex, NULL);
+        pthread_cond_init(&_tileLoadedCondition, NULL);
+        _cachedTiles = [NSMutableDictionary dictionary];
+        _memoryBudget = memoryBudget;
+    }
+    return self;
+}
+
++ (instancetype)tiledMatrixWithURL:(NSURL *)url
+                              rows:(MAVIndex)rows
+                           columns:(MAVIndex)columns
+                         tileOrder:(MAVIndex)tileOrder
+                         precision:(MCKPrecision)precision
+                      memoryBudget:(size_t)memoryBudget
+                             error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Tile files can only be written to file URLs.");
+    NSAssert(rows > 0 && columns > 0, @"A tiled matrix must have at least one row and column.");
+    NSAssert(tileOrder > 0, @"Tiles must have at least one row and column.");
+    
+    int fileDescriptor = open(url.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(errno, url);
+        }
+        return nil;
+    }
+    
+    MAVTiledMatrix *tiledMatrix = [[self alloc] initWithURL:url
+                                             fileDescriptor:fileDescriptor
+                                                       rows:rows
+                                                    columns:columns
+                                                  tileOrder:tileOrder
+                                                  precision:precision
+                                               memoryBudget:memoryBudget];
+    
+    uint8_t *headerBlock = calloc(MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT, 1);
+    memcpy(headerBlock, MAVTiledMatrixFileSignature, sizeof(MAVTiledMatrixFileSignature));
+    OSWriteLittleInt32(headerBlock, 8, MAV_TILED_MATRIX_FILE_VERSION);
+    OSWriteLittleInt32(headerBlock, 12, (uint32_t)tileOrder);
+    OSWriteLittleInt64(headerBlock, 16, (uint64_t)rows);
+    OSWriteLittleInt64(headerBlock, 24, (uint64_t)columns);
+    OSWriteLittleInt32(headerBlock, 32, precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
+    // extending the file instead of writing the tiles leaves them as holes that read back as zeros
+    BOOL written = MAVWriteFully(fileDescriptor, headerBlock, MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT)
+    && ftruncate(fileDescriptor, [tiledMatrix offsetOfTileAtIndex:[tiledMatrix numberOfTiles]]) == 0;
+    int code = errno;
+    free(headerBlock);
+    if (!written) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(code, url);
+        }
+        return nil;
+    }
+    
+    return tiledMatrix;
+}
+
++ (instancetype)tiledMatrixWithContentsOfURL:(NSURL *)url
+                                memoryBudget:(size_t)memoryBudget
+                                       error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Tile files can only be read from file URLs.");
+    
+    int fileDescriptor = open(url.fileSystemRepresentation, O_RDWR);
+    if (fileDescriptor < 0) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(errno, url);
+        }
+        return nil;
+    }
+    
+    uint8_t header[MAV_TILED_MATRIX_FILE_HEADER_FIELDS_LENGTH];
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(errno, url);
+        }
+        close(fileDescriptor);
+        return nil;
+    }
+    if ((uint64_t)status.st_size < MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT || !MAVReadTileFully(fileDescriptor, header, sizeof(header), 0)) {
+        if (error) {
+            *error = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the file is shorter than a header");
+        }
+        close(fileDescriptor);
+        return nil;
+    }
+    
+    uint32_t version = OSReadLittleInt32(header, 8);
+    uint32_t tileOrder = OSReadLittleInt32(header, 12);
+    uint64_t rows = OSReadLittleInt64(header, 16);
+    uint64_t columns = OSReadLittleInt64(header, 24);
+    uint32_t valueSize = OSReadLittleInt32(header, 32);
+    
+    NSError *formatError;
+    if (memcmp(header, MAVTiledMatrixFileSignature, sizeof(MAVTiledMatrixFileSignature)) != 0) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the signature is missing");
+    } else if (version != MAV_TILED_MATRIX_FILE_VERSION) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorUnsupportedVersion, url, [NSString stringWithFormat:@"format version %u is not supported", version]);
+    } else if ((valueSize != sizeof(double) && valueSize != sizeof(float))
+               || tileOrder == 0 || tileOrder > INT32_MAX
+               || rows == 0 || rows > INT64_MAX - tileOrder || columns == 0 || columns > INT64_MAX - tileOrder
+               // every tile must be addressable in the file
+               || (rows + tileOrder - 1) / tileOrder > (uint64_t)(INT64_MAX - MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT) / ((uint64_t)tileOrder * tileOrder * valueSize) / ((columns + tileOrder - 1) / tileOrder)) {
+        formatError = MAVMatrixFileFormatError(MAVMatrixFileErrorInvalidFormat, url, @"the header describes an impossible matrix");
+    }
+    if (formatError != nil) {
+        if (error) {
+            *error = formatError;
+        }
+        close(fileDescriptor);
+        return nil;
+    }
+    
+    MAVTiledMatrix *tiledMatrix = [[self alloc] initWithURL:url
+                                             fileDescriptor:fileDescriptor
+                                                       rows:(MAVIndex)rows
+                                                    columns:(MAVIndex)columns
+                                                  tileOrder:(MAVIndex)tileOrder
+                                                  precision:valueSize == sizeof(double) ? MCKPrecisionDouble : MCKPrecisionSingle
+                                               memoryBudget:memoryBudget];
+    if (status.st_size < [tiledMatrix offsetOfTileAtIndex:[tiledMatrix numberOfTiles]]) {
+        if (error) {
+            *error = MAVMatrixFileFormatError(MAVMatrixFileErrorTruncated, url, @"the file ends before the last tile");
+        }
+        return nil;
+    }
+    
+    return tiledMatrix;
+}
+
++ (instancetype)tiledMatrixWithMatrix:(MAVMatrix *)matrix
+                                  URL:(NSURL *)url
+                            tileOrder:(MAVIndex)tileOrder
+                         memoryBudget:(size_t)memoryBudget
+                                error:(NSError **)error
+{
+    MAVTiledMatrix *tiledMatrix = [self tiledMatrixWithURL:url
+                                                      rows:matrix.rows
+                                                   columns:matrix.columns
+                                                 tileOrder:tileOrder
+                                                 precision:matrix.precision
+                                              memoryBudget:memoryBudget
+                                                     error:error];
+    if (tiledMatrix == nil) {
+        return nil;
+    }
+    
+    NSData *values = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    size_t valueSize = matrix.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    for (MAVIndex tileColumn = 0; tileColumn < tiledMatrix.tileColumns; tileColumn++) {
+        for (MAVIndex tileRow = 0; tileRow < tiledMatrix.tileRows; tileRow++) {
+            size_t offset = ((size_t)(tileColumn * tileOrder) * (size_t)matrix.rows + (size_t)(tileRow * tileOrder)) * valueSize;
+            MAVCachedTile *tile = [tiledMatrix pinTileAtRow:tileRow column:tileColumn overwrite:YES];
+            [tiledMatrix copyValues:(const uint8_t *)values.bytes + offset
+                   leadingDimension:matrix.rows
+                               rows:[tiledMatrix rowsInTileRow:tileRow]
+                            columns:[tiledMatrix columnsInTileColumn:tileColumn]
+                           intoTile:tile];
+            [tiledMatrix unpinTile:tile modified:YES];
+        }
+    }
+    
+    return [tiledMatrix synchronizeWithError:error] ? tiledMatrix : nil;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_lock(&_cacheMutex);
+    for (NSNumber *index in _cachedTiles) {
+        MAVCachedTile *tile = _cachedTiles[index];
+        if (tile.dirty) {
+            [self writeTileLocked:tile atIndex:index.unsignedLongValue];
+        }
+    }
+    pthread_mutex_unlock(&_cacheMutex);
+    
+    close(_fileDescriptor);
+    pthread_cond_destroy(&_tileLoadedCondition);
+    pthread_mutex_destroy(&_cacheMutex);
+}
+
+#pragma mark - Properties
+
+- (size_t)memoryBudget
+{
+    pthread_mutex_lock(&_cacheMutex);
+    size_t memoryBudget = _memoryBudget;
+    pthread_mutex_unlock(&_cacheMutex);
+    return memoryBudget;
+}
+
+- (void)setMemoryBudget:(size_t)memoryBudget
+{
+    pthread_mutex_lock(&_cacheMutex);
+    _memoryBudget = memoryBudget;
+    [self evictTilesLocked];
+    pthread_mutex_unlock(&_cacheMutex);
+}
+
+- (uint64_t)bytesRead
+{
+    pthread_mutex_lock(&_cacheMutex);
+    uint64_t bytesRead = _bytesRead;
+    pthread_mutex_unlock(&_cacheMutex);
+    return bytesRead;
+}
+
+- (uint64_t)bytesWritten
+{
+    pthread_mutex_lock(&_cacheMutex);
+    uint64_t bytesWritten = _bytesWritten;
+    pthread_mutex_unlock(&_cacheMutex);
+    return bytesWritten;
+}
+
+#pragma mark - Tiles
+
+- (MAVMatrix *)tileAtRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn
+{
+    MAVIndex rows = [self rowsInTileRow:tileRow];
+    MAVIndex columns = [self columnsInTileColumn:tileColumn];
+    size_t valueSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *values = [NSMutableData dataWithLength:(size_t)rows * (size_t)columns * valueSize];
+    
+    MAVCachedTile *tile = [self pinTileAtRow:tileRow column:tileColumn overwrite:NO];
+    for (MAVIndex column = 0; column < columns; column++) {
+        memcpy((uint8_t *)values.mutableBytes + (size_t)column * (size_t)rows * valueSize,
+               (const uint8_t *)tile.values.bytes + (size_t)column * (size_t)self.tileOrder * valueSize,
+               (size_t)rows * valueSize);
+    }
+    [self unpinTile:tile modified:NO];
+    
+    return [MAVMatrix matrixWithValues:values rows:rows columns:columns];
+}
+
+- (void)setTile:(MAVMatrix *)tile atRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn
+{
+    NSAssert(tile.rows == [self rowsInTileRow:tileRow] && tile.columns == [self columnsInTileColumn:tileColumn], @"The matrix must have the rows and columns of the tile it replaces.");
+    NSAssert(tile.precision == self.precision, @"The matrix must have the precision of the tiled matrix.");
+    
+    NSData *values = [tile valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    MAVCachedTile *cachedTile = [self pinTileAtRow:tileRow column:tileColumn overwrite:YES];
+    [self copyValues:values.bytes
+    leadingDimension:tile.rows
+                rows:tile.rows
+             columns:tile.columns
+            intoTile:cachedTile];
+    [self unpinTile:cachedTile modified:YES];
+}
+
+- (void)prefetchTileAtRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn
+{
+    size_t index = [self indexOfTileAtRow:tileRow column:tileColumn];
+    
+    pthread_mutex_lock(&_cacheMutex);
+    BOOL cached = _cachedTiles[@(index)] != nil;
+    pthread_mutex_unlock(&_cacheMutex);
+    if (cached) {
+        return;
+    }
+    
+    dispatch_async([MAVTiledMatrix prefetchQueue], ^{
+        MAVCachedTile *tile = [self pinTileAtIndex:index overwrite:NO];
+        [self unpinTile:tile modified:NO];
+    });
+}
+
+- (MAVMatrix *)matrix
+{
+    size_t valueSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *values = [NSMutableData dataWithLength:(size_t)self.rows * (size_t)self.columns * valueSize];
+    
+    for (MAVIndex tileColumn = 0; tileColumn < self.tileColumns; tileColumn++) {
+        for (MAVIndex tileRow = 0; tileRow < self.tileRows; tileRow++) {
+            [self prefetchNextTileAfterRow:tileRow column:tileColumn];
+            MAVIndex rows = [self rowsInTileRow:tileRow];
+            MAVIndex columns = [self columnsInTileColumn:tileColumn];
+            MAVCachedTile *tile = [self pinTileAtRow:tileRow column:tileColumn overwrite:NO];
+            for (MAVIndex column = 0; column < columns; column++) {
+                size_t destination = ((size_t)(tileColumn * self.tileOrder + column) * (size_t)self.rows + (size_t)(tileRow * self.tileOrder)) * valueSize;
+                memcpy((uint8_t *)values.mutableBytes + destination,
+                       (const uint8_t *)tile.values.bytes + (size_t)column * (size_t)self.tileOrder * valueSize,
+                       (size_t)rows * valueSize);
+            }
+            [self unpinTile:tile modified:NO];
+        }
+    }
+    
+    return [MAVMatrix matrixWithValues:values rows:self.rows columns:self.columns];
+}
+
+- (BOOL)synchronizeWithError:(NSError **)error
+{
+    pthread_mutex_lock(&_cacheMutex);
+    for (NSNumber *index in _cachedTiles) {
+        MAVCachedTile *tile = _cachedTiles[index];
+        if (tile.dirty && tile.pins == 0) {
+            [self writeTileLocked:tile atIndex:index.unsignedLongValue];
+        }
+    }
+    NSError *ioError = _ioError;
+    _ioError = nil;
+    pthread_mutex_unlock(&_cacheMutex);
+    
+    if (ioError != nil) {
+        if (error) {
+            *error = ioError;
+        }
+        return NO;
+    }
+    return YES;
+}
+
+#pragma mark - Operations
+
+- (MAVTiledMatrix *)productWithTiledMatrix:(MAVTiledMatrix *)tiledMatrix
+                                       URL:(NSURL *)url
+                                     error:(NSError **)error
+{
+    NSAssert(self.columns == tiledMatrix.rows, @"Invalid dimensions for matrix multiplication: %lld columns and %lld rows.", (long long int)self.columns, (long long int)tiledMatrix.rows);
+    NSAssert(self.tileOrder == tiledMatrix.tileOrder, @"Tiled matrices can only be multiplied if their tiles are the same size.");
+    NSAssert(self.precision == tiledMatrix.precision, @"Tiled matrices can only be multiplied if they have the same precision.");
+    
+    MAVTiledMatrix *product = [MAVTiledMatrix tiledMatrixWithURL:url
+                                                            rows:self.rows
+                                                         columns:tiledMatrix.columns
+                                                       tileOrder:self.tileOrder
+                                                       precision:self.precision
+                                                    memoryBudget:self.memoryBudget
+                                                           error:error];
+    if (product == nil) {
+        return nil;
+    }
+    
+    MAVLAPACKInteger tileOrder = MAVLAPACKIntegerFromIndex(self.tileOrder);
+    for (MAVIndex tileColumn = 0; tileColumn < product.tileColumns; tileColumn++) {
+        for (MAVIndex tileRow = 0; tileRow < product.tileRows; tileRow++) {
+            MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex([product rowsInTileRow:tileRow]);
+            MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex([product columnsInTileColumn:tileColumn]);
+            MAVCachedTile *productTile = [product pinTileAtRow:tileRow column:tileColumn overwrite:YES];
+            
+            for (MAVIndex inner = 0; inner < self.tileColumns; inner++) {
+                // load the pair of tiles for the next step while multiplying this one
+                if (inner + 1 < self.tileColumns) {
+                    [self prefetchTileAtRow:tileRow column:inner + 1];
+                    [tiledMatrix prefetchTileAtRow:inner + 1 column:tileColumn];
+                } else if (tileRow + 1 < product.tileRows) {
+                    [self prefetchTileAtRow:tileRow + 1 column:0];
+                } else if (tileColumn + 1 < product.tileColumns) {
+                    [self prefetchTileAtRow:0 column:0];
+                    [tiledMatrix prefetchTileAtRow:0 column:tileColumn + 1];
+                }
+                
+                MAVLAPACKInteger k = MAVLAPACKIntegerFromIndex([self columnsInTileColumn:inner]);
+                MAVCachedTile *leftTile = [self pinTileAtRow:tileRow column:inner overwrite:NO];
+                MAVCachedTile *rightTile = [tiledMatrix pinTileAtRow:inner column:tileColumn overwrite:NO];
+                if (self.precision == MCKPrecisionDouble) {
+                    cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0, leftTile.values.bytes, tileOrder, rightTile.values.bytes, tileOrder, inner == 0 ? 0.0 : 1.0, productTile.values.mutableBytes, tileOrder);
+                } else {
+                    cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0f, leftTile.values.bytes, tileOrder, rightTile.values.bytes, tileOrder, inner == 0 ? 0.0f : 1.0f, productTile.values.mutableBytes, tileOrder);
+                }
+                [self unpinTile:leftTile modified:NO];
+                [tiledMatrix unpinTile:rightTile modified:NO];
+            }
+            
+            [product unpinTile:productTile modified:YES];
+        }
+    }
+    
+    if (![self synchronizeWithError:error] || ![tiledMatrix synchronizeWithError:error] || ![product synchronizeWithError:error]) {
+        return nil;
+    }
+    return product;
+}
+
+- (MAVTiledMatrix *)transposeWithURL:(NSURL *)url
+                               error:(NSError **)error
+{
+    MAVTiledMatrix *transpose = [MAVTiledMatrix tiledMatrixWithURL:url
+                                                              rows:self.columns
+                                                           columns:self.rows
+                                                         tileOrder:self.tileOrder
+                                                         precision:self.precision
+                                                      memoryBudget:self.memoryBudget
+                                                             error:error];
+    if (transpose == nil) {
+        return nil;
+    }
+    
+    size_t tileOrder = (size_t)self.tileOrder;
+    for (MAVIndex tileColumn = 0; tileColumn < self.tileColumns; tileColumn++) {
+        for (MAVIndex tileRow = 0; tileRow < self.tileRows; tileRow++) {
+            [self prefetchNextTileAfterRow:tileRow column:tileColumn];
+            
+            // tiles are padded with zeros, so transposing the full tile keeps the padding of the transpose zero
+            MAVCachedTile *tile = [self pinTileAtRow:tileRow column:tileColumn overwrite:NO];
+            MAVCachedTile *transposeTile = [transpose pinTileAtRow:tileColumn column:tileRow overwrite:YES];
+            if (self.precision == MCKPrecisionDouble) {
+                MAVTransposeValuesD(tile.values.bytes, tileOrder, tileOrder, transposeTile.values.mutableBytes);
+            } else {
+                MAVTransposeValues(tile.values.bytes, tileOrder, tileOrder, transposeTile.values.mutableBytes);
+            }
+            [self unpinTile:tile modified:NO];
+            [transpose unpinTile:transposeTile modified:YES];
+        }
+    }
+    
+    if (![self synchronizeWithError:error] || ![transpose synchronizeWithError:error]) {
+        return nil;
+    }
+    return transpose;
+}
+
+- (MAVTiledMatrix *)choleskyFactorWithURL:(NSURL *)url
+                                    error:(NSError **)error
+{
+    NSAssert(self.rows == self.columns, @"Only square matrices have a Cholesky factorization.");
+    
+    MAVTiledMatrix *factor = [MAVTiledMatrix tiledMatrixWithURL:url
+                                                           rows:self.rows
+                                                        columns:self.columns
+                                                      tileOrder:self.tileOrder
+                                                      precision:self.precision
+                                                   memoryBudget:self.memoryBudget
+                                                          error:error];
+    if (factor == nil) {
+        return nil;
+    }
+    
+    // copy the lower triangle of tiles, then factor it in place; the tiles above the diagonal stay zero
+    MAVIndex tiles = self.tileRows;
+    for (MAVIndex tileColumn = 0; tileColumn < tiles; tileColumn++) {
+        for (MAVIndex tileRow = tileColumn; tileRow < tiles; tileRow++) {
+            if (tileRow + 1 < tiles) {
+                [self prefetchTileAtRow:tileRow + 1 column:tileColumn];
+            } else if (tileColumn + 1 < tiles) {
+                [self prefetchTileAtRow:tileColumn + 1 column:tileColumn + 1];
+            }
+            MAVCachedTile *tile = [self pinTileAtRow:tileRow column:tileColumn overwrite:NO];
+            MAVCachedTile *factorTile = [factor pinTileAtRow:tileRow column:tileColumn overwrite:YES];
+            memcpy(factorTile.values.mutableBytes, tile.values.bytes, _tileLength);
+            [self unpinTile:tile modified:NO];
+            [factor unpinTile:factorTile modified:YES];
+        }
+    }
+    if (![self synchronizeWithError:error]) {
+        return nil;
+    }
+    
+    MAVLAPACKInteger tileOrder = MAVLAPACKIntegerFromIndex(self.tileOrder);
+    BOOL isDouble = self.precision == MCKPrecisionDouble;
+    for (MAVIndex step = 0; step < tiles; step++) {
+        MAVLAPACKInteger order = MAVLAPACKIntegerFromIndex([factor rowsInTileRow:step]);
+        
+        // factor the diagonal tile
+        MAVCachedTile *diagonalTile = [factor pinTileAtRow:step column:step overwrite:NO];
+        if (step + 1 < tiles) {
+            [factor prefetchTileAtRow:step + 1 column:step];
+        }
+        MAVLAPACKInteger n = order;
+        MAVLAPACKInteger lda = tileOrder;
+        MAVLAPACKInteger info = 0;
+        if (isDouble) {
+            double *values = diagonalTile.values.mutableBytes;
+            dpotrf_("L", &n, values, &lda, &info);
+            for (MAVIndex column = 1; column < order; column++) {
+                memset(values + column * tileOrder, 0, (size_t)column * sizeof(double));
+            }
+        } else {
+            float *values = diagonalTile.values.mutableBytes;
+            spotrf_("L", &n, values, &lda, &info);
+            for (MAVIndex column = 1; column < order; column++) {
+                memset(values + column * tileOrder, 0, (size_t)column * sizeof(float));
+            }
+        }
+        if (info > 0) {
+            [factor unpinTile:diagonalTile modified:YES];
+            if (error) {
+                NSString *description = [NSString stringWithFormat:@"The leading minor of order %lld is not positive definite.", (long long int)(step * tileOrder + info)];
+                *error = [NSError errorWithDomain:MAVTiledMatrixErrorDomain
+                                             code:MAVTiledMatrixErrorNotPositiveDefinite
+                                         userInfo:@{ NSLocalizedDescriptionKey: description }];
+            }
+            return nil;
+        }
+        
+        // solve for the tiles below it: L(i, step) = A(i, step) * L(step, step)⁻ᵀ
+        for (MAVIndex tileRow = step + 1; tileRow < tiles; tileRow++) {
+            if (tileRow + 1 < tiles) {
+                [factor prefetchTileAtRow:tileRow + 1 column:step];
+            } else if (step + 1 < tiles) {
+                [factor prefetchTileAtRow:step + 1 column:step + 1];
+            }
+            MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex([factor rowsInTileRow:tileRow]);
+            MAVCachedTile *tile = [factor pinTileAtRow:tileRow column:step overwrite:NO];
+            if (isDouble) {
+                cblas_dtrsm(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasNonUnit, m, order, 1.0, diagonalTile.values.bytes, tileOrder, tile.values.mutableBytes, tileOrder);
+            } else {
+                cblas_strsm(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasNonUnit, m, order, 1.0f, diagonalTile.values.bytes, tileOrder, tile.values.mutableBytes, tileOrder);
+            }
+            [factor unpinTile:tile modified:YES];
+        }
+        [factor unpinTile:diagonalTile modified:YES];
+        
+        // update the trailing tiles: A(i, j) -= L(i, step) * L(j, step)ᵀ
+        for (MAVIndex tileColumn = step + 1; tileColumn < tiles; tileColumn++) {
+            MAVLAPACKInteger columns = MAVLAPACKIntegerFromIndex([factor rowsInTileRow:tileColumn]);
+            MAVCachedTile *panelTile = [factor pinTileAtRow:tileColumn column:step overwrite:NO];
+            
+            MAVCachedTile *trailingDiagonalTile = [factor pinTileAtRow:tileColumn column:tileColumn overwrite:NO];
+            if (isDouble) {
+                cblas_dsyrk(CblasColMajor, CblasLower, CblasNoTrans, columns, order, -1.0, panelTile.values.bytes, tileOrder, 1.0, trailingDiagonalTile.values.mutableBytes, tileOrder);
+            } else {
+                cblas_ssyrk(CblasColMajor, CblasLower, CblasNoTrans, columns, order, -1.0f, panelTile.values.bytes, tileOrder, 1.0f, trailingDiagonalTile.values.mutableBytes, tileOrder);
+            }
+            [factor unpinTile:trailingDiagonalTile modified:YES];
+            
+            for (MAVIndex tileRow = tileColumn + 1; tileRow < tiles; tileRow++) {
+                if (tileRow + 1 < tiles) {
+                    [factor prefetchTileAtRow:tileRow + 1 column:step];
+                    [factor prefetchTileAtRow:tileRow + 1 column:tileColumn];
+                } else if (tileColumn + 1 < tiles) {
+                    [factor prefetchTileAtRow:tileColumn + 1 column:step];
+                    [factor prefetchTileAtRow:tileColumn + 1 column:tileColumn + 1];
+                }
+                MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex([factor rowsInTileRow:tileRow]);
+                MAVCachedTile *leftTile = [factor pinTileAtRow:tileRow column:step overwrite:NO];
+                MAVCachedTile *tile = [factor pinTileAtRow:tileRow column:tileColumn overwrite:NO];
+                if (isDouble) {
+                    cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, m, columns, order, -1.0, leftTile.values.bytes, tileOrder, panelTile.values.bytes, tileOrder, 1.0, tile.values.mutableBytes, tileOrder);
+                } else {
+                    cblas_sgemm(CblasColMajor, CblasNoTrans, CblasTrans, m, columns, order, -1.0f, leftTile.values.bytes, tileOrder, panelTile.values.bytes, tileOrder, 1.0f, tile.values.mutableBytes, tileOrder);
+                }
+                [factor unpinTile:leftTile modified:NO];
+                [factor unpinTile:tile modified:YES];
+            }
+            
+            [factor unpinTile:panelTile modified:NO];
+        }
+    }
+    
+    return [factor synchronizeWithError:error] ? factor : nil;
+}
+
+#pragma mark - Private
+
+// serializes the prefetching of tiles of every tiled matrix
++ (dispatch_queue_t)prefetchQueue
+{
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.amproductions.mavec.tile-prefetch", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+- (MAVIndex)rowsInTileRow:(MAVIndex)tileRow
+{
+    return MIN(self.tileOrder, self.rows - tileRow * self.tileOrder);
+}
+
+- (MAVIndex)columnsInTileColumn:(MAVIndex)tileColumn
+{
+    return MIN(self.tileOrder, self.columns - tileColumn * self.tileOrder);
+}
+
+- (size_t)numberOfTiles
+{
+    return (size_t)self.tileRows * (size_t)self.tileColumns;
+}
+
+- (size_t)indexOfTileAtRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn
+{
+    NSAssert(tileRow >= 0 && tileRow < self.tileRows && tileColumn >= 0 && tileColumn < self.tileColumns, @"Tile (%lld, %lld) is outside the %lld x %lld tiles of the matrix.", (long long int)tileRow, (long long int)tileColumn, (long long int)self.tileRows, (long long int)self.tileColumns);
+    return (size_t)tileColumn * (size_t)self.tileRows + (size_t)tileRow;
+}
+
+- (off_t)offsetOfTileAtIndex:(size_t)index
+{
+    return (off_t)MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT + (off_t)index * (off_t)_tileLength;
+}
+
+// prefetch the tile following the given one in column-major tile order
+- (void)prefetchNextTileAfterRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn
+{
+    if (tileRow + 1 < self.tileRows) {
+        [self prefetchTileAtRow:tileRow + 1 column:tileColumn];
+    } else if (tileColumn + 1 < self.tileColumns) {
+        [self prefetchTileAtRow:0 column:tileColumn + 1];
+    }
+}
+
+// copy a column-major array of values into the leading rows and columns of a tile
+- (void)copyValues:(const void *)values
+  leadingDimension:(MAVIndex)leadingDimension
+              rows:(MAVIndex)rows
+           columns:(MAVIndex)columns
+          intoTile:(MAVCachedTile *)tile
+{
+    size_t valueSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    for (MAVIndex column = 0; column < columns; column++) {
+        memcpy((uint8_t *)tile.values.mutableBytes + (size_t)column * (size_t)self.tileOrder * valueSize,
+               (const uint8_t *)values + (size_t)column * (size_t)leadingDimension * valueSize,
+               (size_t)rows * valueSize);
+    }
+}
+
+- (MAVCachedTile *)pinTileAtRow:(MAVIndex)tileRow column:(MAVIndex)tileColumn overwrite:(BOOL)overwrite
+{
+    return [self pinTileAtIndex:[self indexOfTileAtRow:tileRow column:tileColumn] overwrite:overwrite];
+}
+
+/**
+ @brief Return a tile from the cache, reading it from the file first if it is not cached, and keep it from being evicted until it is passed to unpinTile:modified:. If another thread is reading the tile, wait for it to finish.
+ @param overwrite YES if the caller will replace every value of the tile, so a tile that is not cached need not be read and starts out as zeros.
+ */
+- (MAVCachedTile *)pinTileAtIndex:(size_t)index overwrite:(BOOL)overwrite
+{
+    NSNumber *key = @(index);
+    
+    pthread_mutex_lock(&_cacheMutex);
+    MAVCachedTile *tile = _cachedTiles[key];
+    BOOL mustRead = NO;
+    if (tile == nil) {
+        tile = [[MAVCachedTile alloc] init];
+        tile.values = [NSMutableData dataWithLength:_tileLength];
+        tile.loaded = overwrite;
+        mustRead = !overwrite;
+        _cachedTiles[key] = tile;
+        _cachedLength += _tileLength;
+    }
+    tile.pins += 1;
+    tile.lastUse = ++_useClock;
+    [self evictTilesLocked];
+    
+    if (mustRead) {
+        pthread_mutex_unlock(&_cacheMutex);
+        BOOL read = MAVReadTileFully(_fileDescriptor, tile.values.mutableBytes, _tileLength, [self offsetOfTileAtIndex:index]);
+        int code = errno;
+        pthread_mutex_lock(&_cacheMutex);
+        if (read) {
+            _bytesRead += _tileLength;
+        } else if (_ioError == nil) {
+            _ioError = MAVMatrixFileSystemError(code, self.url);
+        }
+        tile.loaded = YES;
+        pthread_cond_broadcast(&_tileLoadedCondition);
+    } else {
+        while (!tile.loaded) {
+            pthread_cond_wait(&_tileLoadedCondition, &_cacheMutex);
+        }
+    }
+    pthread_mutex_unlock(&_cacheMutex);
+    
+    return tile;
+}
+
+/**
+ @brief Allow a tile returned by pinTileAtIndex:overwrite: to be evicted again.
+ @param modified YES if the caller changed the values of the tile, so it must be written back to the file.
+ */
+- (void)unpinTile:(MAVCachedTile *)tile modified:(BOOL)modified
+{
+    pthread_mutex_lock(&_cacheMutex);
+    tile.pins -= 1;
+    if (modified) {
+        tile.dirty = YES;
+    }
+    [self evictTilesLocked];
+    pthread_mutex_unlock(&_cacheMutex);
+}
+
+// must be called holding _cacheMutex; evicts the least recently used unpinned tiles until the cache fits the memory budget
+- (void)evictTilesLocked
+{
+    while (_cachedLength > _memoryBudget) {
+        NSNumber *victimIndex;
+        MAVCachedTile *victim;
+        for (NSNumber *index in _cachedTiles) {
+            MAVCachedTile *tile = _cachedTiles[index];
+            if (tile.pins == 0 && (victim == nil || tile.lastUse < victim.lastUse)) {
+                victim = tile;
+                victimIndex = index;
+            }
+        }
+        if (victim == nil) {
+            return;
+        }
+        
+        if (victim.dirty) {
+            [self writeTileLocked:victim atIndex:victimIndex.unsignedLongValue];
+        }
+        [_cachedTiles removeObjectForKey:victimIndex];
+        _cachedLength -= _tileLength;
+    }
+}
+
+// must be called holding _cacheMutex
+- (void)writeTileLocked:(MAVCachedTile *)tile atIndex:(size_t)index
+{
+    if (MAVWriteTileFully(_fileDescriptor, tile.values.bytes, _tileLength, [self offsetOfTileAtIndex:index])) {
+        _bytesWritten += _tileLength;
+        tile.dirty = NO;
+    } else if (_ioError == nil) {
+        _ioError = MAVMatrixFileSystemError(errno, self.url);
+    }
+}
+
+@end
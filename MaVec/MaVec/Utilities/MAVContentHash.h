@@ -0,0 +1,149 @@
+//
+//  MAVContentHash.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+/*
+ A 64-bit hash of a sequence of floating-point values, computed over their values
+ rather than their bits: every value is widened to double, negative zero is
+ hashed as zero and every NaN as the same NaN, so sequences that compare equal
+ value by value hash equally whatever their precision. Values are folded into
+ four independent lanes with the round of xxHash64, so the lanes of a block of
+ four values are computed in parallel, and the lanes are merged and avalanched
+ when the hash is finished. The lane a value goes to depends only on its
+ position, so a sequence may be hashed in chunks of any size.
+ */
+
+#ifndef MAVContentHash_h
+#define MAVContentHash_h
+
+#import <Accelerate/Accelerate.h>
+#import <stdint.h>
+#import <string.h>
+
+#define MAV_CONTENT_HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define MAV_CONTENT_HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define MAV_CONTENT_HASH_PRIME_3 0x165667B19E3779F9ULL
+
+/**
+ The number of values widened from single precision at a time, on the stack.
+ */
+#define MAV_CONTENT_HASH_CHUNK_SIZE 1024
+
+typedef struct {
+    uint64_t lanes[4];
+    uint64_t count;
+} MAVContentHashState;
+
+static inline uint64_t MAVContentHashRotate(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t MAVContentHashRound(uint64_t lane, uint64_t bits)
+{
+    return MAVContentHashRotate(lane + bits * MAV_CONTENT_HASH_PRIME_2, 31) * MAV_CONTENT_HASH_PRIME_1;
+}
+
+/**
+ @return The bits of value, with negative zero replaced by zero and every NaN by the same quiet NaN.
+ */
+static inline uint64_t MAVContentHashCanonicalBits(double value)
+{
+    if (value != value) {
+        return 0x7FF8000000000000ULL;
+    }
+    value += 0.0;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ @param seed A value distinguishing sequences of the same values in differently shaped containers, like their dimensions.
+ */
+static inline void MAVContentHashInit(MAVContentHashState *state, uint64_t seed)
+{
+    state->lanes[0] = seed + MAV_CONTENT_HASH_PRIME_1 + MAV_CONTENT_HASH_PRIME_2;
+    state->lanes[1] = seed + MAV_CONTENT_HASH_PRIME_2;
+    state->lanes[2] = seed;
+    state->lanes[3] = seed - MAV_CONTENT_HASH_PRIME_1;
+    state->count = 0;
+}
+
+static inline void MAVContentHashUpdateD(MAVContentHashState *state, const double *values, size_t count)
+{
+    size_t i = 0;
+    
+    // realign to the start of a block of four lanes
+    for (; i < count && (state->count + i) % 4 != 0; i++) {
+        size_t lane = (size_t)((state->count + i) % 4);
+        state->lanes[lane] = MAVContentHashRound(state->lanes[lane], MAVContentHashCanonicalBits(values[i]));
+    }
+    
+    uint64_t lane0 = state->lanes[0], lane1 = state->lanes[1], lane2 = state->lanes[2], lane3 = state->lanes[3];
+    for (; i + 4 <= count; i += 4) {
+        lane0 = MAVContentHashRound(lane0, MAVContentHashCanonicalBits(values[i]));
+        lane1 = MAVContentHashRound(lane1, MAVContentHashCanonicalBits(values[i + 1]));
+        lane2 = MAVContentHashRound(lane2, MAVContentHashCanonicalBits(values[i + 2]));
+        lane3 = MAVContentHashRound(lane3, MAVContentHashCanonicalBits(values[i + 3]));
+    }
+    state->lanes[0] = lane0;
+    state->lanes[1] = lane1;
+    state->lanes[2] = lane2;
+    state->lanes[3] = lane3;
+    
+    for (; i < count; i++) {
+        size_t lane = (size_t)((state->count + i) % 4);
+        state->lanes[lane] = MAVContentHashRound(state->lanes[lane], MAVContentHashCanonicalBits(values[i]));
+    }
+    
+    state->count += count;
+}
+
+static inline void MAVContentHashUpdate(MAVContentHashState *state, const float *values, size_t count)
+{
+    double widened[MAV_CONTENT_HASH_CHUNK_SIZE];
+    for (size_t start = 0; start < count; start += MAV_CONTENT_HASH_CHUNK_SIZE) {
+        size_t length = count - start < MAV_CONTENT_HASH_CHUNK_SIZE ? count - start : MAV_CONTENT_HASH_CHUNK_SIZE;
+        vDSP_vspdp(values + start, 1, widened, 1, (vDSP_Length)length);
+        MAVContentHashUpdateD(state, widened, length);
+    }
+}
+
+static inline uint64_t MAVContentHashFinish(const MAVContentHashState *state)
+{
+    uint64_t hash = MAVContentHashRotate(state->lanes[0], 1) + MAVContentHashRotate(state->lanes[1], 7)
+    + MAVContentHashRotate(state->lanes[2], 12) + MAVContentHashRotate(state->lanes[3], 18);
+    hash += state->count;
+    hash ^= hash >> 33;
+    hash *= MAV_CONTENT_HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= MAV_CONTENT_HASH_PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+#endif /* MAVContentHash_h */
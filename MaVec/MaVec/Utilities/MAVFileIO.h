@@ -0,0 +1,89 @@
+//
+//  MAVFileIO.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import "MAVMatrix+MAVMatrixFile.h"
+
+/**
+ @class MAVMappedFile
+ @description A file mapped read-only into memory. Pages of the file are only read from disk when they are first touched, and data created with dataWithRange: keeps the mapping alive for as long as it exists, so matrices can be backed directly by the file's contents.
+ */
+@interface MAVMappedFile : NSObject
+
+/**
+ @property bytes
+ @brief The contents of the file, or NULL if it is empty.
+ */
+@property (assign, readonly, nonatomic) const uint8_t *bytes;
+
+/**
+ @property length
+ @brief The length of the file in bytes.
+ */
+@property (assign, readonly, nonatomic) size_t length;
+
+/**
+ @brief Map a file into memory.
+ @param url The file URL of the file to map.
+ @param error If the file cannot be mapped, set to an error in NSPOSIXErrorDomain.
+ @return A new instance of MAVMappedFile, or nil if the file could not be mapped.
+ */
++ (instancetype)mappedFileWithURL:(NSURL *)url error:(NSError **)error;
+
+/**
+ @brief Create read-only data pointing into the mapped file, without copying it.
+ @param range The range of the file's bytes the data contains, which must lie within the file.
+ @return Data that keeps the file mapped until it is deallocated.
+ */
+- (NSData *)dataWithRange:(NSRange)range;
+
+@end
+
+/**
+ @brief Write bytes to a file descriptor, retrying partial and interrupted writes.
+ @return YES if all the bytes were written, NO with errno set otherwise.
+ */
+BOOL MAVWriteFully(int fileDescriptor, const void *bytes, size_t length);
+
+/**
+ @brief Write a file by writing to a temporary file next to it and moving that into place once it is complete, so readers never see a partially written file.
+ @param url The file URL to write to, replacing any existing file.
+ @param error If the file cannot be written, set to an error in NSPOSIXErrorDomain.
+ @param writeBlock A block writing the contents of the file to a file descriptor, which returns NO with errno set if it fails.
+ @return YES if the file was written, NO otherwise.
+ */
+BOOL MAVWriteFileAtomically(NSURL *url, NSError **error, BOOL (^writeBlock)(int fileDescriptor));
+
+/**
+ @return An error in MAVMatrixFileErrorDomain describing why a file cannot be read as a matrix.
+ */
+NSError *MAVMatrixFileFormatError(MAVMatrixFileError code, NSURL *url, NSString *reason);
+
+/**
+ @return An error in NSPOSIXErrorDomain describing a failed system call on a file.
+ */
+NSError *MAVMatrixFileSystemError(int code, NSURL *url);
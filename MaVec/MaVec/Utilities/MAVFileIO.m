@@ -0,0 +1,210 @@
+//
+//  MAVFileIO.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <errno.h>
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+#import "MAVFileIO.h"
+
+/**
+ @brief Read-only data pointing into a MAVMappedFile, which it keeps mapped.
+ */
+@interface MAVMappedData : NSData
+
+- (instancetype)initWithFile:(MAVMappedFile *)file range:(NSRange)range;
+
+@end
+
+@implementation MAVMappedData
+{
+    MAVMappedFile *_file;
+    NSRange _range;
+}
+
+- (instancetype)initWithFile:(MAVMappedFile *)file range:(NSRange)range
+{
+    self = [super init];
+    if (self) {
+        _file = file;
+        _range = range;
+    }
+    return self;
+}
+
+- (const void *)bytes
+{
+    return _file.bytes + _range.location;
+}
+
+- (NSUInteger)length
+{
+    return _range.length;
+}
+
+- (Class)classForCoder
+{
+    // archive as plain data, copying the bytes out of the mapping
+    return [NSData class];
+}
+
+@end
+
+@interface MAVMappedFile ()
+
+@property (assign, readwrite, nonatomic) const uint8_t *bytes;
+@property (assign, readwrite, nonatomic) size_t length;
+
+@end
+
+@implementation MAVMappedFile
+
++ (instancetype)mappedFileWithURL:(NSURL *)url error:(NSError **)error
+{
+    NSAssert(url.isFileURL, @"Only files can be mapped.");
+    
+    int fileDescriptor = open(url.path.fileSystemRepresentation, O_RDONLY);
+    if (fileDescriptor < 0) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(errno, url);
+        }
+        return nil;
+    }
+    
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0) {
+        int code = errno;
+        close(fileDescriptor);
+        if (error) {
+            *error = MAVMatrixFileSystemError(code, url);
+        }
+        return nil;
+    }
+    
+    MAVMappedFile *file = [[MAVMappedFile alloc] init];
+    file.length = (size_t)status.st_size;
+    if (file.length > 0) {
+        // the mapping keeps its own reference to the file, so the descriptor can be closed right away
+        void *mapping = mmap(NULL, file.length, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        if (mapping == MAP_FAILED) {
+            int code = errno;
+            close(fileDescriptor);
+            if (error) {
+                *error = MAVMatrixFileSystemError(code, url);
+            }
+            return nil;
+        }
+        file.bytes = mapping;
+    }
+    close(fileDescriptor);
+    
+    return file;
+}
+
+- (NSData *)dataWithRange:(NSRange)range
+{
+    NSAssert(NSMaxRange(range) <= self.length, @"Range %@ lies outside the mapped file of %zu bytes.", NSStringFromRange(range), self.length);
+    
+    return [[MAVMappedData alloc] initWithFile:self range:range];
+}
+
+- (void)dealloc
+{
+    if (_bytes != NULL) {
+        munmap((void *)_bytes, _length);
+    }
+}
+
+@end
+
+BOOL MAVWriteFully(int fileDescriptor, const void *bytes, size_t length)
+{
+    const uint8_t *remaining = bytes;
+    while (length > 0) {
+        ssize_t written = write(fileDescriptor, remaining, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return NO;
+        }
+        remaining += written;
+        length -= (size_t)written;
+    }
+    return YES;
+}
+
+BOOL MAVWriteFileAtomically(NSURL *url, NSError **error, BOOL (^writeBlock)(int fileDescriptor))
+{
+    NSCAssert(url.isFileURL, @"Files can only be written to file URLs.");
+    
+    // write next to the destination so the final rename cannot cross file systems
+    NSString *temporaryPath = [url.path stringByAppendingFormat:@".%@.tmp", [NSUUID UUID].UUIDString];
+    int fileDescriptor = open(temporaryPath.fileSystemRepresentation, O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fileDescriptor < 0) {
+        if (error) {
+            *error = MAVMatrixFileSystemError(errno, url);
+        }
+        return NO;
+    }
+    
+    BOOL written = writeBlock(fileDescriptor);
+    int code = errno;
+    if (close(fileDescriptor) != 0 && written) {
+        written = NO;
+        code = errno;
+    }
+    if (written && rename(temporaryPath.fileSystemRepresentation, url.path.fileSystemRepresentation) != 0) {
+        written = NO;
+        code = errno;
+    }
+    
+    if (!written) {
+        unlink(temporaryPath.fileSystemRepresentation);
+        if (error) {
+            *error = MAVMatrixFileSystemError(code, url);
+        }
+    }
+    return written;
+}
+
+NSError *MAVMatrixFileFormatError(MAVMatrixFileError code, NSURL *url, NSString *reason)
+{
+    return [NSError errorWithDomain:MAVMatrixFileErrorDomain
+                               code:code
+                           userInfo:@{ NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ is not a readable matrix file: %@", url.path, reason],
+                                       NSURLErrorKey: url }];
+}
+
+NSError *MAVMatrixFileSystemError(int code, NSURL *url)
+{
+    return [NSError errorWithDomain:NSPOSIXErrorDomain
+                               code:code
+                           userInfo:@{ NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@: %s", url.path, strerror(code)],
+                                       NSURLErrorKey: url }];
+}
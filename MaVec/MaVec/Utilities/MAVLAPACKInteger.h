@@ -0,0 +1,68 @@
+//
+//  MAVLAPACKInteger.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+/*
+ The integer type BLAS and LAPACK take for dimensions, leading dimensions,
+ strides, pivots and status codes. MaVec indexes with 64-bit MAVIndex
+ throughout, but the LAPACK Accelerate ships by default (LP64) takes 32-bit
+ integers, so every length crossing into BLAS or LAPACK is narrowed with
+ MAVLAPACKIntegerFromIndex, which asserts that it fits.
+
+ Defining MAV_LAPACK_ILP64 builds against an ILP64 BLAS and LAPACK, like
+ OpenBLAS built with INTERFACE64=1, whose integers are 64-bit; building with
+ Accelerate's ACCELERATE_NEW_LAPACK and ACCELERATE_LAPACK_ILP64 follows the
+ width Accelerate declares. Either way no narrowing is needed.
+ */
+
+#ifndef MAVLAPACKInteger_h
+#define MAVLAPACKInteger_h
+
+#import <Foundation/Foundation.h>
+#import <Accelerate/Accelerate.h>
+
+#import "MAVTypedefs.h"
+
+#if defined(MAV_LAPACK_ILP64)
+typedef int64_t MAVLAPACKInteger;
+#elif defined(ACCELERATE_NEW_LAPACK)
+typedef __LAPACK_int MAVLAPACKInteger;
+#else
+typedef __CLPK_integer MAVLAPACKInteger;
+#endif
+
+/**
+ @brief Narrow a length or index to the integer type of the linked BLAS and LAPACK.
+ @param index The length or index to narrow.
+ @return index as a MAVLAPACKInteger.
+ */
+static inline MAVLAPACKInteger MAVLAPACKIntegerFromIndex(MAVIndex index)
+{
+    NSCAssert1((MAVIndex)(MAVLAPACKInteger)index == index, @"%lld does not fit in the integers of the linked LAPACK; build with MAV_LAPACK_ILP64 against an ILP64 LAPACK to use it.", (long long int)index);
+    return (MAVLAPACKInteger)index;
+}
+
+#endif /* MAVLAPACKInteger_h */
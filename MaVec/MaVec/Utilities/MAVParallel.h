@@ -0,0 +1,82 @@
+//
+//  MAVParallel.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ The number of values below which the kernels in this file run on the calling thread, where the cost of dispatching work to other threads outweighs the gain.
+ */
+#define MAV_PARALLEL_THRESHOLD (1 << 16)
+
+/**
+ The number of values handled by one task of a reduction when reductions are deterministic, independent of the number of processors.
+ */
+#define MAV_PARALLEL_REDUCTION_CHUNK_SIZE (1 << 15)
+
+/**
+ @brief Choose whether parallel reductions, like MAVVector's sumOfValues, produce bitwise identical results on every machine. When YES, the default, the values are split into chunks of a fixed size whose partial results are always combined in the same order. When NO, the values are split according to the number of active processors, which uses fewer, larger chunks, but since floating-point addition is not associative, results may then differ in their last bits between machines.
+ @param deterministic YES to make reductions independent of the number of processors.
+ */
+void MAVParallelSetDeterministicReductions(BOOL deterministic);
+
+/**
+ @return YES if parallel reductions produce bitwise identical results on every machine.
+ */
+BOOL MAVParallelDeterministicReductions(void);
+
+/**
+ @brief Call a block over contiguous ranges of indices which together cover 0 to count. If count * valuesPerIndex is at least MAV_PARALLEL_THRESHOLD, the ranges run concurrently on a global dispatch queue, so the block must be safe to call from several threads at once and must not assume any order between ranges; otherwise the block is called once on the calling thread.
+ @param count The number of indices to cover.
+ @param valuesPerIndex The number of values processed for each index, like the length of a row when iterating over rows, used to decide whether to split the work.
+ @param block The block to call with each range of indices.
+ */
+void MAVParallelForRanges(size_t count, size_t valuesPerIndex, void (^block)(NSRange range));
+
+/**
+ @brief Reduce contiguous ranges of indices covering 0 to count into partial results, concurrently when large enough as described for MAVParallelForRanges, then combine the partial results in ascending order of their ranges.
+ @param count The number of indices to cover.
+ @param valuesPerIndex The number of values processed for each index.
+ @param partialSize The size in bytes of a partial result.
+ @param result A partial result holding the identity of the reduction, which each partial result starts from and into which they are combined.
+ @param rangeBlock A block accumulating a range of indices into a partial result.
+ @param combineBlock A block accumulating a partial result into result.
+ */
+void MAVParallelReduceRanges(size_t count,
+                             size_t valuesPerIndex,
+                             size_t partialSize,
+                             void *result,
+                             void (^rangeBlock)(NSRange range, void *partial),
+                             void (^combineBlock)(void *result, const void *partial));
+
+/**
+ @brief Test whether a predicate holds for any of the contiguous ranges of indices covering 0 to count, concurrently when large enough as described for MAVParallelForRanges. Ranges which have not started when the predicate first holds are skipped.
+ @param count The number of indices to cover.
+ @param valuesPerIndex The number of values processed for each index.
+ @param predicate A block returning YES if the predicate holds for some index in a range.
+ @return YES if the predicate held for any range.
+ */
+BOOL MAVParallelAnyRange(size_t count, size_t valuesPerIndex, BOOL (^predicate)(NSRange range));
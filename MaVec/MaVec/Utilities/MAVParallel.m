@@ -0,0 +1,125 @@
+//
+//  MAVParallel.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <stdatomic.h>
+
+#import "MAVParallel.h"
+
+static atomic_bool MAVDeterministicReductions = true;
+
+/**
+ @brief Decide how many ranges to split count indices into.
+ @param fixedChunkSize YES to use chunks of MAV_PARALLEL_REDUCTION_CHUNK_SIZE values regardless of the machine, NO to use a few chunks per active processor.
+ */
+static size_t MAVParallelChunkCount(size_t count, size_t valuesPerIndex, BOOL fixedChunkSize)
+{
+    if (count == 0 || count * MAX(valuesPerIndex, (size_t)1) < MAV_PARALLEL_THRESHOLD) {
+        return 1;
+    }
+
+    if (fixedChunkSize) {
+        size_t indicesPerChunk = MAX(MAV_PARALLEL_REDUCTION_CHUNK_SIZE / MAX(valuesPerIndex, (size_t)1), (size_t)1);
+        return (count + indicesPerChunk - 1) / indicesPerChunk;
+    }
+
+    // several chunks per processor balance the load when some threads are busy elsewhere
+    return MIN((size_t)[NSProcessInfo processInfo].activeProcessorCount * 4, count);
+}
+
+static NSRange MAVParallelChunkRange(size_t chunk, size_t chunks, size_t count)
+{
+    size_t start = (size_t)((unsigned long long)count * chunk / chunks);
+    size_t end = (size_t)((unsigned long long)count * (chunk + 1) / chunks);
+    return NSMakeRange(start, end - start);
+}
+
+void MAVParallelSetDeterministicReductions(BOOL deterministic)
+{
+    atomic_store(&MAVDeterministicReductions, deterministic);
+}
+
+BOOL MAVParallelDeterministicReductions(void)
+{
+    return atomic_load(&MAVDeterministicReductions);
+}
+
+void MAVParallelForRanges(size_t count, size_t valuesPerIndex, void (^block)(NSRange range))
+{
+    size_t chunks = MAVParallelChunkCount(count, valuesPerIndex, NO);
+    if (chunks == 1) {
+        block(NSMakeRange(0, count));
+        return;
+    }
+
+    dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+        block(MAVParallelChunkRange(chunk, chunks, count));
+    });
+}
+
+void MAVParallelReduceRanges(size_t count,
+                             size_t valuesPerIndex,
+                             size_t partialSize,
+                             void *result,
+                             void (^rangeBlock)(NSRange range, void *partial),
+                             void (^combineBlock)(void *result, const void *partial))
+{
+    size_t chunks = MAVParallelChunkCount(count, valuesPerIndex, MAVParallelDeterministicReductions());
+    char *partials = malloc(chunks * partialSize);
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        memcpy(partials + chunk * partialSize, result, partialSize);
+    }
+
+    if (chunks == 1) {
+        rangeBlock(NSMakeRange(0, count), partials);
+    } else {
+        dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+            rangeBlock(MAVParallelChunkRange(chunk, chunks, count), partials + chunk * partialSize);
+        });
+    }
+
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        combineBlock(result, partials + chunk * partialSize);
+    }
+    free(partials);
+}
+
+BOOL MAVParallelAnyRange(size_t count, size_t valuesPerIndex, BOOL (^predicate)(NSRange range))
+{
+    size_t chunks = MAVParallelChunkCount(count, valuesPerIndex, NO);
+    if (chunks == 1) {
+        return predicate(NSMakeRange(0, count));
+    }
+
+    atomic_bool found = false;
+    atomic_bool *foundPointer = &found;
+    dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+        if (!atomic_load_explicit(foundPointer, memory_order_relaxed) && predicate(MAVParallelChunkRange(chunk, chunks, count))) {
+            atomic_store_explicit(foundPointer, true, memory_order_relaxed);
+        }
+    });
+    return atomic_load(&found);
+}
@@ -0,0 +1,128 @@
+//
+//  MAVRandomGenerator.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import <MCKNumerics/MCKNumerics.h>
+
+typedef enum : UInt8 {
+    /**
+     Values distributed uniformly on [-1, 1).
+     */
+    MAVRandomDistributionUniform,
+    
+    /**
+     Values from the standard normal distribution, with mean 0 and variance 1.
+     */
+    MAVRandomDistributionNormal,
+    
+    /**
+     Values equal to -1 or 1 with equal probability.
+     */
+    MAVRandomDistributionRademacher
+}
+/**
+ Constants describing the distributions of random values a MAVRandomGenerator can produce.
+ */
+MAVRandomDistribution;
+
+/**
+ @brief Apply the Philox4x32-10 bijection, which scrambles a 128-bit counter under a 64-bit key.
+ @param counter The four 32-bit words of the counter.
+ @param key The two 32-bit words of the key.
+ @param output The four 32-bit words of the result.
+ */
+void MAVPhilox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t output[4]);
+
+/**
+ @class MAVRandomGenerator
+ @description A counter-based random number generator built on Philox4x32-10 (see "Parallel Random Numbers: As Easy as 1, 2, 3", Salmon et al., 2011). Each random block is a pure function of the seed, the stream and the block's position in the sequence, so large arrays are filled in parallel, and a generator created with a given seed and stream always produces the same values, on any machine and with any number of threads. Generators with the same seed but different streams produce independent sequences. A generator may be used from several threads at once; each request reserves its own range of the sequence.
+ */
+@interface MAVRandomGenerator : NSObject
+
+/**
+ @property seed
+ @brief The seed of this generator, used as the Philox key.
+ */
+@property (assign, readonly, nonatomic) uint64_t seed;
+
+/**
+ @property stream
+ @brief The stream of this generator, which selects one of 2⁶⁴ independent sequences for a seed.
+ */
+@property (assign, readonly, nonatomic) uint64_t stream;
+
+/**
+ @brief Create a generator producing the sequence identified by a seed and a stream, starting from its beginning.
+ @param seed The seed of the sequence.
+ @param stream The stream of the sequence.
+ @return A new instance of MAVRandomGenerator.
+ */
++ (instancetype)generatorWithSeed:(uint64_t)seed stream:(uint64_t)stream;
+
+/**
+ @brief The generator used by the random factory methods of MAVMatrix and MAVVector that do not take a generator. Unless replaced with setDefaultGenerator:, it is seeded unpredictably when first used.
+ @return The default generator.
+ */
++ (MAVRandomGenerator *)defaultGenerator;
+
+/**
+ @brief Replace the default generator, for instance with a seeded one to make the random factory methods reproducible.
+ @param generator The new default generator.
+ */
++ (void)setDefaultGenerator:(MAVRandomGenerator *)generator;
+
+/**
+ @brief Generate random values from a distribution.
+ @param distribution The distribution of the values.
+ @param count The number of values to generate.
+ @param precision The precision of the values, either single- or double-precision.
+ @return An array containing count values of the specified precision.
+ */
+- (NSData *)valuesWithDistribution:(MAVRandomDistribution)distribution
+                             count:(size_t)count
+                         precision:(MCKPrecision)precision;
+
+/**
+ @brief Fill an array with random values from a distribution, in parallel when the array is large.
+ @param values An array of doubles or floats with room for count values.
+ @param count The number of values to generate.
+ @param distribution The distribution of the values.
+ @param precision The precision of the values, either single- or double-precision.
+ */
+- (void)fillValues:(void *)values
+             count:(size_t)count
+      distribution:(MAVRandomDistribution)distribution
+         precision:(MCKPrecision)precision;
+
+/**
+ @brief Generate a random index.
+ @param bound The number of possible indices, which must be positive.
+ @return An index uniformly distributed on [0, bound).
+ */
+- (NSUInteger)randomIndexBelow:(NSUInteger)bound;
+
+@end
@@ -0,0 +1,250 @@
+//
+//  MAVRandomGenerator.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <math.h>
+#import <stdatomic.h>
+#import <stdlib.h>
+
+#import "MAVParallel.h"
+#import "MAVRandomGenerator.h"
+
+/**
+ The number of double-precision values generated from one Philox block of four 32-bit words.
+ */
+#define MAV_RANDOM_DOUBLES_PER_BLOCK 2
+
+/**
+ The number of single-precision values generated from one Philox block of four 32-bit words.
+ */
+#define MAV_RANDOM_FLOATS_PER_BLOCK 4
+
+static MAVRandomGenerator *MAVDefaultRandomGenerator;
+
+static inline uint32_t MAVMultiplyHighLow(uint32_t a, uint32_t b, uint32_t *high)
+{
+    uint64_t product = (uint64_t)a * b;
+    *high = (uint32_t)(product >> 32);
+    return (uint32_t)product;
+}
+
+void MAVPhilox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t output[4])
+{
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        uint32_t high0, high1;
+        uint32_t low0 = MAVMultiplyHighLow(0xD2511F53, c0, &high0);
+        uint32_t low1 = MAVMultiplyHighLow(0xCD9E8D57, c2, &high1);
+        c0 = high1 ^ c1 ^ k0;
+        c1 = low1;
+        c2 = high0 ^ c3 ^ k1;
+        c3 = low0;
+        
+        // bump the key with the Weyl sequence constants
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    output[0] = c0;
+    output[1] = c1;
+    output[2] = c2;
+    output[3] = c3;
+}
+
+/**
+ @return A double uniformly distributed on [0, 1) from the 53 high bits of two words.
+ */
+static inline double MAVUnitDouble(uint32_t high, uint32_t low)
+{
+    return (double)((((uint64_t)high << 32) | low) >> 11) * 0x1.0p-53;
+}
+
+/**
+ @return A float uniformly distributed on [0, 1) from the 24 high bits of a word.
+ */
+static inline float MAVUnitFloat(uint32_t word)
+{
+    return (float)(word >> 8) * 0x1.0p-24f;
+}
+
+@interface MAVRandomGenerator ()
+
+@property (assign, readwrite, nonatomic) uint64_t seed;
+@property (assign, readwrite, nonatomic) uint64_t stream;
+
+@end
+
+@implementation MAVRandomGenerator
+{
+    // the position in the sequence of the next unreserved block
+    atomic_uint_fast64_t _nextBlock;
+}
+
+#pragma mark - Constructors
+
++ (instancetype)generatorWithSeed:(uint64_t)seed stream:(uint64_t)stream
+{
+    MAVRandomGenerator *generator = [[self alloc] init];
+    generator.seed = seed;
+    generator.stream = stream;
+    atomic_init(&generator->_nextBlock, 0);
+    return generator;
+}
+
++ (MAVRandomGenerator *)defaultGenerator
+{
+    @synchronized(self) {
+        if (MAVDefaultRandomGenerator == nil) {
+            uint64_t seed = ((uint64_t)arc4random() << 32) | arc4random();
+            MAVDefaultRandomGenerator = [MAVRandomGenerator generatorWithSeed:seed stream:0];
+        }
+        return MAVDefaultRandomGenerator;
+    }
+}
+
++ (void)setDefaultGenerator:(MAVRandomGenerator *)generator
+{
+    @synchronized(self) {
+        MAVDefaultRandomGenerator = generator;
+    }
+}
+
+#pragma mark - Generation
+
+- (NSData *)valuesWithDistribution:(MAVRandomDistribution)distribution
+                             count:(size_t)count
+                         precision:(MCKPrecision)precision
+{
+    size_t size = count * (precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
+    void *values = malloc(size);
+    [self fillValues:values count:count distribution:distribution precision:precision];
+    return [NSData dataWithBytesNoCopy:values length:size];
+}
+
+- (void)fillValues:(void *)values
+             count:(size_t)count
+      distribution:(MAVRandomDistribution)distribution
+         precision:(MCKPrecision)precision
+{
+    size_t valuesPerBlock = precision == MCKPrecisionDouble ? MAV_RANDOM_DOUBLES_PER_BLOCK : MAV_RANDOM_FLOATS_PER_BLOCK;
+    size_t blocks = (count + valuesPerBlock - 1) / valuesPerBlock;
+    uint64_t firstBlock = [self reserveBlocks:blocks];
+    uint32_t key[2] = { (uint32_t)self.seed, (uint32_t)(self.seed >> 32) };
+    uint64_t stream = self.stream;
+    
+    MAVParallelForRanges(blocks, valuesPerBlock, ^(NSRange range) {
+        for (size_t block = range.location; block < NSMaxRange(range); block++) {
+            uint64_t position = firstBlock + block;
+            uint32_t counter[4] = { (uint32_t)position, (uint32_t)(position >> 32), (uint32_t)stream, (uint32_t)(stream >> 32) };
+            uint32_t words[4];
+            MAVPhilox4x32(counter, key, words);
+            
+            size_t start = block * valuesPerBlock;
+            size_t valuesInBlock = MIN(valuesPerBlock, count - start);
+            if (precision == MCKPrecisionDouble) {
+                double blockValues[MAV_RANDOM_DOUBLES_PER_BLOCK];
+                double u0 = MAVUnitDouble(words[0], words[1]);
+                double u1 = MAVUnitDouble(words[2], words[3]);
+                switch (distribution) {
+                    case MAVRandomDistributionUniform:
+                        blockValues[0] = 2.0 * u0 - 1.0;
+                        blockValues[1] = 2.0 * u1 - 1.0;
+                        break;
+                        
+                    case MAVRandomDistributionNormal: {
+                        // Box-Muller transform; 1 - u0 is in (0, 1], so the logarithm is finite
+                        double radius = sqrt(-2.0 * log(1.0 - u0));
+                        double angle = 2.0 * M_PI * u1;
+                        blockValues[0] = radius * cos(angle);
+                        blockValues[1] = radius * sin(angle);
+                    } break;
+                        
+                    case MAVRandomDistributionRademacher:
+                        blockValues[0] = (words[0] >> 31) ? 1.0 : -1.0;
+                        blockValues[1] = (words[2] >> 31) ? 1.0 : -1.0;
+                        break;
+                        
+                    default: break;
+                }
+                memcpy((double *)values + start, blockValues, valuesInBlock * sizeof(double));
+            } else {
+                float blockValues[MAV_RANDOM_FLOATS_PER_BLOCK];
+                for (int i = 0; i < MAV_RANDOM_FLOATS_PER_BLOCK; i += 2) {
+                    float u0 = MAVUnitFloat(words[i]);
+                    float u1 = MAVUnitFloat(words[i + 1]);
+                    switch (distribution) {
+                        case MAVRandomDistributionUniform:
+                            blockValues[i] = 2.0f * u0 - 1.0f;
+                            blockValues[i + 1] = 2.0f * u1 - 1.0f;
+                            break;
+                            
+                        case MAVRandomDistributionNormal: {
+                            float radius = sqrtf(-2.0f * logf(1.0f - u0));
+                            float angle = 2.0f * (float)M_PI * u1;
+                            blockValues[i] = radius * cosf(angle);
+                            blockValues[i + 1] = radius * sinf(angle);
+                        } break;
+                            
+                        case MAVRandomDistributionRademacher:
+                            blockValues[i] = (words[i] >> 31) ? 1.0f : -1.0f;
+                            blockValues[i + 1] = (words[i + 1] >> 31) ? 1.0f : -1.0f;
+                            break;
+                            
+                        default: break;
+                    }
+                }
+                memcpy((float *)values + start, blockValues, valuesInBlock * sizeof(float));
+            }
+        }
+    });
+}
+
+- (NSUInteger)randomIndexBelow:(NSUInteger)bound
+{
+    NSAssert(bound > 0, @"Cannot generate an index below 0.");
+    
+    uint64_t position = [self reserveBlocks:1];
+    uint32_t key[2] = { (uint32_t)self.seed, (uint32_t)(self.seed >> 32) };
+    uint32_t counter[4] = { (uint32_t)position, (uint32_t)(position >> 32), (uint32_t)self.stream, (uint32_t)(self.stream >> 32) };
+    uint32_t words[4];
+    MAVPhilox4x32(counter, key, words);
+    
+    // scale instead of taking a remainder, which would favor small indices
+    NSUInteger index = (NSUInteger)(MAVUnitDouble(words[0], words[1]) * bound);
+    return MIN(index, bound - 1);
+}
+
+#pragma mark - Private
+
+/**
+ @brief Reserve a range of the sequence for one request, so concurrent requests never reuse blocks.
+ @return The position of the first reserved block.
+ */
+- (uint64_t)reserveBlocks:(size_t)blocks
+{
+    return atomic_fetch_add(&_nextBlock, (uint_fast64_t)blocks);
+}
+
+@end
@@ -29,9 +29,9 @@
 #import <Accelerate/Accelerate.h>
 
 /*
- Type to index into elements of a vector or the rows and columns of a matrix.
+ Type to index into elements of a vector or the rows and columns of a matrix. It is 64-bit on every architecture, so lengths and indices of vectors and matrices with more than 2^31 values are representable, whatever the width of the integers of the linked BLAS and LAPACK.
  */
-typedef __CLPK_integer MAVIndex;
+typedef int64_t MAVIndex;
 
 #pragma mark - Vectors
 
@@ -51,6 +51,27 @@ typedef enum : UInt8 {
  */
 MAVVectorFormat;
 
+typedef enum : UInt8 {
+    /**
+     The dot product of two vectors, where larger values are more similar.
+     */
+    MAVVectorSimilarityMetricDotProduct,
+
+    /**
+     The cosine of the angle between two vectors, where larger values are more similar.
+     */
+    MAVVectorSimilarityMetricCosine,
+
+    /**
+     The Euclidean distance between two vectors, where smaller values are more similar.
+     */
+    MAVVectorSimilarityMetricEuclideanDistance
+}
+/**
+ Constants specifying how to compare vectors when searching for the nearest neighbors of a vector.
+ */
+MAVVectorSimilarityMetric;
+
 #pragma mark - Matrices
 
 typedef enum : UInt8 {
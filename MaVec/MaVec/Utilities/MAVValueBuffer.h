@@ -0,0 +1,72 @@
+//
+//  MAVValueBuffer.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+/**
+ @class MAVValueBuffer
+ @description Reference-counted storage for the values of a matrix or vector, which lets copies share one array of values instead of duplicating it. The buffer counts the instances that own it: an instance handing its buffer to a copy calls sharedBuffer, and calls relinquish when it lets go of a buffer. Before writing to its values, an instance replaces its buffer with writableBuffer, which only copies the values if another instance still owns them.
+ */
+@interface MAVValueBuffer : NSObject
+
+/**
+ @property data
+ @brief The values in the buffer, which must not be written to except through writableBuffer.
+ */
+@property (strong, nonatomic, readonly) NSData *data;
+
+/**
+ @brief Create a buffer with a single owner holding the supplied values, without copying them. The values are treated as immutable, so the first call to writableBuffer copies them.
+ @param data The values to store.
+ @return A new instance of MAVValueBuffer.
+ */
++ (instancetype)bufferWithData:(NSData *)data;
+
+/**
+ @brief Create a buffer with a single owner holding the supplied values, without copying them. The owner may write to the values in place for as long as it does not share the buffer.
+ @param data The values to store, which no object other than the buffer may reference.
+ @return A new instance of MAVValueBuffer.
+ */
++ (instancetype)bufferWithMutableData:(NSMutableData *)data;
+
+/**
+ @brief Record another owner of this buffer.
+ @return This buffer, for the new owner to keep.
+ */
+- (instancetype)sharedBuffer;
+
+/**
+ @brief Record that an owner no longer uses this buffer.
+ */
+- (void)relinquish;
+
+/**
+ @brief Obtain a buffer whose values the calling owner may write to in place. If the caller is the only owner and the buffer was created with mutable values, this is the receiver; otherwise the caller relinquishes the receiver and receives a new buffer, of which it is the only owner, holding a mutable copy of the values.
+ @return A buffer whose data is an instance of NSMutableData owned by the caller alone.
+ */
+- (MAVValueBuffer *)writableBuffer;
+
+@end
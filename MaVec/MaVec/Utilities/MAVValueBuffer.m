@@ -0,0 +1,81 @@
+//
+//  MAVValueBuffer.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <stdatomic.h>
+
+#import "MAVValueBuffer.h"
+
+@interface MAVValueBuffer ()
+
+@property (strong, nonatomic, readwrite) NSData *data;
+
+@end
+
+@implementation MAVValueBuffer
+{
+    atomic_int _owners;
+    BOOL _writable;
+}
+
++ (instancetype)bufferWithData:(NSData *)data
+{
+    MAVValueBuffer *buffer = [[self alloc] init];
+    buffer.data = data;
+    atomic_init(&buffer->_owners, 1);
+    return buffer;
+}
+
++ (instancetype)bufferWithMutableData:(NSMutableData *)data
+{
+    MAVValueBuffer *buffer = [self bufferWithData:data];
+    buffer->_writable = YES;
+    return buffer;
+}
+
+- (instancetype)sharedBuffer
+{
+    atomic_fetch_add(&_owners, 1);
+    return self;
+}
+
+- (void)relinquish
+{
+    atomic_fetch_sub(&_owners, 1);
+}
+
+- (MAVValueBuffer *)writableBuffer
+{
+    // another owner can only let go of the buffer concurrently, which at worst causes an unneeded copy, never a missed one
+    if (_writable && atomic_load(&_owners) == 1) {
+        return self;
+    }
+    
+    MAVValueBuffer *buffer = [MAVValueBuffer bufferWithMutableData:[self.data mutableCopy]];
+    [self relinquish];
+    return buffer;
+}
+
+@end
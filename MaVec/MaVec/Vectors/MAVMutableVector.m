@@ -30,6 +30,7 @@
 
 #import "MAVConstants.h"
 #import "MAVMutableVector.h"
+#import "MAVParallel.h"
 #import "MAVVector-Protected.h"
 
 typedef enum {
@@ -76,8 +77,6 @@ MAVVectorMutatingOperationType;
 
 @interface MAVMutableVector ()
 
-@property (strong, nonatomic, readwrite) NSMutableData *values;
-
 /**
  *  Reset the calculated state data of this vector if a mutable operation invalidates it.
  *
@@ -91,8 +90,6 @@ MAVVectorMutatingOperationType;
 
 @implementation MAVMutableVector
 
-@dynamic values;
-
 - (void)setValue:(NSNumber *)value atIndex:(MAVIndex)index
 {
     NSAssert(index >= 0 && index < self.length, @"index = %lld out of the range of values in the vector (%lld)", (long long int)index, (long long int)self.length);
@@ -106,12 +103,12 @@ MAVVectorMutatingOperationType;
     if ([value isDoublePrecision]) {
         double *bytes = malloc(sizeof(double));
         bytes[0] = value.doubleValue;
-        [self.values replaceBytesInRange:NSMakeRange(index * sizeof(double), sizeof(double)) withBytes:bytes];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(index * sizeof(double), sizeof(double)) withBytes:bytes];
         free(bytes);
     } else {
         float *bytes = malloc(sizeof(float));
         bytes[0] = value.floatValue;
-        [self.values replaceBytesInRange:NSMakeRange(index * sizeof(float), sizeof(float)) withBytes:bytes];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(index * sizeof(float), sizeof(float)) withBytes:bytes];
         free(bytes);
     }
 }
@@ -144,19 +141,17 @@ MAVVectorMutatingOperationType;
     [self resetToDefaultIfOperation:MAVVectorMutatingOperationTypeMultiplicationScalar notIdempotentWithInput:scalar atIndex:0];
     
     if (self.precision == MCKPrecisionDouble) {
-        double *newValues = malloc(self.length * sizeof(double));
-        for (MAVIndex i = 0; i < self.length; i++) {
-            newValues[i] = scalar.doubleValue * ((double *)self.values.bytes)[i];
-        }
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:newValues];
-        free(newValues);
+        double *values = self.mutableValues.mutableBytes;
+        double scalarValue = scalar.doubleValue;
+        MAVParallelForRanges(self.length, 1, ^(NSRange range) {
+            vDSP_vsmulD(values + range.location, 1, &scalarValue, values + range.location, 1, range.length);
+        });
     } else {
-        float *newValues = malloc(self.length * sizeof(float));
-        for (MAVIndex i = 0; i < self.length; i++) {
-            newValues[i] = scalar.floatValue * ((float *)self.values.bytes)[i];
-        }
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:newValues];
-        free(newValues);
+        float *values = self.mutableValues.mutableBytes;
+        float scalarValue = scalar.floatValue;
+        MAVParallelForRanges(self.length, 1, ^(NSRange range) {
+            vDSP_vsmul(values + range.location, 1, &scalarValue, values + range.location, 1, range.length);
+        });
     }
     
     return self;
@@ -172,12 +167,12 @@ MAVVectorMutatingOperationType;
     if (self.precision == MCKPrecisionDouble) {
         double *sum = malloc(self.length * sizeof(double));
         vDSP_vaddD(self.values.bytes, 1, vector.values.bytes, 1, sum, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:sum];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:sum];
         free(sum);
     } else {
         float *sum = malloc(self.length * sizeof(float));
         vDSP_vadd(self.values.bytes, 1, vector.values.bytes, 1, sum, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:sum];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:sum];
         free(sum);
     }
     
@@ -194,12 +189,12 @@ MAVVectorMutatingOperationType;
     if (vector.precision == MCKPrecisionDouble) {
         double *diff = malloc(self.length * sizeof(double));
         vDSP_vsubD(vector.values.bytes, 1, self.values.bytes, 1, diff, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:diff];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:diff];
         free(diff);
     } else {
         float *diff = malloc(self.length * sizeof(float));
         vDSP_vsub(vector.values.bytes, 1, self.values.bytes, 1, diff, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:diff];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:diff];
         free(diff);
     }
     
@@ -216,12 +211,12 @@ MAVVectorMutatingOperationType;
     if (self.precision == MCKPrecisionDouble) {
         double *product = malloc(self.length * sizeof(double));
         vDSP_vmulD(self.values.bytes, 1, vector.values.bytes, 1, product, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:product];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:product];
         free(product);
     } else {
         float *product = malloc(self.length * sizeof(float));
         vDSP_vmul(self.values.bytes, 1, vector.values.bytes, 1, product, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:product];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:product];
         free(product);
     }
     
@@ -238,12 +233,12 @@ MAVVectorMutatingOperationType;
     if (self.precision == MCKPrecisionDouble) {
         double *quotient = malloc(self.length * sizeof(double));
         vDSP_vdivD(vector.values.bytes, 1, self.values.bytes, 1, quotient, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:quotient];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:quotient];
         free(quotient);
     } else {
         float *quotient = malloc(self.length * sizeof(float));
         vDSP_vdiv(vector.values.bytes, 1, self.values.bytes, 1, quotient, 1, self.length);
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:quotient];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:quotient];
         free(quotient);
     }
     
@@ -261,14 +256,14 @@ MAVVectorMutatingOperationType;
         for (MAVIndex i = 0; i < original.length; i++) {
             powerValues[i] = pow([original valueAtIndex:i].doubleValue, power);
         }
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:powerValues];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:powerValues];
         free(powerValues);
     } else {
         float *powerValues = malloc(original.length * sizeof(float));
         for (MAVIndex i = 0; i < original.length; i++) {
             powerValues[i] = powf([original valueAtIndex:i].floatValue, power);
         }
-        [self.values replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:powerValues];
+        [self.mutableValues replaceBytesInRange:NSMakeRange(0, self.values.length) withBytes:powerValues];
         free(powerValues);
     }
     
@@ -284,19 +279,14 @@ MAVVectorMutatingOperationType;
     switch (operation) {
         case MAVVectorMutatingOperationTypeAddition:
         case MAVVectorMutatingOperationTypeSubtraction: {
-            MAVVector *vector = input;
-            isIdempotent = [vector isEqualToVector:[MAVVector vectorFilledWithValue:(vector.precision == MCKPrecisionDouble ? @0.0 : @0.0f)
-                                                                             length:vector.length
-                                                                       vectorFormat:vector.vectorFormat]];
+            // adding or subtracting zeros, or multiplying or dividing by ones, changes nothing
+            isIdempotent = ((MAVVector *)input).isZero.isYes;
             break;
         }
             
         case MAVVectorMutatingOperationTypeMultiplicationVector:
         case MAVVectorMutatingOperationTypeDivision: {
-            MAVVector *vector = input;
-            isIdempotent = [vector isEqualToVector:[MAVVector vectorFilledWithValue:(vector.precision == MCKPrecisionDouble ? @1.0 : @1.0f)
-                                                                             length:vector.length
-                                                                       vectorFormat:vector.vectorFormat]];
+            isIdempotent = ((MAVVector *)input).isIdentity.isYes;
             break;
         }
             
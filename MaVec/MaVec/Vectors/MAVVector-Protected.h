@@ -35,10 +35,12 @@
 @property (strong, readwrite, nonatomic) NSNumber *l2Norm;
 @property (strong, readwrite, nonatomic) NSNumber *l3Norm;
 @property (strong, readwrite, nonatomic) NSNumber *infinityNorm;
+@property (strong, readwrite, nonatomic) NSNumber *mean;
+@property (strong, readwrite, nonatomic) NSNumber *variance;
 @property (strong, readwrite, nonatomic) NSNumber *minimumValue;
 @property (strong, readwrite, nonatomic) NSNumber *maximumValue;
-@property (assign, readwrite, nonatomic) int minimumValueIndex;
-@property (assign, readwrite, nonatomic) int maximumValueIndex;
+@property (assign, readwrite, nonatomic) MAVIndex minimumValueIndex;
+@property (assign, readwrite, nonatomic) MAVIndex maximumValueIndex;
 @property (strong, readwrite, nonatomic) MAVVector *absoluteVector;
 @property (assign, readwrite, nonatomic) MCKPrecision precision;
 @property (strong, readwrite, nonatomic) MCKTribool *isIdentity;
@@ -50,7 +52,7 @@
  @param length The length of the C array.
  @return A new instance of MAVVector in a default state.
  */
-- (instancetype)initWithValues:(NSData *)values length:(int)length;
+- (instancetype)initWithValues:(NSData *)values length:(MAVIndex)length;
 
 /**
  @brief Constructs new instance by calling [self init] and sets the supplied values and inferred length.
@@ -59,6 +61,13 @@
  */
 - (instancetype)initWithValuesInArray:(NSArray *)values;
 
+/**
+ *  Returns the values of this vector for writing in place, first copying them 
+ *  if they are shared with a copy of this vector. Only mutable vectors write 
+ *  to their values.
+ */
+- (NSMutableData *)mutableValues;
+
 /**
  *  Sets any computed values or structures that may change with variation in 
  *  vector values to their default values (nil, -1, etc).
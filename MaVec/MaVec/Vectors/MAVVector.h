@@ -28,6 +28,7 @@
 #import <Foundation/Foundation.h>
 #import <MCKNumerics/MCKNumerics.h>
 
+#import "MAVRandomGenerator.h"
 #import "MAVTypedefs.h"
 
 @class MCKTribool;
@@ -36,7 +37,7 @@
  @class MAVVector
  @description A class providing storage and operations for vectors of double precision floating-point numbers, where underlying details about the internal representation (e.g. row- or column- orientation are abstracted away).
  */
-@interface MAVVector : NSObject<NSCopying, NSMutableCopying>
+@interface MAVVector : NSObject<NSCopying, NSMutableCopying, NSSecureCoding>
 
 /**
  @property vectorFormat
@@ -48,7 +49,7 @@
  @property length
  @brief The amount of values in this vector.
  */
-@property (assign, readonly, nonatomic) int length;
+@property (assign, readonly, nonatomic) MAVIndex length;
 
 /**
  @property values
@@ -108,13 +109,25 @@
  @property maximumValueIndex
  @brief The index of the maximum value in the vector. (Lazy-loaded)
  */
-@property (assign, readonly, nonatomic) int maximumValueIndex;
+@property (assign, readonly, nonatomic) MAVIndex maximumValueIndex;
 
 /**
  @property minimumValueIndex
  @brief The index of the minimum value in the vector. (Lazy-loaded)
  */
-@property (assign, readonly, nonatomic) int minimumValueIndex;
+@property (assign, readonly, nonatomic) MAVIndex minimumValueIndex;
+
+/**
+ @property mean
+ @brief The arithmetic mean of the values in the vector. (Lazy-loaded by computeSummaryStatistics)
+ */
+@property (strong, readonly, nonatomic) NSNumber *mean;
+
+/**
+ @property variance
+ @brief The sample variance of the values in the vector, which divides the sum of squared deviations from the mean by one less than the length, or zero for vectors with fewer than two values. (Lazy-loaded by computeSummaryStatistics)
+ */
+@property (strong, readonly, nonatomic) NSNumber *variance;
 
 /**
  @property absoluteVector
@@ -122,6 +135,12 @@
  */
 @property (strong, readonly, nonatomic) MAVVector *absoluteVector;
 
+/**
+ @property contentHash
+ @brief A 64-bit hash of the values in the vector, computed from their values rather than their bits and independent of the vector format. (Lazy-loaded)
+ */
+@property (assign, readonly, nonatomic) uint64_t contentHash;
+
 /**
  @property precision
  @brief The precision of the numeric values in the vector, either single- or double-precision floating point.
@@ -149,7 +168,7 @@
  @param vectorFormat The vector representation of the values, either MAVVectorFormatRow or MAVVectorFormatColumn.
  @return A new instance of MAVVector representing the specified vector.
  */
-- (instancetype)initWithValues:(NSData *)values length:(int)length vectorFormat:(MAVVectorFormat)vectorFormat;
+- (instancetype)initWithValues:(NSData *)values length:(MAVIndex)length vectorFormat:(MAVVectorFormat)vectorFormat;
 
 /**
  @brief Class convenience method to create a new MAVVector with supplied values in column vector format.
@@ -157,7 +176,7 @@
  @param length The number of values being stored in the vector.
  @return A new instance of MAVVector representing the specified vector.
  */
-+ (instancetype)vectorWithValues:(NSData *)values length:(int)length;
++ (instancetype)vectorWithValues:(NSData *)values length:(MAVIndex)length;
 
 /**
  @brief Class convenience method to create a new MAVVector with supplied values in the specified vector format.
@@ -166,7 +185,7 @@
  @param vectorFormat The vector representation of the values, either MAVVectorFormatRow or MAVVectorFormatColumn.
  @return A new instance of MAVVector representing the specified vector.
  */
-+ (instancetype)vectorWithValues:(NSData *)values length:(int)length vectorFormat:(MAVVectorFormat)vectorFormat;
++ (instancetype)vectorWithValues:(NSData *)values length:(MAVIndex)length vectorFormat:(MAVVectorFormat)vectorFormat;
 
 /**
  @brief Initializes a new MAVVector with supplied values in the specified vector format.
@@ -192,14 +211,29 @@
 + (instancetype)vectorWithValuesInArray:(NSArray *)values vectorFormat:(MAVVectorFormat)vectorFormat;
 
 /**
- @brief Generate a vector containing random single- or double-precision floating point values.
+ @brief Generate a vector containing random single- or double-precision floating point values distributed uniformly on [-1, 1), drawn from the default MAVRandomGenerator.
+ @param length The amount of random values to generate for the matrix.
+ @param vectorFormat The format of the vector to generate, either column or row.
+ @param precision The precision of the random values to generate, either single- or double- precision.
+ @return A new MAVVector containing the amount of random values of specified precision.
+ */
++ (instancetype)randomVectorOfLength:(MAVIndex)length
+                        vectorFormat:(MAVVectorFormat)vectorFormat
+                           precision:(MCKPrecision)precision;
+
+/**
+ @brief Generate a vector containing random single- or double-precision floating point values from the specified distribution.
  @param length The amount of random values to generate for the matrix.
  @param vectorFormat The format of the vector to generate, either column or row.
+ @param distribution The distribution of the values.
+ @param generator The generator to draw the values from; seed it to make the vector reproducible.
  @param precision The precision of the random values to generate, either single- or double- precision.
  @return A new MAVVector containing the amount of random values of specified precision.
  */
-+ (instancetype)randomVectorOfLength:(int)length
++ (instancetype)randomVectorOfLength:(MAVIndex)length
                         vectorFormat:(MAVVectorFormat)vectorFormat
+                        distribution:(MAVRandomDistribution)distribution
+                           generator:(MAVRandomGenerator *)generator
                            precision:(MCKPrecision)precision;
 
 /**
@@ -210,12 +244,13 @@
  @return A new MAVVector with specified length and vector format containing the specified value at each element.
  */
 + (instancetype)vectorFilledWithValue:(NSNumber *)value
-                               length:(int)length
+                               length:(MAVIndex)length
                          vectorFormat:(MAVVectorFormat)vectorFormat;
 
 #pragma mark - NSObject overrides
 
 /**
+ @description Vectors whose content hashes have both been computed and differ are unequal without comparing their values, which are otherwise compared with memcmp.
  @return YES is otherVector is either this instance of MAVVector or is identical in length and contains identical values at all positions; NO otherwise.
  */
 - (BOOL)isEqualToVector:(MAVVector *)otherVector;
@@ -224,6 +259,10 @@
  @return YES is otherVector is either this instance of MAVVector or is identical in length and contains identical values at all positions; NO otherwise.
  */
 - (BOOL)isEqual:(id)object;
+
+/**
+ @return The content hash of this vector, so that equal vectors have equal hashes. Mutable vectors must not be mutated while they are used as dictionary keys or set members.
+ */
 - (NSUInteger)hash;
 
 /**
@@ -241,6 +280,11 @@
  */
 - (NSNumber *)valueAtIndex:(MAVIndex)index;
 
+/**
+ @brief Compute the sum, minimum and maximum values with their indices, L1, L2 and L∞ norms, mean and variance of the values in a single pass over them, caching all of them along with isZero and isIdentity. Reading several of these properties from a large vector is faster after calling this than computing each of them on its own. The values are read in blocks small enough to stay in cache while each is reduced, and the partial means and variances of the blocks are combined as in Chan's algorithm, avoiding the cancellation of subtracting accumulated sums of squares.
+ */
+- (void)computeSummaryStatistics;
+
 #pragma mark - Subscripting
 
 /**
@@ -27,11 +27,188 @@
 
 #import <MCKNumerics/MCKNumerics.h>
 
+#import "MAVContentHash.h"
 #import "MAVMutableVector.h"
+#import "MAVParallel.h"
+#import "MAVValueBuffer.h"
 #import "MAVVector-Protected.h"
 #import "MAVVector.h"
 
+/**
+ A partial result of a search for an extreme value of a vector.
+ */
+typedef struct {
+    double value;
+    MAVIndex index;
+} MAVIndexedDouble;
+
+/**
+ A partial result of a search for an extreme value of a single-precision vector.
+ */
+typedef struct {
+    float value;
+    MAVIndex index;
+} MAVIndexedFloat;
+
+/**
+ The number of values computeSummaryStatistics reduces at a time, few enough that a block and its centered copy stay in the L1 cache while every reduction reads them.
+ */
+#define MAV_VECTOR_STATISTICS_BLOCK_LENGTH 512
+
+/**
+ Summary statistics of a range of values of a vector.
+ */
+typedef struct {
+    size_t count;
+    double sum;
+    double mean;
+    double squaredDeviations;
+    double sumOfSquares;
+    double sumOfMagnitudes;
+    double maximumMagnitude;
+    MAVIndexedDouble minimum;
+    MAVIndexedDouble maximum;
+} MAVVectorStatisticsD;
+
+/**
+ Summary statistics of a range of values of a single-precision vector.
+ */
+typedef struct {
+    size_t count;
+    float sum;
+    float mean;
+    float squaredDeviations;
+    float sumOfSquares;
+    float sumOfMagnitudes;
+    float maximumMagnitude;
+    MAVIndexedFloat minimum;
+    MAVIndexedFloat maximum;
+} MAVVectorStatistics;
+
+/**
+ Combine the statistics of a range of values into the statistics of the range preceding it, merging means and squared deviations as in Chan's algorithm.
+ */
+static void MAVVectorStatisticsCombineD(MAVVectorStatisticsD *statistics, const MAVVectorStatisticsD *other)
+{
+    if (other->count == 0) {
+        return;
+    }
+    if (statistics->count == 0) {
+        *statistics = *other;
+        return;
+    }
+    
+    double count = (double)(statistics->count + other->count);
+    double delta = other->mean - statistics->mean;
+    statistics->squaredDeviations += other->squaredDeviations + delta * delta * ((double)statistics->count * (double)other->count / count);
+    statistics->mean += delta * ((double)other->count / count);
+    statistics->count += other->count;
+    statistics->sum += other->sum;
+    statistics->sumOfSquares += other->sumOfSquares;
+    statistics->sumOfMagnitudes += other->sumOfMagnitudes;
+    statistics->maximumMagnitude = MAX(statistics->maximumMagnitude, other->maximumMagnitude);
+    
+    // ranges are combined in ascending order, so ties keep the first index as in a serial scan
+    if (other->minimum.value < statistics->minimum.value) {
+        statistics->minimum = other->minimum;
+    }
+    if (other->maximum.value > statistics->maximum.value) {
+        statistics->maximum = other->maximum;
+    }
+}
+
+static void MAVVectorStatisticsCombine(MAVVectorStatistics *statistics, const MAVVectorStatistics *other)
+{
+    if (other->count == 0) {
+        return;
+    }
+    if (statistics->count == 0) {
+        *statistics = *other;
+        return;
+    }
+    
+    float count = (float)(statistics->count + other->count);
+    float delta = other->mean - statistics->mean;
+    statistics->squaredDeviations += other->squaredDeviations + delta * delta * ((float)statistics->count * (float)other->count / count);
+    statistics->mean += delta * ((float)other->count / count);
+    statistics->count += other->count;
+    statistics->sum += other->sum;
+    statistics->sumOfSquares += other->sumOfSquares;
+    statistics->sumOfMagnitudes += other->sumOfMagnitudes;
+    statistics->maximumMagnitude = MAX(statistics->maximumMagnitude, other->maximumMagnitude);
+    
+    // ranges are combined in ascending order, so ties keep the first index as in a serial scan
+    if (other->minimum.value < statistics->minimum.value) {
+        statistics->minimum = other->minimum;
+    }
+    if (other->maximum.value > statistics->maximum.value) {
+        statistics->maximum = other->maximum;
+    }
+}
+
+/**
+ Reduce the values in a range of a vector into statistics, one cache-sized block at a time.
+ */
+static void MAVVectorStatisticsAddRangeD(MAVVectorStatisticsD *statistics, const double *values, NSRange range)
+{
+    double centered[MAV_VECTOR_STATISTICS_BLOCK_LENGTH];
+    for (size_t offset = range.location; offset < NSMaxRange(range); offset += MAV_VECTOR_STATISTICS_BLOCK_LENGTH) {
+        vDSP_Length count = MIN(MAV_VECTOR_STATISTICS_BLOCK_LENGTH, NSMaxRange(range) - offset);
+        const double *block = values + offset;
+        MAVVectorStatisticsD blockStatistics = { .count = count };
+        vDSP_Length index;
+        
+        vDSP_sveD(block, 1, &blockStatistics.sum, count);
+        blockStatistics.mean = blockStatistics.sum / count;
+        double negativeMean = -blockStatistics.mean;
+        vDSP_vsaddD(block, 1, &negativeMean, centered, 1, count);
+        vDSP_svesqD(centered, 1, &blockStatistics.squaredDeviations, count);
+        vDSP_svesqD(block, 1, &blockStatistics.sumOfSquares, count);
+        vDSP_svemgD(block, 1, &blockStatistics.sumOfMagnitudes, count);
+        vDSP_maxmgvD(block, 1, &blockStatistics.maximumMagnitude, count);
+        vDSP_minviD(block, 1, &blockStatistics.minimum.value, &index, count);
+        blockStatistics.minimum.index = (MAVIndex)(offset + index);
+        vDSP_maxviD(block, 1, &blockStatistics.maximum.value, &index, count);
+        blockStatistics.maximum.index = (MAVIndex)(offset + index);
+        
+        MAVVectorStatisticsCombineD(statistics, &blockStatistics);
+    }
+}
+
+static void MAVVectorStatisticsAddRange(MAVVectorStatistics *statistics, const float *values, NSRange range)
+{
+    float centered[MAV_VECTOR_STATISTICS_BLOCK_LENGTH];
+    for (size_t offset = range.location; offset < NSMaxRange(range); offset += MAV_VECTOR_STATISTICS_BLOCK_LENGTH) {
+        vDSP_Length count = MIN(MAV_VECTOR_STATISTICS_BLOCK_LENGTH, NSMaxRange(range) - offset);
+        const float *block = values + offset;
+        MAVVectorStatistics blockStatistics = { .count = count };
+        vDSP_Length index;
+        
+        vDSP_sve(block, 1, &blockStatistics.sum, count);
+        blockStatistics.mean = blockStatistics.sum / count;
+        float negativeMean = -blockStatistics.mean;
+        vDSP_vsadd(block, 1, &negativeMean, centered, 1, count);
+        vDSP_svesq(centered, 1, &blockStatistics.squaredDeviations, count);
+        vDSP_svesq(block, 1, &blockStatistics.sumOfSquares, count);
+        vDSP_svemg(block, 1, &blockStatistics.sumOfMagnitudes, count);
+        vDSP_maxmgv(block, 1, &blockStatistics.maximumMagnitude, count);
+        vDSP_minvi(block, 1, &blockStatistics.minimum.value, &index, count);
+        blockStatistics.minimum.index = (MAVIndex)(offset + index);
+        vDSP_maxvi(block, 1, &blockStatistics.maximum.value, &index, count);
+        blockStatistics.maximum.index = (MAVIndex)(offset + index);
+        
+        MAVVectorStatisticsCombine(statistics, &blockStatistics);
+    }
+}
+
 @implementation MAVVector
+{
+    // holds the values, possibly shared with copies of this vector
+    MAVValueBuffer *_valueBuffer;
+    
+    uint64_t _contentHash;
+    BOOL _hasContentHash;
+}
 
 - (instancetype)init
 {
@@ -45,11 +222,11 @@
 
 #pragma mark - Private
 
-- (instancetype)initWithValues:(NSData *)values length:(int)length
+- (instancetype)initWithValues:(NSData *)values length:(MAVIndex)length
 {
     self = [self init];
     if (self) {
-        _values = [[self class] isSubclassOfClass:[MAVMutableVector class]] ? [values mutableCopy] : values;
+        _valueBuffer = [[self class] isSubclassOfClass:[MAVMutableVector class]] ? [MAVValueBuffer bufferWithMutableData:[values mutableCopy]] : [MAVValueBuffer bufferWithData:values];
         _length = length;
         _precision = [values containsDoublePrecisionValues:length] ? MCKPrecisionDouble : MCKPrecisionSingle;
     }
@@ -60,7 +237,7 @@
 {
     self = [self init];
     if (self) {
-        _length = (int)values.count;
+        _length = (MAVIndex)values.count;
         
         for (NSNumber *n in values) {
             if (n.isDoublePrecision) {
@@ -75,9 +252,10 @@
             [values enumerateObjectsUsingBlock:^(NSNumber *value, NSUInteger idx, BOOL *stop) {
                 valuesArray[idx] = value.doubleValue;
             }];
-            _values = [NSData dataWithBytesNoCopy:valuesArray length:size];
             if ([[self class] isSubclassOfClass:[MAVMutableVector class]]) {
-                _values = [_values mutableCopy];
+                _valueBuffer = [MAVValueBuffer bufferWithMutableData:[NSMutableData dataWithBytesNoCopy:valuesArray length:size]];
+            } else {
+                _valueBuffer = [MAVValueBuffer bufferWithData:[NSData dataWithBytesNoCopy:valuesArray length:size]];
             }
         } else {
             NSUInteger size = values.count * sizeof(float);
@@ -85,15 +263,32 @@
             [values enumerateObjectsUsingBlock:^(NSNumber *value, NSUInteger idx, BOOL *stop) {
                 valuesArray[idx] = value.floatValue;
             }];
-            _values = [NSData dataWithBytesNoCopy:valuesArray length:size];
             if ([[self class] isSubclassOfClass:[MAVMutableVector class]]) {
-                _values = [_values mutableCopy];
+                _valueBuffer = [MAVValueBuffer bufferWithMutableData:[NSMutableData dataWithBytesNoCopy:valuesArray length:size]];
+            } else {
+                _valueBuffer = [MAVValueBuffer bufferWithData:[NSData dataWithBytesNoCopy:valuesArray length:size]];
             }
         }
     }
     return self;
 }
 
+- (void)dealloc
+{
+    [_valueBuffer relinquish];
+}
+
+- (NSData *)values
+{
+    return _valueBuffer.data;
+}
+
+- (NSMutableData *)mutableValues
+{
+    _valueBuffer = [_valueBuffer writableBuffer];
+    return (NSMutableData *)_valueBuffer.data;
+}
+
 - (void)resetToDefaultState
 {
     _sumOfValues = nil;
@@ -102,6 +297,8 @@
     _l2Norm = nil;
     _l3Norm = nil;
     _infinityNorm = nil;
+    _mean = nil;
+    _variance = nil;
     _minimumValue = nil;
     _maximumValue = nil;
     _minimumValueIndex = -1;
@@ -109,11 +306,12 @@
     _absoluteVector = nil;
     _isIdentity = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
     _isZero = [MCKTribool triboolWithValue:MCKTriboolValueUnknown];
+    _hasContentHash = NO;
 }
 
 #pragma mark - Constructors
 
-- (instancetype)initWithValues:(NSData *)values length:(int)length vectorFormat:(MAVVectorFormat)vectorFormat
+- (instancetype)initWithValues:(NSData *)values length:(MAVIndex)length vectorFormat:(MAVVectorFormat)vectorFormat
 {
     self = [self initWithValues:values length:length];
     if (self) {
@@ -122,14 +320,14 @@
     return self;
 }
 
-+ (instancetype)vectorWithValues:(NSData *)values length:(int)length
++ (instancetype)vectorWithValues:(NSData *)values length:(MAVIndex)length
 {
     return [[self alloc] initWithValues:values
                                  length:length
                            vectorFormat:MAVVectorFormatColumnVector];
 }
 
-+ (instancetype)vectorWithValues:(NSData *)values length:(int)length vectorFormat:(MAVVectorFormat)vectorFormat
++ (instancetype)vectorWithValues:(NSData *)values length:(MAVIndex)length vectorFormat:(MAVVectorFormat)vectorFormat
 {
     return [[self alloc] initWithValues:values
                                  length:length
@@ -157,37 +355,34 @@
                                   vectorFormat:vectorFormat];
 }
 
-+ (instancetype)randomVectorOfLength:(int)length
++ (instancetype)randomVectorOfLength:(MAVIndex)length
                         vectorFormat:(MAVVectorFormat)vectorFormat
                            precision:(MCKPrecision)precision
 {
-    if (precision == MCKPrecisionDouble) {
-        NSUInteger size = length * sizeof(double);
-        double *values = malloc(size);
-        for (int i = 0; i < length; i++) {
-            values[i] = [NSNumber mck_randomDouble].doubleValue;
-        }
-        return [[self class] vectorWithValues:[NSData dataWithBytesNoCopy:values length:size]
-                                       length:length
-                                 vectorFormat:vectorFormat];
-    } else {
-        NSUInteger size = length * sizeof(float);
-        float *values = malloc(size);
-        for (int i = 0; i < length; i++) {
-            values[i] = [NSNumber mck_randomFloat].floatValue;
-        }
-        return [[self class] vectorWithValues:[NSData dataWithBytesNoCopy:values length:size]
-                                       length:length
-                                 vectorFormat:vectorFormat];
-    }
+    return [self randomVectorOfLength:length
+                         vectorFormat:vectorFormat
+                         distribution:MAVRandomDistributionUniform
+                            generator:[MAVRandomGenerator defaultGenerator]
+                            precision:precision];
+}
+
++ (instancetype)randomVectorOfLength:(MAVIndex)length
+                        vectorFormat:(MAVVectorFormat)vectorFormat
+                        distribution:(MAVRandomDistribution)distribution
+                           generator:(MAVRandomGenerator *)generator
+                           precision:(MCKPrecision)precision
+{
+    return [[self class] vectorWithValues:[generator valuesWithDistribution:distribution count:length precision:precision]
+                                   length:length
+                             vectorFormat:vectorFormat];
 }
 
 + (instancetype)vectorFilledWithValue:(NSNumber *)value
-                               length:(int)length
+                               length:(MAVIndex)length
                          vectorFormat:(MAVVectorFormat)vectorFormat
 {
     NSMutableArray *values = [NSMutableArray array];
-    for (int i = 0; i < length; i++) {
+    for (MAVIndex i = 0; i < length; i++) {
         [values addObject:value];
     }
     MAVVector *vector = [self vectorWithValuesInArray:values
@@ -208,14 +403,8 @@
 - (MCKTribool *)isZero
 {
     if (_isZero.triboolValue == MCKTriboolValueUnknown) {
-        MCKTriboolValue isZero = MCKTriboolValueYes;
-        for (MAVIndex valueIndex = 0; valueIndex < self.length; valueIndex++) {
-            if (![[self valueAtIndex:valueIndex] isEqualToNumber:@0]) {
-                isZero = MCKTriboolValueNo;
-                break;
-            }
-        }
-        _isZero = [MCKTribool triboolWithValue:isZero];
+        // all values are zero exactly when the largest magnitude is
+        _isZero = [MCKTribool triboolWithValue:self.infinityNorm.doubleValue == 0.0 ? MCKTriboolValueYes : MCKTriboolValueNo];
     }
     return _isZero;
 }
@@ -223,32 +412,53 @@
 - (MCKTribool *)isIdentity
 {
     if (_isIdentity.triboolValue == MCKTriboolValueUnknown) {
-        MCKTriboolValue isIdentity = MCKTriboolValueYes;
-        for (MAVIndex valueIndex = 0; valueIndex < self.length; valueIndex++) {
-            if (![[self valueAtIndex:valueIndex] isEqualToNumber:@1]) {
-                isIdentity = MCKTriboolValueNo;
-                break;
-            }
-        }
-        _isIdentity = [MCKTribool triboolWithValue:isIdentity];
+        // all values are one exactly when the smallest and largest are
+        BOOL isIdentity = self.length == 0 || (self.minimumValue.doubleValue == 1.0 && self.maximumValue.doubleValue == 1.0);
+        _isIdentity = [MCKTribool triboolWithValue:isIdentity ? MCKTriboolValueYes : MCKTriboolValueNo];
     }
     return _isIdentity;
 }
 
+- (uint64_t)contentHash
+{
+    if (!_hasContentHash) {
+        MAVContentHashState state;
+        MAVContentHashInit(&state, (uint64_t)self.length);
+        if (self.precision == MCKPrecisionDouble) {
+            MAVContentHashUpdateD(&state, self.values.bytes, (size_t)self.length);
+        } else {
+            MAVContentHashUpdate(&state, self.values.bytes, (size_t)self.length);
+        }
+        _contentHash = MAVContentHashFinish(&state);
+        _hasContentHash = YES;
+    }
+    return _contentHash;
+}
+
 - (NSNumber *)sumOfValues
 {
     if (_sumOfValues == nil) {
         if (self.precision == MCKPrecisionDouble) {
+            const double *values = self.values.bytes;
             double sum = 0.0;
-            for (int i = 0; i < self.length; i += 1) {
-                sum += ((double *)self.values.bytes)[i];
-            }
+            MAVParallelReduceRanges(self.length, 1, sizeof(double), &sum, ^(NSRange range, void *partial) {
+                double rangeSum;
+                vDSP_sveD(values + range.location, 1, &rangeSum, range.length);
+                *(double *)partial += rangeSum;
+            }, ^(void *result, const void *partial) {
+                *(double *)result += *(const double *)partial;
+            });
             _sumOfValues = @(sum);
         } else {
+            const float *values = self.values.bytes;
             float sum = 0.f;
-            for (int i = 0; i < self.length; i += 1) {
-                sum += ((float *)self.values.bytes)[i];
-            }
+            MAVParallelReduceRanges(self.length, 1, sizeof(float), &sum, ^(NSRange range, void *partial) {
+                float rangeSum;
+                vDSP_sve(values + range.location, 1, &rangeSum, range.length);
+                *(float *)partial += rangeSum;
+            }, ^(void *result, const void *partial) {
+                *(float *)result += *(const float *)partial;
+            });
             _sumOfValues = @(sum);
         }
     }
@@ -290,15 +500,34 @@
 - (NSNumber *)l3Norm
 {
     if (_l3Norm == nil) {
-        MAVMutableVector *mutableCopy = [self mutableCopy];
-        MAVVector *cubedVector = [mutableCopy raiseToPower:3];
+        // accumulate the cubed magnitudes directly rather than cubing a copy of the vector
         if (self.precision == MCKPrecisionDouble) {
-            double cubedSum;
-            vDSP_svemgD(cubedVector.values.bytes, 1, &cubedSum, self.length);
+            const double *values = self.values.bytes;
+            double cubedSum = 0.0;
+            MAVParallelReduceRanges(self.length, 1, sizeof(double), &cubedSum, ^(NSRange range, void *partial) {
+                double partialSum = *(double *)partial;
+                for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                    double magnitude = fabs(values[i]);
+                    partialSum += magnitude * magnitude * magnitude;
+                }
+                *(double *)partial = partialSum;
+            }, ^(void *result, const void *partial) {
+                *(double *)result += *(const double *)partial;
+            });
             _l3Norm = @(cbrt(cubedSum));
         } else {
-            float cubedSum;
-            vDSP_svemg(cubedVector.values.bytes, 1, &cubedSum, self.length);
+            const float *values = self.values.bytes;
+            float cubedSum = 0.f;
+            MAVParallelReduceRanges(self.length, 1, sizeof(float), &cubedSum, ^(NSRange range, void *partial) {
+                float partialSum = *(float *)partial;
+                for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                    float magnitude = fabsf(values[i]);
+                    partialSum += magnitude * magnitude * magnitude;
+                }
+                *(float *)partial = partialSum;
+            }, ^(void *result, const void *partial) {
+                *(float *)result += *(const float *)partial;
+            });
             _l3Norm = @(cbrtf(cubedSum));
         }
     }
@@ -308,25 +537,63 @@
 - (NSNumber *)infinityNorm
 {
     if (_infinityNorm == nil) {
-        _infinityNorm = self.absoluteVector.maximumValue;
+        if (self.precision == MCKPrecisionDouble) {
+            double norm = 0.0;
+            vDSP_maxmgvD(self.values.bytes, 1, &norm, self.length);
+            _infinityNorm = @(norm);
+        } else {
+            float norm = 0.f;
+            vDSP_maxmgv(self.values.bytes, 1, &norm, self.length);
+            _infinityNorm = @(norm);
+        }
     }
     return _infinityNorm;
 }
 
+- (NSNumber *)mean
+{
+    if (_mean == nil) {
+        [self computeSummaryStatistics];
+    }
+    return _mean;
+}
+
+- (NSNumber *)variance
+{
+    if (_variance == nil) {
+        [self computeSummaryStatistics];
+    }
+    return _variance;
+}
+
 - (NSNumber *)productOfValues
 {
     if (_productOfValues == nil) {
         if (self.precision == MCKPrecisionDouble) {
+            const double *values = self.values.bytes;
             double product = 1.0;
-            for (int i = 0; i < self.length; i += 1) {
-                product *= ((double *)self.values.bytes)[i];
-            }
+            MAVParallelReduceRanges(self.length, 1, sizeof(double), &product, ^(NSRange range, void *partial) {
+                double partialProduct = *(double *)partial;
+                for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                    partialProduct *= values[i];
+                }
+                *(double *)partial = partialProduct;
+            }, ^(void *result, const void *partial) {
+                *(double *)result *= *(const double *)partial;
+            });
             _productOfValues = @(product);
         } else {
+            const float *values = self.values.bytes;
             float product = 1.f;
-            for (int i = 0; i < self.length; i += 1) {
-                product *= ((float *)self.values.bytes)[i];
-            }
+            MAVParallelReduceRanges(self.length, 1, sizeof(float), &product, ^(NSRange range, void *partial) {
+                float partialProduct = *(float *)partial;
+                for (size_t i = range.location; i < NSMaxRange(range); i++) {
+                    partialProduct *= values[i];
+                }
+                *(float *)partial = partialProduct;
+            }, ^(void *result, const void *partial) {
+                *(float *)result *= *(const float *)partial;
+            });
             _productOfValues = @(product);
         }
     }
@@ -337,25 +604,43 @@
 {
     if (_maximumValue == nil) {
         if (self.precision == MCKPrecisionDouble) {
-            double max = DBL_MIN;
-            for (int i = 0; i < self.length; i++) {
-                double value = ((double *)self.values.bytes)[i];
-                if (value > max) {
-                    max = value;
-                    _maximumValueIndex = i;
+            const double *values = self.values.bytes;
+            MAVIndexedDouble max = { -INFINITY, _maximumValueIndex };
+            MAVParallelReduceRanges(self.length, 1, sizeof(MAVIndexedDouble), &max, ^(NSRange range, void *partial) {
+                MAVIndexedDouble rangeMax;
+                vDSP_Length index;
+                vDSP_maxviD(values + range.location, 1, &rangeMax.value, &index, range.length);
+                rangeMax.index = (MAVIndex)(range.location + index);
+                if (rangeMax.value > ((MAVIndexedDouble *)partial)->value) {
+                    *(MAVIndexedDouble *)partial = rangeMax;
                 }
-            }
-            _maximumValue = @(max);
+            }, ^(void *result, const void *partial) {
+                // ranges are combined in ascending order, so ties keep the first index as in a serial scan
+                if (((const MAVIndexedDouble *)partial)->value > ((MAVIndexedDouble *)result)->value) {
+                    *(MAVIndexedDouble *)result = *(const MAVIndexedDouble *)partial;
+                }
+            });
+            _maximumValue = @(max.value);
+            _maximumValueIndex = max.index;
         } else {
-            float max = FLT_MIN;
-            for (int i = 0; i < self.length; i++) {
-                float value = ((float *)self.values.bytes)[i];
-                if (value > max) {
-                    max = value;
-                    _maximumValueIndex = i;
+            const float *values = self.values.bytes;
+            MAVIndexedFloat max = { -INFINITY, _maximumValueIndex };
+            MAVParallelReduceRanges(self.length, 1, sizeof(MAVIndexedFloat), &max, ^(NSRange range, void *partial) {
+                MAVIndexedFloat rangeMax;
+                vDSP_Length index;
+                vDSP_maxvi(values + range.location, 1, &rangeMax.value, &index, range.length);
+                rangeMax.index = (MAVIndex)(range.location + index);
+                if (rangeMax.value > ((MAVIndexedFloat *)partial)->value) {
+                    *(MAVIndexedFloat *)partial = rangeMax;
                 }
-            }
-            _maximumValue = @(max);
+            }, ^(void *result, const void *partial) {
+                // ranges are combined in ascending order, so ties keep the first index as in a serial scan
+                if (((const MAVIndexedFloat *)partial)->value > ((MAVIndexedFloat *)result)->value) {
+                    *(MAVIndexedFloat *)result = *(const MAVIndexedFloat *)partial;
+                }
+            });
+            _maximumValue = @(max.value);
+            _maximumValueIndex = max.index;
         }
     }
     return _maximumValue;
@@ -365,25 +650,43 @@
 {
     if (_minimumValue == nil) {
         if (self.precision == MCKPrecisionDouble) {
-            double min = DBL_MAX;
-            for (int i = 0; i < self.length; i++) {
-                double value = ((double *)self.values.bytes)[i];
-                if (value < min) {
-                    min = value;
-                    _minimumValueIndex = i;
+            const double *values = self.values.bytes;
+            MAVIndexedDouble min = { INFINITY, _minimumValueIndex };
+            MAVParallelReduceRanges(self.length, 1, sizeof(MAVIndexedDouble), &min, ^(NSRange range, void *partial) {
+                MAVIndexedDouble rangeMin;
+                vDSP_Length index;
+                vDSP_minviD(values + range.location, 1, &rangeMin.value, &index, range.length);
+                rangeMin.index = (MAVIndex)(range.location + index);
+                if (rangeMin.value < ((MAVIndexedDouble *)partial)->value) {
+                    *(MAVIndexedDouble *)partial = rangeMin;
                 }
-            }
-            _minimumValue = @(min);
+            }, ^(void *result, const void *partial) {
+                // ranges are combined in ascending order, so ties keep the first index as in a serial scan
+                if (((const MAVIndexedDouble *)partial)->value < ((MAVIndexedDouble *)result)->value) {
+                    *(MAVIndexedDouble *)result = *(const MAVIndexedDouble *)partial;
+                }
+            });
+            _minimumValue = @(min.value);
+            _minimumValueIndex = min.index;
         } else {
-            float min = FLT_MAX;
-            for (int i = 0; i < self.length; i++) {
-                float value = ((float *)self.values.bytes)[i];
-                if (value < min) {
-                    min = value;
-                    _minimumValueIndex = i;
+            const float *values = self.values.bytes;
+            MAVIndexedFloat min = { INFINITY, _minimumValueIndex };
+            MAVParallelReduceRanges(self.length, 1, sizeof(MAVIndexedFloat), &min, ^(NSRange range, void *partial) {
+                MAVIndexedFloat rangeMin;
+                vDSP_Length index;
+                vDSP_minvi(values + range.location, 1, &rangeMin.value, &index, range.length);
+                rangeMin.index = (MAVIndex)(range.location + index);
+                if (rangeMin.value < ((MAVIndexedFloat *)partial)->value) {
+                    *(MAVIndexedFloat *)partial = rangeMin;
                 }
-            }
-            _minimumValue = @(min);
+            }, ^(void *result, const void *partial) {
+                // ranges are combined in ascending order, so ties keep the first index as in a serial scan
+                if (((const MAVIndexedFloat *)partial)->value < ((MAVIndexedFloat *)result)->value) {
+                    *(MAVIndexedFloat *)result = *(const MAVIndexedFloat *)partial;
+                }
+            });
+            _minimumValue = @(min.value);
+            _minimumValueIndex = min.index;
         }
     }
     return _minimumValue;
@@ -409,11 +712,12 @@
         }
     }
     
-    if (self.isIdentity) {
+    // pass on what is already known without computing it
+    if (_isIdentity.isYes) {
         _absoluteVector.isIdentity = [MCKTribool triboolWithValue:MCKTriboolValueYes];
         _absoluteVector.isZero = [MCKTribool triboolWithValue:MCKTriboolValueNo];
     }
-    else if (self.isZero) {
+    else if (_isZero.isYes) {
         _absoluteVector.isIdentity = [MCKTribool triboolWithValue:MCKTriboolValueNo];
         _absoluteVector.isZero = [MCKTribool triboolWithValue:MCKTriboolValueYes];
     }
@@ -427,10 +731,12 @@
 {
     if (self == otherVector.self) {
         return YES;
-    } else if (self.length == otherVector.length) {
-        return [self.values isEqualToData:otherVector.values];
-    } else {
+    } else if (self.length != otherVector.length || self.values.length != otherVector.values.length) {
+        return NO;
+    } else if (_hasContentHash && otherVector->_hasContentHash && _contentHash != otherVector->_contentHash) {
         return NO;
+    } else {
+        return self.values.bytes == otherVector.values.bytes || memcmp(self.values.bytes, otherVector.values.bytes, self.values.length) == 0;
     }
 }
 
@@ -447,31 +753,21 @@
 
 - (NSUInteger)hash
 {
-    return self.values.hash;
+    return (NSUInteger)self.contentHash;
 }
 
 - (NSString *)description
 {
     int padding = 0;
     if (self.vectorFormat == MAVVectorFormatColumnVector) {
-        if (self.precision == MCKPrecisionDouble) {
-            double max = DBL_MIN;
-            for (int i = 0; i < self.length; i++) {
-                max = MAX(max, fabs(((double *)self.values.bytes)[i]));
-            }
-            padding = (MAVIndex)floor(log10(max)) + 5;
-        } else {
-            float max = FLT_MIN;
-            for (int i = 0; i < self.length; i++) {
-                max = MAX(max, fabsf(((float *)self.values.bytes)[i]));
-            }
-            padding = (MAVIndex)floorf(log10f(max)) + 5;
-        }
+        // the widest value has the largest magnitude; the floor keeps log10 finite for zero vectors
+        double max = MAX(self.infinityNorm.doubleValue, DBL_MIN);
+        padding = (int)floor(log10(max)) + 5;
     }
     
     NSMutableString *description = [@"\n" mutableCopy];
     
-    for (int j = 0; j < self.length; j++) {
+    for (MAVIndex j = 0; j < self.length; j++) {
         NSString *valueString;
         if (self.precision == MCKPrecisionDouble) {
             valueString = [NSString stringWithFormat:@"%.1f", ((double *)self.values.bytes)[j]];
@@ -505,44 +801,30 @@
 {
     MAVVector *vectorCopy = [[self class] allocWithZone:zone];
     
-    [self deepCopyVector:self intoNewVector:vectorCopy mutable:NO];
+    [self copyVector:self intoNewVector:vectorCopy];
     
     return vectorCopy;
 }
 
-- (void)deepCopyVector:(MAVVector *)vector intoNewVector:(MAVVector *)newVector mutable:(BOOL)mutable
+- (void)copyVector:(MAVVector *)vector intoNewVector:(MAVVector *)newVector
 {
     newVector->_length = vector->_length;
     newVector->_vectorFormat = vector->_vectorFormat;
     newVector->_minimumValueIndex = vector->_minimumValueIndex;
     newVector->_maximumValueIndex = vector->_maximumValueIndex;
     newVector->_precision = vector->_precision;
+    newVector->_contentHash = vector->_contentHash;
+    newVector->_hasContentHash = vector->_hasContentHash;
+    
+    // share the values; whichever vector mutates them first copies them
+    newVector->_valueBuffer = [vector->_valueBuffer sharedBuffer];
     
-    if (vector->_precision == MCKPrecisionDouble) {
-        double *values = malloc(vector->_values.length);
-        for (int i = 0; i < vector->_values.length / sizeof(double); i++) {
-            values[i] = ((double *)vector->_values.bytes)[i];
-        }
-        if ( mutable ) {
-            newVector->_values = [NSMutableData dataWithBytesNoCopy:values length:vector->_values.length];
-        } else {
-            newVector->_values = [NSData dataWithBytesNoCopy:values length:vector->_values.length];
-        }
-    } else {
-        float *values = malloc(vector->_values.length);
-        for (int i = 0; i < vector->_values.length / sizeof(float); i++) {
-            values[i] = ((float *)vector->_values.bytes)[i];
-        }
-        if ( mutable ) {
-            newVector->_values = [NSMutableData dataWithBytesNoCopy:values length:vector->_values.length];
-        } else {
-            newVector->_values = [NSData dataWithBytesNoCopy:values length:vector->_values.length];
-        }
-    }
     newVector->_l1Norm = vector->_l1Norm.copy;
     newVector->_l2Norm = vector->_l2Norm.copy;
     newVector->_l3Norm = vector->_l3Norm.copy;
     newVector->_infinityNorm = vector->_infinityNorm.copy;
+    newVector->_mean = vector->_mean.copy;
+    newVector->_variance = vector->_variance.copy;
     newVector->_minimumValue = vector->_minimumValue.copy;
     newVector->_maximumValue = vector->_maximumValue.copy;
     newVector->_absoluteVector = vector->_absoluteVector.copy;
@@ -554,11 +836,50 @@
 {
     MAVMutableVector *newVector = [MAVMutableVector allocWithZone:zone];
     
-    [self deepCopyVector:self intoNewVector:newVector mutable:YES];
+    [self copyVector:self intoNewVector:newVector];
     
     return newVector;
 }
 
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:self.values forKey:@"values"];
+    [aCoder encodeInt64:self.length forKey:@"length"];
+    [aCoder encodeInt32:self.vectorFormat forKey:@"vectorFormat"];
+    [aCoder encodeInt32:self.precision forKey:@"precision"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    NSData *values = [aDecoder decodeObjectOfClass:[NSData class] forKey:@"values"];
+    int64_t length = [aDecoder decodeInt64ForKey:@"length"];
+    int32_t vectorFormat = [aDecoder decodeInt32ForKey:@"vectorFormat"];
+    int32_t precision = [aDecoder decodeInt32ForKey:@"precision"];
+    
+    // archives may come from anywhere, so refuse any whose length disagrees with its values
+    size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    if (values == nil || length < 0
+        || (vectorFormat != MAVVectorFormatRowVector && vectorFormat != MAVVectorFormatColumnVector)
+        || (precision != MCKPrecisionSingle && precision != MCKPrecisionDouble)
+        || values.length % valueSize != 0 || values.length / valueSize != (uint64_t)length) {
+        return nil;
+    }
+    
+    self = [self initWithValues:values length:(MAVIndex)length];
+    if (self) {
+        _vectorFormat = (MAVVectorFormat)vectorFormat;
+        _precision = (MCKPrecision)precision;
+    }
+    return self;
+}
+
 #pragma mark - Inspection
 
 - (NSNumber *)valueAtIndex:(MAVIndex)index
@@ -574,6 +895,66 @@
     return value;
 }
 
+- (void)computeSummaryStatistics
+{
+    // the results shared by both precisions, for deriving isZero and isIdentity
+    size_t count;
+    double minimum, maximum, maximumMagnitude;
+    MAVIndex minimumIndex, maximumIndex;
+    if (self.precision == MCKPrecisionDouble) {
+        const double *values = self.values.bytes;
+        MAVVectorStatisticsD statistics = { .minimum = { INFINITY, -1 }, .maximum = { -INFINITY, -1 } };
+        MAVParallelReduceRanges(self.length, 1, sizeof(MAVVectorStatisticsD), &statistics, ^(NSRange range, void *partial) {
+            MAVVectorStatisticsAddRangeD(partial, values, range);
+        }, ^(void *result, const void *partial) {
+            MAVVectorStatisticsCombineD(result, partial);
+        });
+        count = statistics.count;
+        minimum = statistics.minimum.value;
+        minimumIndex = statistics.minimum.index;
+        maximum = statistics.maximum.value;
+        maximumIndex = statistics.maximum.index;
+        maximumMagnitude = statistics.maximumMagnitude;
+        
+        _sumOfValues = @(statistics.sum);
+        _minimumValue = @(statistics.minimum.value);
+        _maximumValue = @(statistics.maximum.value);
+        _l1Norm = @(statistics.sumOfMagnitudes);
+        _l2Norm = @(sqrt(statistics.sumOfSquares));
+        _infinityNorm = @(statistics.maximumMagnitude);
+        _mean = @(statistics.mean);
+        _variance = @(count > 1 ? statistics.squaredDeviations / (double)(count - 1) : 0.0);
+    } else {
+        const float *values = self.values.bytes;
+        MAVVectorStatistics statistics = { .minimum = { INFINITY, -1 }, .maximum = { -INFINITY, -1 } };
+        MAVParallelReduceRanges(self.length, 1, sizeof(MAVVectorStatistics), &statistics, ^(NSRange range, void *partial) {
+            MAVVectorStatisticsAddRange(partial, values, range);
+        }, ^(void *result, const void *partial) {
+            MAVVectorStatisticsCombine(result, partial);
+        });
+        count = statistics.count;
+        minimum = statistics.minimum.value;
+        minimumIndex = statistics.minimum.index;
+        maximum = statistics.maximum.value;
+        maximumIndex = statistics.maximum.index;
+        maximumMagnitude = statistics.maximumMagnitude;
+        
+        _sumOfValues = @(statistics.sum);
+        _minimumValue = @(statistics.minimum.value);
+        _maximumValue = @(statistics.maximum.value);
+        _l1Norm = @(statistics.sumOfMagnitudes);
+        _l2Norm = @(sqrtf(statistics.sumOfSquares));
+        _infinityNorm = @(statistics.maximumMagnitude);
+        _mean = @(statistics.mean);
+        _variance = @(count > 1 ? statistics.squaredDeviations / (float)(count - 1) : 0.f);
+    }
+    
+    _minimumValueIndex = minimumIndex;
+    _maximumValueIndex = maximumIndex;
+    _isZero = [MCKTribool triboolWithValue:maximumMagnitude == 0.0 ? MCKTriboolValueYes : MCKTriboolValueNo];
+    _isIdentity = [MCKTribool triboolWithValue:count == 0 || (minimum == 1.0 && maximum == 1.0) ? MCKTriboolValueYes : MCKTriboolValueNo];
+}
+
 #pragma mark - Subscripting
 
 - (NSNumber *)objectAtIndexedSubscript:(MAVIndex)idx
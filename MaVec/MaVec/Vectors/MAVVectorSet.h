@@ -0,0 +1,133 @@
+//
+//  MAVVectorSet.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+
+#import <MCKNumerics/MCKNumerics.h>
+
+#import "MAVTypedefs.h"
+
+@class MAVMatrix;
+@class MAVVector;
+
+/**
+ The number of vectors in each block of queries and of the set searched when comparing vector sets, so searches hold at most MAV_VECTOR_SET_BLOCK_SIZE * MAV_VECTOR_SET_BLOCK_SIZE scores in memory for each block of queries being processed, however large the set.
+ */
+#define MAV_VECTOR_SET_BLOCK_SIZE 1024
+
+/**
+ @class MAVVectorSet
+ @description An immutable set of vectors of the same dimension, stored as the rows of one contiguous row-major matrix. Comparisons between sets are computed a block of vectors at a time with one matrix multiplication per pair of blocks (see http://www.netlib.org/lapack/explore-html/d7/d2b/dgemm_8f.html) instead of one dot product per pair of vectors. Cosine similarities and Euclidean distances are derived from the dot products and the norms of the vectors, which are computed once when the set is created, using ‖q - x‖² = ‖q‖² + ‖x‖² - 2 q·x.
+ */
+@interface MAVVectorSet : NSObject
+
+/**
+ @property count
+ @brief The number of vectors in the set.
+ */
+@property (nonatomic, readonly, assign) MAVIndex count;
+
+/**
+ @property dimension
+ @brief The number of values in each vector.
+ */
+@property (nonatomic, readonly, assign) MAVIndex dimension;
+
+/**
+ @property precision
+ @brief Whether the values of the vectors are single- or double-precision.
+ */
+@property (nonatomic, readonly, assign) MCKPrecision precision;
+
+/**
+ @property matrix
+ @brief A row-major matrix with one row for each vector in the set.
+ */
+@property (nonatomic, readonly, strong) MAVMatrix *matrix;
+
+/**
+ @property squaredNorms
+ @brief A one-dimensional C array holding the squared Euclidean norm of each vector in the set, in the set's precision.
+ */
+@property (nonatomic, readonly, strong) NSData *squaredNorms;
+
+#pragma mark - Constructors
+
+/**
+ @brief Construct a new MAVVectorSet object.
+ @param matrix A matrix whose rows are the vectors of the set. Its values are copied in row-major conventional storage.
+ @return A new MAVVectorSet object.
+ */
+- (instancetype)initWithMatrix:(MAVMatrix *)matrix;
+
+/**
+ @brief Class convenience method to construct a new MAVVectorSet object.
+ @param matrix A matrix whose rows are the vectors of the set.
+ @return A new MAVVectorSet object.
+ */
++ (instancetype)vectorSetWithMatrix:(MAVMatrix *)matrix;
+
+/**
+ @brief Construct a new MAVVectorSet object by gathering the values of an array of vectors.
+ @param vectors A non-empty array of MAVVector objects of the same length and precision.
+ @return A new MAVVectorSet object.
+ */
++ (instancetype)vectorSetWithVectors:(NSArray *)vectors;
+
+#pragma mark - Inspection
+
+/**
+ @brief Gather the values of one vector from the set.
+ @param index The index of the vector in the set.
+ @return A new MAVVector object.
+ */
+- (MAVVector *)vectorAtIndex:(MAVIndex)index;
+
+#pragma mark - Comparisons
+
+/**
+ @brief Compare every vector in another set with every vector in this set.
+ @param vectorSet The set of query vectors, of the same dimension and precision as this set.
+ @param metric The comparison to compute. Cosine similarities involving a vector of zeros are 0.
+ @return A new row-major matrix with a row for each vector in vectorSet and a column for each vector in this set.
+ */
+- (MAVMatrix *)similaritiesWithVectorSet:(MAVVectorSet *)vectorSet
+                                  metric:(MAVVectorSimilarityMetric)metric;
+
+/**
+ @brief Find the vectors in this set most similar to each vector in another set. The set is compared with a block of queries MAV_VECTOR_SET_BLOCK_SIZE vectors at a time, keeping the best candidates for each query in a heap of at most count entries, so memory does not grow with the size of this set. Blocks of queries are searched concurrently. Ties are broken in favor of the vector with the lower index.
+ @param vectorSet The set of query vectors, of the same dimension and precision as this set.
+ @param count The number of neighbors to find for each query. If this set holds fewer vectors, all of them are returned.
+ @param metric The comparison by which to rank the vectors.
+ @param indices If not NULL, set to a one-dimensional C array of MAVIndex values in the same layout as the returned matrix, holding the index in this set of each neighbor.
+ @return A new row-major matrix with a row for each vector in vectorSet, holding the similarities of its neighbors, best first.
+ */
+- (MAVMatrix *)nearestNeighborsOfVectorSet:(MAVVectorSet *)vectorSet
+                                     count:(MAVIndex)count
+                                    metric:(MAVVectorSimilarityMetric)metric
+                                   indices:(NSData **)indices;
+
+@end
@@ -0,0 +1,388 @@
+//
+//  MAVVectorSet.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <Accelerate/Accelerate.h>
+
+#import "MAVLAPACKInteger.h"
+#import "MAVMatrix+MAVMatrixFactory.h"
+#import "MAVMatrix.h"
+#import "MAVParallel.h"
+#import "MAVVector.h"
+#import "MAVVectorSet.h"
+
+/**
+ A candidate in a nearest neighbor search, scored so that larger scores are more similar whatever the metric.
+ */
+typedef struct {
+    double score;
+    MAVIndex index;
+} MAVNeighbor;
+
+/**
+ @return YES if neighbor a ranks below neighbor b, which is when it has a lower score, or the same score and a higher index.
+ */
+static BOOL MAVNeighborIsWorse(MAVNeighbor a, MAVNeighbor b)
+{
+    return a.score < b.score || (a.score == b.score && a.index > b.index);
+}
+
+static void MAVNeighborSwap(MAVNeighbor *heap, size_t a, size_t b)
+{
+    MAVNeighbor neighbor = heap[a];
+    heap[a] = heap[b];
+    heap[b] = neighbor;
+}
+
+/**
+ @brief Restore the order of a heap whose worst neighbor is at its root, after the neighbor at index i was replaced by a better one.
+ */
+static void MAVNeighborHeapSiftDown(MAVNeighbor *heap, size_t size, size_t i)
+{
+    while (YES) {
+        size_t worst = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < size && MAVNeighborIsWorse(heap[left], heap[worst])) {
+            worst = left;
+        }
+        if (right < size && MAVNeighborIsWorse(heap[right], heap[worst])) {
+            worst = right;
+        }
+        if (worst == i) {
+            return;
+        }
+        MAVNeighborSwap(heap, i, worst);
+        i = worst;
+    }
+}
+
+static void MAVNeighborHeapSiftUp(MAVNeighbor *heap, size_t i)
+{
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!MAVNeighborIsWorse(heap[i], heap[parent])) {
+            return;
+        }
+        MAVNeighborSwap(heap, i, parent);
+        i = parent;
+    }
+}
+
+/**
+ @brief Add a candidate to a heap holding at most capacity neighbors, replacing the worst neighbor if the heap is full and the candidate ranks above it.
+ */
+static void MAVNeighborHeapOffer(MAVNeighbor *heap, size_t *size, size_t capacity, MAVNeighbor candidate)
+{
+    if (*size < capacity) {
+        heap[*size] = candidate;
+        MAVNeighborHeapSiftUp(heap, *size);
+        *size += 1;
+    } else if (MAVNeighborIsWorse(heap[0], candidate)) {
+        heap[0] = candidate;
+        MAVNeighborHeapSiftDown(heap, capacity, 0);
+    }
+}
+
+/**
+ @brief Sort a heap in place, best neighbor first, by repeatedly moving its worst neighbor to the end.
+ */
+static void MAVNeighborHeapSort(MAVNeighbor *heap, size_t size)
+{
+    for (size_t end = size; end > 1; end--) {
+        MAVNeighborSwap(heap, 0, end - 1);
+        MAVNeighborHeapSiftDown(heap, end - 1, 0);
+    }
+}
+
+@implementation MAVVectorSet
+{
+    // the values of the vectors, one after another
+    NSData *_values;
+    
+    // the reciprocal of the Euclidean norm of each vector, or 0 for vectors of zeros
+    NSData *_inverseNorms;
+}
+
+#pragma mark - Constructors
+
+- (instancetype)initWithMatrix:(MAVMatrix *)matrix
+{
+    self = [super init];
+    if (self) {
+        _count = matrix.rows;
+        _dimension = matrix.columns;
+        _precision = matrix.precision;
+        _values = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
+        _matrix = [MAVMatrix matrixWithValues:_values rows:_count columns:_dimension leadingDimension:MAVMatrixLeadingDimensionRow];
+        
+        size_t valueSize = _precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+        NSMutableData *squaredNorms = [NSMutableData dataWithLength:(size_t)_count * valueSize];
+        NSMutableData *inverseNorms = [NSMutableData dataWithLength:(size_t)_count * valueSize];
+        MAVIndex dimension = _dimension;
+        if (_precision == MCKPrecisionDouble) {
+            const double *values = _values.bytes;
+            double *squares = squaredNorms.mutableBytes;
+            double *inverses = inverseNorms.mutableBytes;
+            MAVParallelForRanges((size_t)_count, (size_t)dimension, ^(NSRange range) {
+                for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+                    vDSP_svesqD(values + i * (size_t)dimension, 1, &squares[i], (vDSP_Length)dimension);
+                    inverses[i] = squares[i] > 0.0 ? 1.0 / sqrt(squares[i]) : 0.0;
+                }
+            });
+        } else {
+            const float *values = _values.bytes;
+            float *squares = squaredNorms.mutableBytes;
+            float *inverses = inverseNorms.mutableBytes;
+            MAVParallelForRanges((size_t)_count, (size_t)dimension, ^(NSRange range) {
+                for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+                    vDSP_svesq(values + i * (size_t)dimension, 1, &squares[i], (vDSP_Length)dimension);
+                    inverses[i] = squares[i] > 0.0f ? 1.0f / sqrtf(squares[i]) : 0.0f;
+                }
+            });
+        }
+        _squaredNorms = squaredNorms;
+        _inverseNorms = inverseNorms;
+    }
+    return self;
+}
+
++ (instancetype)vectorSetWithMatrix:(MAVMatrix *)matrix
+{
+    return [[self alloc] initWithMatrix:matrix];
+}
+
++ (instancetype)vectorSetWithVectors:(NSArray *)vectors
+{
+    NSAssert(vectors.count > 0, @"A vector set must contain at least one vector.");
+    
+    MAVVector *first = vectors.firstObject;
+    NSMutableData *values = [NSMutableData dataWithCapacity:first.values.length * vectors.count];
+    for (MAVVector *vector in vectors) {
+        NSAssert(vector.length == first.length, @"Vectors must all have the same length.");
+        NSAssert(vector.precision == first.precision, @"Vectors must all have the same precision.");
+        [values appendData:vector.values];
+    }
+    
+    MAVMatrix *matrix = [MAVMatrix matrixWithValues:values
+                                               rows:(MAVIndex)vectors.count
+                                            columns:first.length
+                                   leadingDimension:MAVMatrixLeadingDimensionRow];
+    return [[self alloc] initWithMatrix:matrix];
+}
+
+#pragma mark - Inspection
+
+- (MAVVector *)vectorAtIndex:(MAVIndex)index
+{
+    NSAssert1(index >= 0 && index < self.count, @"index = %lld is outside the range of vectors in the set.", (long long int)index);
+    
+    size_t rowLength = (size_t)self.dimension * (self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float));
+    return [MAVVector vectorWithValues:[_values subdataWithRange:NSMakeRange((size_t)index * rowLength, rowLength)] length:self.dimension];
+}
+
+#pragma mark - Comparisons
+
+- (MAVMatrix *)similaritiesWithVectorSet:(MAVVectorSet *)vectorSet
+                                  metric:(MAVVectorSimilarityMetric)metric
+{
+    NSAssert(vectorSet.dimension == self.dimension, @"Vectors must have the same dimension.");
+    NSAssert(vectorSet.precision == self.precision, @"Vector sets must have the same precision.");
+    
+    size_t valueSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *values = [NSMutableData dataWithLength:(size_t)vectorSet.count * (size_t)self.count * valueSize];
+    uint8_t *bytes = values.mutableBytes;
+    size_t blockSize = MAV_VECTOR_SET_BLOCK_SIZE;
+    size_t queryBlocks = ((size_t)vectorSet.count + blockSize - 1) / blockSize;
+    size_t vectorBlocks = ((size_t)self.count + blockSize - 1) / blockSize;
+    BOOL doublePrecision = self.precision == MCKPrecisionDouble;
+    
+    MAVParallelForRanges(queryBlocks, blockSize * (size_t)self.count * (size_t)self.dimension, ^(NSRange range) {
+        for (NSUInteger queryBlock = range.location; queryBlock < NSMaxRange(range); queryBlock++) {
+            NSRange queries = NSMakeRange(queryBlock * blockSize, MIN(blockSize, (size_t)vectorSet.count - queryBlock * blockSize));
+            for (size_t vectorBlock = 0; vectorBlock < vectorBlocks; vectorBlock++) {
+                NSRange vectors = NSMakeRange(vectorBlock * blockSize, MIN(blockSize, (size_t)self.count - vectorBlock * blockSize));
+                void *scores = bytes + (queries.location * (size_t)self.count + vectors.location) * valueSize;
+                [self computeScores:scores leadingDimension:self.count ofVectorSet:vectorSet queries:queries vectors:vectors metric:metric];
+                if (metric == MAVVectorSimilarityMetricEuclideanDistance) {
+                    int length = (int)vectors.length;
+                    for (size_t i = 0; i < queries.length; i++) {
+                        void *row = (uint8_t *)scores + i * (size_t)self.count * valueSize;
+                        if (doublePrecision) {
+                            vvsqrt(row, row, &length);
+                        } else {
+                            vvsqrtf(row, row, &length);
+                        }
+                    }
+                }
+            }
+        }
+    });
+    
+    return [MAVMatrix matrixWithValues:values rows:vectorSet.count columns:self.count leadingDimension:MAVMatrixLeadingDimensionRow];
+}
+
+- (MAVMatrix *)nearestNeighborsOfVectorSet:(MAVVectorSet *)vectorSet
+                                     count:(MAVIndex)count
+                                    metric:(MAVVectorSimilarityMetric)metric
+                                   indices:(NSData **)indices
+{
+    NSAssert(vectorSet.dimension == self.dimension, @"Vectors must have the same dimension.");
+    NSAssert(vectorSet.precision == self.precision, @"Vector sets must have the same precision.");
+    NSAssert(count > 0, @"At least one neighbor must be requested.");
+    
+    size_t neighbors = (size_t)MIN(count, self.count);
+    size_t valueSize = self.precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+    NSMutableData *values = [NSMutableData dataWithLength:(size_t)vectorSet.count * neighbors * valueSize];
+    NSMutableData *neighborIndices = [NSMutableData dataWithLength:(size_t)vectorSet.count * neighbors * sizeof(MAVIndex)];
+    uint8_t *valueBytes = values.mutableBytes;
+    MAVIndex *indexBytes = neighborIndices.mutableBytes;
+    size_t blockSize = MAV_VECTOR_SET_BLOCK_SIZE;
+    size_t queryBlocks = ((size_t)vectorSet.count + blockSize - 1) / blockSize;
+    size_t vectorBlocks = ((size_t)self.count + blockSize - 1) / blockSize;
+    BOOL distances = metric == MAVVectorSimilarityMetricEuclideanDistance;
+    BOOL doublePrecision = self.precision == MCKPrecisionDouble;
+    
+    MAVParallelForRanges(queryBlocks, blockSize * (size_t)self.count * (size_t)self.dimension, ^(NSRange range) {
+        // each task scores one block of queries against one block of vectors at a time, so these are all it holds
+        void *scores = malloc(blockSize * blockSize * valueSize);
+        MAVNeighbor *heaps = malloc(blockSize * neighbors * sizeof(MAVNeighbor));
+        size_t *heapSizes = malloc(blockSize * sizeof(size_t));
+        
+        for (NSUInteger queryBlock = range.location; queryBlock < NSMaxRange(range); queryBlock++) {
+            NSRange queries = NSMakeRange(queryBlock * blockSize, MIN(blockSize, (size_t)vectorSet.count - queryBlock * blockSize));
+            memset(heapSizes, 0, queries.length * sizeof(size_t));
+            
+            for (size_t vectorBlock = 0; vectorBlock < vectorBlocks; vectorBlock++) {
+                NSRange vectors = NSMakeRange(vectorBlock * blockSize, MIN(blockSize, (size_t)self.count - vectorBlock * blockSize));
+                [self computeScores:scores leadingDimension:(MAVIndex)vectors.length ofVectorSet:vectorSet queries:queries vectors:vectors metric:metric];
+                
+                // distances rank in reverse, so the heaps hold them negated
+                for (size_t i = 0; i < queries.length; i++) {
+                    MAVNeighbor *heap = heaps + i * neighbors;
+                    for (size_t j = 0; j < vectors.length; j++) {
+                        double score = doublePrecision ? ((double *)scores)[i * vectors.length + j] : (double)((float *)scores)[i * vectors.length + j];
+                        MAVNeighbor candidate = { distances ? -score : score, (MAVIndex)(vectors.location + j) };
+                        MAVNeighborHeapOffer(heap, &heapSizes[i], neighbors, candidate);
+                    }
+                }
+            }
+            
+            for (size_t i = 0; i < queries.length; i++) {
+                MAVNeighbor *heap = heaps + i * neighbors;
+                MAVNeighborHeapSort(heap, heapSizes[i]);
+                size_t row = (queries.location + i) * neighbors;
+                for (size_t r = 0; r < neighbors; r++) {
+                    double score = distances ? sqrt(-heap[r].score) : heap[r].score;
+                    if (doublePrecision) {
+                        ((double *)valueBytes)[row + r] = score;
+                    } else {
+                        ((float *)valueBytes)[row + r] = (float)score;
+                    }
+                    indexBytes[row + r] = heap[r].index;
+                }
+            }
+        }
+        
+        free(scores);
+        free(heaps);
+        free(heapSizes);
+    });
+    
+    if (indices != NULL) {
+        *indices = neighborIndices;
+    }
+    return [MAVMatrix matrixWithValues:values rows:vectorSet.count columns:(MAVIndex)neighbors leadingDimension:MAVMatrixLeadingDimensionRow];
+}
+
+#pragma mark - Private
+
+/**
+ @brief Compare a block of vectors from another set with a block of vectors from this set, computing their dot products with one matrix multiplication and deriving the requested metric from them. Euclidean distances are left squared.
+ @param scores The row-major array in which to store a row of scores for each query.
+ @param leadingDimension The distance between the starts of consecutive rows of scores.
+ @param vectorSet The set holding the queries.
+ @param queries The range of vectors in vectorSet to compare.
+ @param vectors The range of vectors in this set to compare.
+ @param metric The comparison to compute.
+ */
+- (void)computeScores:(void *)scores
+     leadingDimension:(MAVIndex)leadingDimension
+          ofVectorSet:(MAVVectorSet *)vectorSet
+              queries:(NSRange)queries
+              vectors:(NSRange)vectors
+               metric:(MAVVectorSimilarityMetric)metric
+{
+    MAVLAPACKInteger m = MAVLAPACKIntegerFromIndex((MAVIndex)queries.length);
+    MAVLAPACKInteger n = MAVLAPACKIntegerFromIndex((MAVIndex)vectors.length);
+    MAVLAPACKInteger k = MAVLAPACKIntegerFromIndex(self.dimension);
+    MAVLAPACKInteger ldc = MAVLAPACKIntegerFromIndex(leadingDimension);
+    vDSP_Length length = (vDSP_Length)vectors.length;
+    
+    if (self.precision == MCKPrecisionDouble) {
+        const double *queryValues = (const double *)vectorSet->_values.bytes + queries.location * (size_t)self.dimension;
+        const double *vectorValues = (const double *)_values.bytes + vectors.location * (size_t)self.dimension;
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, n, k, 1.0, queryValues, k, vectorValues, k, 0.0, scores, ldc);
+        
+        for (size_t i = 0; i < queries.length; i++) {
+            double *row = (double *)scores + i * (size_t)leadingDimension;
+            if (metric == MAVVectorSimilarityMetricCosine) {
+                const double *inverseNorms = (const double *)_inverseNorms.bytes + vectors.location;
+                vDSP_vmulD(row, 1, inverseNorms, 1, row, 1, length);
+                vDSP_vsmulD(row, 1, (const double *)vectorSet->_inverseNorms.bytes + queries.location + i, row, 1, length);
+            } else if (metric == MAVVectorSimilarityMetricEuclideanDistance) {
+                // ‖q‖² - 2 q·x + ‖x‖², clamped at 0 where rounding makes it negative
+                double minusTwo = -2.0;
+                double zero = 0.0;
+                vDSP_vsmsaD(row, 1, &minusTwo, (const double *)vectorSet->_squaredNorms.bytes + queries.location + i, row, 1, length);
+                vDSP_vaddD(row, 1, (const double *)_squaredNorms.bytes + vectors.location, 1, row, 1, length);
+                vDSP_vthrD(row, 1, &zero, row, 1, length);
+            }
+        }
+    } else {
+        const float *queryValues = (const float *)vectorSet->_values.bytes + queries.location * (size_t)self.dimension;
+        const float *vectorValues = (const float *)_values.bytes + vectors.location * (size_t)self.dimension;
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, n, k, 1.0f, queryValues, k, vectorValues, k, 0.0f, scores, ldc);
+        
+        for (size_t i = 0; i < queries.length; i++) {
+            float *row = (float *)scores + i * (size_t)leadingDimension;
+            if (metric == MAVVectorSimilarityMetricCosine) {
+                const float *inverseNorms = (const float *)_inverseNorms.bytes + vectors.location;
+                vDSP_vmul(row, 1, inverseNorms, 1, row, 1, length);
+                vDSP_vsmul(row, 1, (const float *)vectorSet->_inverseNorms.bytes + queries.location + i, row, 1, length);
+            } else if (metric == MAVVectorSimilarityMetricEuclideanDistance) {
+                // ‖q‖² - 2 q·x + ‖x‖², clamped at 0 where rounding makes it negative
+                float minusTwo = -2.0f;
+                float zero = 0.0f;
+                vDSP_vsmsa(row, 1, &minusTwo, (const float *)vectorSet->_squaredNorms.bytes + queries.location + i, row, 1, length);
+                vDSP_vadd(row, 1, (const float *)_squaredNorms.bytes + vectors.location, 1, row, 1, length);
+                vDSP_vthr(row, 1, &zero, row, 1, length);
+            }
+        }
+    }
+}
+
+@end
@@ -0,0 +1,116 @@
+//
+//  MAVAsyncFactorizationTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVAsyncFactorizationTests : XCTestCase
+
+@end
+
+@implementation MAVAsyncFactorizationTests
+
+- (void)testAsyncSingularValueDecompositionPopulatesCache
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:40 columns:30 precision:MCKPrecisionDouble];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"singular value decomposition"];
+
+    __block MAVSingularValueDecomposition *asyncSVD;
+    [matrix computeSingularValueDecompositionWithCompletion:^(MAVSingularValueDecomposition *singularValueDecomposition) {
+        XCTAssertTrue([NSThread isMainThread], @"Completion was not called on the main queue.");
+        asyncSVD = singularValueDecomposition;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertNotNil(asyncSVD, @"Asynchronous singular value decomposition was not computed.");
+    XCTAssertTrue(matrix.singularValueDecomposition == asyncSVD, @"Asynchronous singular value decomposition did not populate the lazy property.");
+    XCTAssertEqualObjects(asyncSVD.s.diagonalValues, [MAVSingularValueDecomposition singularValueDecompositionWithMatrix:matrix].s.diagonalValues, @"Asynchronous singular values incorrect.");
+}
+
+- (void)testConcurrentAsyncRequestsShareOneFactorization
+{
+    MAVMatrix *matrix = [MAVMatrix randomNonsigularMatrixOfOrder:50 precision:MCKPrecisionDouble];
+    NSMutableArray *results = [NSMutableArray array];
+    for (int i = 0; i < 4; i++) {
+        XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"LU factorization %d", i]];
+        [matrix computeLUFactorizationWithPriority:i % 2 == 0 ? DISPATCH_QUEUE_PRIORITY_HIGH : DISPATCH_QUEUE_PRIORITY_LOW
+                                   completionQueue:dispatch_get_main_queue()
+                                        completion:^(MAVLUFactorization *luFactorization) {
+                                            [results addObject:luFactorization];
+                                            [expectation fulfill];
+                                        }];
+    }
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(results.count, (NSUInteger)4, @"Not every request received a factorization.");
+    for (MAVLUFactorization *luFactorization in results) {
+        XCTAssertTrue(luFactorization == matrix.luFactorization, @"Concurrent requests did not share one factorization.");
+    }
+}
+
+- (void)testHigherPriorityRequestJoiningLowerPriorityRequestSharesOneFactorization
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:60 columns:60 precision:MCKPrecisionDouble];
+    NSMutableArray *results = [NSMutableArray array];
+    NSArray *priorities = @[@(DISPATCH_QUEUE_PRIORITY_BACKGROUND), @(DISPATCH_QUEUE_PRIORITY_DEFAULT), @(DISPATCH_QUEUE_PRIORITY_HIGH)];
+    for (NSNumber *priority in priorities) {
+        XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"eigendecomposition at priority %@", priority]];
+        [matrix computeEigendecompositionWithPriority:priority.longValue
+                                      completionQueue:dispatch_get_main_queue()
+                                           completion:^(MAVEigendecomposition *eigendecomposition) {
+                                               [results addObject:eigendecomposition];
+                                               [expectation fulfill];
+                                           }];
+    }
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqual(results.count, priorities.count, @"Not every request received a decomposition.");
+    for (MAVEigendecomposition *eigendecomposition in results) {
+        XCTAssertTrue(eigendecomposition == matrix.eigendecomposition, @"Requests raising the priority did not share one decomposition.");
+    }
+}
+
+- (void)testCancelledAsyncRequestDoesNotCallCompletion
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:20 columns:20 precision:MCKPrecisionSingle];
+    __block BOOL cancelledCompletionCalled = NO;
+    MAVAsyncFactorizationTask *task = [matrix computeQRFactorizationWithCompletion:^(MAVQRFactorization *qrFactorization) {
+        cancelledCompletionCalled = YES;
+    }];
+    [task cancel];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"QR factorization"];
+    [matrix computeQRFactorizationWithCompletion:^(MAVQRFactorization *qrFactorization) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertTrue(task.isCancelled, @"Task was not marked cancelled.");
+    XCTAssertFalse(cancelledCompletionCalled, @"Completion of a cancelled request was called.");
+}
+
+@end
@@ -0,0 +1,127 @@
+//
+//  MAVCholeskyFactorizationTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVCholeskyFactorizationTests : XCTestCase
+
+@end
+
+
+@implementation MAVCholeskyFactorizationTests
+
+- (void)testFactorizationReproducesMatrix
+{
+    MAVMatrix *a = [self positiveDefiniteMatrix];
+    MAVCholeskyFactorization *cholesky = a.choleskyFactorization;
+    
+    XCTAssertNotNil(cholesky, @"A positive definite matrix has a Cholesky factorization.");
+    [self assertFactorization:cholesky reproducesMatrix:a accuracy:1.0e-12];
+}
+
+- (void)testIndefiniteMatrixHasNoFactorization
+{
+    double values[4] = { 1.0, 2.0, 2.0, 1.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:4 * sizeof(double)] rows:2 columns:2];
+    
+    XCTAssertNil(a.choleskyFactorization, @"An indefinite matrix has no Cholesky factorization.");
+    XCTAssertNil([MAVMatrix randomMatrixWithRows:2 columns:3 precision:MCKPrecisionDouble].choleskyFactorization, @"A rectangular matrix has no Cholesky factorization.");
+}
+
+- (void)testUpdateAndDowndate
+{
+    MAVMatrix *a = [self positiveDefiniteMatrix];
+    double xValues[4] = { 1.0, -1.0, 0.5, 2.0 };
+    MAVVector *x = [MAVVector vectorWithValues:[NSData dataWithBytes:xValues length:4 * sizeof(double)] length:4];
+    
+    MAVMutableMatrix *updatedMatrix = [a mutableCopy];
+    for (MAVIndex i = 0; i < 4; i += 1) {
+        for (MAVIndex j = 0; j < 4; j += 1) {
+            [updatedMatrix setEntryAtRow:i column:j toValue:@([a valueAtRow:i column:j].doubleValue + xValues[i] * xValues[j])];
+        }
+    }
+    
+    MAVCholeskyFactorization *updated = [a.choleskyFactorization factorizationUpdatedWithVector:x];
+    [self assertFactorization:updated reproducesMatrix:updatedMatrix accuracy:1.0e-12];
+    
+    MAVCholeskyFactorization *downdated = [updated factorizationDowndatedWithVector:x];
+    XCTAssertNotNil(downdated, @"Downdating back to a positive definite matrix should succeed.");
+    [self assertFactorization:downdated reproducesMatrix:a accuracy:1.0e-12];
+}
+
+- (void)testDowndateToIndefiniteMatrixFails
+{
+    double xValues[4] = { 3.0, 0.0, 0.0, 0.0 };
+    MAVVector *x = [MAVVector vectorWithValues:[NSData dataWithBytes:xValues length:4 * sizeof(double)] length:4];
+    
+    XCTAssertNil([[self positiveDefiniteMatrix].choleskyFactorization factorizationDowndatedWithVector:x], @"Downdating to an indefinite matrix should fail.");
+}
+
+- (void)testUpdateInSinglePrecision
+{
+    float aValues[4] = { 4.0f, 2.0f, 2.0f, 3.0f };
+    float xValues[2] = { 1.0f, 2.0f };
+    float expectedValues[4] = { 5.0f, 4.0f, 4.0f, 7.0f };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:4 * sizeof(float)] rows:2 columns:2];
+    MAVMatrix *expected = [MAVMatrix matrixWithValues:[NSData dataWithBytes:expectedValues length:4 * sizeof(float)] rows:2 columns:2];
+    MAVVector *x = [MAVVector vectorWithValues:[NSData dataWithBytes:xValues length:2 * sizeof(float)] length:2];
+    
+    [self assertFactorization:[a.choleskyFactorization factorizationUpdatedWithVector:x] reproducesMatrix:expected accuracy:1.0e-5];
+    [self assertFactorization:[a.choleskyFactorization factorizationScaledByScalar:@2.0f] reproducesMatrix:[[a mutableCopy] multiplyByScalar:@2.0f] accuracy:1.0e-5];
+}
+
+#pragma mark - Helpers
+
+- (MAVMatrix *)positiveDefiniteMatrix
+{
+    // symmetric and strictly diagonally dominant with a positive diagonal
+    double values[16] = {
+        4.0, 2.0, 0.0, 0.0,
+        2.0, 5.0, 1.0, 0.0,
+        0.0, 1.0, 3.0, 1.0,
+        0.0, 0.0, 1.0, 2.0
+    };
+    return [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:16 * sizeof(double)] rows:4 columns:4];
+}
+
+- (void)assertFactorization:(MAVCholeskyFactorization *)factorization reproducesMatrix:(MAVMatrix *)matrix accuracy:(double)accuracy
+{
+    XCTAssertNotNil(factorization, @"Expected a Cholesky factorization.");
+    
+    MAVMatrix *l = factorization.lowerTriangularMatrix;
+    MAVMatrix *product = [[l mutableCopy] multiplyByMatrix:l.transpose];
+    for (MAVIndex row = 0; row < matrix.rows; row += 1) {
+        for (MAVIndex column = 0; column < matrix.columns; column += 1) {
+            XCTAssertEqualWithAccuracy([product valueAtRow:row column:column].doubleValue, [matrix valueAtRow:row column:column].doubleValue, accuracy, @"LLᵀ differs from the matrix at (%d, %d).", (int)row, (int)column);
+            if (column > row) {
+                XCTAssertEqual([l valueAtRow:row column:column].doubleValue, 0.0, @"L is not lower triangular at (%d, %d).", (int)row, (int)column);
+            }
+        }
+    }
+}
+
+@end
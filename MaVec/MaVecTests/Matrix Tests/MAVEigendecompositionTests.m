@@ -102,4 +102,42 @@
     }
 }
 
+
+- (void)testSmallSymmetricMatrixEigendecomposition
+{
+    // the first matrix has distinct eigenvalues and is decomposed in closed form; the second has a repeated eigenvalue and falls back to dsyevd
+    double distinctValues[9] = {
+        2.0, -1.0,  0.0,
+        -1.0,  2.0, -1.0,
+        0.0, -1.0,  2.0
+    };
+    double repeatedValues[9] = {
+        3.0, 1.0, 1.0,
+        1.0, 3.0, 1.0,
+        1.0, 1.0, 3.0
+    };
+    
+    for (NSData *values in @[[NSData dataWithBytes:distinctValues length:9*sizeof(double)], [NSData dataWithBytes:repeatedValues length:9*sizeof(double)]]) {
+        MAVMatrix *o = [MAVMatrix matrixWithValues:values rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionRow];
+        MAVEigendecomposition *e = o.eigendecomposition;
+        
+        for (unsigned int i = 0; i < 3; i += 1) {
+            if (i > 0) {
+                XCTAssertLessThanOrEqual([e.eigenvalues valueAtIndex:i - 1].doubleValue, [e.eigenvalues valueAtIndex:i].doubleValue, @"Eigenvalues should be in ascending order");
+            }
+            MAVVector *eigenvector = [e.eigenvectors columnVectorForColumn:i];
+            NSNumber *eigenvalue = [e.eigenvalues valueAtIndex:i];
+            MAVMutableMatrix *mutableCopy = o.mutableCopy;
+            MAVVector *left = [[mutableCopy multiplyByVector:eigenvector] columnVectorForColumn:0];
+            MAVVector *right = [(MAVMutableVector *)[eigenvector mutableCopy] multiplyByScalar:eigenvalue];
+            for (unsigned int j = 0; j < 3; j += 1) {
+                double a = [left valueAtIndex:j].doubleValue;
+                double b = [right valueAtIndex:j].doubleValue;
+                double accuracy = 0.0000000001;
+                XCTAssertEqualWithAccuracy(a, b, accuracy, @"Values at index %u differ by more than %f", j, accuracy);
+            }
+        }
+    }
+}
+
 @end
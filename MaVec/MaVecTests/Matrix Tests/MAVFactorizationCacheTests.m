@@ -0,0 +1,119 @@
+//
+//  MAVFactorizationCacheTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVFactorizationCacheTests : XCTestCase
+
+@end
+
+
+@implementation MAVFactorizationCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    MAVFactorizationCache *cache = [MAVFactorizationCache sharedCache];
+    [cache removeAllObjects];
+    [cache resetStatistics];
+    cache.byteBudget = 64 * 1024 * 1024;
+    cache.enabled = YES;
+}
+
+- (void)tearDown
+{
+    MAVFactorizationCache *cache = [MAVFactorizationCache sharedCache];
+    cache.enabled = NO;
+    [cache removeAllObjects];
+    [cache resetStatistics];
+    [super tearDown];
+}
+
+- (void)testEqualMatricesShareFactorizations
+{
+    MAVFactorizationCache *cache = [MAVFactorizationCache sharedCache];
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:8 columns:8 precision:MCKPrecisionDouble];
+    MAVMatrix *sameValues = [MAVMatrix matrixWithValues:[matrix.values copy] rows:8 columns:8];
+    
+    MAVLUFactorization *lu = matrix.luFactorization;
+    XCTAssertEqual(cache.misses, (uint64_t)1, @"The first factorization should miss the cache.");
+    XCTAssertGreaterThan(cache.bytesUsed, (size_t)0, @"The factorization should be cached.");
+    
+    MAVLUFactorization *cachedLU = sameValues.luFactorization;
+    XCTAssertEqual(cache.hits, (uint64_t)1, @"A matrix with the same values should hit the cache.");
+    XCTAssertEqualObjects(cachedLU.upperTriangularMatrix, lu.upperTriangularMatrix, @"The cached factorization is incorrect.");
+    XCTAssertEqual(cachedLU.numberOfPermutations, lu.numberOfPermutations, @"The cached factorization is incorrect.");
+    
+    MAVMatrix *singlePrecision = [MAVMatrix randomMatrixWithRows:8 columns:8 precision:MCKPrecisionSingle];
+    [singlePrecision inverse];
+    XCTAssertEqual(cache.misses, (uint64_t)2, @"Other matrices should miss the cache.");
+}
+
+- (void)testEqualPackedSymmetricMatricesShareFactorizations
+{
+    MAVFactorizationCache *cache = [MAVFactorizationCache sharedCache];
+    MAVMatrix *matrix = [MAVMatrix randomSymmetricMatrixOfOrder:6 precision:MCKPrecisionDouble];
+    MAVMatrix *sameValues = [MAVMatrix symmetricMatrixWithPackedValues:[matrix.values copy]
+                                                   triangularComponent:matrix.triangularComponent
+                                                      leadingDimension:matrix.leadingDimension
+                                                                 order:6];
+    XCTAssertEqual(matrix.packingMethod, MAVMatrixValuePackingMethodPacked, @"The matrix should use packed storage.");
+    
+    MAVLUFactorization *lu = matrix.luFactorization;
+    MAVLUFactorization *cachedLU = sameValues.luFactorization;
+    XCTAssertEqual(cache.hits, (uint64_t)1, @"A packed symmetric matrix with the same values should hit the cache.");
+    XCTAssertEqualObjects(cachedLU.upperTriangularMatrix, lu.upperTriangularMatrix, @"The cached factorization is incorrect.");
+}
+
+- (void)testBudgetEvictsLeastRecentlyUsedEntries
+{
+    MAVFactorizationCache *cache = [MAVFactorizationCache sharedCache];
+    MAVMatrix *a = [MAVMatrix randomMatrixWithRows:10 columns:10 precision:MCKPrecisionDouble];
+    MAVMatrix *b = [MAVMatrix randomMatrixWithRows:10 columns:10 precision:MCKPrecisionDouble];
+    
+    // room for one matrix and its inverse
+    cache.byteBudget = 2 * 100 * sizeof(double);
+    [a inverse];
+    [b inverse];
+    XCTAssertLessThanOrEqual(cache.bytesUsed, cache.byteBudget, @"The cache should stay within its budget.");
+    
+    [[MAVMatrix matrixWithValues:[a.values copy] rows:10 columns:10] inverse];
+    XCTAssertEqual(cache.hits, (uint64_t)0, @"The least recently used entry should have been evicted.");
+    [[MAVMatrix matrixWithValues:[a.values copy] rows:10 columns:10] inverse];
+    XCTAssertEqual(cache.hits, (uint64_t)1, @"The recomputed entry should have been cached again.");
+}
+
+- (void)testDisabledCacheIsNotConsulted
+{
+    MAVFactorizationCache *cache = [MAVFactorizationCache sharedCache];
+    cache.enabled = NO;
+    [[MAVMatrix randomMatrixWithRows:6 columns:6 precision:MCKPrecisionDouble] qrFactorization];
+    XCTAssertEqual(cache.hits + cache.misses, (uint64_t)0, @"A disabled cache should not be consulted.");
+    XCTAssertEqual(cache.bytesUsed, (size_t)0, @"A disabled cache should not store values.");
+}
+
+@end
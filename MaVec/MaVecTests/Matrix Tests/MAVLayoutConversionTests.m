@@ -0,0 +1,163 @@
+//
+//  MAVLayoutConversionTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVLayoutConversionTests : XCTestCase
+
+@end
+
+static const MAVIndex kMAVBenchmarkOrder = 2048;
+
+@implementation MAVLayoutConversionTests
+
+#pragma mark - Correctness
+
+- (void)testConventionalLayoutConversionOfRectangularMatrices
+{
+    MAVIndex shapes[4][2] = { { 1, 70 }, { 70, 1 }, { 33, 65 }, { 130, 97 } };
+    for (int s = 0; s < 4; s++) {
+        MAVIndex rows = shapes[s][0];
+        MAVIndex columns = shapes[s][1];
+        MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:rows columns:columns precision:MCKPrecisionDouble];
+        const double *columnMajorValues = matrix.values.bytes;
+        const double *rowMajorValues = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow].bytes;
+        const double *transposeValues = matrix.transpose.values.bytes;
+        for (MAVIndex row = 0; row < rows; row++) {
+            for (MAVIndex col = 0; col < columns; col++) {
+                XCTAssertEqual(rowMajorValues[row * columns + col], columnMajorValues[col * rows + row], @"Row-major conversion of %lldx%lld matrix incorrect.", (long long int)rows, (long long int)columns);
+                XCTAssertEqual(transposeValues[row * columns + col], columnMajorValues[col * rows + row], @"Transpose of %lldx%lld matrix incorrect.", (long long int)rows, (long long int)columns);
+            }
+        }
+
+        MAVMatrix *rowMajorMatrix = [MAVMatrix matrixWithValues:[matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow] rows:rows columns:columns leadingDimension:MAVMatrixLeadingDimensionRow];
+        XCTAssertEqualObjects([rowMajorMatrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn], matrix.values, @"Column-major conversion of %lldx%lld matrix incorrect.", (long long int)rows, (long long int)columns);
+    }
+}
+
+- (void)testTriangularExtractionAndPackedUnpacking
+{
+    MAVIndex order = 75;
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:order columns:order precision:MCKPrecisionSingle];
+    MAVMatrixTriangularComponent components[2] = { MAVMatrixTriangularComponentUpper, MAVMatrixTriangularComponentLower };
+    MAVMatrixLeadingDimension leadingDimensions[2] = { MAVMatrixLeadingDimensionColumn, MAVMatrixLeadingDimensionRow };
+    for (int c = 0; c < 2; c++) {
+        for (int l = 0; l < 2; l++) {
+            MAVMatrixTriangularComponent component = components[c];
+            MAVMatrixLeadingDimension leadingDimension = leadingDimensions[l];
+
+            NSData *packedValues = [matrix valuesFromTriangularComponent:component leadingDimension:leadingDimension packingMethod:MAVMatrixValuePackingMethodPacked];
+            NSData *conventionalValues = [matrix valuesFromTriangularComponent:component leadingDimension:leadingDimension packingMethod:MAVMatrixValuePackingMethodConventional];
+            XCTAssertEqual(packedValues.length, (NSUInteger)(order * (order + 1) / 2 * sizeof(float)), @"Packed triangle has the wrong size.");
+
+            MAVMatrix *triangular = [MAVMatrix triangularMatrixWithPackedValues:packedValues ofTriangularComponent:component leadingDimension:leadingDimension order:order];
+            MAVMatrix *symmetric = [MAVMatrix symmetricMatrixWithPackedValues:packedValues triangularComponent:component leadingDimension:leadingDimension order:order];
+            const float *unpackedValues = [triangular valuesWithLeadingDimension:leadingDimension].bytes;
+            MAVMatrixLeadingDimension otherLeadingDimension = leadingDimension == MAVMatrixLeadingDimensionRow ? MAVMatrixLeadingDimensionColumn : MAVMatrixLeadingDimensionRow;
+            const float *transposedUnpackedValues = [triangular valuesWithLeadingDimension:otherLeadingDimension].bytes;
+            const float *symmetricValues = [symmetric valuesWithLeadingDimension:leadingDimension].bytes;
+            XCTAssertEqualObjects([triangular valuesWithLeadingDimension:leadingDimension], conventionalValues, @"Unpacked triangle does not match conventional triangle.");
+
+            for (MAVIndex row = 0; row < order; row++) {
+                for (MAVIndex col = 0; col < order; col++) {
+                    BOOL inTriangle = component == MAVMatrixTriangularComponentUpper ? row <= col : col <= row;
+                    float expected = inTriangle ? [matrix valueAtRow:row column:col].floatValue : 0.f;
+                    size_t index = leadingDimension == MAVMatrixLeadingDimensionRow ? row * order + col : col * order + row;
+                    XCTAssertEqual(unpackedValues[index], expected, @"Unpacked triangular value at (%lld, %lld) incorrect.", (long long int)row, (long long int)col);
+                    size_t transposedIndex = leadingDimension == MAVMatrixLeadingDimensionRow ? col * order + row : row * order + col;
+                    XCTAssertEqual(transposedUnpackedValues[transposedIndex], expected, @"Unpacked triangular value at (%lld, %lld) incorrect in the other layout.", (long long int)row, (long long int)col);
+
+                    float expectedSymmetric = inTriangle ? [matrix valueAtRow:row column:col].floatValue : [matrix valueAtRow:col column:row].floatValue;
+                    XCTAssertEqual(symmetricValues[index], expectedSymmetric, @"Unpacked symmetric value at (%lld, %lld) incorrect.", (long long int)row, (long long int)col);
+                }
+            }
+        }
+    }
+}
+
+- (void)testBandUnpacking
+{
+    // the tridiagonal matrix
+    // [ 1 2 0 0
+    //   3 4 5 0
+    //   0 6 7 8
+    //   0 0 9 10 ]
+    double bandValues[12] = { 0.0, 2.0, 5.0, 8.0, 1.0, 4.0, 7.0, 10.0, 3.0, 6.0, 9.0, 0.0 };
+    MAVMatrix *band = [MAVMatrix bandMatrixWithValues:[NSData dataWithBytes:bandValues length:12 * sizeof(double)] order:4 upperCodiagonals:1 lowerCodiagonals:1];
+    double expected[16] = { 1.0, 2.0, 0.0, 0.0, 3.0, 4.0, 5.0, 0.0, 0.0, 6.0, 7.0, 8.0, 0.0, 0.0, 9.0, 10.0 };
+    const double *rowMajorValues = [band valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow].bytes;
+    for (int i = 0; i < 16; i++) {
+        XCTAssertEqual(rowMajorValues[i], expected[i], @"Unpacked band value %d incorrect.", i);
+    }
+}
+
+#pragma mark - Benchmarks
+
+- (void)testPerformanceOfNaiveLayoutConversion
+{
+    // the nested loops valuesWithLeadingDimension: used before conversions were tiled, kept as a baseline
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:kMAVBenchmarkOrder columns:kMAVBenchmarkOrder precision:MCKPrecisionDouble];
+    const double *columnMajorValues = matrix.values.bytes;
+    [self measureBlock:^{
+        double *values = malloc(kMAVBenchmarkOrder * kMAVBenchmarkOrder * sizeof(double));
+        size_t i = 0;
+        for (MAVIndex j = 0; j < kMAVBenchmarkOrder; j++) {
+            for (MAVIndex k = 0; k < kMAVBenchmarkOrder; k++) {
+                size_t idx = ((i * kMAVBenchmarkOrder) % (kMAVBenchmarkOrder * kMAVBenchmarkOrder)) + j;
+                values[i] = columnMajorValues[idx];
+                i++;
+            }
+        }
+        free(values);
+    }];
+}
+
+- (void)testPerformanceOfLayoutConversion
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:kMAVBenchmarkOrder columns:kMAVBenchmarkOrder precision:MCKPrecisionDouble];
+    [self measureBlock:^{
+        [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
+    }];
+}
+
+- (void)testPerformanceOfSymmetricUnpacking
+{
+    MAVMatrix *matrix = [MAVMatrix randomSymmetricMatrixOfOrder:kMAVBenchmarkOrder precision:MCKPrecisionDouble];
+    [self measureBlock:^{
+        [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn];
+    }];
+}
+
+- (void)testPerformanceOfTriangularPacking
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:kMAVBenchmarkOrder columns:kMAVBenchmarkOrder precision:MCKPrecisionDouble];
+    [self measureBlock:^{
+        [matrix valuesFromTriangularComponent:MAVMatrixTriangularComponentUpper leadingDimension:MAVMatrixLeadingDimensionRow packingMethod:MAVMatrixValuePackingMethodPacked];
+    }];
+}
+
+@end
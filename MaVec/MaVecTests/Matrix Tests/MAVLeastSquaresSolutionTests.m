@@ -122,4 +122,94 @@
     }
 }
 
+- (void)testUpperTriangularSystem
+{
+    double aVals[9] = {
+        2.0, 1.0, 1.0,
+        0.0, 3.0, 2.0,
+        0.0, 0.0, 4.0
+    };
+    double bVals[3] = { 7.0, 12.0, 12.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aVals length:9 * sizeof(double)] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVVector *b = [MAVVector vectorWithValues:[NSData dataWithBytes:bVals length:3 * sizeof(double)] length:3];
+    
+    MAVVector *coefficients = [MAVMatrix solveLinearSystemWithMatrixA:a valuesB:b];
+    
+    double solution[3] = { 1.0, 2.0, 3.0 };
+    for (unsigned int i = 0; i < 3; i++) {
+        XCTAssertEqualWithAccuracy(solution[i], coefficients[i].doubleValue, __DBL_EPSILON__ * 10.0, @"Coefficient %u incorrect", i);
+    }
+}
+
+- (void)testPackedLowerTriangularSystem
+{
+    // column-major packed values for the lower triangle of
+    //  2 0 0
+    //  1 4 0
+    //  3 5 8
+    float aVals[6] = { 2.0f, 1.0f, 3.0f, 4.0f, 5.0f, 8.0f };
+    float bVals[3] = { 2.0f, 5.0f, 16.0f };
+    MAVMatrix *a = [MAVMatrix triangularMatrixWithPackedValues:[NSData dataWithBytes:aVals length:6 * sizeof(float)]
+                                         ofTriangularComponent:MAVMatrixTriangularComponentLower
+                                              leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                         order:3];
+    MAVVector *b = [MAVVector vectorWithValues:[NSData dataWithBytes:bVals length:3 * sizeof(float)] length:3];
+    
+    MAVVector *coefficients = [MAVMatrix solveLinearSystemWithMatrixA:a valuesB:b];
+    
+    for (unsigned int i = 0; i < 3; i++) {
+        XCTAssertEqualWithAccuracy(1.0f, coefficients[i].floatValue, __FLT_EPSILON__ * 10.0f, @"Coefficient %u incorrect", i);
+    }
+}
+
+- (void)testSingularTriangularSystem
+{
+    double aVals[4] = {
+        1.0, 2.0,
+        0.0, 0.0
+    };
+    double bVals[2] = { 1.0, 1.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aVals length:4 * sizeof(double)] rows:2 columns:2 leadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVVector *b = [MAVVector vectorWithValues:[NSData dataWithBytes:bVals length:2 * sizeof(double)] length:2];
+    
+    XCTAssertNil([MAVMatrix solveLinearSystemWithMatrixA:a valuesB:b], @"Singular triangular system should not be solvable");
+}
+
+- (void)testMixedPrecisionSystem
+{
+    double aVals[16] = {
+        10.0, 1.0, 2.0, 0.0,
+        1.0, 12.0, 0.0, 3.0,
+        2.0, 0.0, 9.0, 1.0,
+        0.0, 3.0, 1.0, 11.0
+    };
+    double solution[4] = { 1.0, -2.0, 3.0, -4.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aVals length:16 * sizeof(double)] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    // a general matrix is refined from an LU factorization, a Gram matrix (known positive definite) from a Cholesky factorization
+    for (MAVMatrix *matrix in @[a, [a gramMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional]]) {
+        double bVals[4];
+        for (unsigned int i = 0; i < 4; i++) {
+            bVals[i] = 0.0;
+            for (unsigned int j = 0; j < 4; j++) {
+                bVals[i] += [matrix valueAtRow:i column:j].doubleValue * solution[j];
+            }
+        }
+        MAVVector *b = [MAVVector vectorWithValues:[NSData dataWithBytes:bVals length:4 * sizeof(double)] length:4];
+        
+        MAVIndex iterations = -1;
+        BOOL didFallBack = YES;
+        MAVVector *coefficients = [MAVMatrix solveLinearSystemUsingMixedPrecisionWithMatrixA:matrix
+                                                                                     valuesB:b
+                                                                        refinementIterations:&iterations
+                                                                didFallBackToDoublePrecision:&didFallBack];
+        
+        XCTAssertFalse(didFallBack, @"Well-conditioned system should not need a double-precision factorization");
+        XCTAssertGreaterThanOrEqual(iterations, 0, @"Refinement iterations should be reported");
+        for (unsigned int i = 0; i < 4; i++) {
+            XCTAssertEqualWithAccuracy(solution[i], coefficients[i].doubleValue, 1.0e-12, @"Coefficient %u incorrect", i);
+        }
+    }
+}
+
 @end
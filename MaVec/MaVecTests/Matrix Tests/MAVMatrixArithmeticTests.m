@@ -180,4 +180,32 @@
     XCTAssertThrows([a subtractMatrix:b], @"Should throw an exception for mismatched column amount");
 }
 
+- (void)testSymmetricMatrixAdditionPreservesSymmetry
+{
+    // column-major packed values for the upper triangles of
+    //  1 2 4      6 5 3
+    //  2 3 5  and 5 4 2
+    //  4 5 6      3 2 1
+    double aValues[6] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    double bValues[6] = { 6.0, 5.0, 4.0, 3.0, 2.0, 1.0 };
+    MAVMutableMatrix *a = [MAVMutableMatrix symmetricMatrixWithPackedValues:[NSData dataWithBytes:aValues length:6 * sizeof(double)]
+                                                        triangularComponent:MAVMatrixTriangularComponentUpper
+                                                           leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                                      order:3];
+    MAVMatrix *b = [MAVMatrix symmetricMatrixWithPackedValues:[NSData dataWithBytes:bValues length:6 * sizeof(double)]
+                                          triangularComponent:MAVMatrixTriangularComponentUpper
+                                             leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                        order:3];
+    
+    [a addMatrix:b];
+    
+    XCTAssertEqual(a.packingMethod, MAVMatrixValuePackingMethodPacked, @"Sum of identically packed symmetric matrices should remain packed");
+    XCTAssert(a.isSymmetric.isYes, @"Sum of symmetric matrices should be symmetric");
+    for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 3; j++) {
+            XCTAssertEqual(7.0, [a valueAtRow:i column:j].doubleValue, @"Value at %u,%u incorrectly added", i, j);
+        }
+    }
+}
+
 @end
@@ -0,0 +1,154 @@
+//
+//  MAVMatrixBatchTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVMatrixBatchTests : XCTestCase
+
+@end
+
+@implementation MAVMatrixBatchTests
+
+- (void)testBatchRoundTripsMatrices
+{
+    NSArray *matrices = @[[MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble]];
+    MAVMatrixBatch *batch = [MAVMatrixBatch batchWithMatrices:matrices];
+
+    XCTAssertEqual(batch.count, (size_t)3, @"Batch did not contain every matrix.");
+    XCTAssertEqual(batch.order, 3, @"Batch order was not taken from the matrices.");
+    for (NSUInteger i = 0; i < matrices.count; i++) {
+        XCTAssertEqualObjects([batch matrixAtIndex:i], matrices[i], @"Matrix %lu was not stored correctly in the batch.", (unsigned long)i);
+    }
+}
+
+- (void)testBatchOperationsMatchMatrixOperations
+{
+    for (MAVIndex order = 2; order <= 4; order++) {
+        NSMutableArray *lefts = [NSMutableArray array];
+        NSMutableArray *rights = [NSMutableArray array];
+        for (int i = 0; i < 5; i++) {
+            [lefts addObject:[MAVMatrix randomNonsigularMatrixOfOrder:order precision:MCKPrecisionDouble]];
+            [rights addObject:[MAVMatrix randomMatrixWithRows:order columns:order precision:MCKPrecisionDouble]];
+        }
+        MAVMatrixBatch *leftBatch = [MAVMatrixBatch batchWithMatrices:lefts];
+        MAVMatrixBatch *rightBatch = [MAVMatrixBatch batchWithMatrices:rights];
+
+        MAVMatrixBatch *products = [leftBatch batchByMultiplyingByBatch:rightBatch];
+        MAVMatrixBatch *transposes = [leftBatch transposedBatch];
+        MAVMatrixBatch *inverses = [leftBatch invertedBatch];
+        const double *determinants = [leftBatch determinants].bytes;
+
+        for (int i = 0; i < 5; i++) {
+            MAVMatrix *left = lefts[i];
+            MAVMatrix *expectedProduct = [MAVMatrix productOfMatrices:@[left, rights[i]]];
+            MAVMatrix *product = [products matrixAtIndex:i];
+            MAVMatrix *inverse = [inverses matrixAtIndex:i];
+            for (MAVIndex row = 0; row < order; row++) {
+                for (MAVIndex col = 0; col < order; col++) {
+                    XCTAssertEqualWithAccuracy([product valueAtRow:row column:col].doubleValue, [expectedProduct valueAtRow:row column:col].doubleValue, __DBL_EPSILON__ * 100.0, @"Batched product incorrect.");
+                    XCTAssertEqualWithAccuracy([inverse valueAtRow:row column:col].doubleValue, [left.inverse valueAtRow:row column:col].doubleValue, 1e-8, @"Batched inverse incorrect.");
+                }
+            }
+            XCTAssertEqualObjects([transposes matrixAtIndex:i], left.transpose, @"Batched transpose incorrect.");
+            XCTAssertEqualWithAccuracy(determinants[i], left.determinant.doubleValue, 1e-8, @"Batched determinant incorrect.");
+        }
+    }
+}
+
+- (void)testSinglePrecisionBatchOperationsMatchDoublePrecision
+{
+    for (MAVIndex order = 2; order <= 4; order++) {
+        // random values in [-1, 1) with a dominant diagonal, so every matrix is well conditioned
+        size_t count = 5;
+        size_t valueCount = order * order * count;
+        NSMutableData *values = [[MAVMatrix randomMatrixWithRows:order * order columns:count precision:MCKPrecisionSingle].values mutableCopy];
+        for (MAVIndex k = 0; k < order; k++) {
+            float diagonal = 2.0f * order;
+            vDSP_vsadd((float *)values.mutableBytes + (k * order + k) * count, 1, &diagonal, (float *)values.mutableBytes + (k * order + k) * count, 1, count);
+        }
+        MAVMatrixBatch *batch = [MAVMatrixBatch batchWithValues:values order:order count:count];
+        double *doubleValues = malloc(valueCount * sizeof(double));
+        vDSP_vspdp(batch.values.bytes, 1, doubleValues, 1, valueCount);
+        MAVMatrixBatch *doubleBatch = [MAVMatrixBatch batchWithValues:[NSData dataWithBytesNoCopy:doubleValues length:valueCount * sizeof(double)] order:order count:batch.count];
+
+        const float *inverses = [batch invertedBatch].values.bytes;
+        const float *products = [batch batchByMultiplyingByBatch:batch].values.bytes;
+        const float *determinants = [batch determinants].bytes;
+        const double *expectedInverses = [doubleBatch invertedBatch].values.bytes;
+        const double *expectedProducts = [doubleBatch batchByMultiplyingByBatch:doubleBatch].values.bytes;
+        const double *expectedDeterminants = [doubleBatch determinants].bytes;
+
+        XCTAssertEqual([batch invertedBatch].precision, MCKPrecisionSingle, @"Single-precision batch inverted to the wrong precision.");
+        for (size_t k = 0; k < valueCount; k++) {
+            XCTAssertEqualWithAccuracy(inverses[k], expectedInverses[k], 1e-3 * MAX(1.0, fabs(expectedInverses[k])), @"Single-precision batched inverse incorrect.");
+            XCTAssertEqualWithAccuracy(products[k], expectedProducts[k], 1e-4 * MAX(1.0, fabs(expectedProducts[k])), @"Single-precision batched product incorrect.");
+        }
+        for (size_t i = 0; i < batch.count; i++) {
+            XCTAssertEqualWithAccuracy(determinants[i], expectedDeterminants[i], 1e-4 * MAX(1.0, fabs(expectedDeterminants[i])), @"Single-precision batched determinant incorrect.");
+        }
+    }
+}
+
+- (void)testBatchMultiplicationBroadcastsSingleMatrix
+{
+    float values[4] = { 0.0f, -1.0f, 1.0f, 0.0f };
+    MAVMatrixBatch *rotation = [MAVMatrixBatch batchWithValues:[NSData dataWithBytes:values length:4 * sizeof(float)] order:2 count:1];
+    MAVMatrixBatch *identities = [MAVMatrixBatch identityBatchOfOrder:2 count:10000 precision:MCKPrecisionSingle];
+
+    MAVMatrixBatch *products = [rotation batchByMultiplyingByBatch:identities];
+
+    XCTAssertEqual(products.count, (size_t)10000, @"Broadcast product did not contain a matrix for each identity.");
+    XCTAssertEqual(products.precision, MCKPrecisionSingle, @"Broadcast product did not keep single precision.");
+    XCTAssertEqualObjects([products matrixAtIndex:9999], [rotation matrixAtIndex:0], @"Broadcast product incorrect.");
+}
+
+- (void)testBatchTransformOfVectors
+{
+    // rotate (1, 0) and (0, 2) by a quarter turn counterclockwise
+    double matrixValues[4] = { 0.0, -1.0, 1.0, 0.0 };
+    MAVMatrixBatch *rotation = [MAVMatrixBatch batchWithValues:[NSData dataWithBytes:matrixValues length:4 * sizeof(double)] order:2 count:1];
+    double vectorValues[4] = { 1.0, 0.0, 0.0, 2.0 };
+
+    const double *transformed = [rotation transformVectorValues:[NSData dataWithBytes:vectorValues length:4 * sizeof(double)]].bytes;
+
+    double expected[4] = { 0.0, -2.0, 1.0, 0.0 };
+    for (int i = 0; i < 4; i++) {
+        XCTAssertEqual(transformed[i], expected[i], @"Transformed vector component %d incorrect.", i);
+    }
+}
+
+- (void)testBatchInverseOfSingularMatrixIsNaN
+{
+    double values[4] = { 1.0, 2.0, 2.0, 4.0 };
+    MAVMatrixBatch *batch = [MAVMatrixBatch batchWithValues:[NSData dataWithBytes:values length:4 * sizeof(double)] order:2 count:1];
+
+    XCTAssertTrue(isnan([[batch invertedBatch] matrixAtIndex:0][0][0].doubleValue), @"Inverse of singular matrix in batch should be NaN.");
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  MAVMatrixCodingTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVMatrixCodingTests : XCTestCase
+
+@end
+
+@implementation MAVMatrixCodingTests
+
+- (id)roundTripObject:(id)object ofClass:(Class)class
+{
+    NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:object];
+    NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:archive];
+    unarchiver.requiresSecureCoding = YES;
+    id decoded = [unarchiver decodeObjectOfClass:class forKey:NSKeyedArchiveRootObjectKey];
+    [unarchiver finishDecoding];
+    return decoded;
+}
+
+- (void)testRoundTripPreservesStorage
+{
+    NSArray *matrices = @[[MAVMatrix randomMatrixWithRows:5 columns:3 precision:MCKPrecisionDouble],
+                          [MAVMatrix matrixWithValues:[MAVMatrix randomMatrixWithRows:4 columns:6 precision:MCKPrecisionSingle].values rows:4 columns:6 leadingDimension:MAVMatrixLeadingDimensionRow],
+                          [MAVMatrix randomSymmetricMatrixOfOrder:6 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomTriangularMatrixOfOrder:5 triangularComponent:MAVMatrixTriangularComponentLower precision:MCKPrecisionSingle],
+                          [MAVMatrix randomTriangularMatrixOfOrder:4 triangularComponent:MAVMatrixTriangularComponentUpper precision:MCKPrecisionDouble],
+                          [MAVMatrix randomBandMatrixOfOrder:7 upperCodiagonals:2 lowerCodiagonals:1 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble].mutableCopy];
+    
+    for (MAVMatrix *matrix in matrices) {
+        MAVMatrix *decoded = [self roundTripObject:matrix ofClass:[MAVMatrix class]];
+        
+        XCTAssertEqual([decoded class], [matrix class], @"Unarchived matrix has the wrong class.");
+        XCTAssertEqual(decoded.rows, matrix.rows, @"Rows not preserved.");
+        XCTAssertEqual(decoded.columns, matrix.columns, @"Columns not preserved.");
+        XCTAssertEqual(decoded.precision, matrix.precision, @"Precision not preserved.");
+        XCTAssertEqual(decoded.leadingDimension, matrix.leadingDimension, @"Leading dimension not preserved.");
+        XCTAssertEqual(decoded.packingMethod, matrix.packingMethod, @"Packing method not preserved.");
+        XCTAssertEqual(decoded.triangularComponent, matrix.triangularComponent, @"Triangular component not preserved.");
+        XCTAssertEqualObjects(decoded.values, matrix.values, @"Values were not archived in their storage layout.");
+        XCTAssertEqualObjects(decoded, matrix, @"Unarchived matrix is not equal to the archived matrix.");
+    }
+}
+
+- (void)testDecodedMutableMatrixCanBeMutated
+{
+    MAVMutableMatrix *matrix = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble].mutableCopy;
+    MAVMutableMatrix *decoded = [self roundTripObject:matrix ofClass:[MAVMatrix class]];
+    
+    [decoded setEntryAtRow:1 column:2 toValue:@42.0];
+    
+    XCTAssertEqual([decoded valueAtRow:1 column:2].doubleValue, 42.0, @"Unarchived mutable matrix could not be mutated.");
+    XCTAssertNotEqual([matrix valueAtRow:1 column:2].doubleValue, 42.0, @"Mutating the unarchived matrix changed the archived one.");
+}
+
+- (void)testFactorizationsArchivedOnlyOnRequest
+{
+    MAVMatrix *matrix = [MAVMatrix randomNonsigularMatrixOfOrder:4 precision:MCKPrecisionDouble];
+    MAVLUFactorization *lu = matrix.luFactorization;
+    MAVQRFactorization *qr = matrix.qrFactorization;
+    
+    NSData *withoutFactorizations = [NSKeyedArchiver archivedDataWithRootObject:matrix];
+    matrix.archivesFactorizations = YES;
+    NSData *withFactorizations = [NSKeyedArchiver archivedDataWithRootObject:matrix];
+    XCTAssertGreaterThan(withFactorizations.length, withoutFactorizations.length, @"Factorizations should only be archived when requested.");
+    
+    MAVMatrix *decoded = [self roundTripObject:matrix ofClass:[MAVMatrix class]];
+    XCTAssertTrue(decoded.archivesFactorizations, @"Option to archive factorizations not preserved.");
+    XCTAssertEqualObjects(decoded.luFactorization.lowerTriangularMatrix, lu.lowerTriangularMatrix, @"Cached L not restored.");
+    XCTAssertEqualObjects(decoded.luFactorization.upperTriangularMatrix, lu.upperTriangularMatrix, @"Cached U not restored.");
+    XCTAssertEqualObjects(decoded.luFactorization.permutationMatrix, lu.permutationMatrix, @"Cached P not restored.");
+    XCTAssertEqual(decoded.luFactorization.numberOfPermutations, lu.numberOfPermutations, @"Cached permutation count not restored.");
+    XCTAssertEqualObjects(decoded.qrFactorization.q, qr.q, @"Cached Q not restored.");
+    XCTAssertEqualObjects(decoded.qrFactorization.r, qr.r, @"Cached R not restored.");
+}
+
+- (void)testDecompositionsRoundTrip
+{
+    MAVMatrix *matrix = [MAVMatrix randomSymmetricMatrixOfOrder:4 precision:MCKPrecisionDouble];
+    
+    MAVSingularValueDecomposition *svd = [self roundTripObject:matrix.singularValueDecomposition ofClass:[MAVSingularValueDecomposition class]];
+    XCTAssertEqualObjects(svd.u, matrix.singularValueDecomposition.u, @"U not preserved.");
+    XCTAssertEqualObjects(svd.s, matrix.singularValueDecomposition.s, @"S not preserved.");
+    XCTAssertEqualObjects(svd.vT, matrix.singularValueDecomposition.vT, @"Vᵀ not preserved.");
+    
+    MAVEigendecomposition *eigendecomposition = [self roundTripObject:matrix.eigendecomposition ofClass:[MAVEigendecomposition class]];
+    XCTAssertEqualObjects(eigendecomposition.eigenvectors, matrix.eigendecomposition.eigenvectors, @"Eigenvectors not preserved.");
+    XCTAssertEqualObjects(eigendecomposition.eigenvalues.values, matrix.eigendecomposition.eigenvalues.values, @"Eigenvalues not preserved.");
+}
+
+- (void)testInconsistentArchiveIsRejected
+{
+    // claim a 3x3 matrix while archiving the values of a 2x2 one
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:2 columns:2 precision:MCKPrecisionDouble];
+    NSMutableData *archive = [NSMutableData data];
+    NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:archive];
+    [archiver encodeObject:matrix forKey:NSKeyedArchiveRootObjectKey];
+    [archiver finishEncoding];
+    NSMutableDictionary *plist = [NSPropertyListSerialization propertyListWithData:archive options:NSPropertyListMutableContainersAndLeaves format:NULL error:nil];
+    for (NSMutableDictionary *object in plist[@"$objects"]) {
+        if ([object isKindOfClass:[NSDictionary class]] && object[@"rows"] != nil) {
+            object[@"rows"] = @3;
+            object[@"columns"] = @3;
+        }
+    }
+    NSData *tampered = [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    
+    NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:tampered];
+    unarchiver.requiresSecureCoding = YES;
+    XCTAssertNil([unarchiver decodeObjectOfClass:[MAVMatrix class] forKey:NSKeyedArchiveRootObjectKey], @"Matrix whose dimensions disagree with its values should not be unarchived.");
+}
+
+@end
@@ -159,4 +159,72 @@
     XCTAssertTrue([a isEqualToMatrix:b], @"Matrix copy is not equal to its source.");
 }
 
+- (void)testMatrixCopiesShareValuesUntilMutated
+{
+    MAVMatrix *a = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+    MAVMatrix *original = [MAVMatrix matrixWithValues:[NSData dataWithData:a.values] rows:3 columns:3];
+    MAVMutableMatrix *b = a.mutableCopy;
+    
+    XCTAssertEqual(a.values.bytes, b.values.bytes, @"A mutable copy should share its source's values until it is mutated.");
+    
+    [b setEntryAtRow:0 column:0 toValue:@(-1.0)];
+    
+    XCTAssertNotEqual(a.values.bytes, b.values.bytes, @"Mutating a copy should give it its own values.");
+    XCTAssertTrue([a isEqualToMatrix:original], @"Mutating a copy changed the values of its source.");
+    XCTAssertEqual([b valueAtRow:0 column:0].doubleValue, -1.0, @"Mutation of a copy was lost.");
+    
+    MAVMatrix *c = b.copy;
+    [b multiplyByScalar:@2.0];
+    
+    XCTAssertEqual([c valueAtRow:0 column:0].doubleValue, -1.0, @"Mutating a matrix changed the values of its copy.");
+    XCTAssertEqual([b valueAtRow:0 column:0].doubleValue, -2.0, @"Mutation of a copied matrix was lost.");
+}
+
+- (void)testMutationAfterCopyIsReleasedWritesInPlace
+{
+    MAVMutableMatrix *a = [MAVMutableMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+    @autoreleasepool {
+        MAVMatrix *b = a.copy;
+        XCTAssertEqual(a.values.bytes, b.values.bytes, @"A copy should share its source's values.");
+    }
+    const void *values = a.values.bytes;
+    
+    [a setEntryAtRow:1 column:1 toValue:@5.0];
+    
+    XCTAssertEqual(a.values.bytes, values, @"A matrix no longer sharing its values should mutate them in place.");
+}
+
+- (void)testContentHashIgnoresStorage
+{
+    MAVMatrix *symmetric = [MAVMatrix randomSymmetricMatrixOfOrder:5 precision:MCKPrecisionDouble];
+    NSData *rowMajorValues = [symmetric valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVMatrix *rowMajor = [MAVMatrix matrixWithValues:rowMajorValues rows:5 columns:5 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    XCTAssertEqualObjects(symmetric, rowMajor, @"Matrices with the same values should be equal whatever their storage.");
+    XCTAssertEqual(symmetric.hash, rowMajor.hash, @"Equal matrices should have equal hashes.");
+    
+    double halves[4] = { 0.5, -0.0, 1.5, 2.0 };
+    float halvesF[4] = { 0.5f, 0.0f, 1.5f, 2.0f };
+    MAVMatrix *doubleMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytes:halves length:sizeof(halves)] rows:2 columns:2];
+    MAVMatrix *floatMatrix = [MAVMatrix matrixWithValues:[NSData dataWithBytes:halvesF length:sizeof(halvesF)] rows:2 columns:2];
+    XCTAssertEqualObjects(doubleMatrix, floatMatrix, @"Exactly representable values should be equal across precisions.");
+    XCTAssertEqual(doubleMatrix.contentHash, floatMatrix.contentHash, @"Equal matrices should have equal hashes across precisions.");
+    
+    NSDictionary *dictionary = @{ symmetric: @"symmetric" };
+    XCTAssertEqualObjects(dictionary[rowMajor], @"symmetric", @"Matrices should work as dictionary keys.");
+}
+
+- (void)testContentHashIsInvalidatedByMutation
+{
+    MAVMutableMatrix *matrix = [MAVMutableMatrix randomMatrixWithRows:4 columns:4 precision:MCKPrecisionSingle];
+    MAVMatrix *copy = matrix.copy;
+    uint64_t hash = matrix.contentHash;
+    
+    [matrix setEntryAtRow:2 column:3 toValue:@([matrix valueAtRow:2 column:3].floatValue + 1.0f)];
+    
+    XCTAssertNotEqual(matrix.contentHash, hash, @"Mutating a matrix should change its hash.");
+    XCTAssertEqual(copy.contentHash, hash, @"Mutating a matrix should not change the hash of its copy.");
+    XCTAssertNotEqualObjects(matrix, copy, @"A mutated matrix should no longer equal its copy.");
+}
+
 @end
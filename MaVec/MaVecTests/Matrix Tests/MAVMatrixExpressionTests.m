@@ -0,0 +1,114 @@
+//
+//  MAVMatrixExpressionTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVMatrixExpressionTests : XCTestCase
+
+@end
+
+@implementation MAVMatrixExpressionTests
+
+- (void)testFusedProductsAndSums
+{
+    MCKPrecision precisions[2] = { MCKPrecisionSingle, MCKPrecisionDouble };
+    for (int i = 0; i < 2; i++) {
+        MCKPrecision precision = precisions[i];
+        double accuracy = precision == MCKPrecisionDouble ? 1e-10 : 1e-3;
+        MAVMatrix *a = [MAVMatrix randomMatrixWithRows:4 columns:3 precision:precision];
+        MAVMatrix *b = [MAVMatrix randomMatrixWithRows:3 columns:5 precision:precision];
+        MAVMatrix *c = [MAVMatrix randomMatrixWithRows:4 columns:2 precision:precision];
+        MAVMatrix *d = [MAVMatrix randomMatrixWithRows:2 columns:5 precision:precision];
+        MAVMatrix *e = [MAVMatrix randomMatrixWithRows:4 columns:5 precision:precision];
+        NSNumber *alpha = precision == MCKPrecisionDouble ? @2.5 : @2.5f;
+
+        MAVMatrixExpression *expression = [[[[MAVMatrixExpression expressionWithMatrix:a] expressionByMultiplyingByMatrix:b]
+                                            expressionByAddingExpression:[[MAVMatrixExpression expressionWithMatrix:c] expressionByMultiplyingByMatrix:d]]
+                                           expressionBySubtractingExpression:[[MAVMatrixExpression expressionWithMatrix:e] expressionByMultiplyingByScalar:alpha]];
+        MAVMatrix *result = [expression evaluate];
+
+        MAVMutableMatrix *expected = [[MAVMatrix productOfMatrices:@[a, b]] mutableCopy];
+        [expected addMatrix:[MAVMatrix productOfMatrices:@[c, d]]];
+        [expected subtractMatrix:[(MAVMutableMatrix *)[e mutableCopy] multiplyByScalar:alpha]];
+
+        XCTAssertEqual(result.precision, precision, @"Evaluated expression has wrong precision.");
+        XCTAssertEqual(result.leadingDimension, MAVMatrixLeadingDimensionColumn, @"Evaluated expression should be column-major.");
+        [self assertMatrix:result equalsMatrix:expected accuracy:accuracy message:@"A·B + C·D − αE"];
+    }
+}
+
+- (void)testTransposesAndRowMajorOperands
+{
+    double aValues[6] = { 1.0, 2.0, 3.0,
+                          4.0, 5.0, 6.0 };
+    double bValues[6] = { 1.0, -1.0,
+                          0.0, 2.0,
+                          3.0, 1.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:6 * sizeof(double)] rows:2 columns:3 leadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVMatrix *b = [MAVMatrix matrixWithValues:[NSData dataWithBytes:bValues length:6 * sizeof(double)] rows:3 columns:2 leadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVMatrix *c = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+
+    // (A·B)ᵀ = Bᵀ·Aᵀ
+    MAVMatrix *productTranspose = [[[[MAVMatrixExpression expressionWithMatrix:a] expressionByMultiplyingByMatrix:b] transposedExpression] evaluate];
+    [self assertMatrix:productTranspose equalsMatrix:[MAVMatrix productOfMatrices:@[a, b]].transpose accuracy:1e-12 message:@"(A·B)ᵀ"];
+
+    // Aᵀ·Bᵀ + Cᵀ, with the transposes of row-major leaves
+    MAVMatrixExpression *expression = [[[[MAVMatrixExpression expressionWithMatrix:a] transposedExpression]
+                                        expressionByMultiplyingByExpression:[[MAVMatrixExpression expressionWithMatrix:b] transposedExpression]]
+                                       expressionByAddingExpression:[[MAVMatrixExpression expressionWithMatrix:c] transposedExpression]];
+    MAVMutableMatrix *expected = [[MAVMatrix productOfMatrices:@[a.transpose, b.transpose]] mutableCopy];
+    [expected addMatrix:c.transpose];
+    [self assertMatrix:[expression evaluate] equalsMatrix:expected accuracy:1e-12 message:@"Aᵀ·Bᵀ + Cᵀ"];
+
+    // a transposed leaf alone is copied with a stride
+    [self assertMatrix:[[[MAVMatrixExpression expressionWithMatrix:a] transposedExpression] evaluate] equalsMatrix:a.transpose accuracy:0.0 message:@"Aᵀ"];
+}
+
+- (void)testProductOfSumUsesTemporary
+{
+    MAVMatrix *a = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+    MAVMatrix *b = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+    MAVMatrix *c = [MAVMatrix randomSymmetricMatrixOfOrder:3 precision:MCKPrecisionDouble];
+
+    MAVMatrixExpression *expression = [[[MAVMatrixExpression expressionWithMatrix:a] expressionByAddingMatrix:b] expressionByMultiplyingByMatrix:c];
+
+    MAVMutableMatrix *sum = [a mutableCopy];
+    [sum addMatrix:b];
+    [self assertMatrix:[expression evaluate] equalsMatrix:[MAVMatrix productOfMatrices:@[sum, c]] accuracy:1e-12 message:@"(A + B)·C"];
+}
+
+- (void)testEvaluatingExpressionDoesNotModifyOperands
+{
+    MAVMatrix *a = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+    MAVMatrix *original = [a copy];
+
+    [[[[MAVMatrixExpression expressionWithMatrix:a] expressionByMultiplyingByMatrix:a] expressionByAddingMatrix:a] evaluate];
+
+    XCTAssertEqualObjects(a, original, @"Evaluating an expression modified an operand.");
+}
+
+@end
@@ -0,0 +1,121 @@
+//
+//  MAVMatrixFileTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVMatrixFileTests : XCTestCase
+
+@end
+
+@implementation MAVMatrixFileTests
+
+- (MAVMatrix *)roundTripMatrix:(MAVMatrix *)matrix
+{
+    NSURL *url = [self temporaryFileURLWithExtension:@"mavmatrix"];
+    NSError *error;
+    XCTAssertTrue([matrix writeToURL:url error:&error], @"Writing matrix failed: %@", error);
+    MAVMatrix *read = [MAVMatrix matrixWithContentsOfURL:url error:&error];
+    XCTAssertNotNil(read, @"Reading matrix failed: %@", error);
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    return read;
+}
+
+- (void)testRoundTripPreservesStorage
+{
+    NSArray *matrices = @[[MAVMatrix randomMatrixWithRows:5 columns:3 precision:MCKPrecisionDouble],
+                          [MAVMatrix matrixWithValues:[MAVMatrix randomMatrixWithRows:4 columns:6 precision:MCKPrecisionSingle].values rows:4 columns:6 leadingDimension:MAVMatrixLeadingDimensionRow],
+                          [MAVMatrix randomSymmetricMatrixOfOrder:6 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomTriangularMatrixOfOrder:5 triangularComponent:MAVMatrixTriangularComponentLower precision:MCKPrecisionSingle],
+                          [MAVMatrix randomBandMatrixOfOrder:7 upperCodiagonals:2 lowerCodiagonals:1 precision:MCKPrecisionDouble]];
+    
+    for (MAVMatrix *matrix in matrices) {
+        MAVMatrix *read = [self roundTripMatrix:matrix];
+        
+        XCTAssertEqual(read.rows, matrix.rows, @"Rows not preserved.");
+        XCTAssertEqual(read.columns, matrix.columns, @"Columns not preserved.");
+        XCTAssertEqual(read.precision, matrix.precision, @"Precision not preserved.");
+        XCTAssertEqual(read.leadingDimension, matrix.leadingDimension, @"Leading dimension not preserved.");
+        XCTAssertEqual(read.packingMethod, matrix.packingMethod, @"Packing method not preserved.");
+        XCTAssertEqual(read.triangularComponent, matrix.triangularComponent, @"Triangular component not preserved.");
+        XCTAssertEqualObjects(read.values, matrix.values, @"Values not preserved.");
+        XCTAssertEqualObjects(read, matrix, @"Matrix read from file is not equal to the matrix written.");
+    }
+}
+
+- (void)testMappedMatrixCanBeMutatedAfterCopying
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:3 columns:3 precision:MCKPrecisionDouble];
+    MAVMatrix *read = [self roundTripMatrix:matrix];
+    
+    MAVMutableMatrix *mutable = read.mutableCopy;
+    [mutable setEntryAtRow:0 column:0 toValue:@42.0];
+    
+    XCTAssertEqual([mutable valueAtRow:0 column:0].doubleValue, 42.0, @"Mutation of a copy of a mapped matrix was lost.");
+    XCTAssertEqualObjects(read, matrix, @"Mutating a copy changed the mapped matrix.");
+}
+
+- (void)testPayloadIsAligned
+{
+    MAVMatrix *read = [self roundTripMatrix:[MAVMatrix randomMatrixWithRows:8 columns:8 precision:MCKPrecisionDouble]];
+    
+    XCTAssertEqual((uintptr_t)read.values.bytes % MAV_MATRIX_FILE_PAYLOAD_ALIGNMENT, (uintptr_t)0, @"Values of a mapped matrix should be aligned.");
+}
+
+- (void)testReadingInvalidFilesFails
+{
+    NSURL *url = [self temporaryFileURLWithExtension:@"mavmatrix"];
+    NSError *error;
+    
+    [[@"not a matrix file, but long enough to hold a header of sixty-four bytes" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:url atomically:YES];
+    XCTAssertNil([MAVMatrix matrixWithContentsOfURL:url error:&error], @"Read a matrix from a file without the signature.");
+    XCTAssertEqualObjects(error.domain, MAVMatrixFileErrorDomain, @"Wrong error domain for a file without the signature.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorInvalidFormat, @"Wrong error for a file without the signature.");
+    
+    XCTAssertTrue([[MAVMatrix randomMatrixWithRows:100 columns:100 precision:MCKPrecisionDouble] writeToURL:url error:&error], @"Writing matrix failed: %@", error);
+    NSData *contents = [NSData dataWithContentsOfURL:url];
+    [[contents subdataWithRange:NSMakeRange(0, contents.length - 8)] writeToURL:url atomically:YES];
+    error = nil;
+    XCTAssertNil([MAVMatrix matrixWithContentsOfURL:url error:&error], @"Read a matrix from a truncated file.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorTruncated, @"Wrong error for a truncated file.");
+
+    XCTAssertTrue([[MAVMatrix randomMatrixWithRows:4 columns:4 precision:MCKPrecisionDouble] writeToURL:url error:&error], @"Writing matrix failed: %@", error);
+    NSMutableData *oversized = [NSMutableData dataWithContentsOfURL:url];
+    OSWriteLittleInt64(oversized.mutableBytes, 24, (uint64_t)1 << 40);
+    OSWriteLittleInt64(oversized.mutableBytes, 32, (uint64_t)1 << 40);
+    [oversized writeToURL:url atomically:YES];
+    error = nil;
+    XCTAssertNil([MAVMatrix matrixWithContentsOfURL:url error:&error], @"Read a matrix whose number of values overflows.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorInvalidFormat, @"Wrong error for a matrix whose number of values overflows.");
+
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    error = nil;
+    XCTAssertNil([MAVMatrix matrixWithContentsOfURL:url error:&error], @"Read a matrix from a missing file.");
+    XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain, @"Wrong error domain for a missing file.");
+    XCTAssertEqual(error.code, (NSInteger)ENOENT, @"Wrong error for a missing file.");
+}
+
+@end
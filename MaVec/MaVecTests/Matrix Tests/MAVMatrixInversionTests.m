@@ -88,4 +88,139 @@
     }
 }
 
+- (void)testInverseOfUpperTriangularMatrix
+{
+    double values[16] = {
+        2.0, 1.0, 0.0, 3.0,
+        0.0, 3.0, 1.0, 2.0,
+        0.0, 0.0, 4.0, 1.0,
+        0.0, 0.0, 0.0, 5.0
+    };
+    
+    MAVMatrix *original = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:16*sizeof(double)] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    MAVMatrix *inverse = original.inverse;
+    
+    for (unsigned int row = 0; row < 4; row += 1) {
+        for (unsigned int col = 0; col < 4; col += 1) {
+            double product = 0.0;
+            for (unsigned int k = 0; k < 4; k += 1) {
+                product += [original valueAtRow:row column:k].doubleValue * [inverse valueAtRow:k column:col].doubleValue;
+            }
+            double accuracy = 1.0e-12;
+            XCTAssertEqualWithAccuracy(product, row == col ? 1.0 : 0.0, accuracy, @"Value at (%u, %u) of A * A^-1 incorrect beyond accuracy=%f", row, col, accuracy);
+            if (row > col) {
+                XCTAssertEqual([inverse valueAtRow:row column:col].doubleValue, 0.0, @"Inverse of upper triangular matrix should be upper triangular");
+            }
+        }
+    }
+}
+
+- (void)testInverseOfPackedLowerTriangularMatrix
+{
+    // column-major packed values for the lower triangle of
+    //  2 0 0
+    //  1 4 0
+    //  3 5 8
+    double values[6] = { 2.0, 1.0, 3.0, 4.0, 5.0, 8.0 };
+    
+    MAVMatrix *original = [MAVMatrix triangularMatrixWithPackedValues:[NSData dataWithBytes:values length:6*sizeof(double)]
+                                                ofTriangularComponent:MAVMatrixTriangularComponentLower
+                                                     leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                                order:3];
+    
+    MAVMatrix *inverse = original.inverse;
+    
+    XCTAssertEqual(inverse.packingMethod, MAVMatrixValuePackingMethodPacked, @"Inverse of packed triangular matrix should remain packed");
+    XCTAssertEqual(inverse.triangularComponent, MAVMatrixTriangularComponentLower, @"Inverse of lower triangular matrix should be lower triangular");
+    
+    for (unsigned int row = 0; row < 3; row += 1) {
+        for (unsigned int col = 0; col < 3; col += 1) {
+            double product = 0.0;
+            for (unsigned int k = 0; k < 3; k += 1) {
+                product += [original valueAtRow:row column:k].doubleValue * [inverse valueAtRow:k column:col].doubleValue;
+            }
+            double accuracy = 1.0e-12;
+            XCTAssertEqualWithAccuracy(product, row == col ? 1.0 : 0.0, accuracy, @"Value at (%u, %u) of A * A^-1 incorrect beyond accuracy=%f", row, col, accuracy);
+        }
+    }
+}
+
+- (void)testInverseOfSingularTriangularMatrix
+{
+    double values[9] = {
+        1.0, 2.0, 3.0,
+        0.0, 0.0, 4.0,
+        0.0, 0.0, 5.0
+    };
+    
+    MAVMatrix *original = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:9*sizeof(double)] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    XCTAssertNil(original.inverse, @"Singular triangular matrix should not have an inverse");
+}
+
+
+- (void)testInverseOfSmallMatrix
+{
+    float values[4] = {
+        4.0f, 7.0f,
+        2.0f, 6.0f
+    };
+    MAVMatrix *original = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:4*sizeof(float)] rows:2 columns:2 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    float inverseValues[4] = {
+        0.6f, -0.7f,
+        -0.2f, 0.4f
+    };
+    MAVMatrix *solution = [MAVMatrix matrixWithValues:[NSData dataWithBytes:inverseValues length:4*sizeof(float)] rows:2 columns:2 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    MAVMatrix *inverse = original.inverse;
+    XCTAssertEqual(inverse.precision, MCKPrecisionSingle, @"Inverse should keep the precision of the original matrix");
+    for (MAVIndex i = 0; i < 2; i++) {
+        for (MAVIndex j = 0; j < 2; j++) {
+            XCTAssertEqualWithAccuracy([inverse valueAtRow:i column:j].floatValue, [solution valueAtRow:i column:j].floatValue, 0.00001f, @"Value at %lld,%lld incorrect", (long long int)i, (long long int)j);
+        }
+    }
+    
+    double singularValues[4] = {
+        1.0, 2.0,
+        2.0, 4.0
+    };
+    MAVMatrix *singular = [MAVMatrix matrixWithValues:[NSData dataWithBytes:singularValues length:4*sizeof(double)] rows:2 columns:2 leadingDimension:MAVMatrixLeadingDimensionRow];
+    XCTAssertNil(singular.inverse, @"Singular matrix should not have an inverse");
+}
+
+- (void)testIllConditionedSmallMatrixUsesPivotedFactorization
+{
+    // rows that differ from each other by 1e-3 are nearly linearly dependent, so the unpivoted adjugate loses about five digits of the solution
+    double delta = 1.0e-3;
+    double values[16];
+    for (int i = 0; i < 16; i++) {
+        values[i] = i % 5 == 0 ? 1.0 + delta : 1.0;
+    }
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:16*sizeof(double)] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    double solutionValues[4] = { 1.0, -2.0, 3.0, -4.0 };
+    double bValues[4];
+    for (int row = 0; row < 4; row++) {
+        bValues[row] = 0.0;
+        for (int col = 0; col < 4; col++) {
+            bValues[row] += values[row * 4 + col] * solutionValues[col];
+        }
+    }
+    MAVVector *b = [MAVVector vectorWithValues:[NSData dataWithBytes:bValues length:4*sizeof(double)] length:4];
+    
+    MAVVector *x = [MAVMatrix solveLinearSystemWithMatrixA:a valuesB:b];
+    for (int i = 0; i < 4; i++) {
+        XCTAssertEqualWithAccuracy(x[i].doubleValue, solutionValues[i], 1.0e-12, @"Value %d of the solution of an ill-conditioned system incorrect", i);
+    }
+    
+    MAVMatrix *product = [[a mutableCopy] multiplyByMatrix:a.inverse];
+    for (MAVIndex i = 0; i < 4; i++) {
+        for (MAVIndex j = 0; j < 4; j++) {
+            XCTAssertEqualWithAccuracy([product valueAtRow:i column:j].doubleValue, i == j ? 1.0 : 0.0, 1.0e-10, @"Value at %lld,%lld of A times its inverse incorrect", (long long int)i, (long long int)j);
+        }
+    }
+}
+
 @end
@@ -0,0 +1,146 @@
+//
+//  MAVMatrixMarketTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVMatrixMarketTests : XCTestCase
+
+@end
+
+static const MAVIndex kMAVBenchmarkOrder = 512;
+
+@implementation MAVMatrixMarketTests
+
+- (MAVMatrix *)matrixFromContents:(NSString *)contents precision:(MCKPrecision)precision error:(NSError **)error
+{
+    NSURL *url = [self temporaryFileURLWithExtension:@"mtx"];
+    [contents writeToURL:url atomically:YES encoding:NSASCIIStringEncoding error:nil];
+    MAVMatrix *matrix = [MAVMatrix matrixWithContentsOfMatrixMarketURL:url precision:precision error:error];
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    return matrix;
+}
+
+- (void)testReadArrayFormat
+{
+    NSError *error;
+    MAVMatrix *matrix = [self matrixFromContents:@"%%MatrixMarket matrix array real general\n% a comment\n\n2 3\n1\n2\n3\n4\n5 6\n" precision:MCKPrecisionDouble error:&error];
+    
+    XCTAssertNotNil(matrix, @"Reading array format failed: %@", error);
+    double expected[6] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    XCTAssertEqualObjects(matrix, [MAVMatrix matrixWithValues:[NSData dataWithBytes:expected length:sizeof(expected)] rows:2 columns:3], @"Array values incorrect.");
+}
+
+- (void)testReadSymmetricArrayFormat
+{
+    NSError *error;
+    MAVMatrix *symmetric = [self matrixFromContents:@"%%MatrixMarket matrix array real symmetric\n3 3\n1\n2\n3\n4\n5\n6\n" precision:MCKPrecisionSingle error:&error];
+    XCTAssertNotNil(symmetric, @"Reading symmetric array format failed: %@", error);
+    float expectedSymmetric[9] = { 1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 5.0f, 3.0f, 5.0f, 6.0f };
+    XCTAssertEqualObjects(symmetric.values, [NSData dataWithBytes:expectedSymmetric length:sizeof(expectedSymmetric)], @"Symmetric array values incorrect.");
+    XCTAssertTrue(symmetric.isSymmetric.isYes, @"Symmetric matrices should be marked symmetric.");
+    
+    MAVMatrix *skew = [self matrixFromContents:@"%%MatrixMarket matrix array real skew-symmetric\n3 3\n1\n2\n3\n" precision:MCKPrecisionSingle error:&error];
+    XCTAssertNotNil(skew, @"Reading skew-symmetric array format failed: %@", error);
+    float expectedSkew[9] = { 0.0f, 1.0f, 2.0f, -1.0f, 0.0f, 3.0f, -2.0f, -3.0f, 0.0f };
+    XCTAssertEqualObjects(skew.values, [NSData dataWithBytes:expectedSkew length:sizeof(expectedSkew)], @"Skew-symmetric array values incorrect.");
+}
+
+- (void)testReadCoordinateFormat
+{
+    NSError *error;
+    MAVMatrix *general = [self matrixFromContents:@"%%MatrixMarket matrix coordinate integer general\n3 2 3\n1 1 5\n3 2 -7\n2 1 1e1\n" precision:MCKPrecisionDouble error:&error];
+    XCTAssertNotNil(general, @"Reading coordinate format failed: %@", error);
+    double expectedGeneral[6] = { 5.0, 10.0, 0.0, 0.0, 0.0, -7.0 };
+    XCTAssertEqualObjects(general.values, [NSData dataWithBytes:expectedGeneral length:sizeof(expectedGeneral)], @"Coordinate values incorrect.");
+    
+    MAVMatrix *pattern = [self matrixFromContents:@"%%MatrixMarket matrix coordinate pattern symmetric\n2 2 2\n1 1\n2 1\n" precision:MCKPrecisionDouble error:&error];
+    XCTAssertNotNil(pattern, @"Reading symmetric pattern failed: %@", error);
+    double expectedPattern[4] = { 1.0, 1.0, 1.0, 0.0 };
+    XCTAssertEqualObjects(pattern.values, [NSData dataWithBytes:expectedPattern length:sizeof(expectedPattern)], @"Pattern values incorrect.");
+}
+
+- (void)testInvalidFilesAreRejected
+{
+    NSError *error;
+    
+    XCTAssertNil([self matrixFromContents:@"%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n" precision:MCKPrecisionDouble error:&error], @"Complex matrices should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorUnsupportedType, @"Complex matrices should be reported as unsupported.");
+    
+    XCTAssertNil([self matrixFromContents:@"%%MatrixMarket matrix coordinate real general\n2 2 3\n1 1 1\n2 2 1\n" precision:MCKPrecisionDouble error:&error], @"Files missing entries should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorTruncated, @"Files missing entries should be reported as truncated.");
+    
+    XCTAssertNil([self matrixFromContents:@"%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n" precision:MCKPrecisionDouble error:&error], @"Entries outside the matrix should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorInvalidFormat, @"Entries outside the matrix should be reported as invalid.");
+    
+    XCTAssertNil([self matrixFromContents:@"1 2 3\n" precision:MCKPrecisionDouble error:&error], @"Files without a banner should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorInvalidFormat, @"Files without a banner should be reported as invalid.");
+}
+
+- (void)testRoundTripIsExact
+{
+    NSArray *matrices = @[[MAVMatrix randomMatrixWithRows:4 columns:6 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomMatrixWithRows:5 columns:3 precision:MCKPrecisionSingle],
+                          [MAVMatrix randomSymmetricMatrixOfOrder:5 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomTriangularMatrixOfOrder:4 triangularComponent:MAVMatrixTriangularComponentUpper precision:MCKPrecisionSingle]];
+    MAVMatrixMarketFormat formats[2] = { MAVMatrixMarketFormatArray, MAVMatrixMarketFormatCoordinate };
+    
+    for (MAVMatrix *matrix in matrices) {
+        for (int i = 0; i < 2; i++) {
+            NSURL *url = [self temporaryFileURLWithExtension:@"mtx"];
+            NSError *error;
+            XCTAssertTrue([matrix writeMatrixMarketToURL:url format:formats[i] error:&error], @"Writing Matrix Market file failed: %@", error);
+            MAVMatrix *read = [MAVMatrix matrixWithContentsOfMatrixMarketURL:url precision:matrix.precision error:&error];
+            [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+            
+            XCTAssertNotNil(read, @"Reading Matrix Market file failed: %@", error);
+            XCTAssertEqualObjects(read, matrix, @"Matrix read from Matrix Market file is not exactly equal to the matrix written.");
+        }
+    }
+}
+
+#pragma mark - Benchmarks
+
+- (void)testThroughputOfMatrixMarketFiles
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:kMAVBenchmarkOrder columns:kMAVBenchmarkOrder precision:MCKPrecisionDouble];
+    NSURL *url = [self temporaryFileURLWithExtension:@"mtx"];
+    
+    NSDate *start = [NSDate date];
+    XCTAssertTrue([matrix writeMatrixMarketToURL:url format:MAVMatrixMarketFormatArray error:nil], @"Writing Matrix Market file failed.");
+    NSTimeInterval writeTime = -start.timeIntervalSinceNow;
+    double megabytes = [[[NSFileManager defaultManager] attributesOfItemAtPath:url.path error:nil] fileSize] / 1e6;
+    
+    start = [NSDate date];
+    MAVMatrix *read = [MAVMatrix matrixWithContentsOfMatrixMarketURL:url precision:MCKPrecisionDouble error:nil];
+    NSTimeInterval readTime = -start.timeIntervalSinceNow;
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    
+    XCTAssertEqualObjects(read.values, matrix.values, @"Values not preserved.");
+    NSLog(@"Matrix Market write: %.1f MB/s, read: %.1f MB/s", megabytes / writeTime, megabytes / readTime);
+}
+
+@end
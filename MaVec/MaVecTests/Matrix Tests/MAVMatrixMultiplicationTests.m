@@ -203,4 +203,201 @@
     XCTAssert([power isEqualToMatrix:solution], @"Power of matrix incorrectly calculated.");
 }
 
+- (void)testGramProductIsSymmetric
+{
+    double values[6] = {
+        1.0, 2.0,
+        3.0, 4.0,
+        5.0, 7.0
+    };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:6*sizeof(double)]
+                                          rows:3
+                                       columns:2
+                              leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    MAVMutableMatrix *gram = [a.transpose mutableCopy];
+    [gram multiplyByMatrix:a];
+    
+    XCTAssertEqual(gram.packingMethod, MAVMatrixValuePackingMethodConventional, @"Product should be stored conventionally");
+    XCTAssert(gram.isSymmetric.isYes, @"AᵀA should be symmetric");
+    
+    double solutionValues[4] = {
+        35.0, 49.0,
+        49.0, 69.0
+    };
+    for (unsigned int row = 0; row < 2; row += 1) {
+        for (unsigned int col = 0; col < 2; col += 1) {
+            XCTAssertEqual([gram valueAtRow:row column:col].doubleValue, solutionValues[row * 2 + col], @"Value at (%u, %u) of AᵀA incorrect", row, col);
+        }
+    }
+    
+    MAVMatrix *inverse = gram.inverse;
+    for (unsigned int row = 0; row < 2; row += 1) {
+        for (unsigned int col = 0; col < 2; col += 1) {
+            double product = 0.0;
+            for (unsigned int k = 0; k < 2; k += 1) {
+                product += [gram valueAtRow:row column:k].doubleValue * [inverse valueAtRow:k column:col].doubleValue;
+            }
+            XCTAssertEqualWithAccuracy(product, row == col ? 1.0 : 0.0, 1.0e-10, @"Value at (%u, %u) of AᵀA * (AᵀA)^-1 incorrect", row, col);
+        }
+    }
+}
+
+- (void)testProductOfUpperTriangularMatricesIsUpperTriangular
+{
+    double aValues[9] = {
+        1.0, 2.0, 3.0,
+        0.0, 4.0, 5.0,
+        0.0, 0.0, 6.0
+    };
+    double bValues[9] = {
+        2.0, 1.0, 1.0,
+        0.0, 3.0, 1.0,
+        0.0, 0.0, 2.0
+    };
+    MAVMutableMatrix *a = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:aValues length:9*sizeof(double)]
+                                                        rows:3
+                                                     columns:3
+                                            leadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVMatrix *b = [MAVMatrix matrixWithValues:[NSData dataWithBytes:bValues length:9*sizeof(double)]
+                                          rows:3
+                                       columns:3
+                              leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    [a multiplyByMatrix:b];
+    
+    XCTAssertEqual(a.triangularComponent, MAVMatrixTriangularComponentUpper, @"Product of upper triangular matrices should be upper triangular");
+    
+    double solutionValues[9] = {
+        2.0, 7.0, 9.0,
+        0.0, 12.0, 14.0,
+        0.0, 0.0, 12.0
+    };
+    MAVMatrix *solution = [MAVMatrix matrixWithValues:[NSData dataWithBytes:solutionValues length:9*sizeof(double)]
+                                                 rows:3
+                                              columns:3
+                                     leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    XCTAssert([a isEqualToMatrix:solution], @"Product of upper triangular matrices incorrectly calculated.");
+    XCTAssertEqual(a.determinant.doubleValue, 288.0, @"Determinant of upper triangular product incorrect");
+}
+
+- (void)testGramMatrices
+{
+    double values[6] = {
+        1.0, 2.0,
+        3.0, 4.0,
+        5.0, 7.0
+    };
+    double gramValues[4] = {
+        35.0, 49.0,
+        49.0, 69.0
+    };
+    double outerGramValues[9] = {
+        5.0, 11.0, 19.0,
+        11.0, 25.0, 43.0,
+        19.0, 43.0, 74.0
+    };
+    
+    for (NSNumber *leadingDimension in @[@(MAVMatrixLeadingDimensionRow), @(MAVMatrixLeadingDimensionColumn)]) {
+        MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:6*sizeof(double)]
+                                              rows:3
+                                           columns:2
+                                  leadingDimension:MAVMatrixLeadingDimensionRow];
+        if (leadingDimension.unsignedCharValue == MAVMatrixLeadingDimensionColumn) {
+            a = [MAVMatrix matrixWithValues:[a valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn]
+                                       rows:3
+                                    columns:2
+                           leadingDimension:MAVMatrixLeadingDimensionColumn];
+        }
+        
+        for (NSNumber *packingMethod in @[@(MAVMatrixValuePackingMethodConventional), @(MAVMatrixValuePackingMethodPacked)]) {
+            MAVMatrix *gram = [a gramMatrixWithPackingMethod:packingMethod.unsignedCharValue];
+            MAVMatrix *outerGram = [a outerGramMatrixWithPackingMethod:packingMethod.unsignedCharValue];
+            
+            XCTAssertEqual(gram.packingMethod, packingMethod.unsignedCharValue, @"Gram matrix stored with wrong packing method");
+            XCTAssert(gram.isSymmetric.isYes, @"Gram matrix should be symmetric");
+            XCTAssert(outerGram.isSymmetric.isYes, @"Outer Gram matrix should be symmetric");
+            
+            for (unsigned int row = 0; row < 2; row += 1) {
+                for (unsigned int col = 0; col < 2; col += 1) {
+                    XCTAssertEqual([gram valueAtRow:row column:col].doubleValue, gramValues[row * 2 + col], @"Value at (%u, %u) of AᵀA incorrect", row, col);
+                }
+            }
+            for (unsigned int row = 0; row < 3; row += 1) {
+                for (unsigned int col = 0; col < 3; col += 1) {
+                    XCTAssertEqual([outerGram valueAtRow:row column:col].doubleValue, outerGramValues[row * 3 + col], @"Value at (%u, %u) of AAᵀ incorrect", row, col);
+                }
+            }
+        }
+    }
+}
+
+- (void)testGramMatrixUpdate
+{
+    double values[6] = {
+        1.0, 2.0,
+        3.0, 4.0,
+        5.0, 7.0
+    };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:6*sizeof(double)]
+                                          rows:3
+                                       columns:2
+                              leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    // packed upper triangle of the identity matrix
+    double identityValues[3] = { 1.0, 0.0, 1.0 };
+    MAVMutableMatrix *packed = [MAVMutableMatrix symmetricMatrixWithPackedValues:[NSData dataWithBytes:identityValues length:3*sizeof(double)]
+                                                             triangularComponent:MAVMatrixTriangularComponentUpper
+                                                                leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                                           order:2];
+    MAVMutableMatrix *conventional = [MAVMutableMatrix identityMatrixOfOrder:2 precision:MCKPrecisionDouble];
+    
+    [packed updateWithGramMatrixOfMatrix:a alpha:@2.0 beta:@3.0];
+    [conventional updateWithGramMatrixOfMatrix:a alpha:@2.0 beta:@3.0];
+    
+    double solutionValues[4] = {
+        73.0, 98.0,
+        98.0, 141.0
+    };
+    
+    XCTAssertEqual(packed.packingMethod, MAVMatrixValuePackingMethodPacked, @"Packed matrix should remain packed");
+    for (MAVMatrix *matrix in @[packed, conventional]) {
+        XCTAssert(matrix.isSymmetric.isYes, @"Updated matrix should be symmetric");
+        for (unsigned int row = 0; row < 2; row += 1) {
+            for (unsigned int col = 0; col < 2; col += 1) {
+                XCTAssertEqual([matrix valueAtRow:row column:col].doubleValue, solutionValues[row * 2 + col], @"Value at (%u, %u) of 2AᵀA + 3I incorrect", row, col);
+            }
+        }
+    }
+}
+
+- (void)testOuterGramUpdate
+{
+    double values[6] = {
+        1.0, 2.0,
+        3.0, 4.0,
+        5.0, 7.0
+    };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:6*sizeof(double)]
+                                          rows:3
+                                       columns:2
+                              leadingDimension:MAVMatrixLeadingDimensionRow];
+    MAVMutableMatrix *matrix = [MAVMutableMatrix identityMatrixOfOrder:3 precision:MCKPrecisionDouble];
+    
+    [matrix updateWithOuterGramMatrixOfMatrix:a alpha:@2.0 beta:@3.0];
+    
+    double solutionValues[9] = {
+        13.0, 22.0, 38.0,
+        22.0, 53.0, 86.0,
+        38.0, 86.0, 151.0
+    };
+    XCTAssert(matrix.isSymmetric.isYes, @"Updated matrix should be symmetric");
+    for (unsigned int row = 0; row < 3; row += 1) {
+        for (unsigned int col = 0; col < 3; col += 1) {
+            XCTAssertEqual([matrix valueAtRow:row column:col].doubleValue, solutionValues[row * 3 + col], @"Value at (%u, %u) of 2AAᵀ + 3I incorrect", row, col);
+        }
+    }
+}
+
 @end
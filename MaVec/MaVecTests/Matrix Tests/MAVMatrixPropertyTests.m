@@ -82,6 +82,27 @@
                        leadingDimension:MAVMatrixLeadingDimensionRow];
     
     XCTAssertEqual(matrix.determinant.doubleValue, 24.0, @"Determinant not correct");
+    
+    double upperTriangularValues[16] = {
+        2.0, 1.0, 0.0, 3.0,
+        0.0, 3.0, 1.0, 2.0,
+        0.0, 0.0, 4.0, 1.0,
+        0.0, 0.0, 0.0, 5.0
+    };
+    matrix = [MAVMatrix matrixWithValues:[NSData dataWithBytes:upperTriangularValues length:16*sizeof(double)]
+                                   rows:4
+                                columns:4
+                       leadingDimension:MAVMatrixLeadingDimensionRow];
+    
+    XCTAssertEqual(matrix.determinant.doubleValue, 120.0, @"Determinant not correct");
+    
+    double packedLowerTriangularValues[10] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0 };
+    matrix = [MAVMatrix triangularMatrixWithPackedValues:[NSData dataWithBytes:packedLowerTriangularValues length:10*sizeof(double)]
+                                   ofTriangularComponent:MAVMatrixTriangularComponentLower
+                                        leadingDimension:MAVMatrixLeadingDimensionColumn
+                                                   order:4];
+    
+    XCTAssertEqual(matrix.determinant.doubleValue, 1.0 * 5.0 * 8.0 * 10.0, @"Determinant not correct");
 }
 
 - (void)testMatrixDefiniteness
@@ -279,4 +300,30 @@
     XCTAssert(nonzeroMatrix.isZero.isNo, @"Non zero single precision matrix identified as zero matrix.");
 }
 
+
+- (void)testConcurrentLazyPropertiesAreComputedOnce
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:64 columns:64 precision:MCKPrecisionDouble];
+    
+    NSUInteger numberOfReads = 16;
+    __strong id *singularValueDecompositions = (__strong id *)calloc(numberOfReads, sizeof(id));
+    __strong id *inverses = (__strong id *)calloc(numberOfReads, sizeof(id));
+    dispatch_apply(numberOfReads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        singularValueDecompositions[i] = matrix.singularValueDecomposition;
+        inverses[i] = matrix.inverse;
+    });
+    
+    for (NSUInteger i = 1; i < numberOfReads; i++) {
+        XCTAssertEqual(singularValueDecompositions[i], singularValueDecompositions[0], @"Every thread should receive the same singular value decomposition");
+        XCTAssertEqual(inverses[i], inverses[0], @"Every thread should receive the same inverse");
+    }
+    
+    for (NSUInteger i = 0; i < numberOfReads; i++) {
+        singularValueDecompositions[i] = nil;
+        inverses[i] = nil;
+    }
+    free(singularValueDecompositions);
+    free(inverses);
+}
+
 @end
@@ -144,11 +144,11 @@ static const MAVIndex columns = 3;
                 if ([value isDoublePrecision]) {
                     double resultValue = matrix[row][column].doubleValue;
                     double computedValue = original[row][column].doubleValue + 1.0 * (addition ? 1.0 : -1.0);
-                    XCTAssertEqual(resultValue, computedValue, @"Value at (%d, %d) %@ incorrectly in double precision matrix", row, column, addition ? @"added" : @"subtracted");
+                    XCTAssertEqual(resultValue, computedValue, @"Value at (%lld, %lld) %@ incorrectly in double precision matrix", (long long int)row, (long long int)column, addition ? @"added" : @"subtracted");
                 } else {
                     float resultValue = matrix[row][column].floatValue;
                     float computedValue = original[row][column].floatValue + 1.0f * (addition ? 1.0f : -1.0f);
-                    XCTAssertEqual(resultValue, computedValue, @"Value at (%d, %d) %@ incorrectly in single precision matrix", row, column, addition ? @"added" : @"subtracted");
+                    XCTAssertEqual(resultValue, computedValue, @"Value at (%lld, %lld) %@ incorrectly in single precision matrix", (long long int)row, (long long int)column, addition ? @"added" : @"subtracted");
                 }
             }
         }
@@ -166,11 +166,11 @@ static const MAVIndex columns = 3;
                 if (isDouble) {
                     double computedValue = matrix[row][column].doubleValue;
                     double solution = original[row][column].doubleValue * 5.0;
-                    XCTAssertEqual(computedValue, solution, @"Entry at (%d, %d) not multiplied correctly in double-precision matrix.", row, column);
+                    XCTAssertEqual(computedValue, solution, @"Entry at (%lld, %lld) not multiplied correctly in double-precision matrix.", (long long int)row, (long long int)column);
                 } else {
                     float computedValue = matrix[row][column].floatValue;
                     float solution = original[row][column].floatValue * 5.0f;
-                    XCTAssertEqual(computedValue, solution, @"Entry at (%d, %d) not multiplied correctly in single-precision matrix.", row, column);
+                    XCTAssertEqual(computedValue, solution, @"Entry at (%lld, %lld) not multiplied correctly in single-precision matrix.", (long long int)row, (long long int)column);
                 }
             }
         }
@@ -252,15 +252,15 @@ static const MAVIndex columns = 3;
                 for (MAVIndex column = 0; column < matrix.columns; column++) {
                     if ((rowAssignment && row == dimension) || (!rowAssignment && column == dimension)) {
                         if (isDouble) {
-                            XCTAssertEqual(vector[rowAssignment ? column : row].doubleValue, mutatedMatrix[row][column].doubleValue, @"Mutated %@ in double-precision matrix was not set correctly checking (%d, %d)", rowAssignment ? @"row" : @"column", row, column);
+                            XCTAssertEqual(vector[rowAssignment ? column : row].doubleValue, mutatedMatrix[row][column].doubleValue, @"Mutated %@ in double-precision matrix was not set correctly checking (%lld, %lld)", rowAssignment ? @"row" : @"column", (long long int)row, (long long int)column);
                         } else {
-                            XCTAssertEqual(vector[rowAssignment ? column : row].floatValue, mutatedMatrix[row][column].floatValue, @"Mutated %@ in single-precision matrix was not set correctly checking (%d, %d)", rowAssignment ? @"row" : @"column", row, column);
+                            XCTAssertEqual(vector[rowAssignment ? column : row].floatValue, mutatedMatrix[row][column].floatValue, @"Mutated %@ in single-precision matrix was not set correctly checking (%lld, %lld)", rowAssignment ? @"row" : @"column", (long long int)row, (long long int)column);
                         }
                     } else {
                         if (isDouble) {
-                            XCTAssertEqual(matrix[row][column].doubleValue, mutatedMatrix[row][column].doubleValue, @"%@ not mutated in double-precision row was incorrectly changed checking (%d, %d).", rowAssignment ? @"row" : @"column", row, column);
+                            XCTAssertEqual(matrix[row][column].doubleValue, mutatedMatrix[row][column].doubleValue, @"%@ not mutated in double-precision row was incorrectly changed checking (%lld, %lld).", rowAssignment ? @"row" : @"column", (long long int)row, (long long int)column);
                         } else {
-                            XCTAssertEqual(matrix[row][column].floatValue, mutatedMatrix[row][column].floatValue, @"%@ not mutated in single-precision row was incorrectly changed checking (%d, %d).", rowAssignment ? @"row" : @"column", row, column);
+                            XCTAssertEqual(matrix[row][column].floatValue, mutatedMatrix[row][column].floatValue, @"%@ not mutated in single-precision row was incorrectly changed checking (%lld, %lld).", rowAssignment ? @"row" : @"column", (long long int)row, (long long int)column);
                         }
                     }
                 }
@@ -269,6 +269,159 @@ static const MAVIndex columns = 3;
     }
 }
 
+- (void)testMutationsUpdateCachedQRFactorization
+{
+    double values[12] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0 };
+    MAVMutableMatrix *matrix = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:values length:12 * sizeof(double)] rows:4 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    XCTAssertNotNil(matrix.qrFactorization, @"Expected a QR factorization.");
+    
+    [matrix setEntryAtRow:1 column:2 toValue:@9.0];
+    [self assertMatrix:[[matrix.qrFactorization.q mutableCopy] multiplyByMatrix:matrix.qrFactorization.r] equalsMatrix:matrix accuracy:1.0e-10 message:@"QR after assigning a value"];
+    
+    [matrix setRowVector:[MAVVector vectorWithValuesInArray:@[@1.0, @2.0, @3.0] vectorFormat:MAVVectorFormatRowVector] atRow:3];
+    [self assertMatrix:[[matrix.qrFactorization.q mutableCopy] multiplyByMatrix:matrix.qrFactorization.r] equalsMatrix:matrix accuracy:1.0e-10 message:@"QR after assigning a row"];
+    
+    [matrix setColumnVector:[MAVVector vectorWithValuesInArray:@[@-1.0, @0.0, @2.0, @7.0] vectorFormat:MAVVectorFormatColumnVector] atColumn:0];
+    [self assertMatrix:[[matrix.qrFactorization.q mutableCopy] multiplyByMatrix:matrix.qrFactorization.r] equalsMatrix:matrix accuracy:1.0e-10 message:@"QR after assigning a column"];
+    
+    [matrix swapRowA:0 withRowB:2];
+    [self assertMatrix:[[matrix.qrFactorization.q mutableCopy] multiplyByMatrix:matrix.qrFactorization.r] equalsMatrix:matrix accuracy:1.0e-10 message:@"QR after swapping rows"];
+    
+    [matrix swapColumnA:1 withColumnB:2];
+    [self assertMatrix:[[matrix.qrFactorization.q mutableCopy] multiplyByMatrix:matrix.qrFactorization.r] equalsMatrix:matrix accuracy:1.0e-10 message:@"QR after swapping columns"];
+}
+
+- (void)testRowSwapUpdatesCachedLUFactorization
+{
+    double values[9] = { 2.0, 1.0, 1.0,   4.0, -6.0, 0.0,   -2.0, 7.0, 2.0 };
+    MAVMutableMatrix *matrix = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:values length:9 * sizeof(double)] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    double determinant = matrix.determinant.doubleValue;
+    XCTAssertNotNil(matrix.luFactorization, @"Expected an LU factorization.");
+    
+    [matrix swapRowA:0 withRowB:2];
+    
+    MAVLUFactorization *lu = matrix.luFactorization;
+    [self assertMatrix:[[[lu.permutationMatrix mutableCopy] multiplyByMatrix:lu.lowerTriangularMatrix] multiplyByMatrix:lu.upperTriangularMatrix] equalsMatrix:matrix accuracy:1.0e-10 message:@"PLU after swapping rows"];
+    XCTAssertEqualWithAccuracy(matrix.determinant.doubleValue, -determinant, 1.0e-10, @"Swapping rows should negate the determinant.");
+}
+
+- (void)testMutationsUpdateCachedCholeskyFactorization
+{
+    // larger than the closed-form kernels handle, so solving uses the factorization
+    double values[25] = {
+        4.0, 1.0, 0.0, 0.0, 0.0,
+        1.0, 4.0, 1.0, 0.0, 0.0,
+        0.0, 1.0, 4.0, 1.0, 0.0,
+        0.0, 0.0, 1.0, 4.0, 1.0,
+        0.0, 0.0, 0.0, 1.0, 4.0
+    };
+    MAVMutableMatrix *gram = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:values length:25 * sizeof(double)] rows:5 columns:5 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    XCTAssertNotNil(gram.choleskyFactorization, @"Expected a Cholesky factorization.");
+    
+    // slide a window of observations over the Gram matrix: add one and remove another
+    MAVMatrix *added = [MAVMatrix matrixWithRowVectors:@[[MAVVector vectorWithValuesInArray:@[@1.0, @-1.0, @2.0, @0.0, @1.5] vectorFormat:MAVVectorFormatRowVector]]];
+    MAVMatrix *removed = [MAVMatrix matrixWithRowVectors:@[[MAVVector vectorWithValuesInArray:@[@0.5, @0.5, @0.0, @-1.0, @0.0] vectorFormat:MAVVectorFormatRowVector]]];
+    [gram updateWithGramMatrixOfMatrix:added alpha:@1.0 beta:@1.0];
+    [gram updateWithGramMatrixOfMatrix:removed alpha:@-1.0 beta:@1.0];
+    MAVMatrix *l = gram.choleskyFactorization.lowerTriangularMatrix;
+    [self assertMatrix:[[l mutableCopy] multiplyByMatrix:l.transpose] equalsMatrix:gram accuracy:1.0e-10 message:@"LLᵀ after Gram updates"];
+    
+    [gram setEntryAtRow:1 column:1 toValue:@5.0];
+    l = gram.choleskyFactorization.lowerTriangularMatrix;
+    [self assertMatrix:[[l mutableCopy] multiplyByMatrix:l.transpose] equalsMatrix:gram accuracy:1.0e-10 message:@"LLᵀ after assigning a diagonal value"];
+    
+    // solving with the updated factorization gives the same solution as solving from scratch
+    MAVVector *b = [MAVVector vectorWithValuesInArray:@[@1.0, @2.0, @3.0, @4.0, @5.0]];
+    MAVVector *solution = [MAVMatrix solveLinearSystemWithMatrixA:gram valuesB:b];
+    MAVVector *expected = [MAVMatrix solveLinearSystemWithMatrixA:[MAVMatrix matrixWithValues:[gram valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] rows:5 columns:5 leadingDimension:MAVMatrixLeadingDimensionColumn] valuesB:b];
+    for (MAVIndex i = 0; i < 5; i++) {
+        XCTAssertEqualWithAccuracy(solution[i].doubleValue, expected[i].doubleValue, 1.0e-10, @"Solution differs at %d.", (int)i);
+    }
+}
+
+- (void)testScalingTransformsCachedProperties
+{
+    double values[16] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0,   2.0, 0.0, 1.0, 7.0 };
+    MAVMutableMatrix *matrix = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:values length:16 * sizeof(double)] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    XCTAssertNotNil(matrix.determinant, @"Expected a determinant.");
+    XCTAssertNotNil(matrix.inverse, @"Expected an inverse.");
+    XCTAssertNotNil(matrix.adjugate, @"Expected an adjugate.");
+    XCTAssertNotNil(matrix.transpose, @"Expected a transpose.");
+    XCTAssertNotNil(matrix.trace, @"Expected a trace.");
+    XCTAssertNotNil(matrix.normL1, @"Expected an L1 norm.");
+    XCTAssertNotNil(matrix.normInfinity, @"Expected an infinity norm.");
+    XCTAssertNotNil(matrix.normFroebenius, @"Expected a Froebenius norm.");
+    XCTAssertNotNil(matrix.conditionNumber, @"Expected a condition number.");
+    XCTAssertNotNil(matrix.luFactorization, @"Expected an LU factorization.");
+    XCTAssertNotNil(matrix.singularValueDecomposition, @"Expected a singular value decomposition.");
+    
+    [matrix multiplyByScalar:@-2.0];
+    MAVMatrix *expected = [MAVMatrix matrixWithValues:[matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    XCTAssertEqualWithAccuracy(matrix.determinant.doubleValue, expected.determinant.doubleValue, 1.0e-8, @"Determinant after scaling");
+    XCTAssertEqualWithAccuracy(matrix.trace.doubleValue, expected.trace.doubleValue, 1.0e-10, @"Trace after scaling");
+    XCTAssertEqualWithAccuracy(matrix.normL1.doubleValue, expected.normL1.doubleValue, 1.0e-10, @"L1 norm after scaling");
+    XCTAssertEqualWithAccuracy(matrix.normInfinity.doubleValue, expected.normInfinity.doubleValue, 1.0e-10, @"Infinity norm after scaling");
+    XCTAssertEqualWithAccuracy(matrix.normFroebenius.doubleValue, expected.normFroebenius.doubleValue, 1.0e-10, @"Froebenius norm after scaling");
+    XCTAssertEqualWithAccuracy(matrix.conditionNumber.doubleValue, expected.conditionNumber.doubleValue, 1.0e-8, @"Condition number after scaling");
+    [self assertMatrix:matrix.inverse equalsMatrix:expected.inverse accuracy:1.0e-10 message:@"Inverse after scaling"];
+    [self assertMatrix:matrix.adjugate equalsMatrix:expected.adjugate accuracy:1.0e-8 message:@"Adjugate after scaling"];
+    [self assertMatrix:matrix.transpose equalsMatrix:expected.transpose accuracy:1.0e-10 message:@"Transpose after scaling"];
+    
+    MAVLUFactorization *lu = matrix.luFactorization;
+    [self assertMatrix:[[[lu.permutationMatrix mutableCopy] multiplyByMatrix:lu.lowerTriangularMatrix] multiplyByMatrix:lu.upperTriangularMatrix] equalsMatrix:matrix accuracy:1.0e-10 message:@"PLU after scaling"];
+    
+    MAVSingularValueDecomposition *svd = matrix.singularValueDecomposition;
+    [self assertMatrix:[[[svd.u mutableCopy] multiplyByMatrix:svd.s] multiplyByMatrix:svd.vT] equalsMatrix:matrix accuracy:1.0e-10 message:@"UΣVᵀ after scaling"];
+    for (MAVIndex i = 0; i < 4; i += 1) {
+        XCTAssertGreaterThanOrEqual([svd.s valueAtRow:i column:i].doubleValue, 0.0, @"Singular values must stay nonnegative.");
+    }
+}
+
+- (void)testScalingTransformsCachedSymmetricProperties
+{
+    double values[9] = { 4.0, 1.0, 0.0,   1.0, 3.0, 1.0,   0.0, 1.0, 2.0 };
+    MAVMutableMatrix *matrix = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:values length:9 * sizeof(double)] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    XCTAssertEqual(matrix.definiteness, MAVMatrixDefinitenessPositiveDefinite, @"Expected a positive definite matrix.");
+    XCTAssertNotNil(matrix.choleskyFactorization, @"Expected a Cholesky factorization.");
+    XCTAssertNotNil(matrix.eigendecomposition, @"Expected an eigendecomposition.");
+    
+    [matrix multiplyByScalar:@3.0];
+    MAVMatrix *l = matrix.choleskyFactorization.lowerTriangularMatrix;
+    [self assertMatrix:[[l mutableCopy] multiplyByMatrix:l.transpose] equalsMatrix:matrix accuracy:1.0e-10 message:@"LLᵀ after positive scaling"];
+    XCTAssertEqual(matrix.definiteness, MAVMatrixDefinitenessPositiveDefinite, @"Positive scaling preserves definiteness.");
+    
+    [matrix multiplyByScalar:@-0.5];
+    MAVMatrix *expected = [MAVMatrix matrixWithValues:[matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    XCTAssertEqual(matrix.definiteness, MAVMatrixDefinitenessNegativeDefinite, @"Negative scaling flips definiteness.");
+    for (MAVIndex i = 0; i < 3; i += 1) {
+        XCTAssertEqualWithAccuracy([matrix.eigendecomposition.eigenvalues valueAtIndex:i].doubleValue, [expected.eigendecomposition.eigenvalues valueAtIndex:i].doubleValue, 1.0e-10, @"Eigenvalues after negative scaling should stay in ascending order.");
+    }
+}
+
+- (void)testSwapsTransformCachedProperties
+{
+    double values[16] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0,   2.0, 0.0, 1.0, 7.0 };
+    MAVMutableMatrix *matrix = [MAVMutableMatrix matrixWithValues:[NSData dataWithBytes:values length:16 * sizeof(double)] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    NSNumber *normL1 = matrix.normL1;
+    XCTAssertNotNil(matrix.determinant, @"Expected a determinant.");
+    XCTAssertNotNil(matrix.inverse, @"Expected an inverse.");
+    XCTAssertNotNil(matrix.transpose, @"Expected a transpose.");
+    XCTAssertNotNil(matrix.singularValueDecomposition, @"Expected a singular value decomposition.");
+    
+    [matrix swapRowA:0 withRowB:3];
+    [matrix swapColumnA:1 withColumnB:2];
+    MAVMatrix *expected = [MAVMatrix matrixWithValues:[matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionColumn] rows:4 columns:4 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    XCTAssertEqualWithAccuracy(matrix.determinant.doubleValue, expected.determinant.doubleValue, 1.0e-8, @"Determinant after swaps");
+    XCTAssertEqualWithAccuracy(matrix.normL1.doubleValue, normL1.doubleValue, 1.0e-10, @"L1 norm after swaps");
+    [self assertMatrix:matrix.inverse equalsMatrix:expected.inverse accuracy:1.0e-10 message:@"Inverse after swaps"];
+    [self assertMatrix:matrix.transpose equalsMatrix:expected.transpose accuracy:1.0e-10 message:@"Transpose after swaps"];
+    
+    MAVSingularValueDecomposition *svd = matrix.singularValueDecomposition;
+    [self assertMatrix:[[[svd.u mutableCopy] multiplyByMatrix:svd.s] multiplyByMatrix:svd.vT] equalsMatrix:matrix accuracy:1.0e-10 message:@"UΣVᵀ after swaps"];
+}
+
 - (MAVMutableMatrix *)matrixOfRepresentationType:(MAVMatrixInternalRepresentation)representation withPrecision:(MCKPrecision)precision
 {
     MAVMutableMatrix *matrix;
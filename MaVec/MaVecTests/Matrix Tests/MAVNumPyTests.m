@@ -0,0 +1,218 @@
+//
+//  MAVNumPyTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVNumPyTests : XCTestCase
+
+@end
+
+static const MAVIndex kMAVBenchmarkOrder = 1024;
+
+@implementation MAVNumPyTests
+
+- (NSURL *)fileURLWithBytes:(const void *)bytes length:(size_t)length extension:(NSString *)extension
+{
+    NSURL *url = [self temporaryFileURLWithExtension:extension];
+    [[NSData dataWithBytes:bytes length:length] writeToURL:url atomically:YES];
+    return url;
+}
+
+/**
+ @return The bytes of a version 1.0 .npy file with the specified header dictionary, padded as NumPy pads it, followed by the specified values.
+ */
+- (NSData *)numPyFileWithDictionary:(NSString *)dictionary values:(const void *)values length:(size_t)length
+{
+    NSMutableData *file = [NSMutableData dataWithBytes:"\x93NUMPY\x01\x00" length:8];
+    NSMutableString *header = dictionary.mutableCopy;
+    while ((10 + header.length + 1) % 64 != 0) {
+        [header appendString:@" "];
+    }
+    [header appendString:@"\n"];
+    uint16_t headerLength = CFSwapInt16HostToLittle((uint16_t)header.length);
+    [file appendBytes:&headerLength length:2];
+    [file appendData:[header dataUsingEncoding:NSASCIIStringEncoding]];
+    [file appendBytes:values length:length];
+    return file;
+}
+
+- (MAVMatrix *)matrixFromNumPyFile:(NSData *)file error:(NSError **)error
+{
+    NSURL *url = [self fileURLWithBytes:file.bytes length:file.length extension:@"npy"];
+    MAVMatrix *matrix = [MAVMatrix matrixWithContentsOfNumPyURL:url error:error];
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    return matrix;
+}
+
+- (void)testRoundTripPreservesMatrix
+{
+    NSArray *matrices = @[[MAVMatrix randomMatrixWithRows:5 columns:3 precision:MCKPrecisionDouble],
+                          [MAVMatrix matrixWithValues:[MAVMatrix randomMatrixWithRows:4 columns:6 precision:MCKPrecisionSingle].values rows:4 columns:6 leadingDimension:MAVMatrixLeadingDimensionRow],
+                          [MAVMatrix randomSymmetricMatrixOfOrder:6 precision:MCKPrecisionDouble],
+                          [MAVMatrix randomBandMatrixOfOrder:7 upperCodiagonals:2 lowerCodiagonals:1 precision:MCKPrecisionSingle]];
+    
+    for (MAVMatrix *matrix in matrices) {
+        NSURL *url = [self temporaryFileURLWithExtension:@"npy"];
+        NSError *error;
+        XCTAssertTrue([matrix writeNumPyToURL:url error:&error], @"Writing .npy file failed: %@", error);
+        MAVMatrix *read = [MAVMatrix matrixWithContentsOfNumPyURL:url error:&error];
+        XCTAssertNotNil(read, @"Reading .npy file failed: %@", error);
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        
+        XCTAssertEqual(read.precision, matrix.precision, @"Precision not preserved.");
+        XCTAssertEqual(read.packingMethod, MAVMatrixValuePackingMethodConventional, @"NumPy arrays should be read into conventional storage.");
+        XCTAssertEqualObjects(read, matrix, @"Matrix read from .npy file is not equal to the matrix written.");
+    }
+}
+
+- (void)testOrderMapsToLeadingDimension
+{
+    double values[6] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    NSError *error;
+    
+    MAVMatrix *cOrder = [self matrixFromNumPyFile:[self numPyFileWithDictionary:@"{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }" values:values length:sizeof(values)] error:&error];
+    XCTAssertNotNil(cOrder, @"Reading C-ordered array failed: %@", error);
+    XCTAssertEqual(cOrder.leadingDimension, MAVMatrixLeadingDimensionRow, @"C-ordered arrays should be row-major.");
+    XCTAssertEqual(cOrder.rows, 2, @"Rows incorrect.");
+    XCTAssertEqual(cOrder.columns, 3, @"Columns incorrect.");
+    XCTAssertEqual([cOrder valueAtRow:1 column:0].doubleValue, 4.0, @"C-ordered values read in the wrong order.");
+    
+    MAVMatrix *fortranOrder = [self matrixFromNumPyFile:[self numPyFileWithDictionary:@"{\"descr\": \"<f8\", \"fortran_order\": True, \"shape\": (2, 3)}" values:values length:sizeof(values)] error:&error];
+    XCTAssertNotNil(fortranOrder, @"Reading Fortran-ordered array failed: %@", error);
+    XCTAssertEqual(fortranOrder.leadingDimension, MAVMatrixLeadingDimensionColumn, @"Fortran-ordered arrays should be column-major.");
+    XCTAssertEqual([fortranOrder valueAtRow:1 column:0].doubleValue, 2.0, @"Fortran-ordered values read in the wrong order.");
+}
+
+- (void)testBigEndianAndOneDimensionalArrays
+{
+    uint32_t values[3];
+    float expected[3] = { 1.5f, -2.0f, 1e-3f };
+    for (int i = 0; i < 3; i++) {
+        uint32_t bits;
+        memcpy(&bits, &expected[i], sizeof(bits));
+        values[i] = CFSwapInt32HostToBig(bits);
+    }
+    NSError *error;
+    MAVMatrix *matrix = [self matrixFromNumPyFile:[self numPyFileWithDictionary:@"{'descr': '>f4', 'fortran_order': False, 'shape': (3,), }" values:values length:sizeof(values)] error:&error];
+    
+    XCTAssertNotNil(matrix, @"Reading big-endian array failed: %@", error);
+    XCTAssertEqual(matrix.precision, MCKPrecisionSingle, @"f4 arrays should be single precision.");
+    XCTAssertEqual(matrix.rows, 3, @"One-dimensional arrays should become a column.");
+    XCTAssertEqual(matrix.columns, 1, @"One-dimensional arrays should become a column.");
+    for (MAVIndex i = 0; i < 3; i++) {
+        XCTAssertEqual([matrix valueAtRow:i column:0].floatValue, expected[i], @"Big-endian value %lld not swapped.", (long long int)i);
+    }
+}
+
+- (void)testUnsupportedArraysAreRejected
+{
+    int64_t values[4] = { 1, 2, 3, 4 };
+    NSError *error;
+    
+    XCTAssertNil([self matrixFromNumPyFile:[self numPyFileWithDictionary:@"{'descr': '<i8', 'fortran_order': False, 'shape': (2, 2), }" values:values length:sizeof(values)] error:&error], @"Integer arrays should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorUnsupportedType, @"Integer arrays should be reported as unsupported.");
+    
+    XCTAssertNil([self matrixFromNumPyFile:[self numPyFileWithDictionary:@"{'descr': '<f8', 'fortran_order': False, 'shape': (1, 2, 2), }" values:values length:sizeof(values)] error:&error], @"Three-dimensional arrays should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorUnsupportedType, @"Three-dimensional arrays should be reported as unsupported.");
+    
+    XCTAssertNil([self matrixFromNumPyFile:[self numPyFileWithDictionary:@"{'descr': '<f8', 'fortran_order': False, 'shape': (3, 2), }" values:values length:sizeof(values)] error:&error], @"Arrays missing values should not be read.");
+    XCTAssertEqual(error.code, MAVMatrixFileErrorTruncated, @"Arrays missing values should be reported as truncated.");
+}
+
+- (void)testArchiveRoundTrip
+{
+    NSDictionary *matrices = @{ @"weights": [MAVMatrix randomMatrixWithRows:3 columns:4 precision:MCKPrecisionDouble],
+                                @"bias": [MAVMatrix randomMatrixWithRows:3 columns:1 precision:MCKPrecisionSingle],
+                                @"covariance": [MAVMatrix randomSymmetricMatrixOfOrder:5 precision:MCKPrecisionDouble] };
+    NSURL *url = [self temporaryFileURLWithExtension:@"npz"];
+    NSError *error;
+    
+    XCTAssertTrue([MAVMatrix writeMatrices:matrices toNumPyArchiveURL:url error:&error], @"Writing .npz archive failed: %@", error);
+    NSDictionary *read = [MAVMatrix matricesWithContentsOfNumPyArchiveURL:url error:&error];
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    
+    XCTAssertNotNil(read, @"Reading .npz archive failed: %@", error);
+    XCTAssertEqualObjects([NSSet setWithArray:read.allKeys], [NSSet setWithArray:matrices.allKeys], @"Array names not preserved.");
+    for (NSString *name in matrices) {
+        XCTAssertEqualObjects(read[name], matrices[name], @"Matrix %@ not preserved.", name);
+    }
+}
+
+- (void)testCompressedArchive
+{
+    // numpy.savez_compressed of a 2x2 big-endian float32 Fortran-ordered array [[1, 3], [2, 4]] named weights
+    const uint8_t archive[201] = {
+        0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x4d, 0x4b, 0x53, 0x5d, 0xb8, 0x88,
+        0x88, 0x40, 0x51, 0x00, 0x00, 0x00, 0x90, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x77, 0x65,
+        0x69, 0x67, 0x68, 0x74, 0x73, 0x2e, 0x6e, 0x70, 0x79, 0x9b, 0xec, 0x17, 0xea, 0x1b, 0x10, 0xc9,
+        0xc8, 0x50, 0xc6, 0x50, 0xad, 0x9e, 0x92, 0x5a, 0x9c, 0x5c, 0xa4, 0x6e, 0xa5, 0xa0, 0x6e, 0x97,
+        0x66, 0xa2, 0xae, 0xa3, 0xa0, 0x9e, 0x96, 0x5f, 0x54, 0x52, 0x94, 0x98, 0x17, 0x9f, 0x5f, 0x94,
+        0x92, 0x0a, 0x12, 0x0f, 0x29, 0x2a, 0x4d, 0x05, 0x0a, 0x17, 0x67, 0x24, 0x16, 0xa4, 0x02, 0xb9,
+        0x1a, 0x46, 0x3a, 0x0a, 0x46, 0x9a, 0x3a, 0x0a, 0xb5, 0x0a, 0xe4, 0x03, 0x2e, 0xfb, 0x06, 0x06,
+        0x06, 0x07, 0x06, 0x20, 0x06, 0x12, 0x0e, 0x40, 0x36, 0x00, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03,
+        0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x4d, 0x4b, 0x53, 0x5d, 0xb8, 0x88, 0x88, 0x40, 0x51, 0x00,
+        0x00, 0x00, 0x90, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x77, 0x65, 0x69, 0x67, 0x68, 0x74, 0x73, 0x2e,
+        0x6e, 0x70, 0x79, 0x50, 0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x39,
+        0x00, 0x00, 0x00, 0x7a, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    NSURL *url = [self fileURLWithBytes:archive length:sizeof(archive) extension:@"npz"];
+    NSError *error;
+    NSDictionary *matrices = [MAVMatrix matricesWithContentsOfNumPyArchiveURL:url error:&error];
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    
+    XCTAssertNotNil(matrices, @"Reading compressed archive failed: %@", error);
+    MAVMatrix *weights = matrices[@"weights"];
+    XCTAssertEqual(weights.precision, MCKPrecisionSingle, @"f4 arrays should be single precision.");
+    XCTAssertEqual(weights.leadingDimension, MAVMatrixLeadingDimensionColumn, @"Fortran-ordered arrays should be column-major.");
+    float expected[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    XCTAssertEqualObjects(weights.values, [NSData dataWithBytes:expected length:sizeof(expected)], @"Compressed values not inflated correctly.");
+}
+
+#pragma mark - Benchmarks
+
+- (void)testThroughputOfNumPyFiles
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:kMAVBenchmarkOrder columns:kMAVBenchmarkOrder precision:MCKPrecisionDouble];
+    NSURL *url = [self temporaryFileURLWithExtension:@"npy"];
+    double megabytes = matrix.values.length / 1e6;
+    
+    NSDate *start = [NSDate date];
+    XCTAssertTrue([matrix writeNumPyToURL:url error:nil], @"Writing .npy file failed.");
+    NSTimeInterval writeTime = -start.timeIntervalSinceNow;
+    
+    start = [NSDate date];
+    MAVMatrix *read = [MAVMatrix matrixWithContentsOfNumPyURL:url error:nil];
+    // touch every page so the mapping is actually read
+    XCTAssertEqualObjects(read.values, matrix.values, @"Values not preserved.");
+    NSTimeInterval readTime = -start.timeIntervalSinceNow;
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    
+    NSLog(@".npy write: %.1f MB/s, read: %.1f MB/s", megabytes / writeTime, megabytes / readTime);
+}
+
+@end
@@ -94,4 +94,135 @@
     }
 }
 
+#pragma mark - Updates
+
+- (void)testRankOneUpdate
+{
+    double aValues[12] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0 };
+    double uValues[4] = { 1.0, -1.0, 2.0, 0.5 };
+    double vValues[3] = { -2.0, 0.5, 1.0 };
+    double expectedValues[12];
+    for (int j = 0; j < 3; j += 1) {
+        for (int i = 0; i < 4; i += 1) {
+            expectedValues[j * 4 + i] = aValues[j * 4 + i] + uValues[i] * vValues[j];
+        }
+    }
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:12 * sizeof(double)] rows:4 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    MAVMatrix *expected = [MAVMatrix matrixWithValues:[NSData dataWithBytes:expectedValues length:12 * sizeof(double)] rows:4 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    MAVQRFactorization *updated = [a.qrFactorization factorizationUpdatedWithColumnVector:[MAVVector vectorWithValues:[NSData dataWithBytes:uValues length:4 * sizeof(double)] length:4]
+                                                                                rowVector:[MAVVector vectorWithValues:[NSData dataWithBytes:vValues length:3 * sizeof(double)] length:3]];
+    
+    [self assertFactorization:updated reproducesMatrix:expected accuracy:1.0e-10];
+}
+
+- (void)testRankOneUpdateInSinglePrecision
+{
+    float aValues[9] = { 2.0f, 1.0f, 0.0f,   1.0f, 3.0f, 1.0f,   0.0f, 1.0f, 4.0f };
+    float uValues[3] = { 0.0f, 1.0f, 0.0f };
+    float vValues[3] = { 0.0f, 0.0f, 2.5f };
+    float expectedValues[9] = { 2.0f, 1.0f, 0.0f,   1.0f, 3.0f, 1.0f,   0.0f, 3.5f, 4.0f };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:9 * sizeof(float)] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    MAVMatrix *expected = [MAVMatrix matrixWithValues:[NSData dataWithBytes:expectedValues length:9 * sizeof(float)] rows:3 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    MAVQRFactorization *updated = [a.qrFactorization factorizationUpdatedWithColumnVector:[MAVVector vectorWithValues:[NSData dataWithBytes:uValues length:3 * sizeof(float)] length:3]
+                                                                                rowVector:[MAVVector vectorWithValues:[NSData dataWithBytes:vValues length:3 * sizeof(float)] length:3]];
+    
+    [self assertFactorization:updated reproducesMatrix:expected accuracy:1.0e-5];
+}
+
+- (void)testInsertingAndRemovingRows
+{
+    double aValues[12] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0 };
+    double rowValues[3] = { 7.0, -1.0, 2.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:12 * sizeof(double)] rows:4 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    MAVVector *row = [MAVVector vectorWithValues:[NSData dataWithBytes:rowValues length:3 * sizeof(double)] length:3 vectorFormat:MAVVectorFormatRowVector];
+    
+    NSMutableArray *rows = [NSMutableArray array];
+    for (MAVIndex i = 0; i < a.rows; i += 1) {
+        [rows addObject:[a rowVectorForRow:i]];
+    }
+    
+    for (MAVIndex index = 0; index <= a.rows; index += 1) {
+        NSMutableArray *insertedRows = [rows mutableCopy];
+        [insertedRows insertObject:row atIndex:index];
+        MAVQRFactorization *inserted = [a.qrFactorization factorizationByInsertingRowVector:row atRow:index];
+        [self assertFactorization:inserted reproducesMatrix:[MAVMatrix matrixWithRowVectors:insertedRows] accuracy:1.0e-10];
+        
+        // removing the inserted row again recovers a factorization of the original matrix
+        [self assertFactorization:[inserted factorizationByRemovingRow:index] reproducesMatrix:a accuracy:1.0e-10];
+    }
+    
+    for (MAVIndex index = 0; index < a.rows; index += 1) {
+        NSMutableArray *remainingRows = [rows mutableCopy];
+        [remainingRows removeObjectAtIndex:index];
+        MAVQRFactorization *removed = [a.qrFactorization factorizationByRemovingRow:index];
+        [self assertFactorization:removed reproducesMatrix:[MAVMatrix matrixWithRowVectors:remainingRows] accuracy:1.0e-10];
+    }
+}
+
+- (void)testInsertingAndRemovingColumns
+{
+    double aValues[12] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0 };
+    double columnValues[4] = { -1.0, 2.0, 0.5, 3.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:12 * sizeof(double)] rows:4 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    MAVVector *column = [MAVVector vectorWithValues:[NSData dataWithBytes:columnValues length:4 * sizeof(double)] length:4];
+    
+    NSMutableArray *columns = [NSMutableArray array];
+    for (MAVIndex j = 0; j < a.columns; j += 1) {
+        [columns addObject:[a columnVectorForColumn:j]];
+    }
+    
+    for (MAVIndex index = 0; index <= a.columns; index += 1) {
+        NSMutableArray *insertedColumns = [columns mutableCopy];
+        [insertedColumns insertObject:column atIndex:index];
+        MAVQRFactorization *inserted = [a.qrFactorization factorizationByInsertingColumnVector:column atColumn:index];
+        [self assertFactorization:inserted reproducesMatrix:[MAVMatrix matrixWithColumnVectors:insertedColumns] accuracy:1.0e-10];
+    }
+    
+    for (MAVIndex index = 0; index < a.columns; index += 1) {
+        NSMutableArray *remainingColumns = [columns mutableCopy];
+        [remainingColumns removeObjectAtIndex:index];
+        MAVQRFactorization *removed = [a.qrFactorization factorizationByRemovingColumn:index];
+        [self assertFactorization:removed reproducesMatrix:[MAVMatrix matrixWithColumnVectors:remainingColumns] accuracy:1.0e-10];
+    }
+}
+
+- (void)testSwappingRowsAndColumns
+{
+    double aValues[12] = { 4.0, -2.0, 1.0, 3.0,   1.0, 5.0, -3.0, 2.0,   0.5, 1.0, 6.0, -1.0 };
+    MAVMatrix *a = [MAVMatrix matrixWithValues:[NSData dataWithBytes:aValues length:12 * sizeof(double)] rows:4 columns:3 leadingDimension:MAVMatrixLeadingDimensionColumn];
+    
+    MAVMutableMatrix *rowsSwapped = [a mutableCopy];
+    [rowsSwapped swapRowA:0 withRowB:3];
+    [self assertFactorization:[a.qrFactorization factorizationBySwappingRowA:0 withRowB:3] reproducesMatrix:rowsSwapped accuracy:1.0e-10];
+    
+    MAVMutableMatrix *columnsSwapped = [a mutableCopy];
+    [columnsSwapped swapColumnA:0 withColumnB:2];
+    [self assertFactorization:[a.qrFactorization factorizationBySwappingColumnA:0 withColumnB:2] reproducesMatrix:columnsSwapped accuracy:1.0e-10];
+}
+
+#pragma mark - Helpers
+
+- (void)assertFactorization:(MAVQRFactorization *)factorization reproducesMatrix:(MAVMatrix *)matrix accuracy:(double)accuracy
+{
+    XCTAssertEqual(factorization.q.rows, matrix.rows, @"Q has the wrong order.");
+    XCTAssertEqual(factorization.r.rows, matrix.rows, @"R has the wrong amount of rows.");
+    XCTAssertEqual(factorization.r.columns, matrix.columns, @"R has the wrong amount of columns.");
+    
+    MAVMatrix *product = [[factorization.q mutableCopy] multiplyByMatrix:factorization.r];
+    MAVMatrix *orthogonality = [[factorization.q.transpose mutableCopy] multiplyByMatrix:factorization.q];
+    for (MAVIndex row = 0; row < matrix.rows; row += 1) {
+        for (MAVIndex column = 0; column < matrix.columns; column += 1) {
+            XCTAssertEqualWithAccuracy([product valueAtRow:row column:column].doubleValue, [matrix valueAtRow:row column:column].doubleValue, accuracy, @"QR differs from the matrix at (%d, %d).", (int)row, (int)column);
+            if (row > column) {
+                XCTAssertEqualWithAccuracy([factorization.r valueAtRow:row column:column].doubleValue, 0.0, accuracy, @"R is not upper triangular at (%d, %d).", (int)row, (int)column);
+            }
+        }
+        for (MAVIndex column = 0; column < matrix.rows; column += 1) {
+            XCTAssertEqualWithAccuracy([orthogonality valueAtRow:row column:column].doubleValue, row == column ? 1.0 : 0.0, accuracy, @"Q is not orthogonal at (%d, %d).", (int)row, (int)column);
+        }
+    }
+}
+
 @end
@@ -0,0 +1,158 @@
+//
+//  MAVTiledMatrixTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVTiledMatrixTests : XCTestCase
+
+@end
+
+
+@implementation MAVTiledMatrixTests
+
+- (void)testConversionRoundTrip
+{
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:7 columns:5 precision:MCKPrecisionDouble];
+    NSURL *url = [self temporaryFileURLWithExtension:@"tiles"];
+    NSError *error;
+    
+    MAVTiledMatrix *tiledMatrix = [MAVTiledMatrix tiledMatrixWithMatrix:matrix URL:url tileOrder:3 memoryBudget:2 * 9 * sizeof(double) error:&error];
+    XCTAssertNotNil(tiledMatrix, @"Creating a tiled matrix failed: %@", error);
+    XCTAssertEqual(tiledMatrix.tileRows, 3, @"Wrong amount of tile rows.");
+    XCTAssertEqual(tiledMatrix.tileColumns, 2, @"Wrong amount of tile columns.");
+    XCTAssertEqualObjects([tiledMatrix matrix], matrix, @"Tiled matrix values incorrect.");
+    
+    MAVMatrix *edgeTile = [tiledMatrix tileAtRow:2 column:1];
+    XCTAssertEqual(edgeTile.rows, 1, @"Edge tiles should be trimmed to the matrix.");
+    XCTAssertEqual(edgeTile.columns, 2, @"Edge tiles should be trimmed to the matrix.");
+    XCTAssertEqualObjects([edgeTile valueAtRow:0 column:1], [matrix valueAtRow:6 column:4], @"Edge tile values incorrect.");
+    
+    MAVTiledMatrix *reopened = [MAVTiledMatrix tiledMatrixWithContentsOfURL:url memoryBudget:1024 error:&error];
+    XCTAssertNotNil(reopened, @"Reopening a tile file failed: %@", error);
+    XCTAssertEqualObjects([reopened matrix], matrix, @"Reopened tiled matrix values incorrect.");
+    XCTAssertEqual(reopened.bytesRead, (uint64_t)(6 * 9 * sizeof(double)), @"Every tile should be read exactly once.");
+    
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+}
+
+- (void)testSetTileIsWrittenBack
+{
+    NSURL *url = [self temporaryFileURLWithExtension:@"tiles"];
+    NSError *error;
+    MAVTiledMatrix *tiledMatrix = [MAVTiledMatrix tiledMatrixWithURL:url rows:5 columns:5 tileOrder:4 precision:MCKPrecisionSingle memoryBudget:0 error:&error];
+    XCTAssertNotNil(tiledMatrix, @"Creating a tiled matrix failed: %@", error);
+    
+    MAVMatrix *tile = [MAVMatrix randomMatrixWithRows:1 columns:4 precision:MCKPrecisionSingle];
+    [tiledMatrix setTile:tile atRow:1 column:0];
+    XCTAssertEqual(tiledMatrix.bytesWritten, (uint64_t)(16 * sizeof(float)), @"Tiles should be written back when evicted from an empty budget.");
+    XCTAssertEqualObjects([tiledMatrix tileAtRow:1 column:0], tile, @"Tile values incorrect.");
+    XCTAssertTrue([tiledMatrix tileAtRow:0 column:0].isZero.isYes, @"Unwritten tiles should be zero.");
+    
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+}
+
+- (void)testProductAndTranspose
+{
+    MCKPrecision precisions[2] = { MCKPrecisionSingle, MCKPrecisionDouble };
+    for (int i = 0; i < 2; i++) {
+        MCKPrecision precision = precisions[i];
+        double accuracy = precision == MCKPrecisionDouble ? 1e-10 : 1e-4;
+        size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+        MAVMatrix *a = [MAVMatrix randomMatrixWithRows:10 columns:7 precision:precision];
+        MAVMatrix *b = [MAVMatrix randomMatrixWithRows:7 columns:9 precision:precision];
+        NSArray *urls = @[[self temporaryFileURLWithExtension:@"tiles"], [self temporaryFileURLWithExtension:@"tiles"], [self temporaryFileURLWithExtension:@"tiles"], [self temporaryFileURLWithExtension:@"tiles"]];
+        NSError *error;
+        
+        // room for only three tiles forces tiles to be evicted and read again
+        size_t budget = 3 * 16 * valueSize;
+        MAVTiledMatrix *tiledA = [MAVTiledMatrix tiledMatrixWithMatrix:a URL:urls[0] tileOrder:4 memoryBudget:budget error:&error];
+        MAVTiledMatrix *tiledB = [MAVTiledMatrix tiledMatrixWithMatrix:b URL:urls[1] tileOrder:4 memoryBudget:budget error:&error];
+        
+        MAVTiledMatrix *product = [tiledA productWithTiledMatrix:tiledB URL:urls[2] error:&error];
+        XCTAssertNotNil(product, @"Tiled multiplication failed: %@", error);
+        [self assertMatrix:[product matrix] equalsMatrix:[MAVMatrix productOfMatrices:@[a, b]] accuracy:accuracy message:@"Tiled product"];
+        XCTAssertGreaterThan(tiledA.bytesRead, (uint64_t)0, @"Evicted tiles should be read from the file.");
+        XCTAssertGreaterThan(product.bytesWritten, (uint64_t)0, @"Product tiles should be written to the file.");
+        
+        MAVTiledMatrix *transpose = [tiledA transposeWithURL:urls[3] error:&error];
+        XCTAssertNotNil(transpose, @"Tiled transpose failed: %@", error);
+        XCTAssertEqualObjects([transpose matrix], a.transpose, @"Tiled transpose incorrect.");
+        
+        for (NSURL *url in urls) {
+            [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        }
+    }
+}
+
+- (void)testCholeskyFactor
+{
+    MCKPrecision precisions[2] = { MCKPrecisionSingle, MCKPrecisionDouble };
+    for (int i = 0; i < 2; i++) {
+        MCKPrecision precision = precisions[i];
+        double accuracy = precision == MCKPrecisionDouble ? 1e-9 : 1e-3;
+        size_t valueSize = precision == MCKPrecisionDouble ? sizeof(double) : sizeof(float);
+        MAVMatrix *m = [MAVMatrix randomNonsigularMatrixOfOrder:10 precision:precision];
+        MAVMatrix *a = [MAVMatrix productOfMatrices:@[m, m.transpose]];
+        NSURL *url = [self temporaryFileURLWithExtension:@"tiles"];
+        NSURL *factorURL = [self temporaryFileURLWithExtension:@"tiles"];
+        NSError *error;
+        
+        MAVTiledMatrix *tiledA = [MAVTiledMatrix tiledMatrixWithMatrix:a URL:url tileOrder:4 memoryBudget:4 * 16 * valueSize error:&error];
+        MAVTiledMatrix *factor = [tiledA choleskyFactorWithURL:factorURL error:&error];
+        XCTAssertNotNil(factor, @"Tiled Cholesky factorization failed: %@", error);
+        
+        MAVMatrix *l = [factor matrix];
+        for (MAVIndex column = 1; column < l.columns; column++) {
+            for (MAVIndex row = 0; row < column; row++) {
+                XCTAssertEqual([l valueAtRow:row column:column].doubleValue, 0.0, @"The Cholesky factor should be lower triangular.");
+            }
+        }
+        [self assertMatrix:[MAVMatrix productOfMatrices:@[l, l.transpose]] equalsMatrix:a accuracy:accuracy message:@"LLᵀ"];
+        
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        [[NSFileManager defaultManager] removeItemAtURL:factorURL error:nil];
+    }
+}
+
+- (void)testCholeskyFactorRejectsIndefiniteMatrices
+{
+    double values[4] = { 1.0, 2.0, 2.0, 1.0 };
+    MAVMatrix *matrix = [MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:sizeof(values)] rows:2 columns:2];
+    NSURL *url = [self temporaryFileURLWithExtension:@"tiles"];
+    NSURL *factorURL = [self temporaryFileURLWithExtension:@"tiles"];
+    NSError *error;
+    
+    MAVTiledMatrix *tiledMatrix = [MAVTiledMatrix tiledMatrixWithMatrix:matrix URL:url tileOrder:1 memoryBudget:1024 error:&error];
+    XCTAssertNil([tiledMatrix choleskyFactorWithURL:factorURL error:&error], @"Indefinite matrices have no Cholesky factor.");
+    XCTAssertEqualObjects(error.domain, MAVTiledMatrixErrorDomain, @"Wrong error domain.");
+    XCTAssertEqual(error.code, MAVTiledMatrixErrorNotPositiveDefinite, @"Wrong error code.");
+    
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    [[NSFileManager defaultManager] removeItemAtURL:factorURL error:nil];
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  MAVCovarianceAccumulatorTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVCovarianceAccumulatorTests : XCTestCase
+
+@end
+
+
+@implementation MAVCovarianceAccumulatorTests
+
+// the covariance of the rows of samples computed directly from its definition
+- (MAVMatrix *)expectedCovarianceOfSamples:(MAVMatrix *)samples
+{
+    MAVMutableMatrix *covariance = [MAVMutableMatrix matrixWithRows:samples.columns columns:samples.columns precision:MCKPrecisionDouble];
+    for (MAVIndex i = 0; i < samples.columns; i++) {
+        for (MAVIndex j = 0; j < samples.columns; j++) {
+            double meanI = 0.0, meanJ = 0.0;
+            for (MAVIndex row = 0; row < samples.rows; row++) {
+                meanI += [samples valueAtRow:row column:i].doubleValue / samples.rows;
+                meanJ += [samples valueAtRow:row column:j].doubleValue / samples.rows;
+            }
+            double sum = 0.0;
+            for (MAVIndex row = 0; row < samples.rows; row++) {
+                sum += ([samples valueAtRow:row column:i].doubleValue - meanI) * ([samples valueAtRow:row column:j].doubleValue - meanJ);
+            }
+            [covariance setEntryAtRow:i column:j toValue:@(sum / (samples.rows - 1))];
+        }
+    }
+    return covariance;
+}
+
+- (void)testSamplesBlocksAndMergingAgree
+{
+    MAVMatrix *samples = [MAVMatrix randomMatrixWithRows:40 columns:5 precision:MCKPrecisionDouble];
+    MAVMatrix *expected = [self expectedCovarianceOfSamples:samples];
+    
+    MAVCovarianceAccumulator *bySample = [MAVCovarianceAccumulator accumulatorWithDimension:5 precision:MCKPrecisionDouble];
+    for (MAVIndex row = 0; row < samples.rows; row++) {
+        [bySample addSample:[samples rowVectorForRow:row]];
+    }
+    XCTAssertEqual(bySample.count, (uint64_t)40, @"Wrong amount of samples.");
+    [self assertMatrix:[bySample covarianceMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional] equalsMatrix:expected accuracy:1e-12 message:@"Rank-1 updates"];
+    
+    MAVCovarianceAccumulator *byBlock = [MAVCovarianceAccumulator accumulatorWithDimension:5 precision:MCKPrecisionDouble];
+    MAVCovarianceAccumulator *secondHalf = [MAVCovarianceAccumulator accumulatorWithDimension:5 precision:MCKPrecisionDouble];
+    double *values = (double *)[samples valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow].bytes;
+    [byBlock addSamples:[MAVMatrix matrixWithValues:[NSData dataWithBytes:values length:13 * 5 * sizeof(double)] rows:13 columns:5 leadingDimension:MAVMatrixLeadingDimensionRow]];
+    [secondHalf addSamples:[MAVMatrix matrixWithValues:[NSData dataWithBytes:values + 13 * 5 length:27 * 5 * sizeof(double)] rows:27 columns:5 leadingDimension:MAVMatrixLeadingDimensionRow]];
+    [byBlock addAccumulator:secondHalf];
+    
+    MAVMatrix *covariance = [byBlock covarianceMatrixWithPackingMethod:MAVMatrixValuePackingMethodPacked];
+    XCTAssertEqual(covariance.packingMethod, MAVMatrixValuePackingMethodPacked, @"The covariance should be packed.");
+    XCTAssertTrue(covariance.isSymmetric.isYes, @"The covariance should be flagged symmetric.");
+    [self assertMatrix:covariance equalsMatrix:expected accuracy:1e-12 message:@"Rank-k updates"];
+    XCTAssertEqualWithAccuracy([byBlock.mean valueAtIndex:3].doubleValue, [bySample.mean valueAtIndex:3].doubleValue, 1e-14, @"Means should agree.");
+}
+
+- (void)testGramMatrix
+{
+    MCKPrecision precisions[2] = { MCKPrecisionSingle, MCKPrecisionDouble };
+    for (int i = 0; i < 2; i++) {
+        MCKPrecision precision = precisions[i];
+        MAVMatrix *samples = [MAVMatrix randomMatrixWithRows:20 columns:4 precision:precision];
+        MAVCovarianceAccumulator *accumulator = [MAVCovarianceAccumulator accumulatorWithDimension:4 precision:precision];
+        [accumulator addSamples:samples];
+        
+        [self assertMatrix:[accumulator gramMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional]
+              equalsMatrix:[samples gramMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional]
+                  accuracy:precision == MCKPrecisionDouble ? 1e-12 : 1e-4
+                   message:@"Gram matrix"];
+    }
+}
+
+- (void)testEmptyBlocksAreIgnored
+{
+    MCKPrecision precisions[2] = { MCKPrecisionSingle, MCKPrecisionDouble };
+    for (int i = 0; i < 2; i++) {
+        MCKPrecision precision = precisions[i];
+        MAVMatrix *empty = [MAVMatrix matrixWithRows:0 columns:4 precision:precision];
+        MAVMatrix *samples = [MAVMatrix randomMatrixWithRows:20 columns:4 precision:precision];
+        MAVCovarianceAccumulator *expected = [MAVCovarianceAccumulator accumulatorWithDimension:4 precision:precision];
+        [expected addSamples:samples];
+        
+        MAVCovarianceAccumulator *accumulator = [MAVCovarianceAccumulator accumulatorWithDimension:4 precision:precision];
+        [accumulator addSamples:empty];
+        XCTAssertEqual(accumulator.count, (uint64_t)0, @"An empty block should not add samples.");
+        [accumulator addSamples:samples];
+        [accumulator addSamples:empty];
+        XCTAssertEqual(accumulator.count, (uint64_t)20, @"An empty block should not add samples.");
+        
+        double accuracy = precision == MCKPrecisionDouble ? 1e-12 : 1e-4;
+        for (MAVIndex j = 0; j < 4; j++) {
+            XCTAssertEqualWithAccuracy([accumulator.mean valueAtIndex:j].doubleValue, [expected.mean valueAtIndex:j].doubleValue, accuracy, @"An empty block should not change the mean.");
+        }
+        [self assertMatrix:[accumulator covarianceMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional]
+              equalsMatrix:[expected covarianceMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional]
+                  accuracy:accuracy
+                   message:@"An empty block should not change the covariance"];
+    }
+}
+
+- (void)testLargeOffsetIsStable
+{
+    // raw sums of squares lose every significant digit of a variance of 1 around a mean of 1e9
+    double values[4] = { 1e9 + 1.0, 1e9 - 1.0, 1e9 + 1.0, 1e9 - 1.0 };
+    MAVCovarianceAccumulator *accumulator = [MAVCovarianceAccumulator accumulatorWithDimension:1 precision:MCKPrecisionDouble];
+    for (int i = 0; i < 4; i++) {
+        [accumulator addSample:[MAVVector vectorWithValues:[NSData dataWithBytes:&values[i] length:sizeof(double)] length:1]];
+    }
+    XCTAssertEqualWithAccuracy([[accumulator covarianceMatrixWithPackingMethod:MAVMatrixValuePackingMethodConventional] valueAtRow:0 column:0].doubleValue, 4.0 / 3.0, 1e-9, @"Variance incorrect.");
+}
+
+@end
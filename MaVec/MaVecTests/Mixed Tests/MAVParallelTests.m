@@ -0,0 +1,105 @@
+//
+//  MAVParallelTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVParallelTests : XCTestCase
+
+@end
+
+@implementation MAVParallelTests
+
+- (void)testParallelReductionsMatchSerialReductions
+{
+    size_t length = 1000000;
+    double *values = malloc(length * sizeof(double));
+    double serialSum = 0.0;
+    for (size_t i = 0; i < length; i++) {
+        values[i] = (double)(i % 1000) - 400.0;
+        serialSum += values[i];
+    }
+    values[654321] = 5000.0;
+    values[765432] = 5000.0;
+    serialSum += 10000.0 - ((double)(654321 % 1000) - 400.0) - ((double)(765432 % 1000) - 400.0);
+    MAVVector *vector = [MAVVector vectorWithValues:[NSData dataWithBytesNoCopy:values length:length * sizeof(double)] length:(int)length];
+
+    XCTAssertEqualWithAccuracy(vector.sumOfValues.doubleValue, serialSum, 1e-6, @"Parallel sum incorrect.");
+    XCTAssertEqual(vector.maximumValue.doubleValue, 5000.0, @"Parallel maximum incorrect.");
+    XCTAssertEqual(vector.maximumValueIndex, 654321, @"Parallel maximum did not report the first index of the maximum.");
+    XCTAssertEqual(vector.minimumValue.doubleValue, -400.0, @"Parallel minimum incorrect.");
+    XCTAssertEqual(vector.minimumValueIndex, 0, @"Parallel minimum did not report the first index of the minimum.");
+}
+
+- (void)testDeterministicReductionsAreRepeatable
+{
+    MAVVector *vector = [MAVVector randomVectorOfLength:500000 vectorFormat:MAVVectorFormatColumnVector precision:MCKPrecisionSingle];
+    MAVParallelSetDeterministicReductions(YES);
+    float sum = vector.sumOfValues.floatValue;
+    for (int i = 0; i < 5; i++) {
+        MAVVector *copy = vector.copy;
+        XCTAssertEqual(copy.sumOfValues.floatValue, sum, @"Deterministic parallel sum was not repeatable.");
+    }
+}
+
+- (void)testParallelScansOfLargeMatrices
+{
+    MAVIndex order = 600;
+    MAVMatrix *identity = [MAVMatrix identityMatrixOfOrder:order precision:MCKPrecisionDouble];
+    XCTAssertTrue(identity.isIdentity.isYes, @"Large identity matrix not reported as identity.");
+    XCTAssertTrue(identity.isSymmetric.isYes, @"Large identity matrix not reported as symmetric.");
+    XCTAssertTrue(identity.isZero.isNo, @"Large identity matrix reported as zero.");
+
+    MAVMutableMatrix *asymmetric = [identity mutableCopy];
+    [asymmetric setEntryAtRow:order - 2 column:order - 1 toValue:@2.0];
+    XCTAssertTrue(asymmetric.isSymmetric.isNo, @"Large asymmetric matrix reported as symmetric.");
+    XCTAssertTrue(asymmetric.isIdentity.isNo, @"Large non-identity matrix reported as identity.");
+
+    MAVMatrix *zero = [MAVMatrix matrixFilledWithValue:@0.0 rows:order columns:order];
+    XCTAssertTrue(zero.isZero.isYes, @"Large zero matrix not reported as zero.");
+}
+
+- (void)testParallelLayoutConversionAndScaling
+{
+    MAVIndex rows = 500;
+    MAVIndex columns = 300;
+    MAVMatrix *matrix = [MAVMatrix randomMatrixWithRows:rows columns:columns precision:MCKPrecisionSingle];
+    const float *columnMajorValues = matrix.values.bytes;
+    const float *rowMajorValues = [matrix valuesWithLeadingDimension:MAVMatrixLeadingDimensionRow].bytes;
+    for (MAVIndex row = 0; row < rows; row += 37) {
+        for (MAVIndex col = 0; col < columns; col += 29) {
+            XCTAssertEqual(rowMajorValues[row * columns + col], columnMajorValues[col * rows + row], @"Parallel layout conversion incorrect.");
+        }
+    }
+
+    MAVMutableMatrix *scaled = [[matrix mutableCopy] multiplyByScalar:@2.0f];
+    const float *scaledValues = scaled.values.bytes;
+    for (size_t i = 0; i < (size_t)(rows * columns); i += 101) {
+        XCTAssertEqual(scaledValues[i], columnMajorValues[i] * 2.0f, @"Parallel scaling incorrect.");
+    }
+}
+
+@end
@@ -0,0 +1,130 @@
+//
+//  MAVRandomGeneratorTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVRandomGeneratorTests : XCTestCase
+
+@end
+
+@implementation MAVRandomGeneratorTests
+
+- (void)testPhiloxKnownAnswers
+{
+    // known answers for Philox4x32-10 from the Random123 distribution
+    uint32_t zeroCounter[4] = { 0, 0, 0, 0 };
+    uint32_t zeroKey[2] = { 0, 0 };
+    uint32_t expectedForZero[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+    uint32_t piCounter[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+    uint32_t piKey[2] = { 0xa4093822, 0x299f31d0 };
+    uint32_t expectedForPi[4] = { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 };
+    
+    uint32_t output[4];
+    MAVPhilox4x32(zeroCounter, zeroKey, output);
+    for (int i = 0; i < 4; i++) {
+        XCTAssertEqual(output[i], expectedForZero[i], @"Philox output word %d incorrect for zero counter and key.", i);
+    }
+    MAVPhilox4x32(piCounter, piKey, output);
+    for (int i = 0; i < 4; i++) {
+        XCTAssertEqual(output[i], expectedForPi[i], @"Philox output word %d incorrect for digits of pi.", i);
+    }
+}
+
+- (void)testSeededGeneratorsAreReproducible
+{
+    NSData *first = [[MAVRandomGenerator generatorWithSeed:42 stream:0] valuesWithDistribution:MAVRandomDistributionNormal count:1001 precision:MCKPrecisionDouble];
+    NSData *second = [[MAVRandomGenerator generatorWithSeed:42 stream:0] valuesWithDistribution:MAVRandomDistributionNormal count:1001 precision:MCKPrecisionDouble];
+    NSData *otherStream = [[MAVRandomGenerator generatorWithSeed:42 stream:1] valuesWithDistribution:MAVRandomDistributionNormal count:1001 precision:MCKPrecisionDouble];
+    
+    XCTAssertEqualObjects(first, second, @"Generators with the same seed and stream produced different values.");
+    XCTAssertNotEqualObjects(first, otherStream, @"Generators with different streams produced the same values.");
+    
+    MAVMatrix *a = [MAVMatrix randomMatrixWithRows:5 columns:4 distribution:MAVRandomDistributionUniform generator:[MAVRandomGenerator generatorWithSeed:7 stream:3] precision:MCKPrecisionSingle];
+    MAVMatrix *b = [MAVMatrix randomMatrixWithRows:5 columns:4 distribution:MAVRandomDistributionUniform generator:[MAVRandomGenerator generatorWithSeed:7 stream:3] precision:MCKPrecisionSingle];
+    XCTAssertEqualObjects(a, b, @"Random matrices from identically seeded generators differ.");
+}
+
+- (void)testParallelFillMatchesSuccessiveFills
+{
+    size_t count = 1 << 18;
+    MAVRandomGenerator *whole = [MAVRandomGenerator generatorWithSeed:2015 stream:0];
+    MAVRandomGenerator *halves = [MAVRandomGenerator generatorWithSeed:2015 stream:0];
+    
+    NSData *wholeValues = [whole valuesWithDistribution:MAVRandomDistributionUniform count:count precision:MCKPrecisionDouble];
+    NSMutableData *halvesValues = [[halves valuesWithDistribution:MAVRandomDistributionUniform count:count / 2 precision:MCKPrecisionDouble] mutableCopy];
+    [halvesValues appendData:[halves valuesWithDistribution:MAVRandomDistributionUniform count:count / 2 precision:MCKPrecisionDouble]];
+    
+    XCTAssertEqualObjects(wholeValues, halvesValues, @"Values should depend only on their position in the sequence, not on how they were requested.");
+}
+
+- (void)testDistributions
+{
+    size_t count = 100000;
+    MAVRandomGenerator *generator = [MAVRandomGenerator generatorWithSeed:1 stream:0];
+    
+    const float *uniform = [generator valuesWithDistribution:MAVRandomDistributionUniform count:count precision:MCKPrecisionSingle].bytes;
+    const double *normal = [generator valuesWithDistribution:MAVRandomDistributionNormal count:count precision:MCKPrecisionDouble].bytes;
+    const double *rademacher = [generator valuesWithDistribution:MAVRandomDistributionRademacher count:count precision:MCKPrecisionDouble].bytes;
+    
+    double uniformSum = 0.0, normalSum = 0.0, normalSquares = 0.0, rademacherSum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        XCTAssertTrue(uniform[i] >= -1.0f && uniform[i] < 1.0f, @"Uniform value %f out of range.", uniform[i]);
+        XCTAssertTrue(rademacher[i] == 1.0 || rademacher[i] == -1.0, @"Rademacher value %f is not ±1.", rademacher[i]);
+        uniformSum += uniform[i];
+        normalSum += normal[i];
+        normalSquares += normal[i] * normal[i];
+        rademacherSum += rademacher[i];
+    }
+    
+    XCTAssertEqualWithAccuracy(uniformSum / count, 0.0, 0.01, @"Mean of uniform values incorrect.");
+    XCTAssertEqualWithAccuracy(normalSum / count, 0.0, 0.02, @"Mean of normal values incorrect.");
+    XCTAssertEqualWithAccuracy(normalSquares / count, 1.0, 0.02, @"Variance of normal values incorrect.");
+    XCTAssertEqualWithAccuracy(rademacherSum / count, 0.0, 0.02, @"Mean of Rademacher values incorrect.");
+}
+
+- (void)testRandomIndexIsInRange
+{
+    MAVRandomGenerator *generator = [MAVRandomGenerator generatorWithSeed:3 stream:0];
+    for (int i = 0; i < 1000; i++) {
+        XCTAssertLessThan([generator randomIndexBelow:7], (NSUInteger)7, @"Random index out of range.");
+    }
+}
+
+- (void)testDefaultGeneratorCanBeSeeded
+{
+    MAVRandomGenerator *previous = [MAVRandomGenerator defaultGenerator];
+    
+    [MAVRandomGenerator setDefaultGenerator:[MAVRandomGenerator generatorWithSeed:99 stream:0]];
+    MAVMatrix *a = [MAVMatrix randomSymmetricMatrixOfOrder:4 precision:MCKPrecisionDouble];
+    [MAVRandomGenerator setDefaultGenerator:[MAVRandomGenerator generatorWithSeed:99 stream:0]];
+    MAVMatrix *b = [MAVMatrix randomSymmetricMatrixOfOrder:4 precision:MCKPrecisionDouble];
+    [MAVRandomGenerator setDefaultGenerator:previous];
+    
+    XCTAssertEqualObjects(a, b, @"Factory methods should draw from the default generator.");
+}
+
+@end
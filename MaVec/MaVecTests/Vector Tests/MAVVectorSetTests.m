@@ -0,0 +1,142 @@
+//
+//  MAVVectorSetTests.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@interface MAVVectorSetTests : XCTestCase
+
+@end
+
+
+@implementation MAVVectorSetTests
+
+// the similarity of two vectors computed directly from their values
+- (double)expectedSimilarityOfVector:(MAVVector *)a toVector:(MAVVector *)b metric:(MAVVectorSimilarityMetric)metric
+{
+    double dot = 0.0, aSquares = 0.0, bSquares = 0.0, distanceSquares = 0.0;
+    for (MAVIndex i = 0; i < a.length; i++) {
+        double x = a[i].doubleValue;
+        double y = b[i].doubleValue;
+        dot += x * y;
+        aSquares += x * x;
+        bSquares += y * y;
+        distanceSquares += (x - y) * (x - y);
+    }
+    switch (metric) {
+        case MAVVectorSimilarityMetricDotProduct: return dot;
+        case MAVVectorSimilarityMetricCosine: return dot / sqrt(aSquares * bSquares);
+        case MAVVectorSimilarityMetricEuclideanDistance: return sqrt(distanceSquares);
+    }
+}
+
+- (void)testSimilaritiesMatchPairwiseComparisons
+{
+    MAVVectorSet *vectors = [MAVVectorSet vectorSetWithMatrix:[MAVMatrix randomMatrixWithRows:7 columns:5 precision:MCKPrecisionDouble]];
+    MAVVectorSet *queries = [MAVVectorSet vectorSetWithMatrix:[MAVMatrix randomMatrixWithRows:3 columns:5 precision:MCKPrecisionDouble]];
+    
+    for (MAVVectorSimilarityMetric metric = MAVVectorSimilarityMetricDotProduct; metric <= MAVVectorSimilarityMetricEuclideanDistance; metric++) {
+        MAVMatrix *similarities = [vectors similaritiesWithVectorSet:queries metric:metric];
+        XCTAssertEqual(similarities.rows, queries.count, @"Expected a row for each query.");
+        XCTAssertEqual(similarities.columns, vectors.count, @"Expected a column for each vector.");
+        for (MAVIndex q = 0; q < queries.count; q++) {
+            for (MAVIndex v = 0; v < vectors.count; v++) {
+                double expected = [self expectedSimilarityOfVector:[queries vectorAtIndex:q] toVector:[vectors vectorAtIndex:v] metric:metric];
+                XCTAssertEqualWithAccuracy([similarities valueAtRow:q column:v].doubleValue, expected, 1e-10, @"Wrong similarity of query %lld to vector %lld with metric %d.", (long long int)q, (long long int)v, (int)metric);
+            }
+        }
+    }
+}
+
+- (void)testSimilarityOfVectorToItself
+{
+    MAVVectorSet *vectors = [MAVVectorSet vectorSetWithVectors:@[[MAVVector vectorWithValuesInArray:@[@3.0f, @4.0f]],
+                                                                 [MAVVector vectorWithValuesInArray:@[@0.0f, @0.0f]]]];
+    
+    MAVMatrix *distances = [vectors similaritiesWithVectorSet:vectors metric:MAVVectorSimilarityMetricEuclideanDistance];
+    XCTAssertEqual([distances valueAtRow:0 column:0].floatValue, 0.0f, @"The distance of a vector to itself should be 0.");
+    XCTAssertEqualWithAccuracy([distances valueAtRow:0 column:1].floatValue, 5.0f, 1e-5f, @"Wrong distance to the vector of zeros.");
+    
+    MAVMatrix *cosines = [vectors similaritiesWithVectorSet:vectors metric:MAVVectorSimilarityMetricCosine];
+    XCTAssertEqualWithAccuracy([cosines valueAtRow:0 column:0].floatValue, 1.0f, 1e-6f, @"The cosine similarity of a vector to itself should be 1.");
+    XCTAssertEqual([cosines valueAtRow:1 column:1].floatValue, 0.0f, @"The cosine similarity to a vector of zeros should be 0.");
+}
+
+- (void)testNearestNeighborsMatchBruteForceAcrossBlocks
+{
+    MAVIndex count = MAV_VECTOR_SET_BLOCK_SIZE + 300;
+    MAVIndex neighbors = 10;
+    MAVVectorSet *vectors = [MAVVectorSet vectorSetWithMatrix:[MAVMatrix randomMatrixWithRows:count columns:8 precision:MCKPrecisionDouble]];
+    MAVVectorSet *queries = [MAVVectorSet vectorSetWithMatrix:[MAVMatrix randomMatrixWithRows:4 columns:8 precision:MCKPrecisionDouble]];
+    
+    for (MAVVectorSimilarityMetric metric = MAVVectorSimilarityMetricDotProduct; metric <= MAVVectorSimilarityMetricEuclideanDistance; metric++) {
+        NSData *indices;
+        MAVMatrix *scores = [vectors nearestNeighborsOfVectorSet:queries count:neighbors metric:metric indices:&indices];
+        MAVMatrix *similarities = [vectors similaritiesWithVectorSet:queries metric:metric];
+        XCTAssertEqual(scores.columns, neighbors, @"Expected a column for each neighbor.");
+        
+        for (MAVIndex q = 0; q < queries.count; q++) {
+            NSMutableArray *ranking = [NSMutableArray array];
+            for (MAVIndex v = 0; v < count; v++) {
+                [ranking addObject:@(v)];
+            }
+            [ranking sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+                double x = [similarities valueAtRow:q column:a.longLongValue].doubleValue;
+                double y = [similarities valueAtRow:q column:b.longLongValue].doubleValue;
+                if (metric == MAVVectorSimilarityMetricEuclideanDistance) {
+                    return x < y ? NSOrderedAscending : (x > y ? NSOrderedDescending : NSOrderedSame);
+                }
+                return x > y ? NSOrderedAscending : (x < y ? NSOrderedDescending : NSOrderedSame);
+            }];
+            
+            for (MAVIndex r = 0; r < neighbors; r++) {
+                MAVIndex index = ((const MAVIndex *)indices.bytes)[q * neighbors + r];
+                XCTAssertEqual(index, [ranking[r] longLongValue], @"Wrong neighbor %lld of query %lld with metric %d.", (long long int)r, (long long int)q, (int)metric);
+                XCTAssertEqualWithAccuracy([scores valueAtRow:q column:r].doubleValue, [similarities valueAtRow:q column:index].doubleValue, 1e-10, @"Wrong score of neighbor %lld of query %lld.", (long long int)r, (long long int)q);
+            }
+        }
+    }
+}
+
+- (void)testNearestNeighborsOfSmallSetReturnsWholeSet
+{
+    MAVVectorSet *vectors = [MAVVectorSet vectorSetWithVectors:@[[MAVVector vectorWithValuesInArray:@[@1.0, @0.0]],
+                                                                 [MAVVector vectorWithValuesInArray:@[@0.0, @1.0]],
+                                                                 [MAVVector vectorWithValuesInArray:@[@2.0, @2.0]]]];
+    MAVVectorSet *queries = [MAVVectorSet vectorSetWithVectors:@[[MAVVector vectorWithValuesInArray:@[@0.0, @3.0]]]];
+    
+    NSData *indices;
+    MAVMatrix *distances = [vectors nearestNeighborsOfVectorSet:queries count:5 metric:MAVVectorSimilarityMetricEuclideanDistance indices:&indices];
+    XCTAssertEqual(distances.columns, (MAVIndex)3, @"Expected every vector in the set.");
+    
+    const MAVIndex *neighbors = indices.bytes;
+    XCTAssertEqual(neighbors[0], (MAVIndex)1, @"Wrong nearest neighbor.");
+    XCTAssertEqual(neighbors[1], (MAVIndex)2, @"Wrong second nearest neighbor.");
+    XCTAssertEqual(neighbors[2], (MAVIndex)0, @"Wrong farthest neighbor.");
+    XCTAssertEqualWithAccuracy([distances valueAtRow:0 column:0].doubleValue, 2.0, 1e-12, @"Wrong distance to the nearest neighbor.");
+}
+
+@end
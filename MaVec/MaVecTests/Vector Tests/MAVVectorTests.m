@@ -171,6 +171,26 @@
     XCTAssertTrue([a isEqualToVector:aCopy], @"Vector copy is not equal to its source.");
 }
 
+- (void)testVectorCopiesShareValuesUntilMutated
+{
+    MAVVector *a = [MAVVector vectorWithValuesInArray:@[@3.0, @(-3.0), @1.0]];
+    MAVMutableVector *b = a.mutableCopy;
+    
+    XCTAssertEqual(a.values.bytes, b.values.bytes, @"A mutable copy should share its source's values until it is mutated.");
+    
+    b[0] = @5.0;
+    
+    XCTAssertNotEqual(a.values.bytes, b.values.bytes, @"Mutating a copy should give it its own values.");
+    XCTAssertEqual([a valueAtIndex:0].doubleValue, 3.0, @"Mutating a copy changed the values of its source.");
+    XCTAssertEqual([b valueAtIndex:0].doubleValue, 5.0, @"Mutation of a copy was lost.");
+    
+    MAVVector *c = b.copy;
+    [b multiplyByScalar:@2.0];
+    
+    XCTAssertEqual([c valueAtIndex:0].doubleValue, 5.0, @"Mutating a vector changed the values of its copy.");
+    XCTAssertEqual([b valueAtIndex:0].doubleValue, 10.0, @"Mutation of a copied vector was lost.");
+}
+
 - (void)testVectorNorms
 {
     MAVVector *vector = [MAVVector vectorWithValuesInArray:@[@1.0, @2.0, @3.0]];
@@ -186,6 +206,55 @@
     XCTAssertEqual(vector.infinityNorm.doubleValue, infinityNormSolution, @"Infinity norm incorrect.");
 }
 
+- (void)testExtremeValues
+{
+    MAVVector *vector = [MAVVector vectorWithValuesInArray:@[@-4.0, @-1.5, @-9.0, @-1.5, @-9.0]];
+    
+    XCTAssertEqual(vector.maximumValue.doubleValue, -1.5, @"Maximum of negative values incorrect.");
+    XCTAssertEqual(vector.maximumValueIndex, 1, @"Maximum index should be the first of equal values.");
+    XCTAssertEqual(vector.minimumValue.doubleValue, -9.0, @"Minimum incorrect.");
+    XCTAssertEqual(vector.minimumValueIndex, 2, @"Minimum index should be the first of equal values.");
+    XCTAssertEqual(vector.sumOfValues.doubleValue, -25.0, @"Sum incorrect.");
+}
+
+- (void)testSummaryStatistics
+{
+    // long enough to span several blocks of the statistics pass
+    MCKPrecision precisions[2] = { MCKPrecisionDouble, MCKPrecisionSingle };
+    for (int p = 0; p < 2; p++) {
+        double accuracy = precisions[p] == MCKPrecisionDouble ? 1e-9 : 1e-2;
+        MAVMutableVector *vector = [MAVMutableVector randomVectorOfLength:3001 vectorFormat:MAVVectorFormatColumnVector precision:precisions[p]];
+        [vector multiplyByScalar:@10.0];
+        MAVVector *separately = [MAVVector vectorWithValues:vector.values length:vector.length];
+        
+        [vector computeSummaryStatistics];
+        
+        double mean = 0.0;
+        for (int i = 0; i < vector.length; i++) {
+            mean += [vector valueAtIndex:i].doubleValue;
+        }
+        mean /= vector.length;
+        double squaredDeviations = 0.0;
+        for (int i = 0; i < vector.length; i++) {
+            double deviation = [vector valueAtIndex:i].doubleValue - mean;
+            squaredDeviations += deviation * deviation;
+        }
+        
+        XCTAssertEqualWithAccuracy(vector.mean.doubleValue, mean, accuracy, @"Mean incorrect.");
+        XCTAssertEqualWithAccuracy(vector.variance.doubleValue, squaredDeviations / (vector.length - 1), accuracy, @"Variance incorrect.");
+        XCTAssertEqualWithAccuracy(vector.sumOfValues.doubleValue, separately.sumOfValues.doubleValue, accuracy * vector.length, @"Sum incorrect.");
+        XCTAssertEqualWithAccuracy(vector.l1Norm.doubleValue, separately.l1Norm.doubleValue, accuracy * vector.length, @"L1 norm incorrect.");
+        XCTAssertEqualWithAccuracy(vector.l2Norm.doubleValue, separately.l2Norm.doubleValue, accuracy * 10, @"L2 norm incorrect.");
+        XCTAssertEqual(vector.infinityNorm.doubleValue, separately.infinityNorm.doubleValue, @"Infinity norm incorrect.");
+        XCTAssertEqual(vector.maximumValue.doubleValue, separately.maximumValue.doubleValue, @"Maximum incorrect.");
+        XCTAssertEqual(vector.maximumValueIndex, separately.maximumValueIndex, @"Maximum index incorrect.");
+        XCTAssertEqual(vector.minimumValue.doubleValue, separately.minimumValue.doubleValue, @"Minimum incorrect.");
+        XCTAssertEqual(vector.minimumValueIndex, separately.minimumValueIndex, @"Minimum index incorrect.");
+        XCTAssert(vector.isZero.isNo, @"Random vector identified as zero.");
+        XCTAssert(vector.isIdentity.isNo, @"Random vector identified as identity.");
+    }
+}
+
 - (void)testIdentityVector
 {
     MAVVector *doubleIdentityVector = [MAVVector vectorFilledWithValue:@1.0 length:4 vectorFormat:MAVVectorFormatRowVector];
@@ -220,4 +289,35 @@
     XCTAssert(randomSingleVector.isZero.isNo, @"Non-zero single precision vector identified as zero.");
 }
 
+- (void)testSecureCodingRoundTrip
+{
+    MAVVector *vectors[3] = { [MAVVector randomVectorOfLength:5 vectorFormat:MAVVectorFormatRowVector precision:MCKPrecisionDouble],
+                              [MAVMutableVector randomVectorOfLength:4 vectorFormat:MAVVectorFormatColumnVector precision:MCKPrecisionSingle],
+                              [MAVVector vectorWithValues:[NSData dataWithBytes:(float[3]){ 1.0f, -2.0f, 3.0f } length:3 * sizeof(float)] length:3 vectorFormat:MAVVectorFormatRowVector] };
+    
+    for (int i = 0; i < 3; i++) {
+        NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:[NSKeyedArchiver archivedDataWithRootObject:vectors[i]]];
+        unarchiver.requiresSecureCoding = YES;
+        MAVVector *decoded = [unarchiver decodeObjectOfClass:[MAVVector class] forKey:NSKeyedArchiveRootObjectKey];
+        
+        XCTAssertEqual([decoded class], [vectors[i] class], @"Unarchived vector has the wrong class.");
+        XCTAssertEqual(decoded.vectorFormat, vectors[i].vectorFormat, @"Vector format not preserved.");
+        XCTAssertEqual(decoded.precision, vectors[i].precision, @"Precision not preserved.");
+        XCTAssertEqualObjects(decoded.values, vectors[i].values, @"Values not preserved.");
+    }
+}
+
+- (void)testContentHash
+{
+    MAVVector *column = [MAVVector randomVectorOfLength:9 vectorFormat:MAVVectorFormatColumnVector precision:MCKPrecisionDouble];
+    MAVVector *row = [MAVVector vectorWithValues:column.values length:9 vectorFormat:MAVVectorFormatRowVector];
+    XCTAssertEqualObjects(column, row, @"Vector format should not affect equality.");
+    XCTAssertEqual(column.hash, row.hash, @"Equal vectors should have equal hashes.");
+    
+    MAVMutableVector *mutated = column.mutableCopy;
+    [mutated setValue:@([column valueAtIndex:4].doubleValue + 1.0) atIndex:4];
+    XCTAssertNotEqual(mutated.contentHash, column.contentHash, @"Mutating a vector should change its hash.");
+    XCTAssertNotEqualObjects(mutated, column, @"A mutated vector should no longer equal its source.");
+}
+
 @end
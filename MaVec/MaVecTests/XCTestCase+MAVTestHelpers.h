@@ -0,0 +1,47 @@
+//
+//  XCTestCase+MAVTestHelpers.h
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+
+@class MAVMatrix;
+
+/**
+ @description Helpers shared by the test cases of MaVec.
+ */
+@interface XCTestCase (MAVTestHelpers)
+
+/**
+ @return The URL of a file with a unique name and the specified extension in the temporary directory. The file is not created.
+ */
+- (NSURL *)temporaryFileURLWithExtension:(NSString *)extension;
+
+/**
+ @brief Assert that two matrices have the same dimensions, and that each value of the first is within the specified accuracy of the corresponding value of the second.
+ */
+- (void)assertMatrix:(MAVMatrix *)matrix equalsMatrix:(MAVMatrix *)expected accuracy:(double)accuracy message:(NSString *)message;
+
+@end
@@ -0,0 +1,49 @@
+//
+//  XCTestCase+MAVTestHelpers.m
+//  MaVec
+//
+//  Created by Andrew McKnight on 10/19/26.
+//
+//  Copyright © 2015 AMProductions
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+
+#import "XCTestCase+MAVTestHelpers.h"
+
+@implementation XCTestCase (MAVTestHelpers)
+
+- (NSURL *)temporaryFileURLWithExtension:(NSString *)extension
+{
+    NSString *name = [[NSUUID UUID].UUIDString stringByAppendingPathExtension:extension];
+    return [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+}
+
+- (void)assertMatrix:(MAVMatrix *)matrix equalsMatrix:(MAVMatrix *)expected accuracy:(double)accuracy message:(NSString *)message
+{
+    XCTAssertEqual(matrix.rows, expected.rows, @"%@: wrong amount of rows.", message);
+    XCTAssertEqual(matrix.columns, expected.columns, @"%@: wrong amount of columns.", message);
+    for (MAVIndex row = 0; row < expected.rows; row++) {
+        for (MAVIndex col = 0; col < expected.columns; col++) {
+            XCTAssertEqualWithAccuracy([matrix valueAtRow:row column:col].doubleValue, [expected valueAtRow:row column:col].doubleValue, accuracy, @"%@: value at (%lld, %lld) incorrect.", message, (long long int)row, (long long int)col);
+        }
+    }
+}
+
+@end